@@ -56,3 +56,53 @@ export function getKeys(obj){
 export function capitalize(str){
     return str.charAt(0).toUpperCase() + str.slice(1);
 }
+
+//! Handlers registered with onGuiUpdate by topic
+const guiUpdateHandlers = {};
+
+//! Splits a GuiUpdateBatch event into the topics it contains
+function dispatchGuiUpdateBatch(event, vars){
+
+    const updates = {};
+
+    // When there is a single topic this isn't an array
+    const topics = Array.isArray(vars.topics) ? vars.topics : [vars.topics];
+
+    for(const topic of topics){
+        updates[topic] = {};
+    }
+
+    // The variables are named "topic.variable"
+    for(const key of getKeys(vars)){
+
+        const separator = key.indexOf(".");
+
+        if(separator < 0)
+            continue;
+
+        const topic = key.substring(0, separator);
+
+        if(updates[topic])
+            updates[topic][key.substring(separator + 1)] = vars[key];
+    }
+
+    for(const topic of topics){
+
+        const handler = guiUpdateHandlers[topic];
+
+        if(handler)
+            handler(event, updates[topic]);
+    }
+}
+
+//! Registers a handler for the updates of topic sent through the
+//! GuiUpdateChannel in C++. The handler gets the same arguments as with
+//! Leviathan.OnGeneric
+export function onGuiUpdate(topic, handler){
+
+    if(Object.keys(guiUpdateHandlers).length == 0){
+        Leviathan.OnGeneric("GuiUpdateBatch", dispatchGuiUpdateBatch);
+    }
+
+    guiUpdateHandlers[topic] = handler;
+}
@@ -339,6 +339,18 @@ function handleDebugOverlayData(vars){
         document.getElementById("debugOverlay").style.display = "none";
     }
 
+    // Per system times of the cell stage, sent as JSON
+    const timings = document.getElementById("systemTimings");
+
+    if(vars.show && vars.systemTimings){
+        timings.innerText = JSON.parse(vars.systemTimings).map((system) => {
+            return system.name + ": " + system.average.toFixed(2) + "ms max: " +
+                system.max.toFixed(2) + "ms";
+        }).join("\n");
+    } else {
+        timings.innerText = "";
+    }
+
     if(vars.ticksBehind){
         document.getElementById("currentTicksBehind").innerText =
             "TICK UPDATES ARE BEHIND BY " + vars.ticksBehind + " TICKS";
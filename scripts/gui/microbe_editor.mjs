@@ -388,13 +388,13 @@ export function setupMicrobeEditor(){
         });
 
         Leviathan.OnGeneric("OrganellePatchEfficiencyData", (event, vars) => {
-            // Just let any exceptions buble up from json parse
-            updateOrganelleEfficiencies(JSON.parse(vars.data));
+            // Just let any exceptions buble up from parsing
+            updateOrganelleEfficiencies(parseProcessPayload(vars.data));
         });
 
         Leviathan.OnGeneric("MicrobeEditorEnergyBalanceUpdated", (event, vars) => {
-            // Just let any exceptions buble up from json parse
-            updateEnergyBalanceBars(JSON.parse(vars.data));
+            // Just let any exceptions buble up from parsing
+            updateEnergyBalanceBars(parseProcessPayload(vars.data));
         });
 
     } else {
@@ -1723,6 +1723,92 @@ function writeOrganelleProcessList(organelleProcesses, targetElement){
     }
 }
 
+//! Version of the process payloads this can read. Must match
+//! PROCESS_PAYLOAD_VERSION in process_information.h
+const PROCESS_PAYLOAD_VERSION = 1;
+
+//! Parses a process_efficiencies or energy_balance payload from
+//! ProcessEfficiencies::toGUIPayload or EnergyBalance::toGUIPayload into the
+//! same objects as their toJSON formats
+function parseProcessPayload(text){
+    const lines = text.split("\n");
+    const [type, version] = lines[0].split("\t");
+
+    if(Number(version) !== PROCESS_PAYLOAD_VERSION){
+        throw new Error("unsupported " + type + " payload version: " + version);
+    }
+
+    const result = type === "energy_balance" ?
+        {production: {}, consumption: {}, total: {}} : {organelles: {}};
+
+    let organelle = null;
+    let process = null;
+
+    const addCompound = (group, fields) => {
+        if(!process[group])
+            process[group] = {};
+
+        const compound = {name: fields[2], amount: Number(fields[3])};
+
+        if(fields.length > 4){
+            compound.availableAmount = Number(fields[4]);
+            compound.availableRate = Number(fields[5]);
+        }
+
+        process[group][fields[1]] = compound;
+    };
+
+    for(let i = 1; i < lines.length; ++i){
+        if(lines[i] === "")
+            continue;
+
+        const fields = lines[i].split("\t");
+
+        switch(fields[0]){
+        case "total":
+            result.total.production = Number(fields[1]);
+            result.total.consumption = Number(fields[2]);
+            result.total.balance = Number(fields[3]);
+            result.total.balanceStationary = Number(fields[4]);
+            break;
+        case "production":
+        case "consumption":
+            result[fields[0]][fields[1]] = Number(fields[2]);
+            break;
+        case "organelle":
+            organelle = {};
+            result.organelles[fields[1]] = organelle;
+            break;
+        case "process":
+            process = {name: fields[1], processName: fields[2],
+                speedFactor: Number(fields[3])};
+
+            if(!organelle.processes)
+                organelle.processes = [];
+            organelle.processes.push(process);
+            break;
+        case "input":
+            addCompound("inputs", fields);
+            break;
+        case "output":
+            addCompound("outputs", fields);
+            break;
+        case "environment":
+            addCompound("environment", fields);
+            break;
+        case "error":
+            if(!result.errors)
+                result.errors = [];
+            result.errors.push(fields[1]);
+            break;
+        default:
+            throw new Error("unknown " + type + " payload record: " + fields[0]);
+        }
+    }
+
+    return result;
+}
+
 // Updates the organelle efficiencies in tooltips
 function updateOrganelleEfficiencies(data) {
     const organelles = [
@@ -144,14 +144,14 @@ export function runMicrobeHUDSetup(){
     if(common.isInEngine()){
 
         // Register for the microbe stage events
-        Leviathan.OnGeneric("PlayerCompoundAmounts", (event, vars) => {
+        common.onGuiUpdate("PlayerCompoundAmounts", (event, vars) => {
 
             // Apply the new values
             updateMicrobeHUDBars(vars);
         });
 
         // Event for population changes
-        Leviathan.OnGeneric("PopulationChange", (event, vars) => {
+        common.onGuiUpdate("PopulationChange", (event, vars) => {
 
             // Apply the new values
             updatePopulation(vars.populationAmount);
@@ -181,7 +181,7 @@ export function runMicrobeHUDSetup(){
         });
 
         // Event for receiving data about stuff we are hovering over
-        Leviathan.OnGeneric("PlayerMouseHover", (event, vars) => {
+        common.onGuiUpdate("PlayerMouseHover", (event, vars) => {
 
             // Apply the new values
             updateHoverInfo(vars);
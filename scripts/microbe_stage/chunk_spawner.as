@@ -85,3 +85,62 @@ ObjectID spawnChunk(CellStageWorld@ world, const ChunkData@ chunk, const Float3
 
     return chunkEntity;
 }
+
+//! Puts a chunk that went out of the spawn radius to sleep so that the SpawnSystem
+//! can reuse it
+bool deactivateChunk(CellStageWorld@ world, ObjectID chunkEntity)
+{
+    auto rigidBody = world.GetComponent_Physics(chunkEntity);
+
+    if(rigidBody.Body is null)
+        return false;
+
+    // Park the body out of the way so that it doesn't collide with anything
+    auto position = world.GetComponent_Position(chunkEntity);
+    rigidBody.Body.ClearVelocity();
+    rigidBody.Body.SetPosition(Float3(position._Position.X, DORMANT_ENTITY_DEPTH,
+            position._Position.Z), position._Orientation);
+
+    auto renderNode = world.GetComponent_RenderNode(chunkEntity);
+    renderNode.Hidden = true;
+    renderNode.Marked = true;
+    return true;
+}
+
+//! Wakes up a chunk pooled by deactivateChunk at pos and refills its compounds
+bool recycleChunk(CellStageWorld@ world, const ChunkData@ chunk, ObjectID chunkEntity,
+    const Float3 &in pos)
+{
+    auto rigidBody = world.GetComponent_Physics(chunkEntity);
+
+    if(rigidBody.Body is null)
+        return false;
+
+    auto bag = world.GetComponent_CompoundBagComponent(chunkEntity);
+
+    auto chunkCompounds = chunk.getCompoundKeys();
+
+    for(uint i = 0; i < chunkCompounds.length(); ++i){
+        auto compoundId = SimulationParameters::compoundRegistry().getTypeData(
+            chunkCompounds[i]).id;
+        bag.setCompound(compoundId, chunk.getCompound(chunkCompounds[i]).amount);
+    }
+
+    auto position = world.GetComponent_Position(chunkEntity);
+    position._Position = pos;
+    position._Orientation = Quaternion(Float3(0, 1, 1),
+        Degree(GetEngine().GetRandom().GetNumber(0, 360)));
+    position.Marked = true;
+
+    rigidBody.Body.ClearVelocity();
+    rigidBody.JumpTo(position);
+
+    auto renderNode = world.GetComponent_RenderNode(chunkEntity);
+    renderNode.Hidden = false;
+    renderNode.Marked = true;
+
+    if(IsInGraphicalMode())
+        renderNode.Node.SetPosition(pos);
+
+    return true;
+}
@@ -30,40 +30,8 @@ void spawnCompoundCloud(CellStageWorld@ world, CompoundId compound, float amount
 // ------------------------------------ //
 // Agents
 void createAgentCloud(CellStageWorld@ world, CompoundId compoundId,
-    Float3 pos, Float3 direction, float amount, float lifetime,
-    string speciesName, ObjectID creatorEntity)
+    Float3 pos, Float3 direction, float amount, const string &in speciesName)
 {
-    auto normalizedDirection = direction.Normalize();
-    auto agentEntity = world.CreateEntity();
-
-    auto position = world.Create_Position(agentEntity, pos + (direction * 1.5),
-        Quaternion(Float3(0, 1, 0),
-            Degree(GetEngine().GetRandom().GetNumber(0, 360))));
-
-    // Agent
-    auto agentProperties = world.Create_AgentProperties(agentEntity);
-    agentProperties.setSpeciesName(speciesName);
-    agentProperties.setParentEntity(creatorEntity);
-    agentProperties.setAgentType("oxytoxy");
-
-    auto rigidBody = world.Create_Physics(agentEntity, position);
-
-
-    auto body = rigidBody.CreatePhysicsBody(world.GetPhysicalWorld(),
-        world.GetPhysicalWorld().CreateSphere(HEX_SIZE), 0.5,
-        world.GetPhysicalMaterial("agentCollision"));
-
-    body.ConstraintMovementAxises();
-
-    // TODO: physics property applying here as well
-    // rigidBody.properties.friction = 0.4;
-    // rigidBody.properties.linearDamping = 0.4;
-
-    body.SetVelocity(normalizedDirection * AGENT_EMISSION_VELOCITY);
-    rigidBody.JumpTo(position);
-    auto sceneNode = world.Create_RenderNode(agentEntity);
-    auto model = world.Create_Model(agentEntity, "oxytoxy.fbx",
-        getBasicMaterialWithTexture("oxytoxy_fluid.png"));
-
-    auto timedLifeComponent = world.Create_TimedLifeComponent(agentEntity, lifetime);
+    world.GetAgentCloudSystem().emitAgent(world, compoundId, pos, direction, amount,
+        speciesName);
 }
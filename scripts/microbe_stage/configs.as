@@ -7,6 +7,8 @@
 
 // Global defines
 const auto MICROBE_SPAWN_RADIUS = 150;
+// Spawned entities waiting to be recycled are parked this far below the play area
+const auto DORMANT_ENTITY_DEPTH = -1000.0f;
 // Right now these are used for species split from the player
 const auto INITIAL_SPLIT_POPULATION_MIN = 600;
 const auto INITIAL_SPLIT_POPULATION_MAX = 2000;
@@ -30,31 +32,19 @@ const auto CHUNK_ENGULF_COMPOUND_DIVISOR = 30.0f;
 const auto MIN_SPAWN_DISTANCE = -5000.0f;
 const auto MAX_SPAWN_DISTANCE = 5000.0f;
 
-// Cell Colors
-const auto MIN_COLOR = 0.0f;
-const auto MAX_COLOR = 0.9f;
+// The colour and opacity ranges, mutation chances, personality limits, ATP
+// costs, the health and bandwidth values and the engulfing values are
+// registered from src/microbe_stage/microbe_constants.h as the C++ code uses
+// them too
 
 // Too subtle?
 const auto MIN_COLOR_MUTATION = -0.2f;
 const auto MAX_COLOR_MUTATION = 0.2f;
 
-const auto MIN_OPACITY = 0.5f;
-const auto MAX_OPACITY = 1.8f;
-
-const auto MIN_OPACITY_CHITIN = 0.4f;
-const auto MAX_OPACITY_CHITIN = 1.2f;
-
 // Min Opacity Mutation
 const auto MIN_OPACITY_MUTATION = -0.01f;
 const auto MAX_OPACITY_MUTATION = 0.01f;
 
-// Mutation Variables
-const auto MUTATION_BACTERIA_TO_EUKARYOTE = 1.0f;
-const auto MUTATION_CREATION_RATE = 0.1f;
-const auto MUTATION_EXTRA_CREATION_RATE = 0.1f;
-const auto MUTATION_DELETION_RATE = 0.1f;
-const auto MUTATION_REPLACEMENT_RATE = 0.1f;
-
 // Genus splitting and name mutation
 const auto MUTATION_CHANGE_GENUS = 33;
 const auto MUTATION_WORD_EDIT = 10;
@@ -62,17 +52,6 @@ const auto MUTATION_WORD_EDIT = 10;
 //Removal cost
 const auto ORGANELLE_REMOVE_COST = 10;
 
-// Max fear and agression and activity
-const auto MAX_SPECIES_AGRESSION = 400.0f;
-const auto MAX_SPECIES_FEAR = 400.0f;
-const auto MAX_SPECIES_ACTIVITY = 400.0f;
-const auto MAX_SPECIES_FOCUS = 400.0f;
-const auto MAX_SPECIES_OPPORTUNISM = 400.0f;
-
-// Personality Mutation
-const auto MAX_SPECIES_PERSONALITY_MUTATION = 20.0f;
-const auto MIN_SPECIES_PERSONALITY_MUTATION = -20.0f;
-
 // Bacterial Colony configuration
 const auto MIN_BACTERIAL_COLONY_SIZE = 2;
 const auto MAX_BACTERIAL_COLONY_SIZE = 6;
@@ -97,29 +76,13 @@ const auto AI_TIME_INTERVAL = 0.2f;
 
 const auto AI_CELL_THINK_INTERVAL = 3.f;
 
-// Osmoregulation ATP cost
-//! If you change this you must also change the value in process_system.cpp
-const auto ATP_COST_FOR_OSMOREGULATION = 1.0f;
-
 //Purge Divisor
 const auto COMPOUND_PURGE_MODIFIER = 2.0f;
 
-//! BASE MOVEMENT COST ATP cost
-//! Cancels out a little bit more then one cytoplasm's glycolysis
-//! Note: this is applied *per* hex
-//! If you change this you must also change the value in process_system.cpp
-const auto BASE_MOVEMENT_ATP_COST = 1.0f;
-
 // The player's name
 const auto PLAYER_NAME = "Player";
 
-const auto DEFAULT_HEALTH = 100;
-// Amount of health per second regenerated
-const auto REGENERATION_RATE = 1.0f;
-
 // Movement stuff
-//! If you change this you must also change the value in process_system.cpp
-const auto FLAGELLA_ENERGY_COST = 7.1f;
 const auto FLAGELLA_BASE_FORCE = 0.7f;
 const auto CELL_BASE_THRUST = 1.6f;
 
@@ -141,22 +104,10 @@ const auto CELL_REQUIRED_DRAG_BEFORE_APPLY =  0.0033f;
 // to organelles. TODO: Modify to reflect microbe size.
 const uint COMPOUND_PROCESS_DISTRIBUTION_INTERVAL = 100;
 
-// Amount the microbes maxmimum bandwidth increases with per organelle
-// added. This is a temporary replacement for microbe surface area
-const float BANDWIDTH_PER_ORGANELLE = 1.0;
-
-// The of time it takes for the microbe to regenerate an amount of
-// bandwidth equal to maxBandwidth
-const float BANDWIDTH_REFILL_DURATION = 0.8f;
-
 // No idea what this does (if anything), but it isn't used in the
 // process system, or when ejecting compounds.
 const float STORAGE_EJECTION_THRESHHOLD = 0.8;
 
-// The amount of time between each loop to maintaining a fill level
-// below STORAGE_EJECTION_THRESHHOLD and eject useless compounds
-const float EXCESS_COMPOUND_COLLECTION_INTERVAL = 1.f;
-
 // The amount of hitpoints each organelle provides to a microbe.
 const uint MICROBE_HITPOINTS_PER_ORGANELLE = 10;
 
@@ -169,24 +120,9 @@ const float RELATIVE_VELOCITY_TO_BUMP_SOUND = 6.0;
 // I think (emphasis on think) this is unused.
 const float INITIAL_EMISSION_RADIUS = 0.5;
 
-// The speed reduction when a cell is in rngulfing mode.
-const double ENGULFING_MOVEMENT_DIVISION = 2.0f;
-
-// The speed reduction when a cell is being engulfed.
-const double ENGULFED_MOVEMENT_DIVISION = 10.0f;
-
-// The amount of ATP per second spent on being on engulfing mode.
-const float ENGULFING_ATP_COST_SECOND = 1.5;
-
 // The minimum HP ratio between a cell and a possible engulfing victim.
 const float ENGULF_HP_RATIO_REQ = 1.5f;
 
-// The amount of hp per second of damage
-const float ENGULF_DAMAGE = 45.0f;
-
-// Oxytoxy Damage
-const float OXY_TOXY_DAMAGE = 10.0f;
-
 // Cooldown between agent emissions, in seconds.
 const float AGENT_EMISSION_COOLDOWN = 2.f;
 
@@ -204,7 +140,6 @@ const int CREATURE_KILL_POPULATION_GAIN = 50;
 const int CREATURE_SCAVENGE_POPULATION_GAIN = 10;
 const int CREATURE_REPRODUCE_POPULATION_GAIN = 50;
 const int CREATURE_ESCAPE_POPULATION_GAIN = 50;
-const uint CREATURE_ESCAPE_INTERVAL = 5000;
 
 
 // Auto-evo tweak variables (TODO: move to JSON)
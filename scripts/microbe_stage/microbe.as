@@ -37,12 +37,19 @@ class MicrobeComponent : ScriptComponent{
         }
 
         organelles.resize(0);
+        organelleHexes.clear();
     }
 
     //! This has to be called after creating this
-    void init(ObjectID forEntity, bool isPlayerMicrobe, Species@ species)
+    //! \param stats The native component of the entity that holds the numeric state
+    void init(ObjectID forEntity, bool isPlayerMicrobe, Species@ species,
+        MicrobeStatsComponent@ stats)
     {
+        @this.stats = stats;
         @this.species = species;
+        stats.setAgentSpecies(species.name);
+        stats.membraneColour = species.colour;
+        stats.isBacteria = species.isBacteria;
 
         this.isPlayerMicrobe = isPlayerMicrobe;
         this.engulfMode = false;
@@ -56,7 +63,7 @@ class MicrobeComponent : ScriptComponent{
 
         //cache hexes in microbe
         for(uint i = 0; i < organelles.length(); ++i){
-            totalHexCountCache += organelles[i].organelle.getHexCount();
+            totalHexCountCache = totalHexCountCache + organelles[i].organelle.getHexCount();
         }
 
         // Microbe system update should initialize this component on next tick
@@ -72,59 +79,144 @@ class MicrobeComponent : ScriptComponent{
     //! \note This is directly read from C++ and MUST BE the first property
     Species@ species;
 
-    // TODO: initialize
-    float hitpoints = DEFAULT_HEALTH;
-    float previousHitpoints = DEFAULT_HEALTH;
-    float maxHitpoints = DEFAULT_HEALTH;
-    bool dead = false;
-    float deathTimer = 0;
+    //! The per tick numeric state is in this native component that is updated by
+    //! MicrobeStatsSystem. The properties below forward to it
+    MicrobeStatsComponent@ stats;
+
+    float hitpoints{
+        get const { return stats.hitpoints; }
+        set { stats.hitpoints = value; }
+    }
+    float maxHitpoints{
+        get const { return stats.maxHitpoints; }
+        set { stats.maxHitpoints = value; }
+    }
+    bool dead{
+        get const { return stats.dead; }
+        set { stats.dead = value; }
+    }
+    //! True while this is pooled by the SpawnSystem waiting to be recycled
+    bool dormant{
+        get const { return stats.dormant; }
+        set { stats.dormant = value; }
+    }
+    float deathTimer{
+        get const { return stats.deathTimer; }
+        set { stats.deathTimer = value; }
+    }
 
     // The organelles in this microbe
     array<PlacedOrganelle@> organelles;
 
+    //! Which organelle is at each hex. Kept up to date by
+    //! MicrobeOperations::addOrganelle and removeOrganelle
+    HexOccupancyMap@ organelleHexes = HexOccupancyMap();
+
     // Organelles with complete resonsiblity for a specific compound
     // (such as agentvacuoles)
-    // Keys are the CompoundId of the agent and the value is int
-    // specifying how many there are
-    dictionary specialStorageOrganelles;
+    // Indexed by the CompoundId of the agent and the value specifies how
+    // many there are. Use the helpers below as this is grown on demand
+    array<int> specialStorageOrganelles;
+
+    int getSpecialStorageCount(CompoundId compound) const
+    {
+        if(compound >= specialStorageOrganelles.length())
+            return 0;
+
+        return specialStorageOrganelles[compound];
+    }
+
+    void changeSpecialStorageCount(CompoundId compound, int change)
+    {
+        if(compound >= specialStorageOrganelles.length())
+            specialStorageOrganelles.resize(compound + 1);
+
+        specialStorageOrganelles[compound] += change;
+    }
 
     Float3 movementDirection = Float3(0, 0, 0);
     Float3 facingTargetPoint = Float3(0, 0, 0);
     float microbetargetdirection = 0;
-    float movementFactor = 1.0; // Multiplied on the movement speed of the microbe.
+    // Multiplied on the movement speed of the microbe.
+    float movementFactor{
+        get const { return stats.movementFactor; }
+        set { stats.movementFactor = value; }
+    }
     // The amount that can be stored in the
     // microbe. NOTE: This does not include
     // special storage organelles.
     // This is also the amount of each
     // individual compound you can hold
-    double capacity = 0;
+    double capacity{
+        get const { return stats.capacity; }
+        set { stats.capacity = value; }
+    }
     // The amount stored in the microbe. NOTE:
     // This does not include special storage
     // organelles.
-    double stored = 0;
+    double stored{
+        get const { return stats.stored; }
+        set { stats.stored = value; }
+    }
     bool initialized = false;
     bool isPlayerMicrobe = false;
-    float maxBandwidth = 10.0 * BANDWIDTH_PER_ORGANELLE; // wtf is a bandwidth anyway?
-    float remainingBandwidth = 0.0;
-    float compoundCollectionTimer = EXCESS_COMPOUND_COLLECTION_INTERVAL;
-    float escapeInterval = 0;
-    float agentEmissionCooldown = 0;
+    // wtf is a bandwidth anyway?
+    float maxBandwidth{
+        get const { return stats.maxBandwidth; }
+        set { stats.maxBandwidth = value; }
+    }
+    float remainingBandwidth{
+        get const { return stats.remainingBandwidth; }
+        set { stats.remainingBandwidth = value; }
+    }
+    float escapeInterval{
+        get const { return stats.escapeInterval; }
+        set { stats.escapeInterval = value; }
+    }
+    float agentEmissionCooldown{
+        get const { return stats.agentEmissionCooldown; }
+        set { stats.agentEmissionCooldown = value; }
+    }
 
     // Is this the place where the actual flash duration works?
     // The one in the organelle class doesn't work
-    float flashDuration = 0;
-    Float4 flashColour = Float4(0, 0, 0, 0);
+    float flashDuration{
+        get const { return stats.flashDuration; }
+        set { stats.flashDuration = value; }
+    }
+    Float4 flashColour{
+        get const { return stats.flashColour; }
+        set { stats.flashColour = value; }
+    }
     //! \todo Change this into an enum
     uint reproductionStage = 0;
 
 
     //variables for engulfing
-    bool engulfMode = false;
-    bool isCurrentlyEngulfing = false;
-    bool isBeingEngulfed = false;
-    bool wasBeingEngulfed = false;
-    bool hasEscaped = false;
-    ObjectID hostileEngulfer = NULL_OBJECT;
+    bool engulfMode{
+        get const { return stats.engulfMode; }
+        set { stats.engulfMode = value; }
+    }
+    bool isCurrentlyEngulfing{
+        get const { return stats.isCurrentlyEngulfing; }
+        set { stats.isCurrentlyEngulfing = value; }
+    }
+    bool isBeingEngulfed{
+        get const { return stats.isBeingEngulfed; }
+        set { stats.isBeingEngulfed = value; }
+    }
+    bool wasBeingEngulfed{
+        get const { return stats.wasBeingEngulfed; }
+        set { stats.wasBeingEngulfed = value; }
+    }
+    bool hasEscaped{
+        get const { return stats.hasEscaped; }
+        set { stats.hasEscaped = value; }
+    }
+    ObjectID hostileEngulfer{
+        get const { return stats.hostileEngulfer; }
+        set { stats.hostileEngulfer = value; }
+    }
     AudioSource@ engulfAudio;
     AudioSource@ otherAudio;
     // New state variables that MicrobeSystem also uses
@@ -136,7 +228,10 @@ class MicrobeComponent : ScriptComponent{
     Float3 queuedMovementForce = Float3(0, 0, 0);
 
     // This variable is used to cache the size of the hexes
-    int totalHexCountCache = 0;
+    int totalHexCountCache{
+        get const { return stats.totalHexCount; }
+        set { stats.totalHexCount = value; }
+    }
 }
 
 //! Helper for MicrobeSystem
@@ -194,6 +289,8 @@ class MicrobeSystem : ScriptSystem{
 
     void Run(float elapsed)
     {
+        SystemTimer timer(world, "MicrobeSystem");
+
         for(uint i = 0; i < CachedComponents.length(); ++i){
             updateMicrobe(CachedComponents[i], elapsed);
         }
@@ -230,6 +327,9 @@ class MicrobeSystem : ScriptSystem{
             return;
         }
 
+        if(microbeComponent.dormant)
+            return;
+
         if(microbeComponent.dead){
 
             updateDeadCell(components, elapsed);
@@ -255,155 +355,49 @@ class MicrobeSystem : ScriptSystem{
         CompoundAbsorberComponent@ compoundAbsorberComponent = components.first;
         CompoundBagComponent@ compoundBag = components.sixth;
         MicrobeComponent@ microbeComponent = components.second;
-        microbeComponent.movementFactor = 1.0f;
-
-        // Recalculating agent cooldown time.
-        microbeComponent.agentEmissionCooldown -= elapsed;
-
-        // Calculate storage.
-        calculateStorageSpace(microbeEntity);
-
-        // Get amount of compounds
-        uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
-        // This is only used in the process sytem to make sure you
-        // dont add anymore when out of space for a specific
-        // compound
-        compoundBag.storageSpace = microbeComponent.capacity;
-
-        // StorageOrganelles
-        updateCompoundAbsorber(microbeEntity);
-
-        // Regenerate bandwidth
-        regenerateBandwidth(microbeEntity, elapsed);
-
-        // Attempt to absorb queued compounds
-        auto absorbed = compoundAbsorberComponent.getAbsorbedCompounds();
-
-        // Loop through compounds and add if you can
-        for(uint i = 0; i < absorbed.length(); ++i){
-            CompoundId compound = absorbed[i];
-            auto amount = compoundAbsorberComponent.absorbedCompoundAmount(compound);
-
-            if(amount > 0.0 && (amount + MicrobeOperations::getCompoundAmount(world,
-                        microbeEntity, compound) <= microbeComponent.capacity)){
-                // Only fill up the microbe if they can hold more of a specific compound
-                MicrobeOperations::storeCompound(world, microbeEntity, compound,
-                    min(microbeComponent.capacity,amount), true);
-            }
-        }
-
-        // Flash membrane if something happens.
-        if(microbeComponent.flashDuration > 0 &&
-            microbeComponent.flashColour != Float4(0, 0, 0, 0)
-        ){
-            microbeComponent.flashDuration -= elapsed;
-
-            // How frequent it flashes, would be nice to update
-            // the flash void to have this variable{
-            if((microbeComponent.flashDuration % 0.6f) < 0.3f){
-                MicrobeOperations::setMembraneColour(world, microbeEntity,
-                    microbeComponent.flashColour);
-            } else {
-                //Restore colour
-                MicrobeOperations::applyMembraneColour(world, microbeEntity);
-            }
+        MicrobeStatsComponent@ stats = microbeComponent.stats;
 
-            if(microbeComponent.flashDuration <= 0){
-                microbeComponent.flashDuration = 0;
-                // Restore colour
-                MicrobeOperations::applyMembraneColour(world, microbeEntity);
-            }
-        }
-
-        //  Handle hitpoints
-        if((microbeComponent.hitpoints < microbeComponent.maxHitpoints))
-        {
-            if(MicrobeOperations::getCompoundAmount(world, microbeEntity,
-                    SimulationParameters::compoundRegistry().getTypeId("atp")) >= 1.0f)
-            {
-                microbeComponent.hitpoints += (REGENERATION_RATE * elapsed);
-                if (microbeComponent.hitpoints > microbeComponent.maxHitpoints)
-                {
-                    microbeComponent.hitpoints =  microbeComponent.maxHitpoints;
-                }
-            }
-        }
+        // Storage, bandwidth, absorbing compounds, health regeneration,
+        // osmoregulation, flashing, the movement factor and the engulfing
+        // state are handled by the native MicrobeStatsSystem
 
         doReproductionStep(components, elapsed);
 
-        if(microbeComponent.engulfMode){
-            // Drain atp
-            auto cost = ENGULFING_ATP_COST_SECOND * elapsed;
-
-            if(MicrobeOperations::takeCompound(world, microbeEntity,
-                    SimulationParameters::compoundRegistry().getTypeId("atp"), cost) <
-                cost - 0.001f)
-            {
-                //LOG_INFO("too little atp, disabling - engulfing");
-                MicrobeOperations::toggleEngulfMode(microbeComponent);
-            }
-
-            // Play sound
-            if (microbeComponent.isPlayerMicrobe &&  (@microbeComponent.engulfAudio is null ||
+        // Play sound
+        if(microbeComponent.engulfMode && microbeComponent.isPlayerMicrobe &&
+            (@microbeComponent.engulfAudio is null ||
                 !microbeComponent.engulfAudio.IsPlaying()))
-            {
-                @microbeComponent.engulfAudio = GetEngine().GetSoundDevice().Play2DSound(
-                    "Data/Sound/soundeffects/engulfment.ogg", false);
+        {
+            @microbeComponent.engulfAudio = GetEngine().GetSoundDevice().Play2DSound(
+                "Data/Sound/soundeffects/engulfment.ogg", false);
 
-                if(microbeComponent.engulfAudio !is null){
+            if(microbeComponent.engulfAudio !is null){
 
-                    if (microbeComponent.isPlayerMicrobe)
-                    {
-                        microbeComponent.engulfAudio.SetVolume(1.0f);
-                    }
+                microbeComponent.engulfAudio.SetVolume(1.0f);
 
-                    // what about other sound level?
+                // what about other sound level?
 
-                } else {
-                    LOG_ERROR("Failed to create engulfment sound player");
-                }
+            } else {
+                LOG_ERROR("Failed to create engulfment sound player");
             }
-
-            // Flash the membrane blue.
-            MicrobeOperations::flashMembraneColour(world, microbeEntity, 1,
-                Float4(0.2,0.5,1.0,0.5));
         }
 
-        if(microbeComponent.engulfMode){
-            microbeComponent.movementFactor =  microbeComponent.movementFactor /
-                ENGULFING_MOVEMENT_DIVISION;
+        if(stats.pendingEngulfDamage > 0){
+            const double engulfDamage = stats.pendingEngulfDamage;
+            stats.pendingEngulfDamage = 0;
+            MicrobeOperations::damage(world, microbeEntity, engulfDamage,
+                "isBeingEngulfed - Microbe.update()s");
         }
 
-        if(microbeComponent.isBeingEngulfed){
-            microbeComponent.movementFactor =  microbeComponent.movementFactor /
-                ENGULFED_MOVEMENT_DIVISION;
+        // Only other species gain population from escaping
+        if(stats.pendingEscapes > 0){
+            stats.pendingEscapes = 0;
 
-            MicrobeOperations::damage(world,microbeEntity, ENGULF_DAMAGE * elapsed,
-                "isBeingEngulfed - Microbe.update()s");
-            microbeComponent.wasBeingEngulfed = true;
-            // Else If we were but are no longer, being engulfed
-        } else if(microbeComponent.wasBeingEngulfed && !microbeComponent.isBeingEngulfed){
-
-            microbeComponent.wasBeingEngulfed = false;
             auto playerSpecies = MicrobeOperations::getSpecies(world, "Default");
 
-            if (!microbeComponent.isPlayerMicrobe &&
+            if(!microbeComponent.isPlayerMicrobe &&
                 microbeComponent.species.name != playerSpecies.name)
             {
-                 microbeComponent.hasEscaped = true;
-                 microbeComponent.escapeInterval = 0;
-            }
-
-            MicrobeOperations::removeEngulfedEffect(world, microbeEntity);
-        }
-
-        // Still considered to be chased for CREATURE_ESCAPE_INTERVAL milliseconds
-        if(microbeComponent.hasEscaped){
-            microbeComponent.escapeInterval += elapsed;
-            if(microbeComponent.escapeInterval >= CREATURE_ESCAPE_INTERVAL){
-                microbeComponent.hasEscaped = false;
-                microbeComponent.escapeInterval = 0;
-
                 auto species = MicrobeOperations::getSpecies(world,
                     microbeComponent.species.name);
 
@@ -413,81 +407,24 @@ class MicrobeSystem : ScriptSystem{
             }
         }
 
-        // Check whether we should not be being engulfed anymore
-        if (microbeComponent.hostileEngulfer != NULL_OBJECT){
-            auto predatorPosition = world.GetComponent_Position(
-                microbeComponent.hostileEngulfer);
-            auto ourPosition = world.GetComponent_Position(microbeEntity);
-            auto predatorMembraneComponent = world.GetComponent_MembraneComponent(
-                microbeComponent.hostileEngulfer);
-
-            if(predatorMembraneComponent is null){
-                // Can't be engulfed by something with no membrane
-                microbeComponent.hostileEngulfer = NULL_OBJECT;
-                microbeComponent.isBeingEngulfed = false;
-            } else {
-
-                auto circleRad = predatorMembraneComponent.calculateEncompassingCircleRadius();
-
-                MicrobeComponent@ hostileMicrobeComponent = cast<MicrobeComponent>(
-                    world.GetScriptComponentHolder("MicrobeComponent").Find(
-                        microbeComponent.hostileEngulfer));
-
-                if (hostileMicrobeComponent.species.isBacteria){
-                    circleRad = circleRad/2;
-                }
-
-                if ((hostileMicrobeComponent is null) ||
-                    (!hostileMicrobeComponent.engulfMode) ||
-                    (hostileMicrobeComponent.dead) ||
-                    (ourPosition._Position -  predatorPosition._Position).LengthSquared() >=
-                    circleRad){
-
-                    microbeComponent.hostileEngulfer = NULL_OBJECT;
-                    microbeComponent.isBeingEngulfed = false;
-                }
-            }
-        }
-        else {
-            microbeComponent.hostileEngulfer = NULL_OBJECT;
-            microbeComponent.isBeingEngulfed = false;
-        }
-
-        // There is an osmoregulation cost
-
-        // This is per second logic time is the amount of ticks per second.
-        // TODO:It seems to happen no matter what (even if it takes away less atp then
-        // you generate per second), we should probably make it take into account the amount
-        // of atp being generated so resources arent wasted
-        auto osmoCost = (microbeComponent.totalHexCountCache * SimulationParameters::membraneRegistry().getTypeData(microbeComponent.species.membraneType).osmoregulationFactor * ATP_COST_FOR_OSMOREGULATION) *
-            elapsed;
-
-        MicrobeOperations::takeCompound(world, microbeEntity,
-            SimulationParameters::compoundRegistry().getTypeId("atp"), osmoCost);
-
-        // Reset compound absorption
-        compoundAbsorberComponent.setAbsorbtionCapacity(microbeComponent.capacity);
-
-        microbeComponent.compoundCollectionTimer += elapsed;
-
         // Moved this to right before atpDamage
         applyCellMovement(components, elapsed);
 
-        while(microbeComponent.compoundCollectionTimer >
-            EXCESS_COMPOUND_COLLECTION_INTERVAL)
+        // For every EXCESS_COMPOUND_COLLECTION_INTERVAL passed
+        while(stats.pendingCompoundCollections > 0)
         {
-            // For every EXCESS_COMPOUND_COLLECTION_INTERVAL passed
             atpDamage(microbeEntity);
 
-            microbeComponent.compoundCollectionTimer -= EXCESS_COMPOUND_COLLECTION_INTERVAL;
+            stats.pendingCompoundCollections = stats.pendingCompoundCollections - 1;
             MicrobeOperations::purgeCompounds(world, microbeEntity);
         }
 
-        if(microbeComponent.hitpoints != microbeComponent.previousHitpoints)
-            membraneComponent.setHealthFraction(microbeComponent.hitpoints /
-                microbeComponent.maxHitpoints);
-
-        microbeComponent.previousHitpoints = microbeComponent.hitpoints;
+        // Toxins from the agent field that touched this cell
+        if(stats.pendingAgentDamage > 0){
+            const double agentDamage = stats.pendingAgentDamage;
+            stats.pendingAgentDamage = 0;
+            MicrobeOperations::damage(world, microbeEntity, agentDamage, "toxin");
+        }
     }
 
     private void updateDeadCell(MicrobeSystemCached@ &in components, float elapsed)
@@ -495,12 +432,8 @@ class MicrobeSystem : ScriptSystem{
         auto microbeEntity = components.entity;
 
         MicrobeComponent@ microbeComponent = components.second;
-        Physics@ physics = components.fourth;
-
-        microbeComponent.deathTimer -= elapsed;
-        // NOTE: this doesn't correctly restore the colour so not sure what this does here
-        microbeComponent.flashDuration = 0;
 
+        // The timer is counted down by the native MicrobeStatsSystem
         if(microbeComponent.deathTimer <= 0){
             if(microbeComponent.isPlayerMicrobe){
                 MicrobeOperations::respawnPlayer(world);
@@ -798,54 +731,6 @@ class MicrobeSystem : ScriptSystem{
 
     // ------------------------------------ //
     // Microbe operations only done by this class
-    //! Updates the used storage space in a microbe and stores it in the microbe component
-    void calculateStorageSpace(ObjectID microbeEntity)
-    {
-        MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
-            world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
-
-        microbeComponent.stored = 0;
-        uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
-        for(uint a = 0; a < compoundCount; ++a){
-            // Again this variable is only really nessessary for run and tumble
-            microbeComponent.stored += MicrobeOperations::getCompoundAmount(world,
-                microbeEntity, a);
-        }
-    }
-
-    // For updating the compound absorber
-    //
-    // Toggles the absorber on and off depending on the remaining storage
-    // capacity of the storage organelles.
-    void updateCompoundAbsorber(ObjectID microbeEntity)
-    {
-        MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
-            world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
-
-        auto compoundAbsorberComponent = world.GetComponent_CompoundAbsorberComponent(
-            microbeEntity);
-
-        if(microbeComponent.remainingBandwidth < 1 ||
-            microbeComponent.dead)
-        {
-            compoundAbsorberComponent.disable();
-        } else {
-            compoundAbsorberComponent.enable();
-        }
-    }
-
-    void regenerateBandwidth(ObjectID microbeEntity, float elapsed)
-    {
-        MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
-            world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
-
-        auto addedBandwidth = microbeComponent.remainingBandwidth + elapsed * 2700.f *
-            (microbeComponent.maxBandwidth / BANDWIDTH_REFILL_DURATION);
-
-        microbeComponent.remainingBandwidth = min(addedBandwidth,
-            microbeComponent.maxBandwidth);
-    }
-
     PlacedOrganelle@ splitOrganelle(ObjectID microbeEntity, PlacedOrganelle@ organelle)
     {
         auto q = organelle.q;
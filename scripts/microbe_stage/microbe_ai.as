@@ -102,6 +102,8 @@ class MicrobeAISystem : ScriptSystem{
     void Release(){}
 
     void Run(float elapsed){
+        SystemTimer timer(world, "MicrobeAISystem");
+
         passedTime += elapsed;
         if (passedTime >= AI_TIME_INTERVAL){
             passedTime = 0.f;
@@ -121,6 +123,10 @@ class MicrobeAISystem : ScriptSystem{
             MicrobeAIControllerComponent@ aiComponent = components.first;
             MicrobeComponent@ microbeComponent = components.second;
             Position@ position = components.third;
+
+            if(microbeComponent.dormant)
+                continue;
+
             // ai interval
             aiComponent.intervalRemaining += AI_TIME_INTERVAL;
             // TODO: Species is now reference counted and could be stored directly
@@ -154,8 +160,7 @@ class MicrobeAISystem : ScriptSystem{
 
             while(aiComponent.intervalRemaining > aiComponent.reevalutationInterval){
                 aiComponent.intervalRemaining -= aiComponent.reevalutationInterval;
-                int numberOfAgentVacuoles = int(
-                    microbeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+                int numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(oxytoxyId);
 
                 // Clear the lists
                 aiComponent.predatoryMicrobes.removeRange(0,aiComponent.predatoryMicrobes.length());
@@ -391,8 +396,7 @@ class MicrobeAISystem : ScriptSystem{
 
         CompoundId oxytoxyId = SimulationParameters::compoundRegistry().getTypeId("oxytoxy");
         // Grab the agent amounts so a small cell with a lot of toxins has the courage to attack.
-        int numberOfAgentVacuoles = int(
-                    microbeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+        int numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(oxytoxyId);
 
         // Retrieve nearest potential prey
         //Max position
@@ -403,7 +407,8 @@ class MicrobeAISystem : ScriptSystem{
             MicrobeComponent@ secondMicrobeComponent = cast<MicrobeComponent>(
                 world.GetScriptComponentHolder("MicrobeComponent").Find(allMicrobes[i]));
 
-            if (allMicrobes[i] != microbeEntity && (secondMicrobeComponent.species !is microbeComponent.species) && !secondMicrobeComponent.dead){
+            if (allMicrobes[i] != microbeEntity && (secondMicrobeComponent.species !is microbeComponent.species) && !secondMicrobeComponent.dead &&
+                !secondMicrobeComponent.dormant){
             if ((aiComponent.speciesAggression==MAX_SPECIES_AGRESSION) or
                     ((((numberOfAgentVacuoles+microbeComponent.totalHexCountCache)*1.0f)*(aiComponent.speciesAggression/AGRESSION_DIVISOR)) >
                     (secondMicrobeComponent.totalHexCountCache*1.0f))){
@@ -457,10 +462,10 @@ class MicrobeAISystem : ScriptSystem{
                 world.GetScriptComponentHolder("MicrobeComponent").Find(allMicrobes[i]));
             // Is this an expensive lookup?, ill come up with a more efficient means of doing this.
             CompoundId oxytoxyId = SimulationParameters::compoundRegistry().getTypeId("oxytoxy");
-            int numberOfAgentVacuoles = int(
-                secondMicrobeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+            int numberOfAgentVacuoles = secondMicrobeComponent.getSpecialStorageCount(oxytoxyId);
             // At max fear add them all
-            if (allMicrobes[i] != microbeEntity && (secondMicrobeComponent.species !is microbeComponent.species) && !secondMicrobeComponent.dead){
+            if (allMicrobes[i] != microbeEntity && (secondMicrobeComponent.species !is microbeComponent.species) && !secondMicrobeComponent.dead &&
+                !secondMicrobeComponent.dormant){
             if ((aiComponent.speciesFear==MAX_SPECIES_FEAR) or
             ((((numberOfAgentVacuoles+secondMicrobeComponent.totalHexCountCache)*1.0f)*(aiComponent.speciesFear/FEAR_DIVISOR)) >
             (microbeComponent.totalHexCountCache*1.0f))){
@@ -512,8 +517,7 @@ class MicrobeAISystem : ScriptSystem{
             return;
         }
         // Agent vacuoles.
-        int numberOfAgentVacuoles = int(
-            microbeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+        int numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(oxytoxyId);
 
         // Chase your prey if you dont like acting like a plant
         // Allows for emergence of Predatory Plants (Like a single cleed version of a venus fly trap)
@@ -596,7 +600,7 @@ class MicrobeAISystem : ScriptSystem{
             if (microbeComponent.hitpoints > 0 && numberOfAgentVacuoles > 0 &&
                 (position._Position -  aiComponent.targetPosition).LengthSquared() <= aiComponent.speciesFocus*10.0f){
                 if (MicrobeOperations::getCompoundAmount(world,microbeEntity,oxytoxyId) >= MINIMUM_AGENT_EMISSION_AMOUNT){
-                    MicrobeOperations::emitAgent(world,microbeEntity, oxytoxyId,10.0f,aiComponent.speciesFocus / 100.f);
+                    MicrobeOperations::emitAgent(world,microbeEntity, oxytoxyId,10.0f);
                 }
             }
         }
@@ -712,8 +716,7 @@ class MicrobeAISystem : ScriptSystem{
                 "oxytoxy");
 
             // Agent vacuoles.
-            int numberOfAgentVacuoles = int(
-                microbeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+            int numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(oxytoxyId);
 
             // If focused you can run away more specifically, if not you freak out and scatter
             if (predator==NULL_OBJECT || !rollCheck(aiComponent.speciesFocus,500.0f)){
@@ -741,7 +744,7 @@ class MicrobeAISystem : ScriptSystem{
             if (microbeComponent.hitpoints > 0 && numberOfAgentVacuoles > 0 &&
                 (position._Position -  aiComponent.targetPosition).LengthSquared() <= aiComponent.speciesFocus*10.0f){
                     if (MicrobeOperations::getCompoundAmount(world,microbeEntity,oxytoxyId) >= MINIMUM_AGENT_EMISSION_AMOUNT){
-                        MicrobeOperations::emitAgent(world,microbeEntity, oxytoxyId,10.0f,aiComponent.speciesFocus / 100.f);
+                        MicrobeOperations::emitAgent(world,microbeEntity, oxytoxyId,10.0f);
                         }
                     }
           }
@@ -755,8 +758,7 @@ class MicrobeAISystem : ScriptSystem{
         Position@ position = components.third;
         MicrobeComponent@ microbeComponent = components.second;
         CompoundId oxytoxyId = SimulationParameters::compoundRegistry().getTypeId("oxytoxy");
-        int numberOfAgentVacuoles = int(
-                    microbeComponent.specialStorageOrganelles[formatUInt(oxytoxyId)]);
+        int numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(oxytoxyId);
 
         //rollCheck(aiComponent.speciesOpportunism,500.0f)
         if (rollCheck(aiComponent.speciesOpportunism,500.0f))
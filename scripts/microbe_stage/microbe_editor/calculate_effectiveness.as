@@ -1,41 +1,43 @@
-//! \brief Calculates the effectiveness of organelles in the current
-//! or given patch and sends it to the GUI
-void calculateOrganelleEffectivenessInPatch(int patchId = -1)
+//! \brief Finds the current patch or the patch with patchId for editor
+//! calculations
+Patch@ getEditorPatch(int patchId = -1)
 {
-    auto world = GetThriveGame().getCellStage();
-    auto map = world.GetPatchManager().getCurrentMap();
+    auto map = GetThriveGame().getCellStage().GetPatchManager().getCurrentMap();
 
     assert(map !is null, "no current patch map detected");
 
-    Patch@ patch;
+    if(patchId == -1)
+        return map.getCurrentPatch();
 
-    if(patchId == -1){
-        @patch = map.getCurrentPatch();
-    } else {
-        @patch = map.getPatch(patchId);
-    }
+    return map.getPatch(patchId);
+}
+
+//! \brief Calculates the effectiveness of organelles in the current
+//! or given patch and sends it to the GUI
+//!
+//! The numbers are cached in model until the patch changes
+void calculateOrganelleEffectivenessInPatch(EnergyBalanceModel@ model, int patchId = -1)
+{
+    Patch@ patch = getEditorPatch(patchId);
 
     if(patch is null){
         LOG_ERROR("calculateOrganelleEffectivenessInPatch: could not find patch: " + patchId);
         return;
     }
 
-    auto keys = getOrganelleNames();
+    model.setPatch(patch);
 
-    array<const OrganelleTemplate@> organelles;
+    const auto result = model.getOrganelleTypeEfficiencies();
 
-    for(uint i = 0; i < keys.length(); ++i){
-        organelles.insertLast(getOrganelleDefinition(keys[i]));
+    if(result is null){
+        LOG_ERROR("calculateOrganelleEffectivenessInPatch: computing failed");
+        return;
     }
 
-    const string result = world.GetProcessSystem().computeOrganelleProcessEfficiencies(
-        organelles, patch);
-
-    // LOG_WRITE("OrganellePatchEfficiencyData: \n" + result);
+    // LOG_WRITE("OrganellePatchEfficiencyData: \n" + result.toJSON());
 
     GenericEvent@ event = GenericEvent("OrganellePatchEfficiencyData");
     NamedVars@ vars = event.GetNamedVars();
-    vars.AddValue(ScriptSafeVariableBlock("data", result));
+    vars.AddValue(ScriptSafeVariableBlock("data", result.toGUIPayload()));
     GetEngine().GetEventHandler().CallEvent(event);
 }
-
@@ -1,42 +1,33 @@
-//! \brief Calculates the energy balance for a cell with the given organelles
+//! \brief Sends the energy balance of the organelles in model to the GUI
 //!
-//! Used by the editor to collect info to send to the GUI
+//! Used by the editor. The model only recalculates organelle numbers when the
+//! patch changes so this is cheap to call after each edit
 #include "calculate_effectiveness.as"
 
-void calculateEnergyBalanceWithOrganellesAndMembraneType(const array<PlacedOrganelle@>@ organelles, const MembraneTypeId membraneType,
+void sendEnergyBalance(EnergyBalanceModel@ model, const MembraneTypeId membraneType,
     int patchId = -1)
 {
-    auto world = GetThriveGame().getCellStage();
-    auto map = world.GetPatchManager().getCurrentMap();
-
-    assert(map !is null, "no current patch map detected");
-
-    Patch@ patch;
-
-    if(patchId == -1){
-        @patch = map.getCurrentPatch();
-    } else {
-        @patch = map.getPatch(patchId);
-    }
+    Patch@ patch = getEditorPatch(patchId);
 
     if(patch is null){
-        LOG_ERROR("calculateEnergyBalanceWithOrganellesAndMembraneType: could not find patch: " + patchId);
+        LOG_ERROR("sendEnergyBalance: could not find patch: " + patchId);
         return;
     }
 
-    array<const OrganelleTemplate@> organelleTemplates;
+    model.setPatch(patch);
+    model.setMembrane(membraneType);
 
-    for(uint i = 0; i < organelles.length(); ++i){
-        organelleTemplates.insertLast(organelles[i].organelle);
-    }
+    const auto result = model.getBalance();
 
-    const string result = world.GetProcessSystem().computeEnergyBalance(
-        organelleTemplates, membraneType, patch);
+    if(result is null){
+        LOG_ERROR("sendEnergyBalance: computing failed");
+        return;
+    }
 
-    // LOG_WRITE("Energy balance data: \n" + result);
+    // LOG_WRITE("Energy balance data: \n" + result.toJSON());
 
     GenericEvent@ event = GenericEvent("MicrobeEditorEnergyBalanceUpdated");
     NamedVars@ vars = event.GetNamedVars();
-    vars.AddValue(ScriptSafeVariableBlock("data", result));
+    vars.AddValue(ScriptSafeVariableBlock("data", result.toGUIPayload()));
     GetEngine().GetEventHandler().CallEvent(event);
 }
@@ -129,7 +129,7 @@ class MicrobeEditor{
         GetThriveGame().getCellStage().GetTimedWorldOperations().onTimePassed(1);
 
         // Send info to the GUI about the organelle effectiveness in the current patch
-        calculateOrganelleEffectivenessInPatch();
+        calculateOrganelleEffectivenessInPatch(editedMicrobeEnergy);
 
         // Reset this, GUI will tell us to enable it again
         showHover = false;
@@ -152,10 +152,12 @@ class MicrobeEditor{
             playerSpecies.organelles);
 
         editedMicrobeOrganelles.resize(0);
+        editedMicrobeOccupancy.clear();
+        editedMicrobeEnergy.clearOrganelles();
         playerSpecies.stringCode="";
         for(uint i = 0; i < templateOrganelles.length(); ++i){
             auto organelle = cast<PlacedOrganelle>(templateOrganelles[i]);
-            editedMicrobeOrganelles.insertLast(organelle);
+            addEditedOrganelle(organelle);
             playerSpecies.stringCode += organelle.organelle.gene;
             // This will always be added after each organelle so its safe to assume its there
             playerSpecies.stringCode+=","+organelle.q+","+
@@ -279,7 +281,7 @@ class MicrobeEditor{
         _updateAlreadyPlacedVisuals();
 
         // Calculate and send energy balance to the GUI
-        calculateEnergyBalanceWithOrganellesAndMembraneType(editedMicrobeOrganelles, membrane, targetPatch);
+        sendEnergyBalance(editedMicrobeEnergy, membrane, targetPatch);
     }
 
     // This destroys and creates again entities to represent all the
@@ -383,8 +385,7 @@ class MicrobeEditor{
                     int posQ = int(hexes[i].X) + organelle.q;
                     int posR = int(hexes[i].Y) + organelle.r;
 
-                    auto organelleHere = OrganellePlacement::getOrganelleAt(
-                        editor.editedMicrobeOrganelles, Int2(posQ, posR));
+                    auto organelleHere = editor.getEditedOrganelleAt(Int2(posQ, posR));
 
                     if(organelleHere !is null &&
                         organelleHere.organelle.name == "cytoplasm")
@@ -393,15 +394,14 @@ class MicrobeEditor{
                         replacedCytos.insertLast(organelleHere);
 
                         LOG_INFO("replaced cytoplasm at " + posQ + ", " + posR);
-                        OrganellePlacement::removeOrganelleAt(editor.editedMicrobeOrganelles,
-                            Int2(posQ, posR));
+                        editor.removeEditedOrganelleAt(Int2(posQ, posR));
                     }
                 }
 
                 @action.data["replacedCytos"] = replacedCytos;
                 LOG_INFO("Placing organelle '" + organelle.organelle.name + "' at: " +
                     organelle.q + ", " + organelle.r);
-                editor.editedMicrobeOrganelles.insertLast(organelle);
+                editor.addEditedOrganelle(organelle);
 
                 editor._onEditedCellChanged();
 
@@ -416,11 +416,9 @@ class MicrobeEditor{
                 for(uint c = 0; c < hexes.length(); ++c){
                     int posQ = int(hexes[c].X) + organelle.q;
                     int posR = int(hexes[c].Y) + organelle.r;
-                    auto organelleHere = OrganellePlacement::getOrganelleAt(
-                        editor.editedMicrobeOrganelles, Int2(posQ, posR));
+                    auto organelleHere = editor.getEditedOrganelleAt(Int2(posQ, posR));
                     if(organelleHere !is null){
-                        OrganellePlacement::removeOrganelleAt(editor.editedMicrobeOrganelles,
-                            Int2(posQ, posR));
+                        editor.removeEditedOrganelleAt(Int2(posQ, posR));
                     }
                 }
 
@@ -430,7 +428,7 @@ class MicrobeEditor{
                     PlacedOrganelle@ replacedCyto = replacedCytos[i];
                     LOG_INFO("Replacing " + replacedCyto.organelle.name + "' at: " +
                         replacedCyto.q + ", " + replacedCyto.r);
-                    editor.editedMicrobeOrganelles.insertLast(replacedCyto);
+                    editor.addEditedOrganelle(replacedCyto);
                 }
 
                 LOG_INFO("Finished replacing cyto");
@@ -601,11 +599,9 @@ class MicrobeEditor{
                     for(uint c = 0; c < hexes.length(); ++c){
                         int posQ = int(hexes[c].X) + organelle.q;
                         int posR = int(hexes[c].Y) + organelle.r;
-                        auto organelleHere = OrganellePlacement::getOrganelleAt(
-                            editor.editedMicrobeOrganelles, Int2(posQ, posR));
+                        auto organelleHere = editor.getEditedOrganelleAt(Int2(posQ, posR));
                         if(organelleHere !is null){
-                            OrganellePlacement::removeOrganelleAt(editor.editedMicrobeOrganelles,
-                                Int2(posQ, posR));
+                            editor.removeEditedOrganelleAt(Int2(posQ, posR));
                             }
 
                     }
@@ -616,12 +612,14 @@ class MicrobeEditor{
             },
             function(EditorAction@ action, MicrobeEditor@ editor){
                 editor.editedMicrobeOrganelles.resize(0);
+                editor.editedMicrobeOccupancy.clear();
+                editor.editedMicrobeEnergy.clearOrganelles();
                 editor.setMutationPoints(int(action.data["previousMP"]));
                 // Load old microbe
                 array<PlacedOrganelle@> oldEditedMicrobeOrganelles =
                     cast<array<PlacedOrganelle@>>(action.data["oldEditedMicrobeOrganelles"]);
                 for(uint i = 0; i < oldEditedMicrobeOrganelles.length(); ++i){
-                    editor.editedMicrobeOrganelles.insertLast(cast<PlacedOrganelle>(oldEditedMicrobeOrganelles[i]));
+                    editor.addEditedOrganelle(cast<PlacedOrganelle>(oldEditedMicrobeOrganelles[i]));
                 }
 
                 editor._onEditedCellChanged();
@@ -736,8 +734,7 @@ class MicrobeEditor{
             int posQ = int(hexes[i].X + q);
             int posR = int(hexes[i].Y + r);
 
-            auto organelleHere = OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles,
-                Int2(posQ, posR));
+            auto organelleHere = getEditedOrganelleAt(Int2(posQ, posR));
 
             if(organelleHere !is null)
             {
@@ -758,16 +755,44 @@ class MicrobeEditor{
         return touching;
     }
 
+    //! Finds the edited organelle that covers hex
+    PlacedOrganelle@ getEditedOrganelleAt(const Int2 &in hex)
+    {
+        return OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles,
+            editedMicrobeOccupancy, hex);
+    }
+
+    //! Removes the edited organelle that covers hex without creating an action
+    bool removeEditedOrganelleAt(const Int2 &in hex)
+    {
+        auto organelle = getEditedOrganelleAt(hex);
+
+        if(organelle is null)
+            return false;
+
+        editedMicrobeEnergy.removeOrganelle(organelle.organelle);
+        return OrganellePlacement::removeOrganelleAt(editedMicrobeOrganelles,
+            editedMicrobeOccupancy, hex);
+    }
+
+    //! Adds an edited organelle without creating an action
+    void addEditedOrganelle(PlacedOrganelle@ organelle)
+    {
+        OrganellePlacement::addOrganelle(editedMicrobeOrganelles, editedMicrobeOccupancy,
+            organelle);
+        editedMicrobeEnergy.addOrganelle(organelle.organelle);
+    }
+
     //! Checks whether the hex at q, r has an organelle in its surroundeing hexes.
     bool surroundsOrganelle(int q, int r)
     {
         return
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q + 0, r - 1)) !is null ||
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q + 1, r - 1)) !is null ||
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q + 1, r + 0)) !is null ||
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q + 0, r + 1)) !is null ||
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q - 1, r + 1)) !is null ||
-            OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles, Int2(q - 1, r + 0)) !is null;
+            getEditedOrganelleAt(Int2(q + 0, r - 1)) !is null ||
+            getEditedOrganelleAt(Int2(q + 1, r - 1)) !is null ||
+            getEditedOrganelleAt(Int2(q + 1, r + 0)) !is null ||
+            getEditedOrganelleAt(Int2(q + 0, r + 1)) !is null ||
+            getEditedOrganelleAt(Int2(q - 1, r + 1)) !is null ||
+            getEditedOrganelleAt(Int2(q - 1, r + 0)) !is null;
     }
 
     void loadMicrobe(int entityId){
@@ -881,8 +906,7 @@ class MicrobeEditor{
 
     void removeOrganelleAt(int q, int r)
     {
-        auto organelleHere = OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles,
-                Int2(q, r));
+        auto organelleHere = getEditedOrganelleAt(Int2(q, r));
         PlacedOrganelle@ organelle = cast<PlacedOrganelle>(organelleHere);
 
         int cost = ORGANELLE_REMOVE_COST;
@@ -898,7 +922,7 @@ class MicrobeEditor{
                     int q = int(action.data["q"]);
                     int r = int(action.data["r"]);
                     // Remove the organelle
-                   OrganellePlacement::removeOrganelleAt(editor.editedMicrobeOrganelles,Int2(q, r));
+                   editor.removeEditedOrganelleAt(Int2(q, r));
                    editor._onEditedCellChanged();
                 },
                 // undo
@@ -911,17 +935,15 @@ class MicrobeEditor{
                     for(uint i = 0; i < hexes.length(); ++i){
                         int posQ = int(hexes[i].X) + organelle.q;
                         int posR = int(hexes[i].Y) + organelle.r;
-                        auto organelleHere = OrganellePlacement::getOrganelleAt(
-                            editor.editedMicrobeOrganelles, Int2(posQ, posR));
+                        auto organelleHere = editor.getEditedOrganelleAt(Int2(posQ, posR));
                         if(organelleHere !is null &&
                             organelleHere.organelle.name == "cytoplasm")
                         {
                             LOG_INFO("replaced cytoplasm");
-                            OrganellePlacement::removeOrganelleAt(editor.editedMicrobeOrganelles,
-                                Int2(posQ, posR));
+                            editor.removeEditedOrganelleAt(Int2(posQ, posR));
                         }
                     }
-                    editor.editedMicrobeOrganelles.insertLast(organelle);
+                    editor.addEditedOrganelle(organelle);
                     editor._onEditedCellChanged();
                 });
                 // Give the action access to some data
@@ -957,8 +979,7 @@ class MicrobeEditor{
             const Float3 pos = Hex::axialToCartesian(posQ, posR);
 
             // Detect can it be placed there
-            auto organelleHere = OrganellePlacement::getOrganelleAt(editedMicrobeOrganelles,
-                Int2(posQ, posR));
+            auto organelleHere = getEditedOrganelleAt(Int2(posQ, posR));
 
             bool canPlace = false;
 
@@ -1313,7 +1334,7 @@ class MicrobeEditor{
             NamedVars@ vars = event.GetNamedVars();
             targetPatch = int(vars.GetSingleValueByName("patchId"));
             // Update organelle effectiveness
-            calculateOrganelleEffectivenessInPatch(targetPatch);
+            calculateOrganelleEffectivenessInPatch(editedMicrobeEnergy, targetPatch);
             return 1;
         } else if(type == "MicrobeEditorNameChanged"){
             NamedVars@ vars = event.GetNamedVars();
@@ -1332,7 +1353,7 @@ class MicrobeEditor{
                     vars.AddValue(ScriptSafeVariableBlock("membrane", SimulationParameters::membraneRegistry().getInternalName(editor.membrane)));
                     GetEngine().GetEventHandler().CallEvent(event);
                     // Calculate and send energy balance to the GUI
-                    calculateEnergyBalanceWithOrganellesAndMembraneType(editor.editedMicrobeOrganelles, editor.membrane, editor.targetPatch); // not using _onEditedCellChange due to visuals not needing update
+                    sendEnergyBalance(editor.editedMicrobeEnergy, editor.membrane, editor.targetPatch); // not using _onEditedCellChange due to visuals not needing update
                 },
                 // undo
                 function(EditorAction@ action, MicrobeEditor@ editor){
@@ -1342,7 +1363,7 @@ class MicrobeEditor{
                     vars.AddValue(ScriptSafeVariableBlock("membrane", SimulationParameters::membraneRegistry().getInternalName(editor.membrane)));
                     GetEngine().GetEventHandler().CallEvent(event);
                     // Calculate and send energy balance to the GUI
-                    calculateEnergyBalanceWithOrganellesAndMembraneType(editor.editedMicrobeOrganelles, editor.membrane, editor.targetPatch);
+                    sendEnergyBalance(editor.editedMicrobeEnergy, editor.membrane, editor.targetPatch);
                 }
             );
 
@@ -1427,6 +1448,14 @@ class MicrobeEditor{
     // This is not private because anonymous callbacks want to access this
     array<PlacedOrganelle@> editedMicrobeOrganelles;
 
+    // Which of editedMicrobeOrganelles is at each hex. Use the edited organelle
+    // helpers to keep this up to date
+    HexOccupancyMap@ editedMicrobeOccupancy = HexOccupancyMap();
+
+    // Energy balance of editedMicrobeOrganelles. Also kept up to date by the
+    // edited organelle helpers
+    EnergyBalanceModel@ editedMicrobeEnergy = EnergyBalanceModel();
+
     // This is the already placed hexes
     private array<ObjectID> placedHexes;
 
@@ -68,6 +68,8 @@ class MicrobeEditorHudSystem : ScriptSystem{
 
     void Run(float elapsed)
     {
+        SystemTimer timer(_world, "MicrobeEditorHudSystem");
+
         // We move all the hexes and the hover hexes to 0,0,0 so that
         // the editor is free to replace them wherever
         // TODO: it would be way better if we didn't have to do this
@@ -59,7 +59,8 @@ Species@ getSpecies(CellStageWorld@ world, const string &in speciesName)
 PlacedOrganelle@ getOrganelleAt(CellStageWorld@ world, ObjectID microbeEntity, Int2 hex)
 {
     MicrobeComponent@ microbeComponent = getMicrobeComponent(world, microbeEntity);
-    return OrganellePlacement::getOrganelleAt(microbeComponent.organelles, hex);
+    return OrganellePlacement::getOrganelleAt(microbeComponent.organelles,
+        microbeComponent.organelleHexes, hex);
 }
 
 //! Helper for other code to mess with a microbe collision. After editing you must call
@@ -104,7 +105,8 @@ bool removeOrganelle(CellStageWorld@ world, ObjectID microbeEntity, Int2 hex)
     auto rigidBodyComponent = world.GetComponent_Physics(microbeEntity);
     auto membraneComponent = world.GetComponent_MembraneComponent(microbeEntity);
 
-    if(!OrganellePlacement::removeOrganelleAt(microbeComponent.organelles, hex)){
+    if(!OrganellePlacement::removeOrganelleAt(microbeComponent.organelles,
+            microbeComponent.organelleHexes, hex)){
         LOG_ERROR("Organelle remove failed (OrganellePlacement::removeOrganelleAt)");
     }
 
@@ -112,7 +114,8 @@ bool removeOrganelle(CellStageWorld@ world, ObjectID microbeEntity, Int2 hex)
 
     organelle.onRemovedFromMicrobe(microbeEntity, rigidBodyComponent.Body.Shape);
 
-    microbeComponent.totalHexCountCache -= organelle.organelle.getHexCount();
+    microbeComponent.totalHexCountCache = microbeComponent.totalHexCountCache -
+        organelle.organelle.getHexCount();
 
     // TODO: there seriously needs to be some caching here to make this less expensive
     rigidBodyComponent.ChangeShape(world.GetPhysicalWorld(), rigidBodyComponent.Body.Shape);
@@ -182,21 +185,21 @@ bool addOrganelle(CellStageWorld@ world, ObjectID microbeEntity, PlacedOrganelle
     // Exact coordinate check //
     // This isn't perfect so that's why it needs to have been checked before that this
     // place isn't full
-    for(uint i = 0; i < microbeComponent.organelles.length(); ++i){
-        if(microbeComponent.organelles[i].q == organelle.q &&
-            microbeComponent.organelles[i].r == organelle.r)
-        {
-            return false;
-        }
-    }
+    auto existing = OrganellePlacement::getOrganelleAt(microbeComponent.organelles,
+        microbeComponent.organelleHexes, Int2(organelle.q, organelle.r));
+
+    if(existing !is null && existing.q == organelle.q && existing.r == organelle.r)
+        return false;
 
     auto membraneComponent = world.GetComponent_MembraneComponent(microbeEntity);
 
     auto position = world.GetComponent_Position(microbeEntity);
 
-    microbeComponent.organelles.insertLast(@organelle);
+    OrganellePlacement::addOrganelle(microbeComponent.organelles,
+        microbeComponent.organelleHexes, organelle);
 
-    microbeComponent.totalHexCountCache += organelle.organelle.getHexCount();
+    microbeComponent.totalHexCountCache = microbeComponent.totalHexCountCache +
+        organelle.organelle.getHexCount();
 
     // Update collision shape
     if(editShape !is null){
@@ -640,6 +643,7 @@ void applyMembraneColour(CellStageWorld@ world, ObjectID microbeEntity)
     MicrobeComponent@ microbeComponent = getMicrobeComponent(world, microbeEntity);
     auto membraneComponent = world.GetComponent_MembraneComponent(microbeEntity);
     membraneComponent.setColour(microbeComponent.species.colour);
+    microbeComponent.stats.membraneColour = microbeComponent.species.colour;
 }
 
 
@@ -651,7 +655,7 @@ void applyMembraneColour(CellStageWorld@ world, ObjectID microbeEntity)
 // // @param maxAmount
 // // The maximum amount to try to emit
 void emitAgent(CellStageWorld@ world, ObjectID microbeEntity, CompoundId compoundId,
-    double maxAmount, float lifeTime)
+    double maxAmount)
 {
     MicrobeComponent@ microbeComponent = getMicrobeComponent(world, microbeEntity);
 
@@ -662,8 +666,7 @@ void emitAgent(CellStageWorld@ world, ObjectID microbeEntity, CompoundId compoun
     if(microbeComponent.agentEmissionCooldown > 0)
         return;
 
-    auto numberOfAgentVacuoles = int (microbeComponent.specialStorageOrganelles[
-            formatUInt(compoundId)]);
+    auto numberOfAgentVacuoles = microbeComponent.getSpecialStorageCount(compoundId);
 
     // Only shoot if you have an agent vacuole.
     if(numberOfAgentVacuoles == 0){
@@ -732,7 +735,7 @@ void emitAgent(CellStageWorld@ world, ObjectID microbeEntity, CompoundId compoun
         {
             playSoundWithDistance(world, "Data/Sound/soundeffects/microbe-release-toxin.ogg",microbeEntity);
             createAgentCloud(world, compoundId, cellPosition._Position+Float3(xnew,0,ynew),
-                    direction, amountToEject, lifeTime, microbeComponent.species.name, microbeEntity);
+                    direction, amountToEject, microbeComponent.species.name);
 
 
             // The cooldown time is inversely proportional to the amount of agent vacuoles.
@@ -827,7 +830,7 @@ void damage(CellStageWorld@ world, ObjectID microbeEntity, double amount, const
             amount /= SimulationParameters::membraneRegistry().getTypeData(microbeComponent.species.membraneType).physicalResistance;
         }
 
-        microbeComponent.hitpoints -= amount;
+        microbeComponent.hitpoints = microbeComponent.hitpoints - amount;
 
         // Flash the microbe red
         flashMembraneColour(world, microbeEntity, 1.f,
@@ -944,6 +947,97 @@ ObjectID spawnMicrobe(CellStageWorld@ world, Float3 pos, const string &in specie
     return microbeEntity;
 }
 
+//! Puts a microbe that went out of the spawn radius to sleep so that the
+//! SpawnSystem can reuse it instead of creating a new one
+bool deactivateSpawnedMicrobe(CellStageWorld@ world, ObjectID microbeEntity)
+{
+    MicrobeComponent@ microbeComponent = getMicrobeComponent(world, microbeEntity);
+
+    if(microbeComponent is null || microbeComponent.dead ||
+        microbeComponent.isPlayerMicrobe)
+        return false;
+
+    auto rigidBodyComponent = world.GetComponent_Physics(microbeEntity);
+
+    if(rigidBodyComponent.Body is null)
+        return false;
+
+    if(microbeComponent.wasBeingEngulfed)
+        removeEngulfedEffect(world, microbeEntity);
+
+    microbeComponent.dormant = true;
+    microbeComponent.movementDirection = Float3(0, 0, 0);
+    microbeComponent.engulfMode = false;
+
+    world.GetComponent_CompoundAbsorberComponent(microbeEntity).disable();
+
+    // Park the body out of the way so that it doesn't collide with anything
+    auto position = world.GetComponent_Position(microbeEntity);
+    rigidBodyComponent.Body.ClearVelocity();
+    rigidBodyComponent.Body.SetPosition(Float3(position._Position.X, DORMANT_ENTITY_DEPTH,
+            position._Position.Z), Quaternion::IDENTITY);
+
+    auto sceneNodeComponent = world.GetComponent_RenderNode(microbeEntity);
+    sceneNodeComponent.Hidden = true;
+    sceneNodeComponent.Marked = true;
+    return true;
+}
+
+//! Wakes up a microbe pooled by deactivateSpawnedMicrobe at pos
+bool recycleSpawnedMicrobe(CellStageWorld@ world, ObjectID microbeEntity,
+    const Float3 &in pos)
+{
+    MicrobeComponent@ microbeComponent = getMicrobeComponent(world, microbeEntity);
+
+    if(microbeComponent is null)
+        return false;
+
+    // The species may have been replaced while this was pooled
+    auto species = getSpecies(world, microbeComponent.species.name);
+
+    if(species is null || species !is microbeComponent.species)
+        return false;
+
+    auto rigidBodyComponent = world.GetComponent_Physics(microbeEntity);
+
+    if(rigidBodyComponent.Body is null)
+        return false;
+
+    microbeComponent.dormant = false;
+    microbeComponent.dead = false;
+    microbeComponent.deathTimer = 0;
+    microbeComponent.reproductionStage = 0;
+
+    for(uint i = 0; i < microbeComponent.organelles.length(); ++i){
+        microbeComponent.organelles[i].reset();
+    }
+
+    setupMicrobeHitpoints(microbeComponent,
+        int(SimulationParameters::membraneRegistry().getTypeData(
+                species.membraneType).hitpoints +
+            species.membraneRigidity * MEMBRANE_RIGIDITY_HITPOINTS_MODIFIER));
+    setupMicrobeCompounds(world, microbeEntity);
+
+    world.GetComponent_CompoundAbsorberComponent(microbeEntity).enable();
+
+    auto position = world.GetComponent_Position(microbeEntity);
+    position._Position = pos;
+    position.Marked = true;
+
+    rigidBodyComponent.Body.ClearVelocity();
+    rigidBodyComponent.JumpTo(position);
+
+    auto sceneNodeComponent = world.GetComponent_RenderNode(microbeEntity);
+    sceneNodeComponent.Hidden = false;
+    sceneNodeComponent.Marked = true;
+
+    if(IsInGraphicalMode())
+        sceneNodeComponent.Node.SetPosition(pos);
+
+    applyMembraneColour(world, microbeEntity);
+    return true;
+}
+
 // Creates and applies microbe collision shape
 void _applyMicrobeCollisionShape(CellStageWorld@ world, Physics@ rigidBody,
     MicrobeComponent@ microbeComponent, PhysicsShape@ shape)
@@ -1009,7 +1103,8 @@ ObjectID _createMicrobeEntity(CellStageWorld@ world, bool aiControlled,
     MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
         world.GetScriptComponentHolder("MicrobeComponent").Create(entity));
 
-    microbeComponent.init(entity, not aiControlled, species);
+    microbeComponent.init(entity, not aiControlled, species,
+        world.Create_MicrobeStatsComponent(entity));
 
     if(aiControlled){
         world.GetScriptComponentHolder("MicrobeAIControllerComponent").Create(entity);
@@ -1097,9 +1192,11 @@ void kill(CellStageWorld@ world, ObjectID microbeEntity)
     const int maxAgentsToShoot = 5;
     int createdAgents = 0;
 
-    auto storageTypes = microbeComponent.specialStorageOrganelles.getKeys();
-    for(uint i = 0; i < storageTypes.length(); ++i){
-        CompoundId compoundId = parseInt(storageTypes[i]);
+    for(uint i = 0; i < microbeComponent.specialStorageOrganelles.length(); ++i){
+        if(microbeComponent.specialStorageOrganelles[i] <= 0)
+            continue;
+
+        CompoundId compoundId = i;
         auto _amount = getCompoundAmount(world, microbeEntity, compoundId);
         while(_amount > 0){
             // Eject up to 5 units per particle
@@ -1108,7 +1205,7 @@ void kill(CellStageWorld@ world, ObjectID microbeEntity)
                 0, GetEngine().GetRandom().GetNumber(0.0f, 1.0f) * 2 - 1);
 
             createAgentCloud(world, compoundId, position._Position, direction, ejectedAmount,
-                2.f, microbeComponent.species.name, NULL_OBJECT);
+                microbeComponent.species.name);
             //take oxytoxy
             takeCompound(world,microbeEntity,compoundId,ejectedAmount);
             ++createdAgents;
@@ -1123,10 +1220,11 @@ void kill(CellStageWorld@ world, ObjectID microbeEntity)
     dictionary compoundsToRelease;
 
     // Eject the compounds that was in the microbe
-    uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
+    array<double> amounts;
+    world.GetComponent_CompoundBagComponent(microbeEntity).getCompoundAmounts(amounts);
 
-    for(uint compoundId = 0; compoundId < compoundCount; ++compoundId){
-        auto total = getCompoundAmount(world, microbeEntity, compoundId)*COMPOUND_RELEASE_PERCENTAGE;
+    for(uint compoundId = 0; compoundId < amounts.length(); ++compoundId){
+        auto total = amounts[compoundId]*COMPOUND_RELEASE_PERCENTAGE;
         compoundsToRelease[formatInt(compoundId)] = float(total);
     }
 
@@ -92,6 +92,8 @@ class MicrobeStageHudSystem : ScriptSystem{
 
     void Run(float elapsed)
     {
+        SystemTimer timer(World, "MicrobeStageHudSystem");
+
         ObjectID player = GetThriveGame().playerData().activeCreature();
 
         //since this is ran every step this is a good place to do music code
@@ -210,9 +212,10 @@ class MicrobeStageHudSystem : ScriptSystem{
                 vars.AddValue(ScriptSafeVariableBlock("IronMax", maxIron));
             }
 
-            // Fire it off so that the GUI scripts will get it and update the GUI state
-            GetEngine().GetEventHandler().CallEvent(event);
-            GetEngine().GetEventHandler().CallEvent(changePopulation);
+            // Queue these for the GUI. Only the changed values are sent at the end of
+            // the tick
+            GetThriveGame().postGuiUpdate(event);
+            GetThriveGame().postGuiUpdate(changePopulation);
         }
     }
 
@@ -412,6 +415,6 @@ void playerShootToxin(CellStageWorld@ world, ObjectID entity)
     MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
         world.GetScriptComponentHolder("MicrobeComponent").Find(entity));
     CompoundId oxytoxyId = SimulationParameters::compoundRegistry().getTypeId("oxytoxy");
-    MicrobeOperations::emitAgent(world, entity, oxytoxyId, 10.0f, 10.0f);
+    MicrobeOperations::emitAgent(world, entity, oxytoxyId, 10.0f);
 }
 
@@ -13,17 +13,31 @@ Species@ createRandomSpecies(int steps = 5)
         100.0f, 100.0f, 100.0f, 200.0f, 100.0f);
 
     for(int step = 0; step < steps; ++step){
-        @current = createMutatedSpecies(current);
+        Species@ mutated = createMutatedSpecies(current);
+
+        if(mutated is null)
+            break;
+
+        @current = mutated;
     }
 
     return current;
 }
 
-//! Creates a mutated version of the species
+//! Creates a mutated version of the species with a new name. The organelles
+//! and the other properties are mutated by the C++ MutationGenerator the same
+//! way as auto-evo mutates species
 Species@ createMutatedSpecies(Species@ parent)
 {
-    bool isBacteria = parent.isBacteria;
-    string name = !isBacteria ? randomSpeciesName() : randomBacteriaName();
+    const Species@ mutation = getMutationForSpecies(parent);
+
+    if(mutation is null){
+        LOG_ERROR("createMutatedSpecies: failed to mutate species: " + parent.name);
+        return null;
+    }
+
+    // Also gets a eukaryote name if it evolved a nucleus
+    string name = mutation.isBacteria ? randomBacteriaName() : randomSpeciesName();
 
     string epithet;
 
@@ -37,27 +51,6 @@ Species@ createMutatedSpecies(Species@ parent)
 
     string genus = parent.genus;
 
-    // Variables used in AI to determine general behavior mutate these
-    // This used to be a method
-    float aggression = parent.aggression+GetEngine().GetRandom().GetFloat(
-        MIN_SPECIES_PERSONALITY_MUTATION, MAX_SPECIES_PERSONALITY_MUTATION);
-    float fear = parent.fear+GetEngine().GetRandom().GetFloat(
-        MIN_SPECIES_PERSONALITY_MUTATION, MAX_SPECIES_PERSONALITY_MUTATION);
-    float activity = parent.activity+GetEngine().GetRandom().GetFloat(
-        MIN_SPECIES_PERSONALITY_MUTATION, MAX_SPECIES_PERSONALITY_MUTATION);
-    float focus = parent.focus+GetEngine().GetRandom().GetFloat(
-        MIN_SPECIES_PERSONALITY_MUTATION, MAX_SPECIES_PERSONALITY_MUTATION);
-    float opportunism = parent.opportunism+GetEngine().GetRandom().GetFloat(
-        MIN_SPECIES_PERSONALITY_MUTATION, MAX_SPECIES_PERSONALITY_MUTATION);
-
-    // Make sure not over or under our scales
-    // This used to be a method as well
-    aggression = clamp(aggression, 0.0f, MAX_SPECIES_AGRESSION);
-    fear = clamp(fear, 0.0f, MAX_SPECIES_FEAR);
-    activity = clamp(activity, 0.0f, MAX_SPECIES_ACTIVITY);
-    focus = clamp(focus, 0.0f, MAX_SPECIES_FOCUS);
-    opportunism = clamp(opportunism, 0.0f, MAX_SPECIES_OPPORTUNISM);
-
     if (GetEngine().GetRandom().GetNumber(0,100) <= MUTATION_CHANGE_GENUS)
     {
         // We can do more fun stuff here later
@@ -69,72 +62,48 @@ Species@ createMutatedSpecies(Species@ parent)
         }
     }
 
-    string stringCode = mutateMicrobe(parent.stringCode, isBacteria);
-
-    // There is a small chance of evolving into a eukaryote
-    if (stringCode.findFirst("N") >= 0){
-        isBacteria=false;
-        name = randomSpeciesName();
-    }
-
-    Float4 colour = isBacteria ? MutationHelpers::randomProkayroteColour() :
-        MutationHelpers::randomColour();
-
-    // This used to be a method
-    string membraneType = "single";
-    if (GetEngine().GetRandom().GetNumber(0,100)<=20){ // Could perhaps use a weighted entry model here... the earlier one is listed, the more likely currently (I think). That may be an issue.
-        if (GetEngine().GetRandom().GetNumber(0,100) < 50){
-            membraneType = "single";
-        }
-        else if (GetEngine().GetRandom().GetNumber(0,100) < 50) {
-            membraneType = "double";
-            colour.W = MutationHelpers::randomOpacityChitin(); // Why on double? Should this be on cellulose instead?
-        }
-        else if (GetEngine().GetRandom().GetNumber(0,100) < 50) {
-            membraneType = "cellulose";
-        }
-        else if (GetEngine().GetRandom().GetNumber(0,100) < 50) {
-            membraneType = "chitin";
-            colour.W = MutationHelpers::randomOpacityChitin();
-        }
-        else if (GetEngine().GetRandom().GetNumber(0,100) < 50) {
-            membraneType = "calcium_carbonate";
-            colour.W = MutationHelpers::randomOpacityChitin();
-        }
-        else {
-            membraneType = "silica";
-            colour.W = MutationHelpers::randomOpacityChitin();
-        }
-    }
-    else{
-        membraneType = SimulationParameters::membraneRegistry().getInternalName(parent.membraneType);
-    }
-
-    float membraneRigidity = max(min(parent.membraneRigidity + GetEngine().GetRandom().GetNumber(-25, 25) / 100.f, 1), -1);
-
     // This translates the genetic code into positions
-    auto organelles = positionOrganelles(stringCode);
-
-    const dictionary@ initialCompounds;
+    auto organelles = positionOrganelles(mutation.stringCode);
+
+    return Species::createSpecies(name, genus, epithet,
+        organelles, mutation.colour, mutation.isBacteria,
+        SimulationParameters::membraneRegistry().getInternalName(mutation.membraneType),
+        mutation.membraneRigidity, getInitialCompoundsForStringCode(mutation.stringCode),
+        mutation.aggression, mutation.fear, mutation.activity, mutation.focus,
+        mutation.opportunism);
+}
 
+//! Picks the starting compounds for a species with the organelles in stringCode
+const dictionary@ getInitialCompoundsForStringCode(const string &in stringCode)
+{
     // If you have iron (f is the symbol for rusticyanin)
     if (stringCode.findFirst('f') >= 0)
     {
-        @initialCompounds = DEFAULT_INITIAL_COMPOUNDS_IRON;
+        return DEFAULT_INITIAL_COMPOUNDS_IRON;
     }
     else if (stringCode.findFirst('C') >= 0 || stringCode.findFirst('c') >= 0)
     {
-        @initialCompounds = DEFAULT_INITIAL_COMPOUNDS_CHEMO;
-    }
-    else {
-        @initialCompounds = DEFAULT_INITIAL_COMPOUNDS;
+        return DEFAULT_INITIAL_COMPOUNDS_CHEMO;
     }
 
-    Species@ newSpecies = Species::createSpecies(name, genus, epithet,
-        organelles, colour, isBacteria, membraneType, membraneRigidity,
-        initialCompounds, aggression, fear, activity, focus, opportunism);
+    return DEFAULT_INITIAL_COMPOUNDS;
+}
+
+//! Creates the organelles and compounds of a species made by the C++
+//! MutationGenerator, which only sets the stringCode. Called by auto-evo when
+//! the mutation is applied
+void restoreMutatedSpecies(Species@ species)
+{
+    auto organelles = positionOrganelles(species.stringCode);
+
+    @species.organelles = array<SpeciesStoredOrganelleType@>();
+
+    for(uint i = 0; i < organelles.length(); ++i){
+        species.organelles.insertLast(organelles[i]);
+    }
 
-    return newSpecies;
+    Species::setInitialCompounds(species,
+        getInitialCompoundsForStringCode(species.stringCode));
 }
 
 namespace Unused{
@@ -14,9 +14,7 @@ class AgentVacuole : OrganelleComponent{
     //  The process that creates the agent this organelle produces.
     AgentVacuole(const string &in compound, const string &in process){
 
-        // Stored as a string as we only need it for dictionary operations
-        this.compound = formatUInt(
-            SimulationParameters::compoundRegistry().getTypeId(compound));
+        this.compound = SimulationParameters::compoundRegistry().getTypeId(compound);
         this.process = process;
     }
 
@@ -30,14 +28,7 @@ class AgentVacuole : OrganelleComponent{
         MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
             organelle.world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
 
-        if(!microbeComponent.specialStorageOrganelles.exists(compound)){
-            microbeComponent.specialStorageOrganelles[compound] = 1;
-        } else {
-            auto value = microbeComponent.specialStorageOrganelles[compound];
-            // This needs to be applied like this otherwise it doesn't actually
-            // apply the change
-            microbeComponent.specialStorageOrganelles[compound] = int(value) + 1;
-        }
+        microbeComponent.changeSpecialStorageCount(compound, 1);
     }
 
     void
@@ -49,9 +40,7 @@ class AgentVacuole : OrganelleComponent{
         MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
             organelle.world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
 
-        auto value = microbeComponent.specialStorageOrganelles[compound];
-        // This needs to be applied like this otherwise it doesn't actually apply the change
-        microbeComponent.specialStorageOrganelles[compound] = int(value) - 1;
+        microbeComponent.changeSpecialStorageCount(compound, -1);
     }
 
     // void AgentVacuole.storage(){
@@ -69,6 +58,6 @@ class AgentVacuole : OrganelleComponent{
     // this.position.r = storage.get("r", 0)
     // }
 
-    private string compound;
+    private CompoundId compound;
     private string process;
 }
@@ -35,7 +35,7 @@ class StorageOrganelle : OrganelleComponent{
         MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
             organelle.world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
 
-        microbeComponent.capacity += this.capacity;
+        microbeComponent.capacity = microbeComponent.capacity + this.capacity;
     }
 
     // Overridded from Organelle.onRemovedFromMicrobe
@@ -47,7 +47,7 @@ class StorageOrganelle : OrganelleComponent{
         MicrobeComponent@ microbeComponent = cast<MicrobeComponent>(
             organelle.world.GetScriptComponentHolder("MicrobeComponent").Find(microbeEntity));
 
-        microbeComponent.capacity -= this.capacity;
+        microbeComponent.capacity = microbeComponent.capacity - this.capacity;
     }
 
     private float capacity;
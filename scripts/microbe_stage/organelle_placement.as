@@ -3,40 +3,67 @@
 
 namespace OrganellePlacement{
 
-//! Searches organelle list for an organelle at the specified hex
-PlacedOrganelle@ getOrganelleAt(const array<PlacedOrganelle@>@ organelles, const Int2 &in hex)
+//! Re-adds all organelles to the occupancy map
+void rebuildOccupancy(const array<PlacedOrganelle@>@ organelles, HexOccupancyMap@ occupancy)
 {
+    occupancy.clear();
+
     for(uint i = 0; i < organelles.length(); ++i){
         auto organelle = organelles[i];
-        auto hexes = organelle.organelle.getRotatedHexes(organelle.rotation);
-        for(uint c = 0; c < hexes.length(); ++c){
-            auto localQ = hex.X - organelle.q;
-            auto localR = hex.Y - organelle.r;
-            if(hexes[c].X == localQ && hexes[c].Y == localR){
-                return organelle;
-            }
-        }
+        occupancy.addOrganelle(organelle.organelle, organelle.q, organelle.r,
+            organelle.rotation);
     }
-    return null;
+}
+
+//! Rebuilds the occupancy map if the number of organelles doesn't match it.
+//! This only catches organelles that were added or removed without going
+//! through the helpers here. Code that moves, rotates or replaces organelles
+//! in the array needs to call rebuildOccupancy itself
+void syncOccupancy(const array<PlacedOrganelle@>@ organelles, HexOccupancyMap@ occupancy)
+{
+    if(occupancy.getCount() != organelles.length())
+        rebuildOccupancy(organelles, occupancy);
+}
+
+//! Adds an organelle to the end of organelles and marks its hexes occupied
+void addOrganelle(array<PlacedOrganelle@>@ organelles, HexOccupancyMap@ occupancy,
+    PlacedOrganelle@ organelle)
+{
+    syncOccupancy(organelles, occupancy);
+
+    organelles.insertLast(organelle);
+    occupancy.addOrganelle(organelle.organelle, organelle.q, organelle.r,
+        organelle.rotation);
+}
+
+//! Finds the organelle at the specified hex
+PlacedOrganelle@ getOrganelleAt(const array<PlacedOrganelle@>@ organelles,
+    HexOccupancyMap@ occupancy, const Int2 &in hex)
+{
+    syncOccupancy(organelles, occupancy);
+
+    const auto index = occupancy.getAt(hex);
+
+    if(index < 0)
+        return null;
+
+    return organelles[uint(index)];
 }
 
 //! Removes organelle that contains hex
-bool removeOrganelleAt(array<PlacedOrganelle@>@ organelles, const Int2 &in hex)
+bool removeOrganelleAt(array<PlacedOrganelle@>@ organelles, HexOccupancyMap@ occupancy,
+    const Int2 &in hex)
 {
-    for(uint i = 0; i < organelles.length(); ++i){
-        auto organelle = organelles[i];
-        auto hexes = organelle.organelle.getRotatedHexes(organelle.rotation);
-        for(uint c = 0; c < hexes.length(); ++c){
-            auto localQ = hex.X - organelle.q;
-            auto localR = hex.Y - organelle.r;
-            if(hexes[c].X == localQ && hexes[c].Y == localR){
-                organelles.removeAt(i);
-                return true;
-            }
-        }
-    }
+    syncOccupancy(organelles, occupancy);
+
+    const auto index = occupancy.getAt(hex);
+
+    if(index < 0)
+        return false;
 
-    return false;
+    organelles.removeAt(uint(index));
+    occupancy.removeAt(uint(index));
+    return true;
 }
 
 }
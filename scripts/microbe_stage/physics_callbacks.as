@@ -1,5 +1,9 @@
 // Callbacks for cell stage physics materials
 
+// Reused between calls to not allocate new arrays each time something is engulfed
+array<double> engulfedAmounts;
+array<double> engulfTaken;
+
 // Used for chunks
 bool cellHitEngulfable(GameWorld@ world,
     ObjectID otherEntity,
@@ -30,15 +34,12 @@ bool cellHitEngulfable(GameWorld@ world,
         if (microbeComponent.engulfMode && microbeComponent.totalHexCountCache >=
             engulfableComponent.getSize() * ENGULF_HP_RATIO_REQ)
         {
-            uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
-            for(uint compoundId = 0; compoundId < compoundCount; ++compoundId){
-                CompoundId realCompoundId = compoundId;
-                double amountToTake = floatBag.takeCompound(
-                    realCompoundId, floatBag.getCompoundAmount(realCompoundId));
-                // Right now you get way too much compounds for engulfing the things but hey
-                compoundBagComponent.giveCompound(
-                    realCompoundId, (amountToTake / CHUNK_ENGULF_COMPOUND_DIVISOR));
-            }
+            // Take everything from the chunk in one go
+            floatBag.getCompoundAmounts(engulfedAmounts);
+            floatBag.takeCompounds(engulfedAmounts, engulfTaken);
+            // Right now you get way too much compounds for engulfing the things but hey
+            compoundBagComponent.giveCompounds(engulfTaken,
+                1.0 / CHUNK_ENGULF_COMPOUND_DIVISOR);
             world.QueueDestroyEntity(otherEntity);
         }
     }
@@ -90,15 +91,12 @@ bool cellHitDamageChunk(GameWorld@ world,
         if (microbeComponent.engulfMode && microbeComponent.totalHexCountCache >=
             engulfableComponent.getSize() * ENGULF_HP_RATIO_REQ)
         {
-            uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
-            for(uint compoundId = 0; compoundId < compoundCount; ++compoundId){
-                CompoundId realCompoundId = compoundId;
-                double amountToTake = floatBag.takeCompound(
-                    realCompoundId, floatBag.getCompoundAmount(realCompoundId));
-                // Right now you get way too much compounds for engulfing the things but hey
-                compoundBagComponent.giveCompound(
-                    realCompoundId, (amountToTake / CHUNK_ENGULF_COMPOUND_DIVISOR));
-            }
+            // Take everything from the chunk in one go
+            floatBag.getCompoundAmounts(engulfedAmounts);
+            floatBag.takeCompounds(engulfedAmounts, engulfTaken);
+            // Right now you get way too much compounds for engulfing the things but hey
+            compoundBagComponent.giveCompounds(engulfTaken,
+                1.0 / CHUNK_ENGULF_COMPOUND_DIVISOR);
 
             disappear = true;
         }
@@ -111,40 +109,6 @@ bool cellHitDamageChunk(GameWorld@ world,
     return true;
 }
 
-// Actual collision between agent and cell, applies damage and removes
-// the agent if the hit was valid
-bool cellHitAgent(GameWorld@ world,
-    ObjectID otherEntity,
-    ObjectID cellEntity,
-    MicrobeComponent@ microbeComponent,
-    const PhysicsShape@ cellShape,
-    int cellSubCollision)
-{
-    const bool isPilus = cellShape.GetChildCustomTag(cellSubCollision) ==
-        PHYSICS_PILUS_TAG;
-
-    // Agent can't hit through a pilus
-    if(isPilus)
-        return false;
-
-    CellStageWorld@ asCellWorld = cast<CellStageWorld>(world);
-
-    AgentProperties@ propertiesComponent =
-        asCellWorld.GetComponent_AgentProperties(otherEntity);
-
-    if (propertiesComponent !is null){
-        if (propertiesComponent.getSpeciesName() != microbeComponent.species.name &&
-            !microbeComponent.dead){
-
-            MicrobeOperations::damage(asCellWorld, cellEntity, double(OXY_TOXY_DAMAGE),
-                "toxin");
-            world.QueueDestroyEntity(otherEntity);
-        }
-    }
-
-    return true;
-}
-
 bool cellOnCellActualContact(GameWorld@ world,
     const PhysicsShape@ firstShape,
     MicrobeComponent@ firstMicrobeComponent,
@@ -289,52 +253,3 @@ bool beingEngulfed(GameWorld@ world, ObjectID firstEntity, ObjectID secondEntity
 
     return true;
 }
-
-//! \brief Skips collision if agent shouldn't damange the given cell
-bool hitAgent(GameWorld@ world, ObjectID firstEntity, ObjectID secondEntity)
-{
-    // TODO: why is this used here when each place that sets this return immediately?
-    bool shouldCollide = true;
-
-    // Grab the microbe components
-    MicrobeComponent@ firstMicrobeComponent = cast<MicrobeComponent>(
-        world.GetScriptComponentHolder("MicrobeComponent").Find(firstEntity));
-    MicrobeComponent@ secondMicrobeComponent = cast<MicrobeComponent>(
-        world.GetScriptComponentHolder("MicrobeComponent").Find(secondEntity));
-    CellStageWorld@ asCellWorld = cast<CellStageWorld>(world);
-    AgentProperties@ firstPropertiesComponent =
-        asCellWorld.GetComponent_AgentProperties(firstEntity);
-    AgentProperties@ secondPropertiesComponent =
-        asCellWorld.GetComponent_AgentProperties(secondEntity);
-
-    if (firstPropertiesComponent !is null || secondPropertiesComponent !is null)
-    {
-        if (firstPropertiesComponent !is null && secondMicrobeComponent !is null)
-        {
-            if (firstPropertiesComponent.getSpeciesName()==secondMicrobeComponent.species.name ||
-                firstPropertiesComponent.getParentEntity()==secondEntity)
-            {
-                shouldCollide = false;
-                return shouldCollide;
-            }
-        }
-        else if (secondPropertiesComponent !is null && firstMicrobeComponent !is null)
-        {
-            if (secondPropertiesComponent.getSpeciesName()==firstMicrobeComponent.species.name ||
-                secondPropertiesComponent.getParentEntity()==firstEntity)
-            {
-                shouldCollide = false;
-                return shouldCollide;
-            }
-        }
-    }
-
-    // Check if one is a microbe, and the other is not
-    if ((firstMicrobeComponent !is null || secondMicrobeComponent !is null) &&
-        !(firstMicrobeComponent !is null && secondMicrobeComponent !is null))
-    {
-        shouldCollide = true;
-    }
-
-    return shouldCollide;
-}
@@ -2,30 +2,15 @@
 #include "nucleus_organelle.as"
 #include "hex.as"
 #include "mutation_helpers.as"
-// Lists of valid organelles to choose from for mutation
+// The organelle names keyed by their gene letters for reading stringCodes.
+// The mutations are made by the C++ MutationGenerator
 dictionary organelleLetters = {};
-array<string> VALID_ORGANELLES = {};
-array<string> VALID_ORGANELLE_LETTERS = {};
-array<float> VALID_ORGANELLE_CHANCES = {};
-array<float> VALID_PROKARYOTE_ORGANELLE_CHANCES = {};
-
-// These have to be global to work or we need a place to put them that
-// isnt global note the eukaryote one is old, so this is how this was
-// already programmed
-float maxEukaryoteScore = 0;
-float maxProkaryoteScore = 0;
 
 //! Called from world new game setup
 void setupOrganelleLetters(){
 
     // Reset everything
     organelleLetters = {};
-    VALID_ORGANELLES = {};
-    VALID_ORGANELLE_LETTERS = {};
-    VALID_ORGANELLE_CHANCES = {};
-    VALID_PROKARYOTE_ORGANELLE_CHANCES = {};
-    maxEukaryoteScore = 0;
-    maxProkaryoteScore = 0;
 
     // Setup the organelle letters
     auto keys = getOrganelleNames();
@@ -37,150 +22,7 @@ void setupOrganelleLetters(){
 
         // Getting the organelle letters from the organelle table.
         organelleLetters[organelleInfo.gene] = organelleName;
-
-        // TODO: doesn't the procedural generation also add a nucleus? why is this check here?
-        if(!organelleInfo.hasComponent("nucleus")){
-
-            VALID_ORGANELLES.insertLast(organelleName);
-            VALID_ORGANELLE_CHANCES.insertLast(organelleInfo.chanceToCreate);
-            VALID_PROKARYOTE_ORGANELLE_CHANCES.insertLast(organelleInfo.prokaryoteChance);
-            VALID_ORGANELLE_LETTERS.insertLast(organelleInfo.gene);
-
-            // Getting the max chance score for the roulette selection.
-            maxEukaryoteScore += organelleInfo.chanceToCreate;
-            maxProkaryoteScore += organelleInfo.prokaryoteChance;
-        }
-    }
-}
-
-// Returns a random organelle letter
-// TODO: verify that this has a good chance of returning also the last organelle
-// TODO: is there a way to make this run faster?
-string getRandomLetter(bool isBacteria){
-
-    // This is actually essentially the entire mutation system here
-    if (!isBacteria)
-    {
-        float i = GetEngine().GetRandom().GetNumber(0.f, maxEukaryoteScore);
-        for(uint index = 0; index < VALID_ORGANELLES.length(); ++index){
-
-            i -= VALID_ORGANELLE_CHANCES[index];
-
-            if(i <= 0){
-                return VALID_ORGANELLE_LETTERS[index];
-            }
-        }
-    }
-    else
-    {
-        float i = GetEngine().GetRandom().GetNumber(0.f, maxProkaryoteScore);
-        for(uint index = 0; index < VALID_ORGANELLES.length(); ++index){
-            i -= VALID_PROKARYOTE_ORGANELLE_CHANCES[index];
-
-            if(i <= 0){
-                return VALID_ORGANELLE_LETTERS[index];
-            }
-        }
-    }
-
-    // Just in case
-    //LOG_WARNING("getRandomLetter: just in case case hit");
-    return getOrganelleDefinition("cytoplasm").gene;
-}
-
-// Checks whether an organelle in a certain position would fit within a list of other organelles.
-bool isValidPlacement(const string &in organelleName, int q, int r, int rotation,
-    const  array<PlacedOrganelle@>@ &in organelleList
-) {
-
-    // this is now slightly less hacky but it could be btter
-    const auto organelleHexes = getOrganelleDefinition(organelleName).getRotatedHexes(rotation);
-
-    for(uint i = 0; i < organelleList.length(); ++i){
-
-        auto otherOrganelle = organelleList[i];
-        auto organelleDef = getOrganelleDefinition(otherOrganelle.organelle.name);
-
-        // The organelles hexes
-        auto otherOrganelleHexes = organelleDef.getRotatedHexes(organelleList[i].rotation);
-
-        for(uint thisHexIndex = 0; thisHexIndex < organelleHexes.length(); ++thisHexIndex){
-
-            for(uint otherHexIndex = 0; otherHexIndex < otherOrganelleHexes.length();
-                ++otherHexIndex)
-            {
-                const auto hex = organelleHexes[thisHexIndex];
-                const auto otherHex = otherOrganelleHexes[otherHexIndex];
-                if(hex.X + q == otherHex.X + otherOrganelle.q &&
-                    hex.Y + r == otherHex.Y + otherOrganelle.r)
-                {
-                    return false;
-                }
-            }
-        }
-    }
-
-    return true;
-}
-
-// Finds a valid position to place the organelle and returns it
-// We should be able to get far more creative with our cells now
-OrganelleTemplatePlaced@ getRealisticPosition(const string &in organelleName,
-    array<PlacedOrganelle@>@ organelleList
-) {
-    int q = 0;
-    int r = 0;
-
-    array<PlacedOrganelle@>@ organelleShuffledArray = organelleList;
-
-    // Shuffle the Array to make sure its not always placing at the same part of the cell
-    organelleShuffledArray.sort( function(a,b) {
-        return GetEngine().GetRandom().GetNumber(0,100) <= 50;
-    }
-    );
-
-    // Loop through all the organelles and find an open spot to place our new organelle attached to existing organelles
-    // This almost always is over at the first iteration, so its not a huge performance hog
-    for(uint i = 0; i < organelleShuffledArray.length(); ++i){
-        // The organelle we wish to be next to
-        auto otherOrganelle = organelleShuffledArray[i].organelle;
-        auto organelleDef = getOrganelleDefinition(otherOrganelle.name);
-
-        // The organelles hexes
-        auto hexes = organelleDef.getRotatedHexes(organelleShuffledArray[i].rotation);
-
-        // Middle of our organelle
-        q = organelleShuffledArray[i].q;
-        r = organelleShuffledArray[i].r;
-
-        for(uint z = 0; z < hexes.length(); ++z){
-            // Off set by hexes in organelle we are looking at
-            q += hexes[z].X;
-            r += hexes[z].Y;
-
-            for(int side = 1; side <= 6; ++side){
-                Int2 offset = Int2(HEX_NEIGHBOUR_OFFSET[formatInt(side)]);
-                // Offset by hex offset
-                q = q + offset.X;
-                r = r + offset.Y;
-
-                //Check every possible rotation value.
-                for(int j = 0; j <= 5; ++j){
-                    int rotation = (360 * j / 6);
-                    if(isValidPlacement(organelleName, q, r, rotation, organelleShuffledArray)){
-                        return OrganelleTemplatePlaced(organelleName, q, r, rotation);
-                    }
-                }
-            }
-
-        //Gotta reset each time
-        q = organelleShuffledArray[i].q;
-        r = organelleShuffledArray[i].r;
-
-        }
     }
-    // We didnt find an open spot, that doesnt mak emuch sense
-    return null;
 }
 
 // This function takes in a positioning block from the string code and a name
@@ -238,108 +80,6 @@ array<PlacedOrganelle@>@ positionOrganelles(const string &in stringCode){
     return result;
 }
 
-//! Mutates a species' dna code randomly
-
-
-string translateOrganelleToGene(OrganelleTemplatePlaced@ ourOrganelle){
-    string completeString = "";
-    auto organelle = getOrganelleDefinition(ourOrganelle.type);
-    completeString=organelle.gene+","+
-        ourOrganelle.q+","+
-        ourOrganelle.r+","+
-        ourOrganelle.rotation;
-    return completeString;
-
-}
-
-// Pass in the string code, isbacteria
-string mutateMicrobe(const string &in stringCode, bool isBacteria)
-{
-    array<string>@ chromArray = stringCode.split("|");
-    auto modifiedArray = chromArray;
-   //LOG_INFO(chromArray[0]);
-    string completeString = "";
-
-    // Delete or replace an organelle randomly
-    for(uint i = 0; i < chromArray.length(); i++){
-        string chromosomes = chromArray[i];
-        // Removing last organelle would be silly
-        if(GetEngine().GetRandom().GetNumber(0.f, 1.f) < MUTATION_DELETION_RATE && chromosomes.length() > 0){
-            if (i != chromArray.length()-1 && CharacterToString(chromosomes[0]) != "N"){
-                //LOG_INFO("deleteing");
-                //LOG_INFO("chromosomes:"+chromArray[i]);
-               // Delete organelle and its position
-                modifiedArray.removeAt(i);
-
-            }
-        }else if(GetEngine().GetRandom().GetNumber(0.f, 1.f) < MUTATION_REPLACEMENT_RATE && chromosomes.length() > 0){
-            if (CharacterToString(chromosomes[0]) != "N"){
-                //LOG_INFO("Replacing");
-                //LOG_INFO("chromosomes:"+chromArray[i]);
-                chromosomes[0]=getRandomLetter(isBacteria)[0];
-                if (i != chromArray.length()-1){
-                    modifiedArray.removeAt(i);
-                    modifiedArray.insertAt(i,chromosomes);
-                }
-                else{
-                    modifiedArray.removeAt(i);
-                    modifiedArray.insertLast(chromosomes);
-                }
-            }
-        }
-
-    }
-
-
-    completeString = join(modifiedArray,"|");
-
-    // Can add up to 6 new organelles (Which should allow AI to catch up to player more
-    // We can insert new organelles at the end of the list
-    if(GetEngine().GetRandom().GetNumber(0.f, 1.f) < MUTATION_CREATION_RATE){
-        const auto organelleList = positionOrganelles(completeString);
-        const auto letter = getRandomLetter(isBacteria);
-        string name = string(organelleLetters[letter]);
-        const string returnedGenome = translateOrganelleToGene(getRealisticPosition(name,organelleList));
-        //LOG_INFO("Adding");
-        //LOG_INFO("chromosomes:"+returnedGenome);
-        completeString+="|"+returnedGenome;
-    }
-
-    /*
-    Probability of mutation occuring 5 time(s) = 0.15 = 1.0E-5
-    Probability of mutation NOT occuring = (1 - 0.1)5 = 0.59049
-    Probability of mutation occuring = 1 - (1 - 0.1)5 = 0.40951
-    */
-    // We can insert new organelles at the end of the list
-    for(int n = 0; n < 5; n++ ){
-    // We can insert new organelles at the end of the list
-        if(GetEngine().GetRandom().GetNumber(0.f, 1.f) < MUTATION_EXTRA_CREATION_RATE){
-            const auto organelleList = positionOrganelles(completeString);
-            const auto letter = getRandomLetter(isBacteria);
-            string name = string(organelleLetters[letter]);
-            const string returnedGenome = translateOrganelleToGene(getRealisticPosition(name,organelleList));
-            //LOG_INFO("Adding");
-            //LOG_INFO("chromosomes:"+returnedGenome);
-            completeString+="|"+returnedGenome;
-        }
-    }
-
-    if (isBacteria){
-        if(GetEngine().GetRandom().GetNumber(0.f, 100.f) <= MUTATION_BACTERIA_TO_EUKARYOTE){
-            const auto organelleList = positionOrganelles(completeString);
-            const auto letter = "N";
-            string name = string(organelleLetters[letter]);
-            const string returnedGenome = translateOrganelleToGene(getRealisticPosition(name,organelleList));
-            //LOG_INFO("Adding");
-            //LOG_INFO("chromosomes:"+returnedGenome);
-            completeString+="|"+returnedGenome;
-        }
-    }
-
-    // LOG_INFO("Mutated: "+completeString);
-    return completeString;
-}
-
 //! Generates a few random species in all patches
 void generateRandomSpeciesForFreeBuild(PatchMap@ map)
 {
@@ -35,7 +35,17 @@ ScriptComponent@ MicrobeAIControllerComponentFactory(GameWorld@ world)
 //! in a world
 void setupSystemsForWorld(CellStageWorld@ world)
 {
-    // Fail if compound registry is empty (hud system caches the compound ids on startup) //
+    setupSimulationForWorld(world);
+
+    // The hud system caches the compound ids on startup
+    world.RegisterScriptSystem("MicrobeStageHudSystem", MicrobeStageHudSystem());
+}
+
+//! The part of setupSystemsForWorld that simulates the world. ThriveBenchmark
+//! uses this for replays as it has no GUI
+void setupSimulationForWorld(CellStageWorld@ world)
+{
+    // Fail if compound registry is empty //
     assert(SimulationParameters::compoundRegistry().getSize() > 0,
         "Compound registry is empty");
 
@@ -45,7 +55,6 @@ void setupSystemsForWorld(CellStageWorld@ world)
 
     // Add any new systems and component types that are defined in scripts here
     world.RegisterScriptSystem("MicrobeSystem", MicrobeSystem());
-    world.RegisterScriptSystem("MicrobeStageHudSystem", MicrobeStageHudSystem());
     world.RegisterScriptSystem("MicrobeAISystem", MicrobeAISystem());
 
     // Add world effects
@@ -82,6 +91,19 @@ void setupSystemsForWorld_Client(CellStageWorld@ world)
     world.RegisterScriptSystem("MicrobeStageHudSystem", MicrobeStageHudSystem());
 }
 
+//! Variant of setupScriptsForWorld for the headless ThriveBot. It has no GUI
+//! so the HUD system is left out
+void setupScriptsForWorld_Bot(CellStageWorld@ world)
+{
+    // Fail if compound registry is empty //
+    assert(SimulationParameters::compoundRegistry().getSize() > 0,
+        "Compound registry is empty");
+
+    world.RegisterScriptComponentType("MicrobeComponent", @MicrobeComponentFactory);
+
+    world.RegisterScriptSystem("MicrobeSystem", MicrobeSystem());
+}
+
 
 //! This spawns the player
 void setupPlayer(CellStageWorld@ world)
@@ -90,16 +112,17 @@ void setupPlayer(CellStageWorld@ world)
     GetThriveGame().playerData().lockedMap().addLock("Toxin");
     GetThriveGame().playerData().lockedMap().addLock("chloroplast");
 
-    ObjectID microbe = MicrobeOperations::spawnMicrobe(world, Float3(0, 0, 0), "Default",
-        false);
-
-    assert(microbe != NULL_OBJECT, "Failed to spawn player cell");
-
-    GetThriveGame().playerData().setActiveCreature(microbe);
+    GetThriveGame().playerData().setActiveCreature(spawnPlayerCell(world));
 }
 
 //! This spawns a player in multiplayer
 ObjectID spawnPlayer_Server(CellStageWorld@ world)
+{
+    return spawnPlayerCell(world);
+}
+
+//! Spawns the cell of the player. Also used by ThriveBenchmark replays
+ObjectID spawnPlayerCell(CellStageWorld@ world)
 {
     ObjectID microbe = MicrobeOperations::spawnMicrobe(world, Float3(0, 0, 0), "Default",
         false);
@@ -120,7 +143,8 @@ void setupClientSideReceivedCell(CellStageWorld@ world, ObjectID entity)
 
     assert(species !is null);
 
-    microbeComponent.init(entity, true, species);
+    microbeComponent.init(entity, true, species,
+        world.Create_MicrobeStatsComponent(entity));
 
     auto shape = world.GetPhysicalWorld().CreateCompound();
     Species::applyTemplate(world, entity, species, shape);
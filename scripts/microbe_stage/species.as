@@ -19,6 +19,7 @@ void applyTemplate(CellStageWorld@ world, ObjectID microbe, Species@ species,
 
     MicrobeOperations::setMembraneType(world, microbe, species.membraneType);
     MicrobeOperations::setMembraneColour(world, microbe, species.colour);
+    microbeComponent.stats.membraneColour = species.colour;
     MicrobeOperations::setupMicrobeHitpoints(world, microbe,
         int(SimulationParameters::membraneRegistry().getTypeData(species.membraneType).hitpoints +
         microbeComponent.species.membraneRigidity * MEMBRANE_RIGIDITY_HITPOINTS_MODIFIER));
@@ -101,8 +102,6 @@ Species@ createSpecies(const string &in name, const string &in genus,
     species.epithet = epithet;
 
 
-    @species.avgCompoundAmounts = dictionary();
-
     @species.organelles = array<SpeciesStoredOrganelleType@>();
     species.stringCode = "";
 
@@ -146,6 +145,17 @@ Species@ createSpecies(const string &in name, const string &in genus,
     species.focus = focus;
     species.opportunism = opportunism;
 
+    setInitialCompounds(species, compounds);
+
+    return species;
+}
+
+//! Sets the avgCompoundAmounts of species from a dictionary of InitialCompounds
+//! keyed by compound internal names
+void setInitialCompounds(Species@ species, const dictionary &in compounds)
+{
+    @species.avgCompoundAmounts = dictionary();
+
     // Iterates over all compounds, and sets amounts and priorities
     uint64 compoundCount = SimulationParameters::compoundRegistry().getSize();
     for(uint i = 0; i < compoundCount; i++){
@@ -165,9 +175,40 @@ Species@ createSpecies(const string &in name, const string &in genus,
 
         species.avgCompoundAmounts[formatUInt(compound.id)] = compoundAmount;
     }
+}
 
+//! Recreates the script objects of a species that was loaded from a save
+//! \param initialCompounds Written by the C++ save code in the format
+//! "compound:amount:priority|..."
+void restoreSavedSpecies(Species@ species, const string &in stringCode,
+    const string &in initialCompounds)
+{
+    auto organelles = positionOrganelles(stringCode);
 
-    return species;
+    @species.organelles = array<SpeciesStoredOrganelleType@>();
+    species.stringCode = stringCode;
+
+    for(uint i = 0; i < organelles.length(); ++i){
+        species.organelles.insertLast(organelles[i]);
+    }
+
+    @species.avgCompoundAmounts = dictionary();
+
+    const auto compounds = initialCompounds.split("|");
+
+    for(uint i = 0; i < compounds.length(); ++i){
+
+        const auto parts = compounds[i].split(":");
+
+        if(parts.length() != 3)
+            continue;
+
+        const auto compoundId = SimulationParameters::compoundRegistry().getTypeId(
+            parts[0]);
+
+        species.avgCompoundAmounts[formatUInt(compoundId)] = InitialCompound(
+            parseFloat(parts[1]), parseInt(parts[2]));
+    }
 }
 
 // Currently this goes through STARTER_MICROBES (defined in config.as)
@@ -2,21 +2,32 @@
 #include "ThriveGame.h"
 
 #include "engine/player_data.h"
+#include "engine/replication.h"
+#include "engine/tracing.h"
+#include "general/auto_save.h"
 #include "general/global_keypresses.h"
+#include "general/locked_map.h"
+#include "general/save_game.h"
 
 #include "auto-evo/auto-evo.h"
 #include "generated/cell_stage_world.h"
 #include "generated/microbe_editor_world.h"
+#include "gui_update_channel.h"
 #include "main_menu_keypresses.h"
+#include "microbe_stage/cloud_streaming.h"
+#include "microbe_stage/input_recording.h"
 #include "microbe_stage/microbe_editor_key_handler.h"
 #include "microbe_stage/organelle_table.h"
 #include "microbe_stage/simulation_parameters.h"
 #include "scripting/script_initializer.h"
+#include "thrive_js_interface.h"
 #include "thrive_net_handler.h"
+#include "thrive_packets.h"
 #include "thrive_version.h"
 #include "thrive_world_factory.h"
 
 
+#include <Application/GameConfiguration.h>
 #include <Common/DataStoring/DataStore.h>
 #include <FileSystem.h>
 #include <GUI/GuiView.h>
@@ -28,13 +39,19 @@
 #include <Script/Bindings/BindHelpers.h>
 #include <Script/Bindings/StandardWorldBindHelper.h>
 #include <Script/ScriptExecutor.h>
+#include <Utility/Random.h>
 #include <Window.h>
 
+#include <fstream>
+#include <random>
+
 using namespace thrive;
 
 // ------------------------------------ //
 constexpr auto BACKGROUND_Y = -15;
 
+constexpr auto AUTOSAVE_FILE = "autosave.thrivesave";
+
 float
     backgroundYForCameraHeight(float height)
 {
@@ -77,7 +94,9 @@ public:
             *game.ApplicationConfiguration->GetKeyConfiguration())),
         m_microbeEditorKeys(std::make_shared<MicrobeEditorKeyHandler>(
             *game.ApplicationConfiguration->GetKeyConfiguration()))
-    {}
+    {
+        registerThriveJSFunctions(m_jsCalls);
+    }
 
     //! Releases graphical things. Needs to be called before shutdown
     void
@@ -175,6 +194,17 @@ public:
 
     AutoEvo m_autoEvo;
 
+    AutoSaver m_autoSaver;
+
+    //! Time since the last autosave, in seconds
+    float m_autoSaveTimer = 0;
+
+    //! The clouds received from the server when connected to one
+    std::shared_ptr<CloudStreamReceiver> m_cloudStreamReceiver;
+
+    //! The entity states received from the server
+    EntityStateReceiver m_entityStateReceiver;
+
     std::shared_ptr<CellStageWorld> m_cellStage;
     std::shared_ptr<MicrobeEditorWorld> m_microbeEditor;
 
@@ -205,6 +235,15 @@ public:
 
     //! Active microbe stage run
     std::shared_ptr<RunParameters> m_autoEvoRun;
+
+    //! Records the player input of the current game when enabled
+    std::unique_ptr<InputRecorder> m_inputRecorder;
+    std::string m_inputRecordingFile;
+
+    GuiUpdateChannel m_guiUpdates;
+
+    //! The functions and queries the GUI can call
+    JSCallDispatcher m_jsCalls;
 };
 
 // ------------------------------------ //
@@ -295,12 +334,73 @@ void
         return;
     }
 
-    Leviathan::Engine* engine = Engine::GetEngine();
-
     LOG_INFO("New game started");
 
+    // Before anything random happens in the new game
+    _startInputRecording();
+
+    if(!_setupCellStageWorld())
+        return;
+
+    // Create a PatchMap (it will also contain the initial species)
+    LOG_INFO("Generating new PatchMap");
+
+    const auto map = generateNewPatchMap();
+
+    if(!map)
+        return;
+
+    try {
+        m_impl->m_cellStage->GetPatchManager().setNewMap(map);
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("Something is wrong with the patch map, exception: ");
+        e.PrintToLog();
+        return;
+    }
+
+    // Make sure the player species exists (a bunch of places rely on it being
+    // named "Default")
+
+    // TODO: it would be nice to make the player species name a
+    // constant or something, other than this magic value
+    auto playerSpecies = m_impl->m_cellStage->GetPatchManager()
+                             .getCurrentMap()
+                             ->findSpeciesByName("Default");
+
+    if(!playerSpecies) {
+        LOG_ERROR("Patch map generation did not generate the default species");
+        return;
+    }
+
+    // Spawn player //
+    ScriptRunningSetup setup("setupPlayer");
+
+    auto result = getMicrobeScripts()->ExecuteOnModule<void>(
+        setup, false, m_impl->m_cellStage.get());
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+        LOG_ERROR("Failed to spawn player!");
+        return;
+    }
+
+    // Apply patch settings
+    m_impl->m_cellStage->GetPatchManager().applyPatchSettings();
+    checkAutoEvoStart();
+}
+
+// ------------------------------------ //
+bool
+    ThriveGame::_setupCellStageWorld()
+{
+    Leviathan::Engine* engine = Engine::GetEngine();
+
     // Reset player data
     m_impl->m_playerData.newGame();
+    m_impl->m_autoSaveTimer = 0;
+
+    // The HUD needs to get everything again
+    m_impl->m_guiUpdates.reset();
 
     Leviathan::Window* window1 = engine->GetWindowEntity();
 
@@ -397,7 +497,7 @@ void
             LOG_ERROR(
                 "Failed to run script setup function: " + setup.Entryfunction);
             MarkAsClosing();
-            return;
+            return false;
         }
 
         LOG_INFO("Finished calling setupOrganelleLetters");
@@ -416,7 +516,7 @@ void
         LOG_ERROR(
             "Failed to run script setup function: " + setup.Entryfunction);
         MarkAsClosing();
-        return;
+        return false;
     }
 
     LOG_INFO("Finished calling setupScriptsForWorld");
@@ -424,72 +524,119 @@ void
     // Set background plane //
     m_impl->createBackgroundItem();
 
-    // Create a PatchMap (it will also contain the initial species)
-    LOG_INFO("Generating new PatchMap");
+    return true;
+}
 
-    const auto map = generateNewPatchMap();
+void
+    ThriveGame::loadSaveGame(const std::string& saveFile)
+{
+    if(!m_postLoadRan) {
 
-    if(!map)
+        Engine::Get()->Invoke([=]() { loadSaveGame(saveFile); });
         return;
+    }
+
+    LOG_INFO("Loading saved game: " + saveFile);
+
+    // Loaded games can't be replayed from just a seed
+    _finishInputRecording();
+
+    std::unique_ptr<CellStageSaveLoader> loader;
 
     try {
-        m_impl->m_cellStage->GetPatchManager().setNewMap(map);
+        loader = std::make_unique<CellStageSaveLoader>(
+            std::make_unique<std::ifstream>(saveFile, std::ios::binary));
     } catch(const Leviathan::Exception& e) {
-        LOG_ERROR("Something is wrong with the patch map, exception: ");
+        LOG_ERROR("Failed to open save: " + saveFile + ", exception: ");
         e.PrintToLog();
         return;
     }
 
-    // Make sure the player species exists (a bunch of places rely on it being
-    // named "Default")
+    if(!_setupCellStageWorld())
+        return;
 
-    // TODO: it would be nice to make the player species name a
-    // constant or something, other than this magic value
-    auto playerSpecies = m_impl->m_cellStage->GetPatchManager()
-                             .getCurrentMap()
-                             ->findSpeciesByName("Default");
+    try {
+        m_impl->m_cellStage->GetPatchManager().setNewMap(
+            loader->loadPatchMap());
 
-    if(!playerSpecies) {
-        LOG_ERROR("Patch map generation did not generate the default species");
-        return;
-    }
+        // The spawners and the environment are set up before the microbes
+        m_impl->m_cellStage->GetPatchManager().applyPatchSettings();
 
-    // Spawn player //
-    setup = ScriptRunningSetup("setupPlayer");
+        // Everything is loaded at once here, the loader would also allow
+        // spreading this over multiple frames
+        while(loader->loadNextSection(*m_impl->m_cellStage)) {
+        }
 
-    result = getMicrobeScripts()->ExecuteOnModule<void>(
-        setup, false, m_impl->m_cellStage.get());
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("Loading save failed, starting a new game. Exception: ");
+        e.PrintToLog();
+        startNewGame();
+        return;
+    }
 
-    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+    const auto player = loader->getPlayer();
 
-        LOG_ERROR("Failed to spawn player!");
+    if(player == NULL_OBJECT) {
+        LOG_ERROR("Save has no player cell, starting a new game");
+        startNewGame();
         return;
     }
 
-    // Apply patch settings
-    m_impl->m_cellStage->GetPatchManager().applyPatchSettings();
+    // Same as setupPlayer
+    m_impl->m_playerData.lockedMap().addLock("Toxin");
+    m_impl->m_playerData.lockedMap().addLock("chloroplast");
+    m_impl->m_playerData.setActiveCreature(player);
+
     checkAutoEvoStart();
 }
 
 void
-    ThriveGame::loadSaveGame(const std::string& saveFile)
+    ThriveGame::saveGame(const std::string& saveFile)
 {
-    // i hate the very idea of writing the same code twice, so i want to call
-    // startNewGame first
-    LOG_INFO("saved game being loaded");
-    ThriveGame::startNewGame();
-    // start a new game, then run a loading script
-    //(the script will disable the tutorial etc)
+    if(!m_impl->m_cellStage) {
+        LOG_ERROR("ThriveGame: saveGame: no game is running");
+        return;
+    }
+
+    const auto map = m_impl->m_cellStage->GetPatchManager().getCurrentMap();
+
+    if(!map) {
+        LOG_ERROR("ThriveGame: saveGame: no patch map");
+        return;
+    }
+
+    std::ofstream file(saveFile, std::ios::binary | std::ios::trunc);
+
+    try {
+        writeCellStageSave(file, *m_impl->m_cellStage, *map,
+            m_impl->m_playerData.activeCreature());
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("Failed to write save: " + saveFile + ", exception: ");
+        e.PrintToLog();
+        return;
+    }
+
+    LOG_INFO("Game saved to: " + saveFile);
 }
 
 void
-    ThriveGame::saveGame(const std::string& saveFile)
+    ThriveGame::autoSave()
 {
-    // i hate the very idea of writing the same code twice, so i want to call
-    // startNewGame first
-    LOG_INFO("game being saved");
-    // start a new game, then run a loading script
-    //(the script will disable the tutorial etc)
+    if(!m_impl->m_cellStage)
+        return;
+
+    const auto map = m_impl->m_cellStage->GetPatchManager().getCurrentMap();
+
+    if(!map)
+        return;
+
+    try {
+        m_impl->m_autoSaver.save(*m_impl->m_cellStage, *map,
+            m_impl->m_playerData.activeCreature(), AUTOSAVE_FILE);
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("Failed to take autosave snapshot, exception: ");
+        e.PrintToLog();
+    }
 }
 // ------------------------------------ //
 CellStageWorld*
@@ -509,6 +656,30 @@ PlayerMicrobeControl*
 {
     return m_impl->m_cellStageKeys.get();
 }
+
+InputRecorder*
+    ThriveGame::getInputRecorder()
+{
+    return m_impl->m_inputRecorder.get();
+}
+
+GuiUpdateChannel&
+    ThriveGame::guiUpdates()
+{
+    return m_impl->m_guiUpdates;
+}
+
+JSCallDispatcher&
+    ThriveGame::jsCalls()
+{
+    return m_impl->m_jsCalls;
+}
+
+void
+    ThriveGame::postGuiUpdate(Leviathan::GenericEvent* event)
+{
+    m_impl->m_guiUpdates.post(Leviathan::GenericEvent::pointer(event));
+}
 // ------------------------------------ //
 void
     ThriveGame::killPlayerCellClicked()
@@ -564,6 +735,9 @@ void
 {
     LOG_INFO("editorButtonClicked called");
 
+    // The replays only cover the cell stage
+    _finishInputRecording();
+
     // Increase player population
     const auto playerSpecies = m_impl->m_cellStage->GetPatchManager()
                                    .getCurrentMap()
@@ -669,6 +843,15 @@ void
 void
     ThriveGame::playerMovedToPatch(int32_t patchId)
 {
+    // In multiplayer the server moves our cell to the world of the patch
+    if(m_network && m_network->IsConnected()) {
+
+        LOG_INFO("Asking the server to move us to patch: " +
+                 std::to_string(patchId));
+        m_network->requestMoveToPatch(patchId);
+        return;
+    }
+
     auto map = m_impl->m_cellStage->GetPatchManager().getCurrentMap();
     if(!map || map->getCurrentPatchId() == patchId)
         return;
@@ -720,11 +903,18 @@ void
 
     // Clear compound clouds
     m_impl->m_cellStage->GetCompoundCloudSystem().emptyAllClouds();
+
+    // And agents
+    m_impl->m_cellStage->GetAgentCloudSystem().emptyAllAgents(
+        *m_impl->m_cellStage);
 }
 
 void
     ThriveGame::exitToMenuClicked()
 {
+    _finishInputRecording();
+    m_impl->m_guiUpdates.reset();
+
     // Unlink window
     Leviathan::Window* window1 = Engine::GetEngine()->GetWindowEntity();
     window1->LinkObjects(nullptr);
@@ -834,6 +1024,105 @@ void
         }
     }
 }
+
+void
+    ThriveGame::dumpSystemTimings()
+{
+    if(!m_impl->m_cellStage) {
+        LOG_WARNING("ThriveGame: no cell stage to dump system timings from");
+        return;
+    }
+
+    const auto& profiler = m_impl->m_cellStage->GetSystemProfiler();
+
+    std::ofstream json("system_timings.json");
+    json << profiler.toJSON();
+
+    std::ofstream csv("system_timings.csv");
+    csv << profiler.toCSV();
+
+    if(!json.good() || !csv.good()) {
+        LOG_ERROR("ThriveGame: failed to write system timings");
+        return;
+    }
+
+    LOG_INFO("ThriveGame: wrote system_timings.json and system_timings.csv");
+
+    const auto jsCallStats = m_impl->m_jsCalls.formatStats();
+
+    if(!jsCallStats.empty())
+        LOG_INFO("ThriveGame: GUI call timings:\n" + jsCallStats);
+
+    LOG_INFO("ThriveGame: GUI updates: " + m_impl->m_guiUpdates.formatStats());
+}
+
+void
+    ThriveGame::toggleTraceRecording()
+{
+    if(!Tracer::isRecording()) {
+        LOG_INFO("ThriveGame: started recording a trace");
+        Tracer::start();
+        return;
+    }
+
+    Tracer::stop();
+
+    if(!Tracer::writeChromeTrace("thrive_trace.json")) {
+        LOG_ERROR("ThriveGame: failed to write thrive_trace.json");
+        return;
+    }
+
+    LOG_INFO("ThriveGame: wrote the recorded trace to thrive_trace.json");
+}
+// ------------------------------------ //
+void
+    ThriveGame::_startInputRecording()
+{
+    _finishInputRecording();
+
+    std::string file;
+
+    {
+        GameConfiguration* configuration = GameConfiguration::Get();
+        GUARD_LOCK_OTHER(configuration);
+        configuration->AccessVariables(guard)
+            ->GetValueAndConvertTo<std::string>("InputRecordingFile", file);
+    }
+
+    if(file.empty())
+        return;
+
+    // The seed is stored in the recording so it can be anything
+    const auto seed = static_cast<uint32_t>(std::random_device()());
+    Leviathan::Random::Get()->SetSeed(seed);
+
+    m_impl->m_inputRecorder = std::make_unique<InputRecorder>(seed);
+    m_impl->m_inputRecordingFile = file;
+
+    LOG_INFO("ThriveGame: recording player input with seed " +
+             std::to_string(seed));
+}
+
+void
+    ThriveGame::_finishInputRecording()
+{
+    if(!m_impl || !m_impl->m_inputRecorder)
+        return;
+
+    std::ofstream file(m_impl->m_inputRecordingFile);
+    file << m_impl->m_inputRecorder->toString();
+
+    if(!file.good()) {
+        LOG_ERROR("ThriveGame: failed to write input recording to: " +
+                  m_impl->m_inputRecordingFile);
+    } else {
+        LOG_INFO("ThriveGame: wrote " +
+                 std::to_string(m_impl->m_inputRecorder->getTickCount()) +
+                 " ticks of input to " + m_impl->m_inputRecordingFile);
+    }
+
+    m_impl->m_inputRecorder.reset();
+}
 // ------------------------------------ //
 void
     ThriveGame::connectToServer(const std::string& url)
@@ -1023,6 +1312,30 @@ void
     LEVIATHAN_ASSERT(SimulationParameters::compoundRegistry.getSize() > 0,
         "compound registry is empty when creating cloud entities for them");
 
+    // The same types as on the server. The clouds aren't simulated here, the
+    // server streams their contents
+    std::vector<Compound> clouds;
+
+    for(size_t i = 0; i < SimulationParameters::compoundRegistry.getSize();
+        ++i) {
+
+        const auto& data =
+            SimulationParameters::compoundRegistry.getTypeData(i);
+
+        if(!data.isCloud)
+            continue;
+
+        clouds.push_back(data);
+    }
+
+    m_impl->m_cellStage->GetCompoundCloudSystem().registerCloudTypes(
+        *m_impl->m_cellStage, clouds);
+
+    m_impl->m_cloudStreamReceiver = std::make_shared<CloudStreamReceiver>();
+    m_impl->m_entityStateReceiver.clear();
+    m_impl->m_cellStage->GetCompoundCloudSystem().setStreamReceiver(
+        m_impl->m_cloudStreamReceiver);
+
     // Let the script do setup //
     // This registers all the script defined systems to run and be
     // available from the world
@@ -1056,6 +1369,60 @@ void
     // control when we receive a notification of a direct control entity
 }
 
+void
+    ThriveGame::receiveCloudStreamMessage(const std::string& message)
+{
+    if(!m_impl->m_cloudStreamReceiver) {
+        LOG_WARNING("ThriveGame: received clouds without joining a server");
+        return;
+    }
+
+    try {
+        m_impl->m_cloudStreamReceiver->receive(message);
+    } catch(const Leviathan::InvalidArgument& e) {
+        LOG_ERROR("ThriveGame: received invalid cloud stream message:");
+        e.PrintToLog();
+    }
+}
+
+bool
+    ThriveGame::receiveEntityStates(
+        const std::string& message, uint32_t& sequence)
+{
+    if(!m_impl->m_cellStage || !m_impl->m_cloudStreamReceiver) {
+        LOG_WARNING("ThriveGame: received entities without joining a server");
+        return false;
+    }
+
+    CellStageWorld& world = *m_impl->m_cellStage;
+
+    try {
+        sequence = m_impl->m_entityStateReceiver.receive(
+            message, [&](ObjectID entity, const std::string& state) {
+                auto* position = world.GetComponentPtr_Position(entity);
+
+                // Not received from the server yet
+                if(!position)
+                    return;
+
+                decodeTransformState(state, position->Members._Position,
+                    position->Members._Orientation);
+                position->Marked = true;
+
+                auto* physics = world.GetComponentPtr_Physics(entity);
+
+                if(physics)
+                    physics->JumpTo(*position);
+            });
+    } catch(const Leviathan::InvalidArgument& e) {
+        LOG_ERROR("ThriveGame: received invalid entity states:");
+        e.PrintToLog();
+        return false;
+    }
+
+    return true;
+}
+
 void
     ThriveGame::doSpawnCellFromServerReceivedComponents(ObjectID id)
 {
@@ -1231,6 +1598,13 @@ void
 void
     ThriveGame::Tick(float elapsed)
 {
+    TraceZone zone("ThriveGame::Tick");
+
+    // The engine has just ticked the world. This adds the time the script
+    // systems took to the timings
+    if(m_impl->m_cellStage)
+        m_impl->m_cellStage->GetSystemProfiler().finishTick();
+
     if(m_debugOverlayEnabled) {
         auto event =
             Leviathan::GenericEvent::MakeShared<Leviathan::GenericEvent>(
@@ -1258,6 +1632,12 @@ void
         vars->Add(std::make_shared<NamedVariableList>(
             "ticksBehind", new Leviathan::IntBlock(store->GetTicksBehind())));
 
+        if(m_impl->m_cellStage) {
+            vars->Add(std::make_shared<NamedVariableList>("systemTimings",
+                new Leviathan::StringBlock(
+                    m_impl->m_cellStage->GetSystemProfiler().toJSON())));
+        }
+
         Engine::Get()->GetEventHandler()->CallEvent(event.detach());
     }
 
@@ -1265,6 +1645,20 @@ void
 
         _checkIsEditorEntryReady();
     }
+
+    // Autosave only while the player is actually playing the cell stage
+    if(m_impl->m_cellStage && m_impl->m_cellStageKeys->isEnabled() &&
+        m_impl->m_playerData.activeCreature() != NULL_OBJECT) {
+
+        m_impl->m_autoSaveTimer += elapsed;
+
+        if(m_impl->m_autoSaveTimer > AUTOSAVE_INTERVAL) {
+            m_impl->m_autoSaveTimer = 0;
+            autoSave();
+        }
+    }
+
+    m_impl->m_guiUpdates.flush();
 }
 
 void
@@ -1437,6 +1831,8 @@ void
 {
     Engine* engine = Engine::Get();
 
+    Tracer::setThreadName("Main");
+
     if(!createImpl()) {
         MarkAsClosing();
         return;
@@ -1456,6 +1852,9 @@ void
         return;
     }
 
+    // The server sends data in these
+    registerThrivePackets();
+
     // This is fine to set here to avoid putting this behind the next no gui
     // check //
     m_postLoadRan = true;
@@ -1494,6 +1893,8 @@ void
 void
     ThriveGame::EnginePreShutdown()
 {
+    _finishInputRecording();
+
     // Make sure all simulations have stopped
     m_impl->m_autoEvo.abortSimulations();
 
@@ -1525,7 +1926,16 @@ void
 void
     ThriveGame::CheckGameConfigurationVariables(Lock& guard,
         GameConfiguration* configobj)
-{}
+{
+    NamedVars* vars = configobj->AccessVariables(guard);
+
+    // Empty to not record the player input
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "InputRecordingFile")) {
+        vars->AddVar("InputRecordingFile", new VariableBlock(std::string("")));
+        configobj->MarkModified(guard);
+    }
+}
 
 void
     ThriveGame::CheckGameKeyConfigVariables(Lock& guard,
@@ -1548,6 +1958,8 @@ void
     keyconfigobj->AddKeyIfMissing(guard, "RotateLeft", {"D"});
     keyconfigobj->AddKeyIfMissing(guard, "ToggleDebugOverlay", {"F3"});
     keyconfigobj->AddKeyIfMissing(guard, "ToggleDebugPhysics", {"F4"});
+    keyconfigobj->AddKeyIfMissing(guard, "DumpSystemTimings", {"F5"});
+    keyconfigobj->AddKeyIfMissing(guard, "ToggleTraceRecording", {"F6"});
 }
 // ------------------------------------ //
 bool
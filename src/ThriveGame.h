@@ -24,6 +24,9 @@ class ThriveNetHandler;
 class PlayerData;
 
 class PlayerMicrobeControl;
+class InputRecorder;
+class GuiUpdateChannel;
+class JSCallDispatcher;
 
 class AutoEvo;
 class Species;
@@ -51,6 +54,12 @@ public:
     void
         saveGame(const std::string& saveFile);
 
+    //! \brief Starts writing an autosave in the background
+    //!
+    //! Called periodically from Tick while the player is in the cell stage
+    void
+        autoSave();
+
     CellStageWorld*
         getCellStage();
 
@@ -60,6 +69,24 @@ public:
     PlayerMicrobeControl*
         getPlayerInput();
 
+    //! \returns The recorder of the player input or null when the current
+    //! game isn't being recorded
+    InputRecorder*
+        getInputRecorder();
+
+    //! \brief The channel for the GUI updates sent every tick
+    GuiUpdateChannel&
+        guiUpdates();
+
+    //! \brief The functions the GUI can call. More can be registered at
+    //! startup
+    JSCallDispatcher&
+        jsCalls();
+
+    //! \brief Script version of guiUpdates().post
+    void
+        postGuiUpdate(Leviathan::GenericEvent* event);
+
     AutoEvo&
         autoEvo();
 
@@ -132,9 +159,21 @@ public:
     void
         toggleDebugPhysics();
 
+    //! \brief Writes the cell stage system timings to system_timings.json
+    //! and system_timings.csv in the working directory and logs the GUI call
+    //! timings
+    void
+        dumpSystemTimings();
+
+    //! \brief Starts recording a trace or stops it and writes it to
+    //! thrive_trace.json in the working directory
+    void
+        toggleTraceRecording();
+
     //! \brief Moves the player to play in the specified patch
     //!
-    //! Also does cleanup like despawning old compounds and cells
+    //! Also does cleanup like despawning old compounds and cells. When
+    //! connected to a server this asks the server to do the move instead
     void
         playerMovedToPatch(int32_t patchId);
 
@@ -168,6 +207,17 @@ public:
     void
         reportLocalControlChanged(GameWorld* world);
 
+    //! \brief Applies compound cloud contents sent by the server
+    void
+        receiveCloudStreamMessage(const std::string& message);
+
+    //! \brief Applies entity positions sent by the server
+    //! \param sequence Set to the number of the message, which needs to be
+    //! acknowledged to the server
+    //! \returns False if the message was invalid
+    bool
+        receiveEntityStates(const std::string& message, uint32_t& sequence);
+
     // ------------------------------------ //
     // Hooking into the engine, and overridden methods from base application
     // etc.
@@ -220,6 +270,23 @@ protected:
     void
         _checkIsEditorEntryReady();
 
+    //! \brief Creates or clears the cell stage world and sets it up for
+    //! starting or loading a game
+    //! \returns False on failure
+    bool
+        _setupCellStageWorld();
+
+    //! \brief Starts recording the player input if InputRecordingFile is set
+    //!
+    //! The engine random generator is reseeded so that the recording can be
+    //! replayed with ThriveBenchmark
+    void
+        _startInputRecording();
+
+    //! \brief Writes the input recording if there is one
+    void
+        _finishInputRecording();
+
 private:
     std::unique_ptr<ThriveNetHandler> m_network;
 
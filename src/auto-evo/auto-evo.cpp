@@ -1,6 +1,8 @@
 // ------------------------------------ //
 #include "auto-evo.h"
 
+#include "engine/tracing.h"
+
 using namespace thrive;
 // ------------------------------------ //
 AutoEvo::AutoEvo() :
@@ -28,6 +30,11 @@ void
 
     queuedRuns.push_back(run);
 
+    // Shows when the background thread gets to the run
+    Tracer::flowStart(
+        "AutoEvo run", reinterpret_cast<std::uintptr_t>(run.get()));
+    Tracer::counter("AutoEvo queued runs", queuedRuns.size());
+
     notifyBackgroundThread.notify_one();
 }
 
@@ -74,6 +81,8 @@ std::string
 void
     AutoEvo::_runBackgroundThread()
 {
+    Tracer::setThreadName("AutoEvo");
+
     GUARD_LOCK();
 
     while(!stopThread) {
@@ -93,17 +102,23 @@ void
 
         guard.unlock();
 
-        currentlyRunning->onBeginExecuting();
-
-        while(!stopThread) {
-            try {
-                if(currentlyRunning->step()) {
-                    // Complete
-                    break;
+        {
+            TraceZone zone("AutoEvo run", "auto-evo");
+            Tracer::flowEnd("AutoEvo run",
+                reinterpret_cast<std::uintptr_t>(currentlyRunning.get()));
+
+            currentlyRunning->onBeginExecuting();
+
+            while(!stopThread) {
+                try {
+                    if(currentlyRunning->step()) {
+                        // Complete
+                        break;
+                    }
+                } catch(const Leviathan::Exception& e) {
+                    LOG_ERROR("Exception happened in auto-evo step: ");
+                    e.PrintToLog();
                 }
-            } catch(const Leviathan::Exception& e) {
-                LOG_ERROR("Exception happened in auto-evo step: ");
-                e.PrintToLog();
             }
         }
 
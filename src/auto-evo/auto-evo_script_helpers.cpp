@@ -1,10 +1,16 @@
 // ------------------------------------ //
 #include "auto-evo_script_helpers.h"
 
+#include "mutation_generator.h"
 #include "thrive_common.h"
 
 #include <Script/ScriptExecutor.h>
 
+#include <boost/scope_exit.hpp>
+
+#include <memory>
+#include <random>
+
 using namespace thrive;
 using namespace autoevo;
 // ------------------------------------ //
@@ -71,27 +77,43 @@ const SpeciesMigration*
 // ------------------------------------ //
 // namespace functions
 Species::pointer
-    thrive::autoevo::getMutationForSpecies(const Species::pointer& species)
+    thrive::autoevo::getMutationForSpecies(
+        const Species::pointer& species, MutationGenerator& generator)
 {
-    ScriptRunningSetup setup = ScriptRunningSetup("createMutatedSpecies");
-
-    auto result =
-        ThriveCommon::get()->getMicrobeScripts()->ExecuteOnModule<Species*>(
-            setup, false, species.get());
+    if(!species)
+        return nullptr;
 
-    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+    return generator.createMutatedSpecies(*species);
+}
 
-        LOG_ERROR("Failed to run createMutatedSpecies");
+Species*
+    thrive::autoevo::getMutationForSpeciesWrapper(const Species* species)
+{
+    if(!species)
         return nullptr;
+
+    BOOST_SCOPE_EXIT(&species)
+    {
+        species->Release();
     }
+    BOOST_SCOPE_EXIT_END;
 
-    if(!result.Value) {
-        LOG_ERROR("createMutatedSpecies returned null");
+    // Created on first use as OrganelleTable isn't loaded when the scripts
+    // are registered
+    thread_local std::unique_ptr<MutationGenerator> generator;
+
+    if(!generator)
+        generator =
+            std::make_unique<MutationGenerator>(std::random_device()());
+
+    auto result = generator->createMutatedSpecies(*species);
+
+    if(!result)
         return nullptr;
-    }
 
-    result.Value->AddRef();
-    return Species::WrapPtr(result.Value);
+    // Reference for the caller
+    result->AddRef();
+    return result.get();
 }
 // ------------------------------------ //
 void
@@ -101,6 +123,23 @@ void
     if(!species || !mutation)
         return;
 
+    // Only the stringCode is set by MutationGenerator
+    if(!mutation->organelles) {
+
+        ScriptRunningSetup restoreSetup =
+            ScriptRunningSetup("restoreMutatedSpecies");
+
+        auto result =
+            ThriveCommon::get()->getMicrobeScripts()->ExecuteOnModule<void>(
+                restoreSetup, false, mutation.get());
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+            LOG_ERROR("Failed to run restoreMutatedSpecies");
+            return;
+        }
+    }
+
     ScriptRunningSetup setup =
         ScriptRunningSetup("applyMutatedSpeciesProperties");
 
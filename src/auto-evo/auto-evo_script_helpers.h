@@ -89,11 +89,29 @@ public:
     std::vector<SpeciesMigration::pointer> migrations;
 };
 
+class MutationGenerator;
+
 //! \returns a mutated version of a species
+//! \see MutationGenerator
 Species::pointer
-    getMutationForSpecies(const Species::pointer& species);
+    getMutationForSpecies(
+        const Species::pointer& species, MutationGenerator& generator);
+
+//! \brief Mutates a species for the scripts with a generator of the calling
+//! thread
+//!
+//! The editor and the new game setup use this so that they mutate species the
+//! same way as auto-evo. Like MutationGenerator::createMutatedSpecies the
+//! result only has its stringCode set and keeps the names of species.
+//! \returns The mutation with a reference added for the caller or null
+//! \note Releases the reference to species given by the scripts
+Species*
+    getMutationForSpeciesWrapper(const Species* species);
 
 //! \brief Applies the gene code and other property changes to a species
+//!
+//! Creates the script side organelles of mutation if MutationGenerator
+//! created it
 void
     applySpeciesMutation(const Species::pointer& species,
         const Species::pointer& mutation);
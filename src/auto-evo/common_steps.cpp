@@ -16,12 +16,16 @@ LambdaStep::LambdaStep(std::function<void(RunResults&)> operation) :
 // FindBestMutation
 FindBestMutation::FindBestMutation(const PatchMap::pointer& map,
     const Species::pointer& species,
+    const std::shared_ptr<MutationGenerator>& generator,
     int mutationsToTry,
     bool allowNoMutation /*= true*/) :
     m_map(map),
-    m_species(species), m_tryNoMutation(allowNoMutation),
-    m_mutationsToTry(mutationsToTry)
-{}
+    m_species(species), m_generator(generator),
+    m_tryNoMutation(allowNoMutation), m_mutationsToTry(mutationsToTry)
+{
+    if(!m_generator)
+        throw InvalidArgument("FindBestMutation needs a generator");
+}
 // ------------------------------------ //
 bool
     FindBestMutation::step(RunResults& resultsStore)
@@ -51,7 +55,12 @@ bool
 
     if(m_mutationsToTry > 0 && !ran) {
 
-        const auto mutated = getMutationForSpecies(m_species);
+        const auto mutated = getMutationForSpecies(m_species, *m_generator);
+
+        if(!mutated) {
+            --m_mutationsToTry;
+            return false;
+        }
 
         auto config =
             SimulationConfiguration::MakeShared<SimulationConfiguration>();
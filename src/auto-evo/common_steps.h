@@ -1,6 +1,7 @@
 #pragma once
 
 #include "auto-evo_script_helpers.h"
+#include "mutation_generator.h"
 #include "run_results.h"
 #include "run_step.h"
 
@@ -36,8 +37,10 @@ private:
 //! \brief Step that finds the best mutation for a single species
 class FindBestMutation : public RunStep {
 public:
+    //! \param generator Shared between the steps of a run
     FindBestMutation(const PatchMap::pointer& map,
         const Species::pointer& species,
+        const std::shared_ptr<MutationGenerator>& generator,
         int mutationsToTry,
         bool allowNoMutation = true);
 
@@ -50,6 +53,7 @@ public:
 private:
     const PatchMap::pointer m_map;
     const Species::pointer m_species;
+    const std::shared_ptr<MutationGenerator> m_generator;
     bool m_tryNoMutation;
     int m_mutationsToTry;
 
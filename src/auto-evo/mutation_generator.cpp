@@ -0,0 +1,327 @@
+// ------------------------------------ //
+#include "mutation_generator.h"
+
+#include "microbe_stage/microbe_constants.h"
+#include "microbe_stage/organelle_table.h"
+#include "microbe_stage/simulation_parameters.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <map>
+#include <numeric>
+
+using namespace thrive;
+using namespace autoevo;
+// ------------------------------------ //
+//! How many times MUTATION_EXTRA_CREATION_RATE is tried
+constexpr auto MUTATION_EXTRA_CREATION_TRIES = 5;
+
+//! The neighbours of a hex in the same order as HEX_NEIGHBOUR_OFFSET in hex.as
+constexpr std::array<std::array<int, 2>, 6> HEX_NEIGHBOUR_OFFSETS = {
+    {{0, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, 0}, {-1, 1}}};
+// ------------------------------------ //
+MutationGenerator::MutationGenerator(uint32_t seed) :
+    m_occupancy(HexOccupancyMap::MakeShared<HexOccupancyMap>()),
+    m_random(seed)
+{
+    // Sorted by name to make the chances not depend on the table order
+    std::map<std::string, const OrganelleTemplate*> organelles;
+
+    for(const auto& [name, organelle] :
+        OrganelleTable::getOrganelleDefinitions())
+        organelles[name] = organelle.get();
+
+    for(const auto& [name, organelle] : organelles) {
+
+        if(!organelle->m_gene.empty())
+            m_genes[organelle->m_gene.front()] = organelle;
+
+        if(name == "cytoplasm")
+            m_cytoplasm = organelle;
+
+        // The nucleus is only added by the bacteria to eukaryote mutation
+        if(organelle->hasComponent("nucleus")) {
+            m_nucleus = organelle;
+            continue;
+        }
+
+        m_choices.push_back({organelle, organelle->getChanceToCreate(),
+            organelle->getProkaryoteChance()});
+
+        m_maxEukaryoteScore += organelle->getChanceToCreate();
+        m_maxProkaryoteScore += organelle->getProkaryoteChance();
+    }
+
+    if(!m_cytoplasm || !m_nucleus)
+        throw Leviathan::InvalidState(
+            "organelle table is missing cytoplasm or nucleus");
+}
+// ------------------------------------ //
+Species::pointer
+    MutationGenerator::createMutatedSpecies(const Species& parent)
+{
+    OrganelleLayout layout;
+
+    try {
+        layout = parseStringCode(parent.stringCode);
+    } catch(const Leviathan::InvalidArgument& e) {
+        LOG_ERROR("MutationGenerator: species '" + parent.name +
+                  "' has invalid stringCode: " + e.what());
+        return nullptr;
+    }
+
+    layout = mutateLayout(layout, parent.isBacteria);
+
+    auto species = Species::MakeShared<Species>(parent.name);
+
+    species->genus = parent.genus;
+    species->epithet = parent.epithet;
+    species->stringCode = toStringCode(layout);
+
+    // There is a small chance of evolving into a eukaryote
+    species->isBacteria =
+        parent.isBacteria &&
+        std::none_of(layout.begin(), layout.end(),
+            [this](const GeneOrganelle& organelle) {
+                return organelle.type == m_nucleus;
+            });
+
+    const auto mutatePersonality = [this](float value, float max) {
+        return std::clamp(value + _random(MIN_SPECIES_PERSONALITY_MUTATION,
+                                      MAX_SPECIES_PERSONALITY_MUTATION),
+            0.f, max);
+    };
+
+    species->aggression =
+        mutatePersonality(parent.aggression, MAX_SPECIES_AGRESSION);
+    species->fear = mutatePersonality(parent.fear, MAX_SPECIES_FEAR);
+    species->activity =
+        mutatePersonality(parent.activity, MAX_SPECIES_ACTIVITY);
+    species->focus = mutatePersonality(parent.focus, MAX_SPECIES_FOCUS);
+    species->opportunism =
+        mutatePersonality(parent.opportunism, MAX_SPECIES_OPPORTUNISM);
+
+    species->colour = Float4(_random(MIN_COLOR, MAX_COLOR),
+        _random(MIN_COLOR, MAX_COLOR), _random(MIN_COLOR, MAX_COLOR),
+        species->isBacteria ? _random(MIN_OPACITY, MAX_OPACITY + 1) :
+                              _random(MIN_OPACITY, MAX_OPACITY));
+
+    // Same chances as in createMutatedSpecies, the earlier membranes are more
+    // likely
+    std::string membrane;
+
+    if(_random(0, 100) <= 20) {
+        if(_random(0, 100) < 50) {
+            membrane = "single";
+        } else if(_random(0, 100) < 50) {
+            membrane = "double";
+        } else if(_random(0, 100) < 50) {
+            membrane = "cellulose";
+        } else if(_random(0, 100) < 50) {
+            membrane = "chitin";
+        } else if(_random(0, 100) < 50) {
+            membrane = "calcium_carbonate";
+        } else {
+            membrane = "silica";
+        }
+    }
+
+    if(membrane.empty()) {
+        species->membraneType = parent.membraneType;
+    } else {
+        species->membraneType =
+            SimulationParameters::membraneRegistry.getTypeId(membrane);
+
+        if(membrane != "single" && membrane != "cellulose")
+            species->colour.W =
+                _random(MIN_OPACITY_CHITIN, MAX_OPACITY_CHITIN);
+    }
+
+    species->membraneRigidity = std::clamp(
+        parent.membraneRigidity + _random(-25, 25) / 100.f, -1.f, 1.f);
+
+    return species;
+}
+// ------------------------------------ //
+OrganelleLayout
+    MutationGenerator::mutateLayout(
+        const OrganelleLayout& parent, bool isBacteria)
+{
+    OrganelleLayout result;
+    result.reserve(parent.size() + MUTATION_EXTRA_CREATION_TRIES + 2);
+
+    // Delete or replace organelles randomly
+    for(size_t i = 0; i < parent.size(); ++i) {
+
+        GeneOrganelle organelle = parent[i];
+        const bool isNucleus = organelle.type == m_nucleus;
+
+        if(_random(0.f, 1.f) < MUTATION_DELETION_RATE) {
+            // Removing the last organelle would be silly
+            if(i != parent.size() - 1 && !isNucleus)
+                continue;
+
+        } else if(_random(0.f, 1.f) < MUTATION_REPLACEMENT_RATE) {
+            if(!isNucleus)
+                organelle.type = &getRandomOrganelle(isBacteria);
+        }
+
+        result.push_back(organelle);
+    }
+
+    // New organelles are added at the end of the list
+    if(_random(0.f, 1.f) < MUTATION_CREATION_RATE)
+        addNextToExisting(result, getRandomOrganelle(isBacteria));
+
+    for(int i = 0; i < MUTATION_EXTRA_CREATION_TRIES; ++i) {
+        if(_random(0.f, 1.f) < MUTATION_EXTRA_CREATION_RATE)
+            addNextToExisting(result, getRandomOrganelle(isBacteria));
+    }
+
+    if(isBacteria && _random(0.f, 100.f) <= MUTATION_BACTERIA_TO_EUKARYOTE)
+        addNextToExisting(result, *m_nucleus);
+
+    return result;
+}
+// ------------------------------------ //
+bool
+    MutationGenerator::addNextToExisting(
+        OrganelleLayout& layout, const OrganelleTemplate& organelle)
+{
+    if(layout.empty()) {
+        layout.push_back({&organelle, 0, 0, 0});
+        return true;
+    }
+
+    _fillOccupancy(layout);
+
+    // Shuffled to not always place at the same part of the cell
+    m_placementOrder.resize(layout.size());
+    std::iota(m_placementOrder.begin(), m_placementOrder.end(), 0);
+    std::shuffle(m_placementOrder.begin(), m_placementOrder.end(), m_random);
+
+    for(const auto index : m_placementOrder) {
+
+        const auto& other = layout[index];
+
+        // Only the real neighbours of each hex are tried so that the new
+        // organelle always shares an edge with an existing one
+        for(const auto& hex : other.type->getRotatedHexes(other.rotation)) {
+            for(const auto& offset : HEX_NEIGHBOUR_OFFSETS) {
+
+                const int q = other.q + hex.X + offset[0];
+                const int r = other.r + hex.Y + offset[1];
+
+                for(int rotation = 0; rotation < 360; rotation += 60) {
+
+                    if(m_occupancy->isFree(
+                           organelle.getRotatedHexes(rotation), q, r)) {
+
+                        layout.push_back({&organelle, q, r, rotation});
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+// ------------------------------------ //
+const OrganelleTemplate&
+    MutationGenerator::getRandomOrganelle(bool isBacteria)
+{
+    float value =
+        _random(0.f, isBacteria ? m_maxProkaryoteScore : m_maxEukaryoteScore);
+
+    for(const auto& choice : m_choices) {
+
+        value -= isBacteria ? choice.prokaryoteChance : choice.eukaryoteChance;
+
+        if(value <= 0)
+            return *choice.organelle;
+    }
+
+    return *m_cytoplasm;
+}
+// ------------------------------------ //
+OrganelleLayout
+    MutationGenerator::parseStringCode(const std::string& stringCode) const
+{
+    OrganelleLayout result;
+
+    size_t start = 0;
+
+    while(start <= stringCode.size()) {
+
+        auto end = stringCode.find('|', start);
+
+        if(end == std::string::npos)
+            end = stringCode.size();
+
+        const auto gene = stringCode.substr(start, end - start);
+        start = end + 1;
+
+        if(gene.empty())
+            continue;
+
+        const auto type = m_genes.find(gene.front());
+
+        if(type == m_genes.end())
+            throw Leviathan::InvalidArgument("unknown gene: " + gene);
+
+        GeneOrganelle organelle;
+        organelle.type = type->second;
+
+        if(std::sscanf(gene.c_str() + 1, ",%d,%d,%d", &organelle.q,
+               &organelle.r, &organelle.rotation) != 3)
+            throw Leviathan::InvalidArgument("malformed gene: " + gene);
+
+        result.push_back(organelle);
+    }
+
+    return result;
+}
+
+std::string
+    MutationGenerator::toStringCode(const OrganelleLayout& layout)
+{
+    std::string result;
+
+    for(const auto& organelle : layout) {
+
+        if(!result.empty())
+            result += '|';
+
+        result += organelle.type->m_gene + "," + std::to_string(organelle.q) +
+                  "," + std::to_string(organelle.r) + "," +
+                  std::to_string(organelle.rotation);
+    }
+
+    return result;
+}
+// ------------------------------------ //
+float
+    MutationGenerator::_random(float min, float max)
+{
+    return std::uniform_real_distribution<float>(min, max)(m_random);
+}
+
+int
+    MutationGenerator::_random(int min, int max)
+{
+    return std::uniform_int_distribution<int>(min, max)(m_random);
+}
+// ------------------------------------ //
+void
+    MutationGenerator::_fillOccupancy(const OrganelleLayout& layout)
+{
+    m_occupancy->clear();
+
+    for(const auto& organelle : layout)
+        m_occupancy->add(organelle.type->getRotatedHexes(organelle.rotation),
+            organelle.q, organelle.r);
+}
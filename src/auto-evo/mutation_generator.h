@@ -0,0 +1,106 @@
+#pragma once
+
+#include "microbe_stage/hex_occupancy_map.h"
+#include "microbe_stage/species.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace thrive {
+
+class OrganelleTemplate;
+
+namespace autoevo {
+
+//! \brief A placed organelle in an OrganelleLayout
+struct GeneOrganelle {
+    //! Owned by OrganelleTable
+    const OrganelleTemplate* type = nullptr;
+    int32_t q = 0;
+    int32_t r = 0;
+    int32_t rotation = 0;
+};
+
+//! \brief The organelles of a species in the order of its stringCode
+using OrganelleLayout = std::vector<GeneOrganelle>;
+
+//! \brief Creates mutated species without going through scripts
+//!
+//! All species mutations are made with this. Auto-evo creates its own
+//! generator and the editor and the new game setup use one through
+//! getMutationForSpeciesWrapper. The created species only have their
+//! stringCode set, applySpeciesMutation and createMutatedSpecies in the
+//! scripts create the script side organelles and compounds.
+//! \note OrganelleTable needs to be initialized before creating this
+class MutationGenerator {
+public:
+    //! \param seed Two generators with the same seed create the same mutations
+    MutationGenerator(uint32_t seed);
+
+    //! \returns A mutated version of parent or null if the stringCode of
+    //! parent is invalid
+    //! \note The names aren't mutated as applying a mutation to a species
+    //! doesn't change its name
+    Species::pointer
+        createMutatedSpecies(const Species& parent);
+
+    //! \brief Randomly deletes, replaces and adds organelles
+    OrganelleLayout
+        mutateLayout(const OrganelleLayout& parent, bool isBacteria);
+
+    //! \brief Adds organelle sharing an edge with one of the organelles in
+    //! layout
+    //! \returns False if there was no free spot
+    bool
+        addNextToExisting(OrganelleLayout& layout,
+            const OrganelleTemplate& organelle);
+
+    //! \returns A random organelle weighted by the chances in organelles.json
+    const OrganelleTemplate&
+        getRandomOrganelle(bool isBacteria);
+
+    //! \exception Leviathan::InvalidArgument if stringCode is malformed
+    OrganelleLayout
+        parseStringCode(const std::string& stringCode) const;
+
+    static std::string
+        toStringCode(const OrganelleLayout& layout);
+
+private:
+    //! An organelle that can be randomly added
+    struct Choice {
+        const OrganelleTemplate* organelle;
+        float eukaryoteChance;
+        float prokaryoteChance;
+    };
+
+    float
+        _random(float min, float max);
+
+    int
+        _random(int min, int max);
+
+    //! \brief Builds m_occupancy from layout
+    void
+        _fillOccupancy(const OrganelleLayout& layout);
+
+private:
+    std::vector<Choice> m_choices;
+    float m_maxEukaryoteScore = 0.f;
+    float m_maxProkaryoteScore = 0.f;
+
+    std::unordered_map<char, const OrganelleTemplate*> m_genes;
+
+    const OrganelleTemplate* m_cytoplasm = nullptr;
+    const OrganelleTemplate* m_nucleus = nullptr;
+
+    //! Reused between the placements to not allocate each time
+    HexOccupancyMap::pointer m_occupancy;
+    std::vector<size_t> m_placementOrder;
+
+    std::mt19937 m_random;
+};
+
+}} // namespace thrive::autoevo
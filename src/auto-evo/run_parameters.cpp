@@ -5,13 +5,17 @@
 #include "run_results.h"
 #include "run_step.h"
 
+#include "engine/tracing.h"
+
 #include <numeric>
 
 using namespace thrive;
 using namespace autoevo;
 // ------------------------------------ //
-RunParameters::RunParameters(const PatchMap::pointer& patchesToSimulate) :
-    m_map(patchesToSimulate), m_results(RunResults::MakeShared<RunResults>())
+RunParameters::RunParameters(
+    const PatchMap::pointer& patchesToSimulate, uint32_t seed) :
+    m_map(patchesToSimulate),
+    m_results(RunResults::MakeShared<RunResults>()), m_seed(seed)
 {
     if(!m_map)
         throw InvalidArgument("null map give to RunParameters");
@@ -136,6 +140,8 @@ std::string
 bool
     RunParameters::step()
 {
+    TraceZone zone("RunParameters::step", "auto-evo");
+
     std::lock_guard<std::mutex> lock(m_stepMutex);
     if(!m_inProgress) {
         // Aborted
@@ -208,6 +214,8 @@ void
 
     std::unordered_set<Species*> alreadyHandledSpecies;
 
+    const auto mutationGenerator = std::make_shared<MutationGenerator>(m_seed);
+
     for(const auto& [id, patch] : m_map->getPatches()) {
 
         for(const auto& species : patch->getSpecies()) {
@@ -224,7 +232,8 @@ void
             if(!species.species->isPlayerSpecies()) {
 
                 m_runSteps.push_back(std::make_unique<FindBestMutation>(m_map,
-                    species.species, m_mutationsPerSpecies, m_allowNoMutation));
+                    species.species, mutationGenerator, m_mutationsPerSpecies,
+                    m_allowNoMutation));
 
                 m_runSteps.push_back(
                     std::make_unique<FindBestMigration>(m_map, species.species,
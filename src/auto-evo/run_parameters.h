@@ -11,6 +11,7 @@
 #include <atomic>
 #include <deque>
 #include <mutex>
+#include <random>
 
 namespace thrive {
 
@@ -35,7 +36,10 @@ class RunParameters {
     };
 
 public:
-    RunParameters(const PatchMap::pointer& patchesToSimulate);
+    //! \param seed For the mutations. Runs with the same seed and map make
+    //! the same mutations
+    RunParameters(const PatchMap::pointer& patchesToSimulate,
+        uint32_t seed = std::random_device()());
     virtual ~RunParameters();
 
     //! \brief Stops this auto-evo run. Waits until the run won't read any
@@ -145,6 +149,8 @@ protected:
     //! applied
     autoevo::RunResults::pointer m_results;
 
+    const uint32_t m_seed;
+
     // Configuration parameters for auto evo
     // TODO: allow loading these from JSON
     const int m_mutationsPerSpecies = 3;
@@ -0,0 +1,696 @@
+// ------------------------------------ //
+#include "ThriveBenchmark.h"
+
+#include "bot/bot_metrics.h"
+#include "engine/system_profiler.h"
+#include "generated/cell_stage_world.h"
+#include "microbe_stage/input_recording.h"
+#include "microbe_stage/player_microbe_control.h"
+#include "microbe_stage/simulation_parameters.h"
+#include "scripting/script_initializer.h"
+#include "thrive_version.h"
+
+#include <Application/GameConfiguration.h>
+#include <Networking/NetworkClientInterface.h>
+#include <Physics/PhysicsMaterialManager.h>
+#include <Script/ScriptExecutor.h>
+#include <Utility/Random.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+//! The fixed tick length, same as the default server tick rate
+constexpr auto BENCHMARK_TICK_RATE = 20;
+
+//! The scenario is spawned inside a square of this half size around the
+//! origin
+constexpr auto BENCHMARK_SPAWN_RADIUS = 100.f;
+
+constexpr auto BENCHMARK_CLOUD_DENSITY = 5000.f;
+
+namespace {
+
+//! \brief Network interface that never connects anywhere
+//!
+//! The engine needs some interface but the benchmark doesn't use the network
+class BenchmarkNetHandler : public Leviathan::NetworkClientInterface {
+public:
+    void
+        _OnProperlyConnected() override
+    {}
+
+protected:
+    void
+        _OnNewConnectionStatusMessage(const std::string& message) override
+    {}
+
+    void
+        _OnDisconnectFromServer(const std::string& reasonstring,
+            bool donebyus) override
+    {}
+
+    std::shared_ptr<Leviathan::PhysicsMaterialManager>
+        GetPhysicsMaterialsForReceivedWorld(int32_t worldtype,
+            const std::string& extraoptions) override
+    {
+        return ThriveBenchmark::get()->createPhysicsMaterials();
+    }
+};
+
+//! \brief FNV-1a over the values rounded to a fixed precision
+//!
+//! Rounding keeps tiny floating point differences from making runs on
+//! different compilers look completely different
+class Checksum {
+public:
+    void
+        add(float value)
+    {
+        // llround has no defined result for these, so they get fixed values
+        // that no rounded value can collide with
+        if(std::isnan(value)) {
+            add(NAN_VALUE);
+            return;
+        }
+
+        if(std::isinf(value)) {
+            add(value > 0 ? POSITIVE_INFINITY_VALUE : NEGATIVE_INFINITY_VALUE);
+            return;
+        }
+
+        // Floats are at most about 3.4e38 so the scaled value can't be
+        // infinite, but it can still be outside the range of llround
+        const double scaled = std::clamp(
+            static_cast<double>(value) * 1000.0, -MAX_SCALED, MAX_SCALED);
+
+        add(static_cast<uint64_t>(std::llround(scaled)));
+    }
+
+    void
+        add(uint64_t value)
+    {
+        for(int i = 0; i < 8; ++i) {
+            m_hash ^= (value >> (i * 8)) & 0xff;
+            m_hash *= 1099511628211ull;
+        }
+    }
+
+    uint64_t
+        get() const
+    {
+        return m_hash;
+    }
+
+private:
+    //! Rounded values are clamped to this so that the sentinels below stay
+    //! unique
+    static constexpr double MAX_SCALED = 4e18;
+
+    static constexpr uint64_t NAN_VALUE = 0x7fffffffffffffffull;
+    static constexpr uint64_t POSITIVE_INFINITY_VALUE = 0x7ffffffffffffffeull;
+    static constexpr uint64_t NEGATIVE_INFINITY_VALUE = 0x8000000000000000ull;
+
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+} // namespace
+
+//! Contains properties that would need unnecessary large includes in the header
+class ThriveBenchmark::Implementation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    std::shared_ptr<CellStageWorld> m_cellStage;
+
+    //! The scenario settings read from the configuration
+    uint32_t m_seed = 0;
+    int m_microbes = 0;
+    int m_clouds = 0;
+    int m_chunks = 0;
+    int m_ticks = 0;
+    std::string m_resultsFile;
+    std::string m_replayFile;
+
+    //! Set when replaying recorded input instead of running the scenario
+    std::unique_ptr<InputReplay> m_replay;
+    ObjectID m_player = NULL_OBJECT;
+
+    //! Used for the spawn positions. The engine random generator is also
+    //! seeded for the scripts and systems
+    std::mt19937 m_random;
+
+    //! Everything spawned by the scenario, used for the checksum
+    std::vector<ObjectID> m_spawned;
+
+    //! The cloud compounds in the order of their ids
+    std::vector<CompoundId> m_cloudCompounds;
+
+    Clock::duration m_tickTime = Clock::duration(0);
+
+    //! The length of each tick for the distribution in the report
+    BotMetrics m_metrics;
+};
+// ------------------------------------ //
+ThriveBenchmark::ThriveBenchmark()
+{
+    staticInstance = this;
+}
+
+ThriveBenchmark::~ThriveBenchmark()
+{
+    staticInstance = nullptr;
+}
+
+std::string
+    ThriveBenchmark::GenerateWindowTitle()
+{
+    return "Thrive Benchmark " GAME_VERSIONS;
+}
+
+ThriveBenchmark*
+    ThriveBenchmark::get()
+{
+    return staticInstance;
+}
+
+ThriveBenchmark* ThriveBenchmark::staticInstance = nullptr;
+
+Leviathan::NetworkInterface*
+    ThriveBenchmark::_GetApplicationPacketHandler()
+{
+    if(!m_network)
+        m_network = std::make_unique<BenchmarkNetHandler>();
+    return m_network.get();
+}
+
+void
+    ThriveBenchmark::_ShutdownApplicationPacketHandler()
+{
+    m_network.reset();
+}
+// ------------------------------------ //
+bool
+    ThriveBenchmark::_createWorld()
+{
+    // Same as ThriveServer::_createShard. Without a window no rendering
+    // resources are created for the world. Replays use the settings of the
+    // single player game they were recorded in
+    auto world = std::make_shared<CellStageWorld>(createPhysicsMaterials());
+
+    const auto settings =
+        m_impl->m_replay ?
+            Leviathan::WorldNetworkSettings::GetSettingsForSinglePlayer() :
+            Leviathan::WorldNetworkSettings::GetSettingsForServer();
+
+    if(!world->Init(settings, nullptr)) {
+        LOG_ERROR("ThriveBenchmark: cell stage world init failed");
+        return false;
+    }
+
+    m_impl->m_cellStage = world;
+
+    ScriptRunningSetup mapSetup("generatePatchMap");
+    auto map =
+        getMicrobeScripts()->ExecuteOnModule<PatchMap*>(mapSetup, false);
+
+    if(map.Result != SCRIPT_RUN_RESULT::Success || !map.Value) {
+        LOG_ERROR("ThriveBenchmark: failed to run generatePatchMap");
+        return false;
+    }
+
+    // We are keeping a reference to the result
+    map.Value->AddRef();
+
+    try {
+        world->GetPatchManager().setNewMap(PatchMap::WrapPtr(map.Value));
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("ThriveBenchmark: something is wrong with the patch map, "
+                  "exception: ");
+        e.PrintToLog();
+        return false;
+    }
+
+    std::vector<Compound> clouds;
+
+    for(size_t i = 0; i < SimulationParameters::compoundRegistry.getSize();
+        ++i) {
+
+        const auto& data =
+            SimulationParameters::compoundRegistry.getTypeData(i);
+
+        if(!data.isCloud)
+            continue;
+
+        clouds.push_back(data);
+        m_impl->m_cloudCompounds.push_back(i);
+    }
+
+    world->GetCompoundCloudSystem().registerCloudTypes(*world, clouds);
+
+    ScriptRunningSetup setup(m_impl->m_replay ? "setupSimulationForWorld" :
+                                                "setupScriptsForWorld_Server");
+
+    auto result =
+        getMicrobeScripts()->ExecuteOnModule<void>(setup, false, world.get());
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+        LOG_ERROR(
+            "Failed to run script setup function: " + setup.Entryfunction);
+        return false;
+    }
+
+    // The game applies these after spawning the player
+    if(!m_impl->m_replay)
+        world->GetPatchManager().applyPatchSettings();
+
+    return true;
+}
+
+bool
+    ThriveBenchmark::_spawnScenario()
+{
+    CellStageWorld& world = *m_impl->m_cellStage;
+
+    const auto randomPosition = [this]() {
+        std::uniform_real_distribution<float> distribution(
+            -BENCHMARK_SPAWN_RADIUS, BENCHMARK_SPAWN_RADIUS);
+
+        // The x value needs to be generated first to not depend on the
+        // argument evaluation order
+        const auto x = distribution(m_impl->m_random);
+        return Float3(x, 0, distribution(m_impl->m_random));
+    };
+
+    const auto map = world.GetPatchManager().getCurrentMap();
+
+    if(!map || !map->getCurrentPatch()) {
+        LOG_ERROR("ThriveBenchmark: patch map has no current patch");
+        return false;
+    }
+
+    const auto patch = map->getCurrentPatch();
+
+    // Microbes of the species in the patch take turns
+    const auto& species = patch->getSpecies();
+
+    if(m_impl->m_microbes > 0 && species.empty()) {
+        LOG_ERROR("ThriveBenchmark: the current patch has no species");
+        return false;
+    }
+
+    ScriptRunningSetup microbeSetup("ObjectID MicrobeOperations::spawnMicrobe("
+                                    "CellStageWorld@, Float3, const string "
+                                    "&in, bool, bool)");
+    microbeSetup.FullDeclaration = true;
+
+    for(int i = 0; i < m_impl->m_microbes; ++i) {
+
+        const auto result =
+            getMicrobeScripts()->ExecuteOnModule<ObjectID>(microbeSetup, false,
+                &world, randomPosition(),
+                species[i % species.size()].species->name, true, false);
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+            LOG_ERROR("ThriveBenchmark: failed to spawn a microbe");
+            return false;
+        }
+
+        m_impl->m_spawned.push_back(result.Value);
+    }
+
+    if(!m_impl->m_cloudCompounds.empty()) {
+
+        std::uniform_int_distribution<size_t> compound(
+            0, m_impl->m_cloudCompounds.size() - 1);
+
+        for(int i = 0; i < m_impl->m_clouds; ++i) {
+
+            const auto id =
+                m_impl->m_cloudCompounds[compound(m_impl->m_random)];
+
+            world.GetCompoundCloudSystem().addCloud(
+                id, BENCHMARK_CLOUD_DENSITY, randomPosition());
+        }
+    }
+
+    std::vector<const ChunkData*> chunkTypes;
+
+    for(const auto& [id, chunk] : patch->getBiome().chunks)
+        chunkTypes.push_back(&chunk);
+
+    if(m_impl->m_chunks > 0 && chunkTypes.empty()) {
+        LOG_ERROR("ThriveBenchmark: the current patch has no chunks");
+        return false;
+    }
+
+    ScriptRunningSetup chunkSetup("spawnChunk");
+
+    for(int i = 0; i < m_impl->m_chunks; ++i) {
+
+        const auto result = getMicrobeScripts()->ExecuteOnModule<ObjectID>(
+            chunkSetup, false, &world, chunkTypes[i % chunkTypes.size()],
+            randomPosition());
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+            LOG_ERROR("ThriveBenchmark: failed to spawn a chunk");
+            return false;
+        }
+
+        m_impl->m_spawned.push_back(result.Value);
+    }
+
+    return true;
+}
+
+bool
+    ThriveBenchmark::_spawnReplayPlayer()
+{
+    // Same order as ThriveGame::startNewGame
+    ScriptRunningSetup setup("spawnPlayerCell");
+
+    const auto result = getMicrobeScripts()->ExecuteOnModule<ObjectID>(
+        setup, false, m_impl->m_cellStage.get());
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+        LOG_ERROR("ThriveBenchmark: failed to spawn the replay player");
+        return false;
+    }
+
+    m_impl->m_player = result.Value;
+    m_impl->m_spawned.push_back(result.Value);
+
+    m_impl->m_cellStage->GetPatchManager().applyPatchSettings();
+    return true;
+}
+
+void
+    ThriveBenchmark::_runTicks()
+{
+    CellStageWorld& world = *m_impl->m_cellStage;
+
+    // Only the scenario is timed
+    world.GetSystemProfiler().OnClear();
+
+    const float elapsed = 1.f / BENCHMARK_TICK_RATE;
+
+    auto& replay = m_impl->m_replay;
+
+    // Every tick is kept for the distribution in the report
+    const uint64_t ticks = replay ? replay->getTickCount() :
+                                    std::max(m_impl->m_ticks, 0);
+    m_impl->m_metrics =
+        BotMetrics(static_cast<size_t>(std::max<uint64_t>(ticks, 1)));
+
+    for(int i = 0; replay ? !replay->isFinished() : i < m_impl->m_ticks;
+        ++i) {
+
+        const auto start = Implementation::Clock::now();
+
+        if(replay) {
+
+            const auto intent = replay->next();
+
+            // The recorded input is ignored once the player has died like
+            // in the game
+            if(PlayerMicrobeControlSystem::isControllable(
+                   world, m_impl->m_player))
+                PlayerMicrobeControlSystem::applyIntent(world,
+                    *getMicrobeScripts(), m_impl->m_player, intent);
+        }
+
+        world.Tick(elapsed);
+
+        const auto duration = Implementation::Clock::now() - start;
+
+        world.GetSystemProfiler().addTickTotal(duration);
+        m_impl->m_tickTime += duration;
+        m_impl->m_metrics.addSample("tick_ms",
+            std::chrono::duration<float, std::milli>(duration).count());
+    }
+
+    if(replay)
+        m_impl->m_ticks = static_cast<int>(replay->getTickCount());
+}
+
+uint64_t
+    ThriveBenchmark::_calculateChecksum() const
+{
+    CellStageWorld& world = *m_impl->m_cellStage;
+
+    Checksum checksum;
+
+    for(const auto entity : m_impl->m_spawned) {
+
+        const auto* position = world.GetComponentPtr_Position(entity);
+
+        // Entities that were destroyed are also part of the end state
+        if(!position) {
+            checksum.add(static_cast<uint64_t>(0));
+            continue;
+        }
+
+        checksum.add(position->Members._Position.X);
+        checksum.add(position->Members._Position.Y);
+        checksum.add(position->Members._Position.Z);
+    }
+
+    CompoundCloudsSnapshot clouds;
+    world.GetCompoundCloudSystem().takeSnapshot(clouds);
+
+    for(const auto& cloud : clouds.clouds) {
+
+        checksum.add(cloud.position.X);
+        checksum.add(cloud.position.Z);
+
+        for(const auto& grid : cloud.grids) {
+
+            // The sum is enough to catch differences and doesn't make the
+            // checksum slow with big clouds
+            double total = 0;
+
+            for(const auto value : grid.data)
+                total += value;
+
+            checksum.add(static_cast<float>(total));
+        }
+    }
+
+    return checksum.get();
+}
+
+void
+    ThriveBenchmark::_report(uint64_t checksum)
+{
+    const auto totalMs = std::chrono::duration<double, std::milli>(
+        m_impl->m_tickTime)
+                             .count();
+
+    char checksumText[17];
+    std::snprintf(checksumText, sizeof(checksumText), "%016llx",
+        static_cast<unsigned long long>(checksum));
+
+    std::stringstream report;
+
+    report << "seed," << m_impl->m_seed << "\n"
+           << "microbes," << m_impl->m_microbes << "\n"
+           << "clouds," << m_impl->m_clouds << "\n"
+           << "chunks," << m_impl->m_chunks << "\n"
+           << "ticks," << m_impl->m_ticks << "\n"
+           << "total_ms," << totalMs << "\n"
+           << "tick_average_ms,"
+           << (m_impl->m_ticks > 0 ? totalMs / m_impl->m_ticks : 0) << "\n";
+
+    if(m_impl->m_metrics.hasSeries("tick_ms")) {
+
+        const auto ticks = m_impl->m_metrics.getSummary("tick_ms");
+
+        report << "tick_min_ms," << ticks.min << "\n"
+               << "tick_p95_ms," << ticks.p95 << "\n"
+               << "tick_max_ms," << ticks.max << "\n";
+    }
+
+    if(m_impl->m_replay)
+        report << "replay," << m_impl->m_replayFile << "\n";
+
+    report << "checksum," << checksumText << "\n\n"
+           << m_impl->m_cellStage->GetSystemProfiler().toCSV();
+
+    LOG_INFO("ThriveBenchmark: results:\n" + report.str());
+
+    if(m_impl->m_resultsFile.empty())
+        return;
+
+    std::ofstream file(m_impl->m_resultsFile);
+
+    if(!file.good()) {
+        LOG_ERROR("ThriveBenchmark: can't write results to: " +
+                  m_impl->m_resultsFile);
+        return;
+    }
+
+    file << report.str();
+}
+// ------------------------------------ //
+void
+    ThriveBenchmark::CustomizeEnginePostLoad()
+{
+    m_impl = std::make_unique<Implementation>();
+
+    {
+        GameConfiguration* configuration = GameConfiguration::Get();
+        GUARD_LOCK_OTHER(configuration);
+        NamedVars* vars = configuration->AccessVariables(guard);
+
+        int seed = 0;
+        vars->GetValueAndConvertTo<int>("BenchmarkSeed", seed);
+        m_impl->m_seed = static_cast<uint32_t>(seed);
+
+        vars->GetValueAndConvertTo<int>(
+            "BenchmarkMicrobes", m_impl->m_microbes);
+        vars->GetValueAndConvertTo<int>("BenchmarkClouds", m_impl->m_clouds);
+        vars->GetValueAndConvertTo<int>("BenchmarkChunks", m_impl->m_chunks);
+        vars->GetValueAndConvertTo<int>("BenchmarkTicks", m_impl->m_ticks);
+        vars->GetValueAndConvertTo<std::string>(
+            "BenchmarkResultsFile", m_impl->m_resultsFile);
+        vars->GetValueAndConvertTo<std::string>(
+            "BenchmarkReplayFile", m_impl->m_replayFile);
+    }
+
+    if(!m_impl->m_replayFile.empty()) {
+
+        std::ifstream file(m_impl->m_replayFile);
+
+        if(!file.good()) {
+            LOG_ERROR("ThriveBenchmark: can't read the replay file: " +
+                      m_impl->m_replayFile);
+            MarkAsClosing();
+            return;
+        }
+
+        std::stringstream recording;
+        recording << file.rdbuf();
+
+        try {
+            m_impl->m_replay = std::make_unique<InputReplay>(recording.str());
+        } catch(const Leviathan::InvalidArgument& e) {
+            LOG_ERROR("ThriveBenchmark: invalid replay file: " +
+                      m_impl->m_replayFile + ", exception: ");
+            e.PrintToLog();
+            MarkAsClosing();
+            return;
+        }
+
+        // The recorded session was played with this seed
+        m_impl->m_seed = m_impl->m_replay->getSeed();
+    }
+
+    // Seeded before the scripts are loaded as the setup may already use
+    // random numbers
+    m_impl->m_random.seed(m_impl->m_seed);
+    Leviathan::Random::Get()->SetSeed(m_impl->m_seed);
+
+    if(!loadScriptsAndConfigs()) {
+
+        LOG_ERROR("Failed to load init data, quitting");
+        MarkAsClosing();
+        return;
+    }
+
+    if(!scriptSetup()) {
+
+        LOG_ERROR("ThriveBenchmark: failed to run setup script functions");
+        MarkAsClosing();
+        return;
+    }
+
+    if(!_createWorld() ||
+        !(m_impl->m_replay ? _spawnReplayPlayer() : _spawnScenario())) {
+        MarkAsClosing();
+        return;
+    }
+
+    if(m_impl->m_replay) {
+        LOG_INFO("ThriveBenchmark: replaying " +
+                 std::to_string(m_impl->m_replay->getTickCount()) +
+                 " ticks from " + m_impl->m_replayFile);
+    } else {
+        LOG_INFO("ThriveBenchmark: running " +
+                 std::to_string(m_impl->m_ticks) + " ticks");
+    }
+
+    _runTicks();
+    _report(_calculateChecksum());
+
+    MarkAsClosing();
+}
+// ------------------------------------ //
+void
+    ThriveBenchmark::EnginePreShutdown()
+{
+    releaseScripts();
+
+    if(m_impl && m_impl->m_cellStage)
+        m_impl->m_cellStage->Release();
+
+    Leviathan::ScriptExecutor::Get()->CollectGarbage();
+
+    m_impl.reset();
+
+    LOG_INFO("ThriveBenchmark EnginePreShutdown ran");
+}
+// ------------------------------------ //
+void
+    ThriveBenchmark::CheckGameConfigurationVariables(Lock& guard,
+        GameConfiguration* configobj)
+{
+    NamedVars* vars = configobj->AccessVariables(guard);
+
+    const auto addInt = [&](const std::string& name, int value) {
+        if(vars->ShouldAddValueIfNotFoundOrWrongType<int>(name)) {
+            vars->AddVar(name, new VariableBlock(value));
+            configobj->MarkModified(guard);
+        }
+    };
+
+    addInt("BenchmarkSeed", 1);
+    addInt("BenchmarkMicrobes", 50);
+    addInt("BenchmarkClouds", 100);
+    addInt("BenchmarkChunks", 20);
+    addInt("BenchmarkTicks", 1000);
+
+    // Empty to only print the results
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "BenchmarkResultsFile")) {
+        vars->AddVar(
+            "BenchmarkResultsFile", new VariableBlock(std::string("")));
+        configobj->MarkModified(guard);
+    }
+
+    // A file written by the game with InputRecordingFile. Empty to run the
+    // scenario
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "BenchmarkReplayFile")) {
+        vars->AddVar(
+            "BenchmarkReplayFile", new VariableBlock(std::string("")));
+        configobj->MarkModified(guard);
+    }
+}
+
+void
+    ThriveBenchmark::CheckGameKeyConfigVariables(Lock& guard,
+        KeyConfiguration* keyconfigobj)
+{}
+// ------------------------------------ //
+bool
+    ThriveBenchmark::InitLoadCustomScriptTypes(asIScriptEngine* engine)
+{
+    return registerThriveScriptTypes(engine);
+}
@@ -0,0 +1,100 @@
+// Thrive Game
+// Copyright (C) 2013-2019  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+//! \file \note This file needs to be named like it is currently
+#include "thrive_common.h"
+
+#include "Application/ServerApplication.h"
+
+namespace thrive {
+
+/**
+ * @brief Headless program that runs a fixed cell stage scenario and reports
+ * how long the systems took
+ *
+ * The world is created without a window like on the server so this runs on a
+ * machine without a GPU. The random generators are seeded from the
+ * configuration so that two runs with the same settings simulate the same
+ * thing and end up with the same checksum.
+ *
+ * When BenchmarkReplayFile is set a player cell is spawned instead of the
+ * scenario and it is controlled by the input recorded by ThriveGame.
+ */
+class ThriveBenchmark : public Leviathan::ServerApplication,
+                        public ThriveCommon {
+    class Implementation;
+
+public:
+    ThriveBenchmark();
+    virtual ~ThriveBenchmark();
+
+    // ------------------------------------ //
+    // Hooking into the engine, and overridden methods from base application
+    // etc.
+
+    void
+        CustomizeEnginePostLoad() override;
+
+    void
+        EnginePreShutdown() override;
+
+    static std::string
+        GenerateWindowTitle();
+
+    // Game configuration checkers //
+    static void
+        CheckGameConfigurationVariables(Lock& guard,
+            GameConfiguration* configobj);
+    static void
+        CheckGameKeyConfigVariables(Lock& guard,
+            KeyConfiguration* keyconfigobj);
+
+    static ThriveBenchmark*
+        get();
+
+    bool
+        InitLoadCustomScriptTypes(asIScriptEngine* engine) override;
+
+private:
+    //! \brief Creates the world in the same way as the server, or for a
+    //! replay with the simulation setup of the single player game
+    bool
+        _createWorld();
+
+    //! \brief Spawns the microbes, clouds and chunks of the scenario
+    bool
+        _spawnScenario();
+
+    //! \brief Spawns the player cell for the replay like the game does
+    bool
+        _spawnReplayPlayer();
+
+    //! \brief Runs the configured number of ticks or until the replay ends
+    void
+        _runTicks();
+
+    //! \brief Hashes the positions of the spawned entities that still exist
+    //! and the cloud contents
+    uint64_t
+        _calculateChecksum() const;
+
+    //! \brief Prints the results and writes them to the results file
+    void
+        _report(uint64_t checksum);
+
+protected:
+    Leviathan::NetworkInterface*
+        _GetApplicationPacketHandler() override;
+    void
+        _ShutdownApplicationPacketHandler() override;
+
+private:
+    std::unique_ptr<Leviathan::NetworkInterface> m_network;
+
+    std::unique_ptr<Implementation> m_impl;
+
+    static ThriveBenchmark* staticInstance;
+};
+
+} // namespace thrive
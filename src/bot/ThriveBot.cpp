@@ -0,0 +1,445 @@
+// ------------------------------------ //
+#include "ThriveBot.h"
+
+#include "bot/bot_input_script.h"
+#include "bot/bot_metrics.h"
+
+#include "generated/cell_stage_world.h"
+#include "microbe_stage/simulation_parameters.h"
+#include "scripting/script_initializer.h"
+#include "thrive_packets.h"
+#include "thrive_version.h"
+#include "thrive_world_factory.h"
+
+#include <Application/GameConfiguration.h>
+#include <Networking/NetworkHandler.h>
+#include <Script/ScriptExecutor.h>
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+//! How often the metrics are reported, in seconds
+constexpr auto BOT_REPORT_INTERVAL = 10.f;
+
+//! How far ahead of the cell the bot looks when moving
+constexpr auto BOT_LOOK_DISTANCE = 10.f;
+
+//! Contains properties that would need unnecessary large includes in the header
+class ThriveBot::Implementation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! \returns Milliseconds since the connection was opened
+    float
+        millisecondsSinceConnect() const
+    {
+        return std::chrono::duration<float, std::milli>(
+            Clock::now() - m_connectStarted)
+            .count();
+    }
+
+    BotMetrics m_metrics;
+
+    std::unique_ptr<BotInputScript> m_script;
+
+    std::string m_metricsFile;
+
+    std::shared_ptr<CellStageWorld> m_cellStage;
+    ObjectID m_controlledEntity = NULL_OBJECT;
+
+    Clock::time_point m_connectStarted;
+
+    //! Entities received since the last report
+    int m_receivedEntities = 0;
+
+    float m_timeSinceReport = 0;
+};
+// ------------------------------------ //
+ThriveBot::ThriveBot()
+{
+    staticInstance = this;
+}
+
+ThriveBot::~ThriveBot()
+{
+    staticInstance = nullptr;
+}
+
+std::string
+    ThriveBot::GenerateWindowTitle()
+{
+    return "Thrive Bot " GAME_VERSIONS;
+}
+
+ThriveBot*
+    ThriveBot::get()
+{
+    return staticInstance;
+}
+
+ThriveBot* ThriveBot::staticInstance = nullptr;
+
+Leviathan::NetworkInterface*
+    ThriveBot::_GetApplicationPacketHandler()
+{
+    if(!m_network)
+        m_network = std::make_unique<ThriveBotNetHandler>();
+    return m_network.get();
+}
+
+void
+    ThriveBot::_ShutdownApplicationPacketHandler()
+{
+    m_network.reset();
+}
+// ------------------------------------ //
+void
+    ThriveBot::connectToServer(const std::string& address)
+{
+    LOG_INFO("ThriveBot: connecting to server at: " + address);
+
+    auto connection = m_network->GetOwner()->OpenConnectionTo(address);
+
+    if(!connection) {
+        LOG_ERROR("ThriveBot: invalid server address: " + address);
+        MarkAsClosing();
+        return;
+    }
+
+    m_impl->m_connectStarted = Implementation::Clock::now();
+
+    if(!m_network->JoinServer(connection)) {
+        LOG_ERROR("ThriveBot: failed to start joining the server");
+        MarkAsClosing();
+        return;
+    }
+}
+
+void
+    ThriveBot::reportJoinedServerWorld(std::shared_ptr<GameWorld> world)
+{
+    LEVIATHAN_ASSERT(
+        world->GetType() == static_cast<int>(THRIVE_WORLD_TYPE::CELL_STAGE),
+        "unexpected world type");
+
+    if(m_impl->m_cellStage) {
+        LOG_ERROR("ThriveBot: joined a world twice, ignoring");
+        return;
+    }
+
+    m_impl->m_metrics.addSample(
+        "join_ms", m_impl->millisecondsSinceConnect());
+
+    m_impl->m_cellStage = std::dynamic_pointer_cast<CellStageWorld>(world);
+
+    // Clouds are registered like on the client so that the server's cloud
+    // updates can be applied
+    std::vector<Compound> clouds;
+
+    for(size_t i = 0; i < SimulationParameters::compoundRegistry.getSize();
+        ++i) {
+
+        const auto& data =
+            SimulationParameters::compoundRegistry.getTypeData(i);
+
+        if(!data.isCloud)
+            continue;
+
+        clouds.push_back(data);
+    }
+
+    m_impl->m_cellStage->GetCompoundCloudSystem().registerCloudTypes(
+        *m_impl->m_cellStage, clouds);
+
+    LEVIATHAN_ASSERT(getMicrobeScripts(), "microbe scripts not loaded");
+
+    ScriptRunningSetup setup("setupScriptsForWorld_Bot");
+
+    auto result = getMicrobeScripts()->ExecuteOnModule<void>(
+        setup, false, m_impl->m_cellStage.get());
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+        LOG_ERROR(
+            "Failed to run script setup function: " + setup.Entryfunction);
+        MarkAsClosing();
+        return;
+    }
+
+    LOG_INFO("ThriveBot: joined the server world");
+}
+
+void
+    ThriveBot::reportLocalControlChanged(GameWorld* world)
+{
+    const auto& control = m_impl->m_cellStage->GetOurLocalControl();
+
+    const bool hadControl = m_impl->m_controlledEntity != NULL_OBJECT;
+
+    m_impl->m_controlledEntity =
+        control.empty() ? NULL_OBJECT : control.front();
+
+    if(!hadControl && m_impl->m_controlledEntity != NULL_OBJECT)
+        m_impl->m_metrics.addSample(
+            "control_ms", m_impl->millisecondsSinceConnect());
+
+    LOG_INFO("ThriveBot: controlled entity is now: " +
+             std::to_string(m_impl->m_controlledEntity));
+}
+
+void
+    ThriveBot::reportEntityReceived(ObjectID id)
+{
+    ++m_impl->m_receivedEntities;
+
+    try {
+        m_impl->m_cellStage->GetComponent_MembraneComponent(id);
+    } catch(const Leviathan::NotFound&) {
+        return;
+    }
+
+    ScriptRunningSetup setup("setupClientSideReceivedCell");
+
+    auto result = getMicrobeScripts()->ExecuteOnModule<void>(
+        setup, false, m_impl->m_cellStage.get(), id);
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success)
+        LOG_ERROR("ThriveBot: failed to run setupClientSideReceivedCell");
+}
+
+void
+    ThriveBot::reportDisconnected(const std::string& reason, bool donebyus)
+{
+    LOG_INFO("ThriveBot: disconnected from server: " + reason);
+
+    if(!donebyus)
+        MarkAsClosing();
+}
+
+const BotMetrics&
+    ThriveBot::getMetrics() const
+{
+    return m_impl->m_metrics;
+}
+// ------------------------------------ //
+void
+    ThriveBot::Tick(float elapsed)
+{
+    if(!m_impl || !m_impl->m_cellStage)
+        return;
+
+    const auto start = Implementation::Clock::now();
+
+    _applyInput(elapsed);
+
+    m_impl->m_metrics.addSample("input_ms",
+        std::chrono::duration<float, std::milli>(
+            Implementation::Clock::now() - start)
+            .count());
+    m_impl->m_metrics.addSample("frame_ms", elapsed * 1000);
+
+    m_impl->m_timeSinceReport += elapsed;
+
+    if(m_impl->m_timeSinceReport >= BOT_REPORT_INTERVAL)
+        _report();
+}
+
+void
+    ThriveBot::_applyInput(float elapsed)
+{
+    const ObjectID entity = m_impl->m_controlledEntity;
+
+    if(entity == NULL_OBJECT)
+        return;
+
+    const auto* position =
+        m_impl->m_cellStage->GetComponentPtr_Position(entity);
+
+    // Not received yet or the cell died
+    if(!position)
+        return;
+
+    const auto input = m_impl->m_script->update(elapsed);
+
+    auto module = getMicrobeScripts();
+    CellStageWorld* world = m_impl->m_cellStage.get();
+
+    const Float3 lookPoint =
+        position->Members._Position + input.movement * BOT_LOOK_DISTANCE;
+
+    ScriptRunningSetup setup("applyCellMovementControl");
+    auto result = module->ExecuteOnModule<void>(
+        setup, false, world, entity, input.movement, lookPoint);
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success)
+        LOG_WARNING("ThriveBot: failed to run applyCellMovementControl");
+
+    if(input.toggleEngulf) {
+
+        ScriptRunningSetup setup("applyEngulfMode");
+        auto result =
+            module->ExecuteOnModule<void>(setup, false, world, entity);
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success)
+            LOG_WARNING("ThriveBot: failed to run applyEngulfMode");
+    }
+
+    if(input.fireToxin) {
+
+        ScriptRunningSetup setup("playerShootToxin");
+        auto result =
+            module->ExecuteOnModule<void>(setup, false, world, entity);
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success)
+            LOG_WARNING("ThriveBot: failed to run playerShootToxin");
+    }
+}
+
+void
+    ThriveBot::_report()
+{
+    m_impl->m_metrics.addSample("entities_received_per_s",
+        m_impl->m_receivedEntities / m_impl->m_timeSinceReport);
+
+    m_impl->m_receivedEntities = 0;
+    m_impl->m_timeSinceReport = 0;
+
+    const auto report = m_impl->m_metrics.formatReport();
+
+    LOG_INFO("ThriveBot: metrics:\n" + report);
+
+    if(m_impl->m_metricsFile.empty())
+        return;
+
+    std::ofstream file(m_impl->m_metricsFile);
+
+    if(!file.good()) {
+        LOG_ERROR("ThriveBot: can't write metrics to: " +
+                  m_impl->m_metricsFile);
+        return;
+    }
+
+    file << report;
+}
+// ------------------------------------ //
+void
+    ThriveBot::CustomizeEnginePostLoad()
+{
+    m_impl = std::make_unique<Implementation>();
+
+    if(!loadScriptsAndConfigs()) {
+
+        LOG_ERROR("Failed to load init data, quitting");
+        MarkAsClosing();
+        return;
+    }
+
+    if(!scriptSetup()) {
+
+        LOG_ERROR("ThriveBot: failed to run setup script functions");
+        MarkAsClosing();
+        return;
+    }
+
+    // The server sends data in these
+    registerThrivePackets();
+
+    std::string address;
+    std::string scriptFile;
+
+    {
+        GameConfiguration* configuration = GameConfiguration::Get();
+        GUARD_LOCK_OTHER(configuration);
+        NamedVars* vars = configuration->AccessVariables(guard);
+
+        vars->GetValueAndConvertTo<std::string>("BotServerAddress", address);
+        vars->GetValueAndConvertTo<std::string>("BotScript", scriptFile);
+        vars->GetValueAndConvertTo<std::string>(
+            "BotMetricsFile", m_impl->m_metricsFile);
+    }
+
+    std::ifstream file(scriptFile);
+
+    if(!file.good()) {
+        LOG_ERROR("ThriveBot: can't read bot script: " + scriptFile);
+        MarkAsClosing();
+        return;
+    }
+
+    std::stringstream script;
+    script << file.rdbuf();
+
+    try {
+        // Bots started at the same time shouldn't wander the same way
+        m_impl->m_script = std::make_unique<BotInputScript>(
+            script.str(), std::random_device{}());
+    } catch(const Leviathan::InvalidArgument& e) {
+
+        LOG_ERROR("ThriveBot: invalid bot script: " + scriptFile);
+        e.PrintToLog();
+        MarkAsClosing();
+        return;
+    }
+
+    connectToServer(address);
+}
+// ------------------------------------ //
+void
+    ThriveBot::EnginePreShutdown()
+{
+    if(m_impl && m_impl->m_timeSinceReport > 0)
+        _report();
+
+    releaseScripts();
+
+    if(m_impl && m_impl->m_cellStage)
+        m_impl->m_cellStage->Release();
+
+    Leviathan::ScriptExecutor::Get()->CollectGarbage();
+
+    m_impl.reset();
+
+    LOG_INFO("ThriveBot EnginePreShutdown ran");
+}
+// ------------------------------------ //
+void
+    ThriveBot::CheckGameConfigurationVariables(Lock& guard,
+        GameConfiguration* configobj)
+{
+    NamedVars* vars = configobj->AccessVariables(guard);
+
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "BotServerAddress")) {
+        vars->AddVar("BotServerAddress",
+            new VariableBlock(std::string("localhost:53226")));
+        configobj->MarkModified(guard);
+    }
+
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>("BotScript")) {
+        vars->AddVar("BotScript", new VariableBlock(std::string(
+                                      "Data/Scripts/bot/default_bot.txt")));
+        configobj->MarkModified(guard);
+    }
+
+    // Empty to only print the metrics
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "BotMetricsFile")) {
+        vars->AddVar("BotMetricsFile", new VariableBlock(std::string("")));
+        configobj->MarkModified(guard);
+    }
+}
+
+void
+    ThriveBot::CheckGameKeyConfigVariables(Lock& guard,
+        KeyConfiguration* keyconfigobj)
+{}
+// ------------------------------------ //
+bool
+    ThriveBot::InitLoadCustomScriptTypes(asIScriptEngine* engine)
+{
+    return registerThriveScriptTypes(engine);
+}
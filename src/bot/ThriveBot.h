@@ -0,0 +1,106 @@
+// Thrive Game
+// Copyright (C) 2013-2018  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+//! \file \note This file needs to be named like it is currently
+#include "thrive_bot_net_handler.h"
+#include "thrive_common.h"
+
+#include "Application/ServerApplication.h"
+
+namespace thrive {
+
+class BotMetrics;
+
+/**
+ * @brief Headless client that joins a server and plays with scripted input
+ *
+ * Used to put load on a ThriveServer for benchmarking it. Nothing is rendered
+ * so this runs without a GPU. Each bot process is one player as the engine
+ * handles a single server connection per client, run many of them to
+ * simulate more players.
+ *
+ * The network bandwidth and latency aren't measured as the engine doesn't
+ * expose them, see doc/load_testing.md
+ */
+class ThriveBot : public Leviathan::ServerApplication, public ThriveCommon {
+    class Implementation;
+
+public:
+    ThriveBot();
+    virtual ~ThriveBot();
+
+    // ------------------------------------ //
+    // Bot methods
+    void
+        connectToServer(const std::string& address);
+
+    void
+        reportJoinedServerWorld(std::shared_ptr<GameWorld> world);
+
+    void
+        reportLocalControlChanged(GameWorld* world);
+
+    void
+        reportEntityReceived(ObjectID id);
+
+    void
+        reportDisconnected(const std::string& reason, bool donebyus);
+
+    const BotMetrics&
+        getMetrics() const;
+
+    // ------------------------------------ //
+    // Hooking into the engine, and overridden methods from base application
+    // etc.
+
+    void
+        Tick(float elapsed) override;
+
+    void
+        CustomizeEnginePostLoad() override;
+
+    void
+        EnginePreShutdown() override;
+
+    static std::string
+        GenerateWindowTitle();
+
+    // Game configuration checkers //
+    static void
+        CheckGameConfigurationVariables(Lock& guard,
+            GameConfiguration* configobj);
+    static void
+        CheckGameKeyConfigVariables(Lock& guard,
+            KeyConfiguration* keyconfigobj);
+
+    static ThriveBot*
+        get();
+
+    bool
+        InitLoadCustomScriptTypes(asIScriptEngine* engine) override;
+
+private:
+    //! \brief Sends the scripted input for the controlled cell
+    void
+        _applyInput(float elapsed);
+
+    //! \brief Prints the metrics and writes them to the metrics file
+    void
+        _report();
+
+protected:
+    Leviathan::NetworkInterface*
+        _GetApplicationPacketHandler() override;
+    void
+        _ShutdownApplicationPacketHandler() override;
+
+private:
+    std::unique_ptr<ThriveBotNetHandler> m_network;
+
+    std::unique_ptr<Implementation> m_impl;
+
+    static ThriveBot* staticInstance;
+};
+
+} // namespace thrive
@@ -0,0 +1,174 @@
+// ------------------------------------ //
+#include "bot_input_script.h"
+
+#include <Exceptions.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+//! How often wander picks a new direction, in seconds
+constexpr auto WANDER_TURN_INTERVAL = 1.5f;
+
+namespace {
+
+float
+    readDuration(std::istringstream& stream, size_t line)
+{
+    float duration = 0;
+
+    if(!(stream >> duration) || !(duration > 0))
+        throw Leviathan::InvalidArgument(
+            "bot script line " + std::to_string(line) +
+            ": expected a positive duration in seconds");
+
+    return duration;
+}
+
+} // namespace
+// ------------------------------------ //
+BotInputScript::BotInputScript(const std::string& script, uint32_t seed) :
+    m_random(seed)
+{
+    std::istringstream lines(script);
+    std::string line;
+    size_t lineNumber = 0;
+    bool takesTime = false;
+
+    while(std::getline(lines, line)) {
+
+        ++lineNumber;
+
+        std::istringstream stream(line);
+        std::string command;
+
+        if(!(stream >> command) || command[0] == '#')
+            continue;
+
+        Action action;
+
+        if(command == "move") {
+
+            float x = 0;
+            float z = 0;
+
+            if(!(stream >> x >> z) || (x == 0 && z == 0))
+                throw Leviathan::InvalidArgument(
+                    "bot script line " + std::to_string(lineNumber) +
+                    ": move needs a non-zero direction");
+
+            action.type = ACTION::MOVE;
+            action.direction = Float3(x, 0, z).Normalize();
+            action.duration = readDuration(stream, lineNumber);
+
+        } else if(command == "wander") {
+
+            action.type = ACTION::WANDER;
+            action.duration = readDuration(stream, lineNumber);
+
+        } else if(command == "wait") {
+
+            action.type = ACTION::WAIT;
+            action.duration = readDuration(stream, lineNumber);
+
+        } else if(command == "engulf") {
+
+            action.type = ACTION::ENGULF;
+
+        } else if(command == "toxin") {
+
+            action.type = ACTION::TOXIN;
+
+        } else {
+            throw Leviathan::InvalidArgument("bot script line " +
+                                             std::to_string(lineNumber) +
+                                             ": unknown action: " + command);
+        }
+
+        takesTime = takesTime || action.duration > 0;
+        m_actions.push_back(action);
+    }
+
+    // Otherwise update would never stop looping
+    if(!takesTime)
+        throw Leviathan::InvalidArgument(
+            "bot script needs at least one action that takes time");
+
+    m_wanderDirection = _randomDirection();
+}
+// ------------------------------------ //
+BotInput
+    BotInputScript::update(float elapsed)
+{
+    BotInput input;
+
+    float left = elapsed;
+
+    // Each instant action can happen only once per update
+    size_t instantActions = 0;
+
+    while(instantActions <= m_actions.size()) {
+
+        const auto& action = m_actions[m_current];
+
+        if(action.type == ACTION::ENGULF || action.type == ACTION::TOXIN) {
+
+            if(action.type == ACTION::ENGULF) {
+                input.toggleEngulf = !input.toggleEngulf;
+            } else {
+                input.fireToxin = true;
+            }
+
+            ++instantActions;
+            _advance();
+            continue;
+        }
+
+        const float remaining = action.duration - m_actionTime;
+
+        if(left < remaining) {
+            m_actionTime += left;
+            break;
+        }
+
+        left -= remaining;
+        _advance();
+    }
+
+    const auto& current = m_actions[m_current];
+
+    switch(current.type) {
+    case ACTION::MOVE: input.movement = current.direction; break;
+    case ACTION::WANDER: {
+
+        m_wanderTimer -= elapsed;
+
+        if(m_wanderTimer <= 0) {
+            m_wanderDirection = _randomDirection();
+            m_wanderTimer = WANDER_TURN_INTERVAL;
+        }
+
+        input.movement = m_wanderDirection;
+        break;
+    }
+    default: break;
+    }
+
+    return input;
+}
+// ------------------------------------ //
+void
+    BotInputScript::_advance()
+{
+    m_current = (m_current + 1) % m_actions.size();
+    m_actionTime = 0;
+}
+
+Float3
+    BotInputScript::_randomDirection()
+{
+    std::uniform_real_distribution<float> angle(0, 2 * Leviathan::PI);
+    const float value = angle(m_random);
+    return Float3(std::cos(value), 0, std::sin(value));
+}
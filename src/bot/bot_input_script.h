@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Common/Types.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace thrive {
+
+//! \brief What a bot does during one tick
+struct BotInput {
+    //! Movement direction on the XZ plane, zero or unit length
+    Float3 movement = Float3(0, 0, 0);
+
+    bool toggleEngulf = false;
+    bool fireToxin = false;
+};
+
+/**
+ * @brief Plays back a scripted list of player actions for ThriveBot
+ *
+ * The script is a text file with one action per line. Empty lines and lines
+ * starting with # are ignored. The script loops once the end is reached.
+ * \code
+ * move <x> <z> <seconds>    # Moves towards the direction
+ * wander <seconds>          # Moves in a random direction that changes
+ * wait <seconds>            # Stops moving
+ * engulf                    # Toggles engulf mode
+ * toxin                     # Fires a toxin
+ * \endcode
+ */
+class BotInputScript {
+public:
+    //! \param seed For the random directions of wander. Bots running the
+    //! same script should use different seeds
+    //! \exception Leviathan::InvalidArgument if the script is invalid or has
+    //! no actions taking time
+    BotInputScript(const std::string& script, uint32_t seed);
+
+    //! \brief Advances the script
+    //! \returns The input for this tick. Actions that were passed during
+    //! elapsed are combined
+    BotInput
+        update(float elapsed);
+
+    size_t
+        getActionCount() const
+    {
+        return m_actions.size();
+    }
+
+private:
+    enum class ACTION { MOVE, WANDER, WAIT, ENGULF, TOXIN };
+
+    struct Action {
+        ACTION type;
+        Float3 direction = Float3(0, 0, 0);
+        float duration = 0;
+    };
+
+    //! \brief Goes to the next action
+    void
+        _advance();
+
+    Float3
+        _randomDirection();
+
+private:
+    std::vector<Action> m_actions;
+    size_t m_current = 0;
+
+    //! Time spent in the current action
+    float m_actionTime = 0;
+
+    std::mt19937 m_random;
+    Float3 m_wanderDirection = Float3(0, 0, 0);
+    float m_wanderTimer = 0;
+};
+
+} // namespace thrive
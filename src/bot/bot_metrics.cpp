@@ -0,0 +1,86 @@
+// ------------------------------------ //
+#include "bot_metrics.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+BotMetrics::BotMetrics(size_t windowSize) : m_windowSize(windowSize)
+{
+    if(windowSize == 0)
+        throw Leviathan::InvalidArgument("window size must be at least 1");
+}
+// ------------------------------------ //
+void
+    BotMetrics::addSample(const std::string& series, float value)
+{
+    auto& target = m_series[series];
+
+    if(target.samples.size() < m_windowSize) {
+        target.samples.push_back(value);
+        return;
+    }
+
+    // Full, replace the oldest
+    target.samples[target.next] = value;
+    target.next = (target.next + 1) % m_windowSize;
+}
+// ------------------------------------ //
+BotMetrics::Summary
+    BotMetrics::getSummary(const std::string& series) const
+{
+    const auto found = m_series.find(series);
+
+    if(found == m_series.end() || found->second.samples.empty())
+        throw Leviathan::NotFound("no bot metrics samples for: " + series);
+
+    auto samples = found->second.samples;
+
+    Summary summary;
+    summary.count = samples.size();
+
+    const auto [min, max] = std::minmax_element(samples.begin(), samples.end());
+    summary.min = *min;
+    summary.max = *max;
+
+    double total = 0;
+
+    for(float sample : samples)
+        total += sample;
+
+    summary.average = static_cast<float>(total / samples.size());
+
+    // Nearest rank percentile. Only that element needs to be in its sorted
+    // place
+    const auto rank =
+        static_cast<size_t>(std::ceil(0.95 * samples.size())) - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    summary.p95 = samples[rank];
+
+    return summary;
+}
+// ------------------------------------ //
+std::string
+    BotMetrics::formatReport() const
+{
+    std::stringstream report;
+
+    for(const auto& [name, series] : m_series) {
+
+        if(series.samples.empty())
+            continue;
+
+        const auto summary = getSummary(name);
+
+        report << name << ": count: " << summary.count
+               << ", min: " << summary.min << ", avg: " << summary.average
+               << ", p95: " << summary.p95 << ", max: " << summary.max
+               << "\n";
+    }
+
+    return report.str();
+}
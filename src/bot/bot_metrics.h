@@ -0,0 +1,76 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace thrive {
+
+//! How many of the latest samples of each series BotMetrics keeps by default
+constexpr size_t BOT_METRICS_DEFAULT_WINDOW = 4096;
+
+/**
+ * @brief Collects measurements of ThriveBot for reporting them
+ *
+ * Each measurement belongs to a named series, for example the tick time. Only
+ * the latest samples of each series are kept so that a long running bot
+ * doesn't keep using more memory and the reports summarize the recent
+ * samples.
+ */
+class BotMetrics {
+public:
+    struct Summary {
+        size_t count = 0;
+        float min = 0;
+        float max = 0;
+        float average = 0;
+
+        //! 95th percentile
+        float p95 = 0;
+    };
+
+    //! \param windowSize How many of the latest samples of each series are
+    //! kept
+    //! \exception Leviathan::InvalidArgument if windowSize is 0
+    BotMetrics(size_t windowSize = BOT_METRICS_DEFAULT_WINDOW);
+
+    void
+        addSample(const std::string& series, float value);
+
+    //! \brief Summarizes the samples in the window of series
+    //! \exception Leviathan::NotFound if series has no samples
+    Summary
+        getSummary(const std::string& series) const;
+
+    bool
+        hasSeries(const std::string& series) const
+    {
+        return m_series.find(series) != m_series.end();
+    }
+
+    //! \returns A line for each series with the summary of it
+    std::string
+        formatReport() const;
+
+    void
+        clear()
+    {
+        m_series.clear();
+    }
+
+private:
+    //! \brief Ring buffer of the latest samples
+    struct Series {
+        std::vector<float> samples;
+
+        //! The index the next sample is written to once the window is full
+        size_t next = 0;
+    };
+
+    size_t m_windowSize;
+
+    //! Sorted by name to keep the report order stable
+    std::map<std::string, Series> m_series;
+};
+
+} // namespace thrive
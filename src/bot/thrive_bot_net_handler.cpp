@@ -0,0 +1,88 @@
+// ------------------------------------ //
+#include "thrive_bot_net_handler.h"
+
+#include "ThriveBot.h"
+#include "engine/replication.h"
+#include "thrive_packets.h"
+
+#include <Networking/NetworkResponse.h>
+#include <Physics/PhysicsMaterialManager.h>
+
+using namespace thrive;
+// ------------------------------------ //
+ThriveBotNetHandler::ThriveBotNetHandler() : NetworkClientInterface() {}
+
+ThriveBotNetHandler::~ThriveBotNetHandler() {}
+// ------------------------------------ //
+void
+    ThriveBotNetHandler::_OnProperlyConnected()
+{
+    DoJoinDefaultWorld();
+}
+
+void
+    ThriveBotNetHandler::HandleResponseOnlyPacket(
+        std::shared_ptr<Leviathan::NetworkResponse> message,
+        Leviathan::Connection& connection)
+{
+    const auto* packet = getThrivePacket(*message);
+
+    if(packet) {
+
+        // Bots don't show the entities but acknowledge them like a player so
+        // that the server sends them deltas
+        if(packet->getType() == THRIVE_PACKET_TYPE::ENTITY_STATES) {
+            try {
+                sendEntityStatesAck(connection,
+                    EntityStateBaselines::getMessageSequence(
+                        packet->getData()));
+            } catch(const Leviathan::InvalidArgument&) {
+                LOG_WARNING("ThriveBot: received invalid entity states");
+            }
+        }
+
+        return;
+    }
+
+    NetworkClientInterface::HandleResponseOnlyPacket(message, connection);
+}
+// ------------------------------------ //
+void
+    ThriveBotNetHandler::_OnNewConnectionStatusMessage(
+        const std::string& message)
+{
+    LOG_INFO("ThriveBot: connection status: " + message);
+}
+
+void
+    ThriveBotNetHandler::_OnDisconnectFromServer(
+        const std::string& reasonstring,
+        bool donebyus)
+{
+    ThriveBot::get()->reportDisconnected(reasonstring, donebyus);
+}
+// ------------------------------------ //
+std::shared_ptr<Leviathan::PhysicsMaterialManager>
+    ThriveBotNetHandler::GetPhysicsMaterialsForReceivedWorld(int32_t worldtype,
+        const std::string& extraoptions)
+{
+    return ThriveBot::get()->createPhysicsMaterials();
+}
+
+void
+    ThriveBotNetHandler::_OnWorldJoined(std::shared_ptr<GameWorld> world)
+{
+    ThriveBot::get()->reportJoinedServerWorld(world);
+}
+
+void
+    ThriveBotNetHandler::_OnLocalControlChanged(GameWorld* world)
+{
+    ThriveBot::get()->reportLocalControlChanged(world);
+}
+
+void
+    ThriveBotNetHandler::_OnEntityReceived(GameWorld* world, ObjectID created)
+{
+    ThriveBot::get()->reportEntityReceived(created);
+}
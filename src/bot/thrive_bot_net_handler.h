@@ -0,0 +1,50 @@
+// Thrive Game
+// Copyright (C) 2013-2018  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+#include "Networking/NetworkClientInterface.h"
+#include "Networking/NetworkInterface.h"
+
+#include <string>
+
+namespace thrive {
+
+//! \brief NetworkClientInterface of ThriveBot. Passes everything to ThriveBot
+//! as there is no GUI to update
+class ThriveBotNetHandler : public Leviathan::NetworkClientInterface {
+public:
+    ThriveBotNetHandler();
+    virtual ~ThriveBotNetHandler();
+
+    void
+        _OnProperlyConnected() override;
+
+    //! \brief Drops the Thrive packets. The bot doesn't show the clouds or
+    //! the entity states, the states are only acknowledged
+    void
+        HandleResponseOnlyPacket(
+            std::shared_ptr<Leviathan::NetworkResponse> message,
+            Leviathan::Connection& connection) override;
+
+protected:
+    void
+        _OnNewConnectionStatusMessage(const std::string& message) override;
+
+    void
+        _OnDisconnectFromServer(const std::string& reasonstring,
+            bool donebyus) override;
+
+    std::shared_ptr<Leviathan::PhysicsMaterialManager>
+        GetPhysicsMaterialsForReceivedWorld(int32_t worldtype,
+            const std::string& extraoptions) override;
+
+    void
+        _OnWorldJoined(std::shared_ptr<GameWorld> world) override;
+
+    void
+        _OnLocalControlChanged(GameWorld* world) override;
+
+    void
+        _OnEntityReceived(GameWorld* world, ObjectID created) override;
+};
+} // namespace thrive
@@ -20,11 +20,11 @@ enum class THRIVE_COMPONENT : uint16_t {
     SPAWNED,
     ABSORBER,
     TIMED_LIFE,
-    PROPERTIES,
     COMPOUND_VENTER,
     ENGULFABLE,
     FLUID_EFFECT,
     DAMAGETOUCH,
+    MICROBE_STATS,
     // TODO: check is this needed for anything
     // INVALID
 };
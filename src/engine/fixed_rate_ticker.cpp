@@ -0,0 +1,88 @@
+// ------------------------------------ //
+#include "fixed_rate_ticker.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+
+using namespace thrive;
+// ------------------------------------ //
+FixedRateTicker::FixedRateTicker(float tickRate, int maxCatchUpTicks) :
+    m_maxCatchUpTicks(maxCatchUpTicks)
+{
+    if(maxCatchUpTicks < 1)
+        throw Leviathan::InvalidArgument("maxCatchUpTicks must be at least 1");
+
+    setTickRate(tickRate);
+}
+// ------------------------------------ //
+int
+    FixedRateTicker::update(const TickCallback& callback)
+{
+    return update(Clock::now(), callback);
+}
+
+int
+    FixedRateTicker::update(Clock::time_point now, const TickCallback& callback)
+{
+    if(!m_started) {
+        m_started = true;
+        m_nextTick = now;
+    }
+
+    const float elapsed = getTickInterval();
+    int ran = 0;
+
+    while(now >= m_nextTick) {
+
+        if(ran >= m_maxCatchUpTicks) {
+
+            // Give up on the ticks we are behind
+            const auto behind = (now - m_nextTick) / m_interval + 1;
+
+            m_stats.droppedTicks += behind;
+            m_nextTick += behind * m_interval;
+            break;
+        }
+
+        const auto start = Clock::now();
+
+        callback(elapsed);
+
+        const auto duration = Clock::now() - start;
+
+        ++m_stats.ticks;
+        m_stats.totalTickTime += duration;
+        m_stats.maxTickTime = std::max(
+            m_stats.maxTickTime,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+
+        if(duration > m_interval)
+            ++m_stats.overrunTicks;
+
+        m_nextTick += m_interval;
+        ++ran;
+    }
+
+    return ran;
+}
+// ------------------------------------ //
+FixedRateTicker::Clock::duration
+    FixedRateTicker::getTimeUntilNextTick(Clock::time_point now) const
+{
+    if(!m_started || now >= m_nextTick)
+        return Clock::duration(0);
+
+    return m_nextTick - now;
+}
+
+void
+    FixedRateTicker::setTickRate(float tickRate)
+{
+    if(tickRate <= 0)
+        throw Leviathan::InvalidArgument("tickRate must be positive");
+
+    m_tickRate = tickRate;
+    m_interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / tickRate));
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace thrive {
+
+//! \brief Statistics collected by FixedRateTicker
+struct TickerStats {
+    //! Ticks that were ran
+    uint64_t ticks = 0;
+
+    //! Ticks that took longer than the tick interval
+    uint64_t overrunTicks = 0;
+
+    //! Ticks that were skipped because the catch up limit was reached
+    uint64_t droppedTicks = 0;
+
+    std::chrono::nanoseconds totalTickTime = std::chrono::nanoseconds(0);
+    std::chrono::nanoseconds maxTickTime = std::chrono::nanoseconds(0);
+
+    //! \returns The average time a tick took in milliseconds
+    float
+        getAverageTickMilliseconds() const
+    {
+        if(ticks == 0)
+            return 0;
+
+        return std::chrono::duration<float, std::milli>(totalTickTime)
+                   .count() /
+               ticks;
+    }
+};
+
+/**
+ * @brief Runs a tick callback at a fixed rate independent of how often update
+ * is called
+ *
+ * If update is called late the missed ticks are ran to catch up, up to
+ * maxCatchUpTicks at once. Any ticks beyond that are dropped so that an
+ * overloaded server doesn't fall further and further behind.
+ */
+class FixedRateTicker {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TickCallback = std::function<void(float elapsed)>;
+
+    //! \param tickRate Ticks per second
+    //! \exception Leviathan::InvalidArgument if the values are not positive
+    FixedRateTicker(float tickRate, int maxCatchUpTicks);
+
+    //! \brief Runs all the ticks that are due
+    //! \returns The number of ticks that were ran
+    int
+        update(const TickCallback& callback);
+
+    //! \brief Version of update with a specific current time
+    int
+        update(Clock::time_point now, const TickCallback& callback);
+
+    //! \returns How long until the next tick is due
+    Clock::duration
+        getTimeUntilNextTick(Clock::time_point now) const;
+
+    //! \brief Changes the rate. The next tick is at the old time
+    void
+        setTickRate(float tickRate);
+
+    float
+        getTickRate() const
+    {
+        return m_tickRate;
+    }
+
+    //! \returns The time between ticks in seconds. This is the elapsed value
+    //! given to the callback
+    float
+        getTickInterval() const
+    {
+        return 1 / m_tickRate;
+    }
+
+    const TickerStats&
+        getStats() const
+    {
+        return m_stats;
+    }
+
+    void
+        resetStats()
+    {
+        m_stats = TickerStats();
+    }
+
+private:
+    float m_tickRate;
+    Clock::duration m_interval;
+    int m_maxCatchUpTicks;
+
+    bool m_started = false;
+    Clock::time_point m_nextTick;
+
+    TickerStats m_stats;
+};
+
+} // namespace thrive
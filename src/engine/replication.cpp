@@ -0,0 +1,513 @@
+// ------------------------------------ //
+#include "replication.h"
+
+#include "general/varint.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+using namespace thrive;
+// ------------------------------------ //
+//! How many unacknowledged states are kept per entity for each observer
+constexpr size_t MAX_PENDING_STATES = 32;
+
+//! Entities at the edge of the area of interest gain priority this much
+//! compared to the entities right next to the observer
+constexpr float EDGE_PRIORITY_FACTOR = 0.2f;
+
+//! Position and rotation
+constexpr size_t TRANSFORM_STATE_FLOATS = 7;
+
+constexpr uint8_t FULL_STATE = 0;
+constexpr uint8_t DELTA_STATE = 1;
+// ------------------------------------ //
+// SpatialHashGrid
+SpatialHashGrid::SpatialHashGrid(float cellSize) : m_cellSize(cellSize)
+{
+    if(cellSize <= 0)
+        throw Leviathan::InvalidArgument("cellSize must be positive");
+}
+
+void
+    SpatialHashGrid::clear()
+{
+    for(auto& [key, cell] : m_cells)
+        cell.clear();
+}
+
+void
+    SpatialHashGrid::insert(ObjectID entity, const Float3& position)
+{
+    m_cells[_cellKey(_cellCoordinate(position.X), _cellCoordinate(position.Z))]
+        .push_back(Entry{entity, position});
+}
+
+void
+    SpatialHashGrid::query(const Float3& center,
+        float radius,
+        std::vector<ObjectID>& result) const
+{
+    const float radiusSquared = radius * radius;
+
+    const auto minX = _cellCoordinate(center.X - radius);
+    const auto maxX = _cellCoordinate(center.X + radius);
+    const auto minZ = _cellCoordinate(center.Z - radius);
+    const auto maxZ = _cellCoordinate(center.Z + radius);
+
+    for(int32_t x = minX; x <= maxX; ++x) {
+        for(int32_t z = minZ; z <= maxZ; ++z) {
+
+            const auto cell = m_cells.find(_cellKey(x, z));
+
+            if(cell == m_cells.end())
+                continue;
+
+            for(const auto& entry : cell->second) {
+
+                const float dx = entry.position.X - center.X;
+                const float dz = entry.position.Z - center.Z;
+
+                if(dx * dx + dz * dz <= radiusSquared)
+                    result.push_back(entry.entity);
+            }
+        }
+    }
+}
+
+int32_t
+    SpatialHashGrid::_cellCoordinate(float value) const
+{
+    return static_cast<int32_t>(std::floor(value / m_cellSize));
+}
+
+uint64_t
+    SpatialHashGrid::_cellKey(int32_t x, int32_t z)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+           static_cast<uint32_t>(z);
+}
+// ------------------------------------ //
+// ReplicationInterestManager
+ReplicationInterestManager::ReplicationInterestManager(float cellSize) :
+    m_grid(cellSize)
+{}
+
+void
+    ReplicationInterestManager::setEntities(
+        const std::vector<ReplicatedEntity>& entities)
+{
+    m_grid.clear();
+    m_entities.clear();
+
+    for(const auto& entity : entities) {
+        m_entities[entity.entity] = entity;
+        m_grid.insert(entity.entity, entity.position);
+    }
+}
+
+void
+    ReplicationInterestManager::updateObserver(int32_t observer,
+        const Float3& position,
+        float interestRadius,
+        uint32_t byteBudget)
+{
+    auto& data = m_observers[observer];
+    data.position = position;
+    data.interestRadius = interestRadius;
+    data.byteBudget = byteBudget;
+}
+
+void
+    ReplicationInterestManager::removeObserver(int32_t observer)
+{
+    m_observers.erase(observer);
+}
+
+void
+    ReplicationInterestManager::selectUpdates(int32_t observer,
+        float elapsed,
+        std::vector<ObjectID>& selected,
+        std::vector<ObjectID>& left)
+{
+    const auto found = m_observers.find(observer);
+
+    if(found == m_observers.end())
+        throw Leviathan::NotFound("no observer with id");
+
+    Observer& data = found->second;
+    const auto updateNumber = ++data.updateNumber;
+
+    m_inRange.clear();
+    m_grid.query(data.position, data.interestRadius, m_inRange);
+
+    // Closer entities gain priority faster
+    for(ObjectID entity : m_inRange) {
+
+        const auto& replicated = m_entities[entity];
+
+        const float dx = replicated.position.X - data.position.X;
+        const float dz = replicated.position.Z - data.position.Z;
+        const float closeness =
+            data.interestRadius > 0 ?
+                1 - std::sqrt(dx * dx + dz * dz) / data.interestRadius :
+                1;
+
+        auto& interest = data.interests[entity];
+        interest.priority += replicated.priority * elapsed *
+                             (EDGE_PRIORITY_FACTOR +
+                                 (1 - EDGE_PRIORITY_FACTOR) * closeness);
+        interest.lastSeen = updateNumber;
+    }
+
+    m_candidates.clear();
+
+    for(auto iter = data.interests.begin(); iter != data.interests.end();) {
+
+        if(iter->second.lastSeen != updateNumber) {
+            left.push_back(iter->first);
+            iter = data.interests.erase(iter);
+            continue;
+        }
+
+        m_candidates.emplace_back(iter->second.priority, iter->first);
+        ++iter;
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(),
+        [](const auto& first, const auto& second) {
+            return std::get<0>(first) > std::get<0>(second);
+        });
+
+    uint32_t used = 0;
+
+    for(const auto& [priority, entity] : m_candidates) {
+
+        const auto size = m_entities[entity].updateSize;
+
+        // An entity larger than the whole budget is sent alone so that it
+        // isn't starved
+        if(used + size > data.byteBudget && !(used == 0 && selected.empty()))
+            continue;
+
+        used += size;
+        selected.push_back(entity);
+        data.interests[entity].priority = 0;
+    }
+}
+// ------------------------------------ //
+// EntityStateBaselines
+void
+    EntityStateBaselines::encode(int32_t observer,
+        ObjectID entity,
+        uint32_t sequence,
+        const std::string& state,
+        std::string& encoded)
+{
+    auto& data = m_observers[observer][entity];
+
+    encoded.clear();
+
+    if(data.hasBaseline) {
+
+        const std::string& baseline = data.baseline.state;
+
+        encoded.push_back(static_cast<char>(DELTA_STATE));
+        appendVarint(encoded, data.baseline.sequence);
+        appendVarint(encoded, state.size());
+
+        // Runs of unchanged bytes and runs of new bytes
+        size_t index = 0;
+
+        while(index < state.size()) {
+
+            const size_t sameStart = index;
+            while(index < state.size() && index < baseline.size() &&
+                  state[index] == baseline[index])
+                ++index;
+
+            const size_t changedStart = index;
+            while(index < state.size() &&
+                  (index >= baseline.size() || state[index] != baseline[index]))
+                ++index;
+
+            appendVarint(encoded, changedStart - sameStart);
+            appendVarint(encoded, index - changedStart);
+            encoded.append(state, changedStart, index - changedStart);
+        }
+
+        // Mostly changed states are cheaper to send whole
+        if(encoded.size() > state.size() + 1)
+            encoded.clear();
+    }
+
+    if(encoded.empty()) {
+        encoded.push_back(static_cast<char>(FULL_STATE));
+        encoded.append(state);
+    }
+
+    data.pending.push_back(SentState{sequence, state});
+
+    if(data.pending.size() > MAX_PENDING_STATES)
+        data.pending.pop_front();
+}
+
+void
+    EntityStateBaselines::acknowledge(int32_t observer, uint32_t sequence)
+{
+    const auto found = m_observers.find(observer);
+
+    if(found == m_observers.end())
+        return;
+
+    for(auto& [entity, data] : found->second) {
+
+        while(!data.pending.empty() &&
+              data.pending.front().sequence <= sequence) {
+
+            if(data.pending.front().sequence == sequence) {
+                data.baseline = std::move(data.pending.front());
+                data.hasBaseline = true;
+            }
+
+            data.pending.pop_front();
+        }
+    }
+}
+
+bool
+    EntityStateBaselines::isDelta(const std::string& encoded)
+{
+    return !encoded.empty() &&
+           static_cast<uint8_t>(encoded[0]) == DELTA_STATE;
+}
+
+uint32_t
+    EntityStateBaselines::getBaselineSequence(const std::string& encoded)
+{
+    if(!isDelta(encoded))
+        throw Leviathan::InvalidArgument("encoded state is not a delta");
+
+    size_t position = 1;
+    return static_cast<uint32_t>(readVarint(encoded, position));
+}
+
+void
+    EntityStateBaselines::decode(const std::string* baseline,
+        const std::string& encoded,
+        std::string& state)
+{
+    if(encoded.empty())
+        throw Leviathan::InvalidArgument("empty encoded state");
+
+    if(!isDelta(encoded)) {
+
+        if(static_cast<uint8_t>(encoded[0]) != FULL_STATE)
+            throw Leviathan::InvalidArgument("unknown encoded state type");
+
+        state.assign(encoded, 1, std::string::npos);
+        return;
+    }
+
+    if(!baseline)
+        throw Leviathan::InvalidArgument("baseline is needed for a delta");
+
+    size_t position = 1;
+    readVarint(encoded, position);
+    const auto size = readVarint(encoded, position);
+
+    state.clear();
+
+    while(state.size() < size) {
+
+        const auto same = readVarint(encoded, position);
+        const auto changed = readVarint(encoded, position);
+
+        if(same + changed == 0 || same + changed > size - state.size() ||
+            state.size() + same > baseline->size() ||
+            changed > encoded.size() - position)
+            throw Leviathan::InvalidArgument("corrupt encoded state");
+
+        state.append(*baseline, state.size(), same);
+        state.append(encoded, position, changed);
+        position += changed;
+    }
+}
+
+void
+    EntityStateBaselines::encodeMessage(int32_t observer,
+        uint32_t sequence,
+        const std::vector<std::tuple<ObjectID, std::string>>& states,
+        const std::vector<ObjectID>& left,
+        std::string& message)
+{
+    message.clear();
+
+    appendVarint(message, sequence);
+    appendVarint(message, states.size());
+
+    for(const auto& [entity, state] : states) {
+
+        encode(observer, entity, sequence, state, m_encoded);
+
+        appendVarint(message, static_cast<uint32_t>(entity));
+        appendVarint(message, m_encoded.size());
+        message.append(m_encoded);
+    }
+
+    appendVarint(message, left.size());
+
+    for(ObjectID entity : left) {
+        appendVarint(message, static_cast<uint32_t>(entity));
+        removeEntity(observer, entity);
+    }
+}
+
+uint32_t
+    EntityStateBaselines::getMessageSequence(const std::string& message)
+{
+    size_t position = 0;
+    return static_cast<uint32_t>(readVarint(message, position));
+}
+
+void
+    EntityStateBaselines::removeObserver(int32_t observer)
+{
+    m_observers.erase(observer);
+}
+
+void
+    EntityStateBaselines::removeEntity(ObjectID entity)
+{
+    for(auto& [observer, entities] : m_observers)
+        entities.erase(entity);
+}
+
+void
+    EntityStateBaselines::removeEntity(int32_t observer, ObjectID entity)
+{
+    const auto found = m_observers.find(observer);
+
+    if(found != m_observers.end())
+        found->second.erase(entity);
+}
+// ------------------------------------ //
+// Transform states
+void
+    thrive::encodeTransformState(const Float3& position,
+        const Quaternion& orientation,
+        std::string& state)
+{
+    const std::array<float, TRANSFORM_STATE_FLOATS> values = {position.X,
+        position.Y, position.Z, orientation.X, orientation.Y, orientation.Z,
+        orientation.W};
+
+    state.assign(reinterpret_cast<const char*>(values.data()),
+        sizeof(float) * values.size());
+}
+
+void
+    thrive::decodeTransformState(
+        const std::string& state, Float3& position, Quaternion& orientation)
+{
+    std::array<float, TRANSFORM_STATE_FLOATS> values;
+
+    if(state.size() != sizeof(float) * values.size())
+        throw Leviathan::InvalidArgument("state is not a transform");
+
+    std::memcpy(values.data(), state.data(), state.size());
+
+    position = Float3(values[0], values[1], values[2]);
+    orientation = Quaternion(values[3], values[4], values[5], values[6]);
+}
+// ------------------------------------ //
+// EntityStateReceiver
+uint32_t
+    EntityStateReceiver::receive(
+        const std::string& message, const ApplyCallback& apply)
+{
+    const auto sequence = EntityStateBaselines::getMessageSequence(message);
+
+    size_t position = 0;
+    readVarint(message, position);
+    const auto count = readVarint(message, position);
+
+    for(uint64_t i = 0; i < count; ++i) {
+
+        const auto entity =
+            static_cast<ObjectID>(readVarint(message, position));
+        const auto size = readVarint(message, position);
+
+        if(size > message.size() - position)
+            throw Leviathan::InvalidArgument("state goes past end of message");
+
+        m_encoded.assign(message, position, size);
+        position += size;
+
+        auto& received = m_entities[entity];
+
+        const std::string* baseline = nullptr;
+
+        if(EntityStateBaselines::isDelta(m_encoded)) {
+
+            const auto baselineSequence =
+                EntityStateBaselines::getBaselineSequence(m_encoded);
+
+            // The server only moves its baseline forward, so the older states
+            // are no longer needed
+            while(!received.empty() &&
+                  received.front().sequence < baselineSequence)
+                received.pop_front();
+
+            if(received.empty() ||
+                received.front().sequence != baselineSequence)
+                continue;
+
+            baseline = &received.front().state;
+        }
+
+        EntityStateBaselines::decode(baseline, m_encoded, m_state);
+
+        // The messages may arrive out of order
+        auto insertAt = received.end();
+
+        while(insertAt != received.begin() &&
+              std::prev(insertAt)->sequence > sequence)
+            --insertAt;
+
+        if(insertAt != received.begin() &&
+            std::prev(insertAt)->sequence == sequence)
+            continue;
+
+        // Old states are kept as baselines but not shown
+        const bool newest = insertAt == received.end();
+
+        received.insert(insertAt, ReceivedState{sequence, m_state});
+
+        // The oldest one is kept as it can be the current baseline. The
+        // server can only switch to one of its last MAX_PENDING_STATES
+        // states
+        if(received.size() > MAX_PENDING_STATES + 1)
+            received.erase(received.begin() + 1);
+
+        if(newest)
+            apply(entity, m_state);
+    }
+
+    const auto leftCount = readVarint(message, position);
+
+    for(uint64_t i = 0; i < leftCount; ++i)
+        m_entities.erase(static_cast<ObjectID>(readVarint(message, position)));
+
+    return sequence;
+}
+
+void
+    EntityStateReceiver::clear()
+{
+    m_entities.clear();
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <Common/Types.h>
+#include <Entities/EntityCommon.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace thrive {
+
+/**
+ * @brief Buckets entity positions into square cells on the XZ plane for fast
+ * radius queries
+ */
+class SpatialHashGrid {
+public:
+    //! \exception Leviathan::InvalidArgument if cellSize is not positive
+    SpatialHashGrid(float cellSize);
+
+    //! \brief Removes all entities. Keeps the allocated cells
+    void
+        clear();
+
+    void
+        insert(ObjectID entity, const Float3& position);
+
+    //! \brief Appends the entities within radius of center to result
+    void
+        query(const Float3& center,
+            float radius,
+            std::vector<ObjectID>& result) const;
+
+private:
+    struct Entry {
+        ObjectID entity;
+        Float3 position;
+    };
+
+    int32_t
+        _cellCoordinate(float value) const;
+
+    static uint64_t
+        _cellKey(int32_t x, int32_t z);
+
+private:
+    float m_cellSize;
+
+    std::unordered_map<uint64_t, std::vector<Entry>> m_cells;
+};
+
+//! \brief An entity that can be sent to players
+struct ReplicatedEntity {
+    ObjectID entity;
+    Float3 position;
+
+    //! Estimated size of an update of this entity in bytes
+    uint32_t updateSize = 32;
+
+    //! Multiplies how quickly the priority of the entity grows
+    float priority = 1;
+};
+
+/**
+ * @brief Decides which entities are sent to which player each tick
+ *
+ * Each player (observer) only receives entities within its area of interest.
+ * Every tick the entities in the area gain priority, faster the closer they
+ * are to the observer. Updates are then picked in priority order until the
+ * byte budget of the observer is used. Sending an entity resets its priority
+ * so far away entities are still sent, just less often.
+ */
+class ReplicationInterestManager {
+public:
+    ReplicationInterestManager(float cellSize = 50.f);
+
+    //! \brief Sets the entities that exist this tick
+    void
+        setEntities(const std::vector<ReplicatedEntity>& entities);
+
+    //! \brief Adds or updates an observer
+    //! \param byteBudget How many bytes of updates can be sent to the
+    //! observer per tick
+    void
+        updateObserver(int32_t observer,
+            const Float3& position,
+            float interestRadius,
+            uint32_t byteBudget);
+
+    void
+        removeObserver(int32_t observer);
+
+    //! \brief Picks the entities to send to observer this tick
+    //! \param selected The picked entities, highest priority first
+    //! \param left Entities that are no longer in the area of interest. The
+    //! client should stop showing these
+    //! \exception Leviathan::NotFound if there is no such observer
+    void
+        selectUpdates(int32_t observer,
+            float elapsed,
+            std::vector<ObjectID>& selected,
+            std::vector<ObjectID>& left);
+
+    size_t
+        getObserverCount() const
+    {
+        return m_observers.size();
+    }
+
+private:
+    struct Interest {
+        float priority = 0;
+
+        //! The selectUpdates call this was last in range in
+        uint32_t lastSeen = 0;
+    };
+
+    struct Observer {
+        Float3 position;
+        float interestRadius = 0;
+        uint32_t byteBudget = 0;
+
+        //! Counts selectUpdates calls
+        uint32_t updateNumber = 0;
+
+        //! The entities in the area of interest
+        std::unordered_map<ObjectID, Interest> interests;
+    };
+
+private:
+    SpatialHashGrid m_grid;
+
+    //! The entities of this tick by id
+    std::unordered_map<ObjectID, ReplicatedEntity> m_entities;
+
+    std::unordered_map<int32_t, Observer> m_observers;
+
+    //! Reused between selectUpdates calls
+    std::vector<ObjectID> m_inRange;
+    std::vector<std::tuple<float, ObjectID>> m_candidates;
+};
+
+/**
+ * @brief Delta compresses entity states against the last state each observer
+ * has acknowledged
+ *
+ * States are opaque byte strings. The encoded state says which baseline it is
+ * against, the receiver needs to keep the states it has received until it
+ * knows they aren't needed as baselines anymore.
+ */
+class EntityStateBaselines {
+public:
+    //! \brief Encodes state for observer and remembers it as a possible
+    //! baseline
+    //! \param sequence Number of the update the state is sent in. These need
+    //! to increase
+    void
+        encode(int32_t observer,
+            ObjectID entity,
+            uint32_t sequence,
+            const std::string& state,
+            std::string& encoded);
+
+    //! \brief Marks the update sequence as received by observer
+    //!
+    //! The states sent in it become the baselines for later updates
+    void
+        acknowledge(int32_t observer, uint32_t sequence);
+
+    //! \returns The sequence number of the baseline encoded is against. Only
+    //! valid if isDelta returns true
+    static uint32_t
+        getBaselineSequence(const std::string& encoded);
+
+    static bool
+        isDelta(const std::string& encoded);
+
+    //! \brief Decodes a state
+    //! \param baseline The state with the sequence from getBaselineSequence.
+    //! Can be null if encoded is not a delta
+    //! \exception Leviathan::InvalidArgument if encoded is corrupt or the
+    //! baseline is missing
+    static void
+        decode(const std::string* baseline,
+            const std::string& encoded,
+            std::string& state);
+
+    //! \brief Builds a message with the states of entities for observer
+    //!
+    //! The message is decoded by EntityStateReceiver. The states of the
+    //! entities in left are forgotten, if they come back they are sent whole
+    //! \param states The entities and their current states
+    //! \param left Entities the observer should stop showing
+    void
+        encodeMessage(int32_t observer,
+            uint32_t sequence,
+            const std::vector<std::tuple<ObjectID, std::string>>& states,
+            const std::vector<ObjectID>& left,
+            std::string& message);
+
+    //! \returns The sequence number of a message from encodeMessage
+    //! \exception Leviathan::InvalidArgument if message is corrupt
+    static uint32_t
+        getMessageSequence(const std::string& message);
+
+    void
+        removeObserver(int32_t observer);
+
+    void
+        removeEntity(ObjectID entity);
+
+    //! \brief Forgets the states of entity sent to observer
+    void
+        removeEntity(int32_t observer, ObjectID entity);
+
+private:
+    struct SentState {
+        uint32_t sequence;
+        std::string state;
+    };
+
+    struct EntityBaseline {
+        bool hasBaseline = false;
+        SentState baseline;
+
+        //! Sent but not yet acknowledged states, oldest first
+        std::deque<SentState> pending;
+    };
+
+private:
+    std::unordered_map<int32_t, std::unordered_map<ObjectID, EntityBaseline>>
+        m_observers;
+
+    //! Reused between encodeMessage calls
+    std::string m_encoded;
+};
+
+//! \brief Encodes the position and rotation of an entity as a state for
+//! EntityStateBaselines
+void
+    encodeTransformState(const Float3& position,
+        const Quaternion& orientation,
+        std::string& state);
+
+//! \brief Decodes a state made by encodeTransformState
+//! \exception Leviathan::InvalidArgument if state is the wrong size
+void
+    decodeTransformState(
+        const std::string& state, Float3& position, Quaternion& orientation);
+
+/**
+ * @brief The client side of EntityStateBaselines
+ *
+ * Decodes the messages from EntityStateBaselines::encodeMessage and keeps the
+ * received states that the server can still use as baselines
+ */
+class EntityStateReceiver {
+public:
+    //! \brief Called with each entity and its state in a message
+    using ApplyCallback =
+        std::function<void(ObjectID entity, const std::string& state)>;
+
+    //! \brief Decodes message and calls apply for the states in it
+    //!
+    //! States that can't be decoded because their baseline isn't here are
+    //! skipped. The server sends them whole once the message is acknowledged
+    //! \returns The sequence of the message. This should be acknowledged to
+    //! the server
+    //! \exception Leviathan::InvalidArgument if message is corrupt
+    uint32_t
+        receive(const std::string& message, const ApplyCallback& apply);
+
+    //! \brief Forgets all states, for example when joining another world
+    void
+        clear();
+
+    size_t
+        getEntityCount() const
+    {
+        return m_entities.size();
+    }
+
+private:
+    struct ReceivedState {
+        uint32_t sequence;
+        std::string state;
+    };
+
+private:
+    //! Received states by entity, oldest first
+    std::unordered_map<ObjectID, std::deque<ReceivedState>> m_entities;
+
+    //! Reused between receive calls
+    std::string m_encoded;
+    std::string m_state;
+};
+
+} // namespace thrive
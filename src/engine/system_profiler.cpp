@@ -0,0 +1,205 @@
+// ------------------------------------ //
+#include "system_profiler.h"
+
+#include "generated/cell_stage_world.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <unordered_set>
+
+using namespace thrive;
+// ------------------------------------ //
+//! How many of the latest runs of a system the statistics are calculated from
+constexpr size_t SYSTEM_PROFILER_WINDOW = 120;
+
+SystemProfiler::SystemProfiler(GameWorld& world) :
+    Leviathan::PerWorldData(world)
+{}
+// ------------------------------------ //
+void
+    SystemProfiler::addSample(const char* system, Clock::duration duration)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_tickStarted) {
+        m_tickStarted = true;
+        m_tickStart = Clock::now() - duration;
+    }
+
+    m_profiledSinceTick += duration;
+    _addSample(
+        system, std::chrono::duration<float, std::milli>(duration).count());
+}
+
+void
+    SystemProfiler::addTickTotal(Clock::duration total)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    _finishTick(total);
+}
+
+void
+    SystemProfiler::finishTick(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_tickStarted)
+        return;
+
+    _finishTick(now - m_tickStart);
+}
+
+void
+    SystemProfiler::_finishTick(Clock::duration total)
+{
+    const auto unprofiled =
+        std::max(total - m_profiledSinceTick, Clock::duration(0));
+    m_profiledSinceTick = Clock::duration(0);
+    m_tickStarted = false;
+
+    _addSample(UNPROFILED,
+        std::chrono::duration<float, std::milli>(unprofiled).count());
+}
+
+void
+    SystemProfiler::_addSample(const char* system, float milliseconds)
+{
+    // There are only a few systems so a linear search is fine
+    auto found = std::find_if(
+        m_systems.begin(), m_systems.end(), [&](const System& existing) {
+            return existing.name == system ||
+                   std::strcmp(existing.name, system) == 0;
+        });
+
+    if(found == m_systems.end()) {
+        m_systems.push_back(System{system, {}, 0});
+        found = m_systems.end() - 1;
+        found->samples.reserve(SYSTEM_PROFILER_WINDOW);
+    }
+
+    if(found->samples.size() < SYSTEM_PROFILER_WINDOW) {
+        found->samples.push_back(milliseconds);
+    } else {
+        found->samples[found->nextSample] = milliseconds;
+    }
+
+    found->nextSample = (found->nextSample + 1) % SYSTEM_PROFILER_WINDOW;
+}
+// ------------------------------------ //
+std::vector<SystemTimingStats>
+    SystemProfiler::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<SystemTimingStats> result;
+    result.reserve(m_systems.size());
+
+    for(const auto& system : m_systems) {
+
+        SystemTimingStats stats;
+        stats.name = system.name;
+        stats.samples = system.samples.size();
+
+        // The last written sample is before the next one to write
+        stats.last = system.samples[(system.nextSample + stats.samples - 1) %
+                                    stats.samples];
+
+        float total = 0;
+
+        for(float sample : system.samples) {
+            total += sample;
+            stats.max = std::max(stats.max, sample);
+        }
+
+        stats.average = total / stats.samples;
+
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+std::string
+    SystemProfiler::toJSON() const
+{
+    std::stringstream json;
+    json << "[";
+
+    bool first = true;
+
+    // The names are identifiers so they don't need escaping
+    for(const auto& stats : getStats()) {
+
+        if(!first)
+            json << ",";
+
+        first = false;
+
+        json << "{\"name\":\"" << stats.name << "\",\"last\":" << stats.last
+             << ",\"average\":" << stats.average << ",\"max\":" << stats.max
+             << ",\"samples\":" << stats.samples << "}";
+    }
+
+    json << "]";
+    return json.str();
+}
+
+std::string
+    SystemProfiler::toCSV() const
+{
+    std::stringstream csv;
+    csv << "system,last_ms,average_ms,max_ms,samples\n";
+
+    for(const auto& stats : getStats()) {
+        csv << stats.name << "," << stats.last << "," << stats.average << ","
+            << stats.max << "," << stats.samples << "\n";
+    }
+
+    return csv.str();
+}
+// ------------------------------------ //
+void
+    SystemProfiler::OnClear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_systems.clear();
+    m_profiledSinceTick = Clock::duration(0);
+    m_tickStarted = false;
+}
+
+SystemProfiler*
+    SystemProfiler::getForWorld(GameWorld& world)
+{
+    // The id is checked as well in case a new world is created at the
+    // address of a deleted one
+    thread_local GameWorld* cachedWorld = nullptr;
+    thread_local int32_t cachedWorldId = -1;
+    thread_local SystemProfiler* cachedProfiler = nullptr;
+
+    if(&world == cachedWorld && world.GetID() == cachedWorldId)
+        return cachedProfiler;
+
+    // Only the cell stage has systems to profile
+    auto* cellStage = dynamic_cast<CellStageWorld*>(&world);
+
+    cachedWorld = &world;
+    cachedWorldId = world.GetID();
+    cachedProfiler = cellStage ? &cellStage->GetSystemProfiler() : nullptr;
+
+    return cachedProfiler;
+}
+
+const char*
+    SystemProfiler::internName(const std::string& name)
+{
+    static std::mutex namesMutex;
+    static std::unordered_set<std::string> names;
+
+    std::lock_guard<std::mutex> lock(namesMutex);
+
+    // Pointers to the elements stay valid when the set rehashes
+    return names.insert(name).first->c_str();
+}
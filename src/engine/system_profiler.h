@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Entities/PerWorldData.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace thrive {
+
+//! \brief Timing statistics of one system over the recent ticks
+struct SystemTimingStats {
+    std::string name;
+
+    //! The times are in milliseconds
+    float last = 0;
+    float average = 0;
+    float max = 0;
+
+    //! How many runs these are calculated from
+    size_t samples = 0;
+};
+
+/**
+ * @brief Times the system runs of a world
+ *
+ * The systems time their Run with a ScopedTimer. The durations of the last
+ * SYSTEM_PROFILER_WINDOW runs of each system are kept for the statistics.
+ * \note The statistics may be read while another thread ticks the world
+ */
+class SystemProfiler : public Leviathan::PerWorldData {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! Name of the time of a tick that no system timed, for example the
+    //! engine work between the systems
+    static constexpr auto UNPROFILED = "Unprofiled";
+
+    //! \brief Adds the time this exists to a system
+    class ScopedTimer {
+    public:
+        ScopedTimer(SystemProfiler& profiler, const char* system) :
+            m_profiler(&profiler), m_system(system), m_start(Clock::now())
+        {}
+
+        //! \brief For systems that only get a GameWorld. Does nothing if the
+        //! world has no profiler
+        ScopedTimer(GameWorld& world, const char* system) :
+            m_profiler(SystemProfiler::getForWorld(world)), m_system(system),
+            m_start(Clock::now())
+        {}
+
+        ~ScopedTimer()
+        {
+            if(m_profiler)
+                m_profiler->addSample(m_system, Clock::now() - m_start);
+        }
+
+        ScopedTimer(const ScopedTimer& other) = delete;
+        ScopedTimer&
+            operator=(const ScopedTimer& other) = delete;
+
+    private:
+        SystemProfiler* const m_profiler;
+        const char* const m_system;
+        const Clock::time_point m_start;
+    };
+
+    SystemProfiler(GameWorld& world);
+
+    //! \param system The name needs to stay valid as long as this object,
+    //! use string literals or internName
+    void
+        addSample(const char* system, Clock::duration duration);
+
+    //! \brief Records how long a whole world tick took. The part of it not
+    //! added to any system since the last call is added to UNPROFILED
+    void
+        addTickTotal(Clock::duration total);
+
+    //! \brief Ends a tick that the engine ran. The tick is taken to have
+    //! started when the first system timed since the last tick started
+    //!
+    //! This is for worlds that the engine ticks, where the whole tick can't
+    //! be timed. The engine runs the application tick after the worlds and
+    //! the script systems after the native systems, so calling this from the
+    //! application tick also counts the script systems, which time their Run
+    //! through the script bindings. Does nothing if no system has ran, for
+    //! example when the world is paused.
+    void
+        finishTick(Clock::time_point now = Clock::now());
+
+    //! \returns The statistics of the systems in the order they first ran
+    std::vector<SystemTimingStats>
+        getStats() const;
+
+    //! \returns The statistics as a JSON array of objects
+    std::string
+        toJSON() const;
+
+    //! \returns The statistics as CSV with a header line
+    std::string
+        toCSV() const;
+
+    //! \brief Clears the statistics
+    void
+        OnClear() override;
+
+    //! \returns The profiler of a world or null if it doesn't have one
+    //! \note The result for the last world is remembered as this is called
+    //! by the timers of many systems each tick
+    static SystemProfiler*
+        getForWorld(GameWorld& world);
+
+    //! \returns A copy of name that stays valid until the program exits
+    //! \note For names that aren't string literals, like the script system
+    //! names. The copies are never freed so the names should be fixed ones
+    static const char*
+        internName(const std::string& name);
+
+private:
+    struct System {
+        const char* name;
+
+        //! Milliseconds, used as a ring buffer
+        std::vector<float> samples;
+        size_t nextSample = 0;
+    };
+
+    void
+        _addSample(const char* system, float milliseconds);
+
+    //! \brief Adds the unprofiled time of a tick. The lock must be held
+    void
+        _finishTick(Clock::duration total);
+
+private:
+    mutable std::mutex m_mutex;
+
+    std::vector<System> m_systems;
+
+    //! Sum of the system times since the last addTickTotal
+    Clock::duration m_profiledSinceTick = Clock::duration(0);
+
+    //! When the first system since the last addTickTotal started
+    Clock::time_point m_tickStart;
+    bool m_tickStarted = false;
+};
+
+} // namespace thrive
@@ -0,0 +1,264 @@
+// ------------------------------------ //
+#include "tracing.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace thrive;
+// ------------------------------------ //
+//! Events after this many on one thread are dropped to not run out of memory
+constexpr size_t MAX_TRACE_EVENTS_PER_THREAD = 1000000;
+
+namespace {
+
+enum class TRACE_EVENT : char {
+    Zone = 'X',
+    Counter = 'C',
+    FlowStart = 's',
+    FlowEnd = 'f'
+};
+
+struct TraceEvent {
+    TRACE_EVENT type;
+    const char* name;
+    const char* category;
+
+    //! Microseconds since the recording started
+    double timestamp;
+
+    //! Duration of zones, value of counters and id of flows
+    double value;
+    uint64_t id;
+};
+
+struct ThreadBuffer {
+    std::mutex mutex;
+    uint32_t threadId;
+    std::string threadName;
+    std::vector<TraceEvent> events;
+    size_t droppedEvents = 0;
+};
+
+//! All the threads that have recorded something. The buffers of threads that
+//! have ended are kept so that their events get written
+std::mutex buffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+
+//! The time the recording started as nanoseconds of Tracer::Clock
+std::atomic<int64_t> recordingStart{0};
+
+ThreadBuffer&
+    getThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+    if(!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->threadId = static_cast<uint32_t>(threadBuffers.size() + 1);
+        threadBuffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+double
+    toTimestamp(Tracer::Clock::time_point time)
+{
+    const auto sinceStart =
+        time.time_since_epoch() - std::chrono::nanoseconds(recordingStart);
+
+    return std::chrono::duration<double, std::micro>(sinceStart).count();
+}
+
+void
+    record(const TraceEvent& event)
+{
+    auto& buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    if(buffer.events.size() >= MAX_TRACE_EVENTS_PER_THREAD) {
+        ++buffer.droppedEvents;
+        return;
+    }
+
+    buffer.events.push_back(event);
+}
+
+void
+    writeEscaped(std::ostream& stream, const std::string& text)
+{
+    for(char character : text) {
+        if(character == '"' || character == '\\')
+            stream << '\\';
+
+        stream << character;
+    }
+}
+
+} // namespace
+// ------------------------------------ //
+std::atomic<bool> Tracer::recording{false};
+
+void
+    Tracer::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        for(const auto& buffer : threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+            buffer->droppedEvents = 0;
+        }
+    }
+
+    recordingStart = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch())
+                         .count();
+
+    recording.store(true, std::memory_order_release);
+}
+
+void
+    Tracer::stop()
+{
+    recording.store(false, std::memory_order_release);
+}
+// ------------------------------------ //
+void
+    Tracer::setThreadName(const std::string& name)
+{
+    auto& buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void
+    Tracer::zone(const char* name,
+        const char* category,
+        Clock::time_point start,
+        Clock::time_point end)
+{
+    if(!isRecording())
+        return;
+
+    record(TraceEvent{TRACE_EVENT::Zone, name, category, toTimestamp(start),
+        std::chrono::duration<double, std::micro>(end - start).count(), 0});
+}
+
+void
+    Tracer::counter(const char* name, double value)
+{
+    if(!isRecording())
+        return;
+
+    record(TraceEvent{TRACE_EVENT::Counter, name, "counter",
+        toTimestamp(Clock::now()), value, 0});
+}
+
+void
+    Tracer::flowStart(const char* name, uint64_t id)
+{
+    if(!isRecording())
+        return;
+
+    record(TraceEvent{TRACE_EVENT::FlowStart, name, "flow",
+        toTimestamp(Clock::now()), 0, id});
+}
+
+void
+    Tracer::flowEnd(const char* name, uint64_t id)
+{
+    if(!isRecording())
+        return;
+
+    record(TraceEvent{TRACE_EVENT::FlowEnd, name, "flow",
+        toTimestamp(Clock::now()), 0, id});
+}
+// ------------------------------------ //
+std::string
+    Tracer::toChromeTraceJSON()
+{
+    std::stringstream json;
+    json.precision(15);
+
+    json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+
+    const auto separate = [&]() {
+        if(!first)
+            json << ",\n";
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    for(const auto& buffer : threadBuffers) {
+
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+        const auto tid = buffer->threadId;
+
+        if(!buffer->threadName.empty()) {
+            separate();
+            json << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,"
+                 << "\"tid\":" << tid << ",\"args\":{\"name\":\"";
+            writeEscaped(json, buffer->threadName);
+            json << "\"}}";
+        }
+
+        for(const auto& event : buffer->events) {
+
+            separate();
+
+            json << "{\"ph\":\"" << static_cast<char>(event.type)
+                 << "\",\"name\":\"" << event.name << "\",\"cat\":\""
+                 << event.category << "\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":" << event.timestamp;
+
+            switch(event.type) {
+            case TRACE_EVENT::Zone: json << ",\"dur\":" << event.value; break;
+            case TRACE_EVENT::Counter:
+                json << ",\"args\":{\"value\":" << event.value << "}";
+                break;
+            case TRACE_EVENT::FlowStart: json << ",\"id\":" << event.id; break;
+            case TRACE_EVENT::FlowEnd:
+                // Binds to the zone the flow ends in
+                json << ",\"id\":" << event.id << ",\"bp\":\"e\"";
+                break;
+            }
+
+            json << "}";
+        }
+
+        if(buffer->droppedEvents > 0) {
+            separate();
+            json << "{\"ph\":\"i\",\"name\":\"dropped " << buffer->droppedEvents
+                 << " events\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":0,\"s\":\"t\"}";
+        }
+    }
+
+    json << "]}";
+    return json.str();
+}
+
+bool
+    Tracer::writeChromeTrace(const std::string& file)
+{
+    std::ofstream stream(file);
+
+    if(!stream.good())
+        return false;
+
+    stream << toChromeTraceJSON();
+    return stream.good();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace thrive {
+
+/**
+ * @brief Records a timeline of what the threads are doing
+ *
+ * The events are written in the Chrome trace event format which can be
+ * viewed with chrome://tracing or Perfetto. Recording is off by default and
+ * all the recording methods return right away when it is off. Each thread
+ * records into its own buffer so threads don't wait for each other.
+ * \note The names of the events need to stay valid until the trace is
+ * written, use string literals
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! \brief Starts recording. Clears the previously recorded events
+    static void
+        start();
+
+    //! \brief Stops recording. The events are kept for writing them
+    static void
+        stop();
+
+    static bool
+        isRecording()
+    {
+        return recording.load(std::memory_order_acquire);
+    }
+
+    //! \brief Names the calling thread in the trace
+    static void
+        setThreadName(const std::string& name);
+
+    //! \brief Records a zone that has ended. TraceZone calls this
+    static void
+        zone(const char* name,
+            const char* category,
+            Clock::time_point start,
+            Clock::time_point end);
+
+    //! \brief Records the value of a counter. Each counter is shown as a graph
+    static void
+        counter(const char* name, double value);
+
+    //! \brief Starts an arrow that ends at flowEnd with the same id. Used to
+    //! show work moving to another thread
+    //! \note Flows are attached to the zone they are recorded in
+    static void
+        flowStart(const char* name, uint64_t id);
+
+    static void
+        flowEnd(const char* name, uint64_t id);
+
+    //! \returns The recorded events as Chrome trace JSON
+    static std::string
+        toChromeTraceJSON();
+
+    //! \returns False if the file couldn't be written
+    static bool
+        writeChromeTrace(const std::string& file);
+
+private:
+    static std::atomic<bool> recording;
+};
+
+//! \brief Records the time this exists as a zone on the calling thread
+class TraceZone {
+public:
+    TraceZone(const char* name, const char* category = "thrive") :
+        m_name(name), m_category(category),
+        m_recording(Tracer::isRecording())
+    {
+        if(m_recording)
+            m_start = Tracer::Clock::now();
+    }
+
+    ~TraceZone()
+    {
+        if(m_recording)
+            Tracer::zone(m_name, m_category, m_start, Tracer::Clock::now());
+    }
+
+    TraceZone(const TraceZone& other) = delete;
+    TraceZone&
+        operator=(const TraceZone& other) = delete;
+
+private:
+    const char* const m_name;
+    const char* const m_category;
+    const bool m_recording;
+    Tracer::Clock::time_point m_start;
+};
+
+} // namespace thrive
@@ -19,4 +19,6 @@ using MembraneTypeId = uint16_t;
 using Milliseconds = int;
 
 constexpr CompoundId NULL_COMPOUND = -1;
+
+constexpr SpawnerTypeId NULL_SPAWNER = -1;
 } // namespace thrive
@@ -0,0 +1,113 @@
+// ------------------------------------ //
+#include "auto_save.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+using namespace thrive;
+// ------------------------------------ //
+AutoSaver::AutoSaver() :
+    m_thread(std::bind(&AutoSaver::_runBackgroundThread, this))
+{}
+
+AutoSaver::~AutoSaver()
+{
+    {
+        GUARD_LOCK();
+        m_stopThread = true;
+        m_notifyBackgroundThread.notify_one();
+    }
+
+    m_thread.join();
+}
+// ------------------------------------ //
+bool
+    AutoSaver::save(CellStageWorld& world,
+        const PatchMap& map,
+        ObjectID player,
+        const std::string& file)
+{
+    if(m_writing) {
+        LOG_WARNING("AutoSaver: skipping autosave as the previous one is still "
+                    "being written");
+        return false;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // The background thread doesn't touch the snapshot while not writing
+    takeCellStageSnapshot(m_snapshot, world, map, player);
+
+    const std::chrono::duration<float, std::milli> elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+
+    if(elapsed.count() > AUTOSAVE_SNAPSHOT_BUDGET) {
+        LOG_WARNING("AutoSaver: taking the snapshot took " +
+                    std::to_string(elapsed.count()) + "ms");
+    }
+
+    GUARD_LOCK();
+
+    m_file = file;
+    m_writing = true;
+    m_notifyBackgroundThread.notify_one();
+    return true;
+}
+// ------------------------------------ //
+void
+    AutoSaver::_runBackgroundThread()
+{
+    GUARD_LOCK();
+
+    while(!m_stopThread) {
+
+        if(!m_writing) {
+            // Wait for work
+            m_notifyBackgroundThread.wait(guard);
+            continue;
+        }
+
+        const auto file = m_file;
+        const auto temporaryFile = file + ".tmp";
+
+        guard.unlock();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        bool success = false;
+
+        try {
+            {
+                std::ofstream stream(temporaryFile,
+                    std::ios::binary | std::ios::out | std::ios::trunc);
+
+                if(!stream.good())
+                    throw Leviathan::InvalidState("can't open file for writing");
+
+                writeCellStageSave(stream, m_snapshot);
+            }
+
+            // Replacing doesn't work on all platforms with just rename
+            std::remove(file.c_str());
+
+            if(std::rename(temporaryFile.c_str(), file.c_str()) != 0)
+                throw Leviathan::InvalidState("can't rename the written save");
+
+            success = true;
+
+        } catch(const Leviathan::Exception& e) {
+            LOG_ERROR("AutoSaver: failed to write autosave to: " + file);
+            e.PrintToLog();
+        }
+
+        if(success) {
+            const std::chrono::duration<float> elapsed =
+                std::chrono::high_resolution_clock::now() - start;
+            LOG_INFO("AutoSaver: wrote autosave to: " + file + " in " +
+                     std::to_string(elapsed.count()) + "s");
+        }
+
+        guard.lock();
+        m_writing = false;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "general/save_game.h"
+
+#include <Common/ThreadSafe.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+namespace thrive {
+
+//! How often the cell stage is autosaved, in seconds
+constexpr auto AUTOSAVE_INTERVAL = 300.f;
+
+//! If taking the autosave snapshot takes longer than this (in milliseconds) a
+//! warning is printed
+constexpr auto AUTOSAVE_SNAPSHOT_BUDGET = 3.f;
+
+//! \brief Writes autosaves without blocking the main thread
+//!
+//! The state of the game is copied into a snapshot on the main thread and the
+//! slow parts (encoding the clouds and writing the file) are done on a
+//! background thread. Only one save can be in progress at once and the same
+//! snapshot buffers are reused between saves.
+class AutoSaver : public Leviathan::ThreadSafe {
+public:
+    AutoSaver();
+    ~AutoSaver();
+
+    //! \brief Takes a snapshot of the cell stage and starts writing it to file
+    //!
+    //! The file is first written next to the target and then renamed over it
+    //! so a crash during writing doesn't destroy the previous autosave.
+    //! \returns False if the previous save is still being written. Nothing is
+    //! done in that case
+    //! \note Needs to be called on the main thread
+    bool
+        save(CellStageWorld& world,
+            const PatchMap& map,
+            ObjectID player,
+            const std::string& file);
+
+    //! \returns True while a save is being written
+    bool
+        saveInProgress() const
+    {
+        return m_writing;
+    }
+
+private:
+    void
+        _runBackgroundThread();
+
+private:
+    //! True from queuing a save until it is written. The snapshot may only be
+    //! touched by the background thread while this is true
+    std::atomic<bool> m_writing = {false};
+
+    //! When true background thread should stop
+    std::atomic<bool> m_stopThread = {false};
+
+    std::condition_variable m_notifyBackgroundThread;
+
+    CellStageSaveSnapshot m_snapshot;
+    std::string m_file;
+
+    std::thread m_thread;
+};
+
+} // namespace thrive
@@ -12,7 +12,11 @@ using namespace thrive;
 GlobalUtilityKeyHandler::GlobalUtilityKeyHandler(KeyConfiguration& keys) :
     m_screenshot(keys.ResolveControlNameToFirstKey("Screenshot")),
     m_debugOverlay(keys.ResolveControlNameToFirstKey("ToggleDebugOverlay")),
-    m_debugPhysics(keys.ResolveControlNameToFirstKey("ToggleDebugPhysics"))
+    m_debugPhysics(keys.ResolveControlNameToFirstKey("ToggleDebugPhysics")),
+    m_dumpSystemTimings(
+        keys.ResolveControlNameToFirstKey("DumpSystemTimings")),
+    m_toggleTraceRecording(
+        keys.ResolveControlNameToFirstKey("ToggleTraceRecording"))
 {}
 // ------------------------------------ //
 bool
@@ -47,6 +51,24 @@ bool
         return true;
     }
 
+    if(m_dumpSystemTimings.Match(key, modifiers)) {
+        if(ThriveGame::Get()) {
+            ThriveGame::Get()->dumpSystemTimings();
+        } else {
+            LOG_WARNING("Can't dump system timings");
+        }
+        return true;
+    }
+
+    if(m_toggleTraceRecording.Match(key, modifiers)) {
+        if(ThriveGame::Get()) {
+            ThriveGame::Get()->toggleTraceRecording();
+        } else {
+            LOG_WARNING("Can't toggle trace recording");
+        }
+        return true;
+    }
+
     // Not used
     return false;
 }
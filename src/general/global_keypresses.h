@@ -25,6 +25,8 @@ private:
     Leviathan::GKey m_screenshot;
     Leviathan::GKey m_debugOverlay;
     Leviathan::GKey m_debugPhysics;
+    Leviathan::GKey m_dumpSystemTimings;
+    Leviathan::GKey m_toggleTraceRecording;
 };
 
 } // namespace thrive
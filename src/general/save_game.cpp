@@ -0,0 +1,931 @@
+// ------------------------------------ //
+#include "save_game.h"
+
+#include "microbe_stage/cloud_grid_codec.h"
+#include "microbe_stage/compound_cloud_system.h"
+#include "microbe_stage/microbe_stats_system.h"
+#include "microbe_stage/process_system.h"
+#include "microbe_stage/simulation_parameters.h"
+#include "microbe_stage/spawn_system.h"
+
+#include "generated/cell_stage_world.h"
+#include "thrive_common.h"
+
+#include <Script/ScriptExecutor.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+//! Sanity limit for the lengths read from saves. Protects against allocating
+//! huge amounts of memory when reading a corrupted save
+constexpr uint32_t MAX_SAVED_COUNT = 10000000;
+
+//! The plain MicrobeComponent properties that are saved. Entity ids and things
+//! that are recreated when the microbe is spawned are not
+constexpr std::array<const char*, 1> SAVED_MICROBE_SCRIPT_PROPERTIES = {
+    "reproductionStage"};
+
+//! Saves need to restore the clouds exactly
+const CloudGridCodec SAVE_GRID_CODEC(CloudCodecSettings{32, 0.f});
+
+// ------------------------------------ //
+// SaveWriter
+SaveWriter::SaveWriter(std::ostream& stream) : m_stream(stream) {}
+
+void
+    SaveWriter::writeHeader()
+{
+    write<uint32_t>(SAVE_FILE_MAGIC);
+    write<uint32_t>(SAVE_FILE_VERSION);
+}
+
+void
+    SaveWriter::beginSection(SAVE_SECTION section)
+{
+    if(m_inSection)
+        throw Leviathan::InvalidState("previous save section not ended");
+
+    m_section.clear();
+    m_sectionType = section;
+    m_inSection = true;
+}
+
+void
+    SaveWriter::endSection()
+{
+    if(!m_inSection)
+        throw Leviathan::InvalidState("no save section started");
+
+    m_inSection = false;
+
+    write<uint32_t>(static_cast<uint32_t>(m_sectionType));
+    write<uint64_t>(m_section.size());
+    writeRaw(m_section.data(), m_section.size());
+}
+
+void
+    SaveWriter::writeEnd()
+{
+    beginSection(SAVE_SECTION::END);
+    endSection();
+    m_stream.flush();
+}
+
+void
+    SaveWriter::writeString(const std::string& value)
+{
+    write<uint32_t>(static_cast<uint32_t>(value.size()));
+    writeRaw(value.data(), value.size());
+}
+
+void
+    SaveWriter::writeFloat3(const Float3& value)
+{
+    write(value.X);
+    write(value.Y);
+    write(value.Z);
+}
+
+void
+    SaveWriter::writeFloat4(const Float4& value)
+{
+    write(value.X);
+    write(value.Y);
+    write(value.Z);
+    write(value.W);
+}
+
+void
+    SaveWriter::writeGrid(const float* data, uint32_t width, uint32_t height)
+{
+    write<uint32_t>(width);
+    write<uint32_t>(height);
+
+    SAVE_GRID_CODEC.encode(
+        data, static_cast<size_t>(width) * height, m_gridBuffer);
+
+    write<uint32_t>(static_cast<uint32_t>(m_gridBuffer.size()));
+    writeRaw(m_gridBuffer.data(), m_gridBuffer.size());
+}
+
+void
+    SaveWriter::writeRaw(const void* data, size_t length)
+{
+    if(m_inSection) {
+        m_section.append(static_cast<const char*>(data), length);
+        return;
+    }
+
+    m_stream.write(static_cast<const char*>(data), length);
+
+    if(!m_stream.good())
+        throw Leviathan::InvalidState("writing save data failed");
+}
+// ------------------------------------ //
+// SaveReader
+SaveReader::SaveReader(std::istream& stream) : m_stream(stream) {}
+
+void
+    SaveReader::readHeader()
+{
+    if(_readUnbounded<uint32_t>() != SAVE_FILE_MAGIC)
+        throw Leviathan::InvalidState("not a Thrive save file");
+
+    const auto version = _readUnbounded<uint32_t>();
+
+    if(version != SAVE_FILE_VERSION)
+        throw Leviathan::InvalidState(
+            "unsupported save version: " + std::to_string(version));
+}
+
+bool
+    SaveReader::nextSection(SAVE_SECTION& section)
+{
+    skipSection();
+
+    // The section headers are not part of any section
+    section = static_cast<SAVE_SECTION>(_readUnbounded<uint32_t>());
+    const auto length = _readUnbounded<uint64_t>();
+
+    m_sectionRemaining = length;
+    return section != SAVE_SECTION::END;
+}
+
+void
+    SaveReader::skipSection()
+{
+    if(m_sectionRemaining == 0)
+        return;
+
+    m_stream.ignore(m_sectionRemaining);
+
+    if(!m_stream.good())
+        throw Leviathan::InvalidState("save data ended in the middle of a "
+                                      "section");
+
+    m_sectionRemaining = 0;
+}
+
+std::string
+    SaveReader::readString()
+{
+    const auto length = read<uint32_t>();
+
+    if(length > m_sectionRemaining)
+        throw Leviathan::InvalidState("save has too long string");
+
+    std::string result;
+    result.resize(length);
+    readRaw(result.data(), length);
+    return result;
+}
+
+Float3
+    SaveReader::readFloat3()
+{
+    Float3 result;
+    result.X = read<float>();
+    result.Y = read<float>();
+    result.Z = read<float>();
+    return result;
+}
+
+Float4
+    SaveReader::readFloat4()
+{
+    Float4 result;
+    result.X = read<float>();
+    result.Y = read<float>();
+    result.Z = read<float>();
+    result.W = read<float>();
+    return result;
+}
+
+void
+    SaveReader::readGrid(std::vector<std::vector<float>>& grid)
+{
+    const auto width = read<uint32_t>();
+    const auto height = read<uint32_t>();
+
+    if(width != grid.size() || (width > 0 && height != grid[0].size()))
+        throw Leviathan::InvalidState("saved grid size doesn't match");
+
+    const auto length = read<uint32_t>();
+
+    if(length > m_sectionRemaining)
+        throw Leviathan::InvalidState("save section is truncated");
+
+    std::string encoded;
+    encoded.resize(length);
+    readRaw(encoded.data(), length);
+
+    std::vector<float> values(static_cast<size_t>(width) * height);
+
+    try {
+        CloudGridCodec::decode(encoded, values.data(), values.size());
+    } catch(const Leviathan::InvalidArgument& e) {
+        e.PrintToLog();
+        throw Leviathan::InvalidState("saved grid is invalid");
+    }
+
+    for(uint32_t x = 0; x < width; ++x)
+        std::copy(values.begin() + x * height,
+            values.begin() + (x + 1) * height, grid[x].begin());
+}
+
+void
+    SaveReader::skipGrid()
+{
+    read<uint32_t>();
+    read<uint32_t>();
+    skipRaw(read<uint32_t>());
+}
+
+void
+    SaveReader::skipRaw(uint64_t length)
+{
+    if(length > m_sectionRemaining)
+        throw Leviathan::InvalidState("save section is truncated");
+
+    m_stream.ignore(length);
+
+    if(!m_stream.good())
+        throw Leviathan::InvalidState("save data ended unexpectedly");
+
+    m_sectionRemaining -= length;
+}
+
+void
+    SaveReader::readRaw(void* data, size_t length)
+{
+    if(length > m_sectionRemaining)
+        throw Leviathan::InvalidState("save section is truncated");
+
+    _readStream(data, length);
+    m_sectionRemaining -= length;
+}
+
+void
+    SaveReader::_readStream(void* data, size_t length)
+{
+    m_stream.read(static_cast<char*>(data), length);
+
+    if(!m_stream.good())
+        throw Leviathan::InvalidState("save data ended unexpectedly");
+}
+// ------------------------------------ //
+// Script object helpers
+//! \returns The index of a property in obj or -1
+int
+    findScriptProperty(const asIScriptObject& obj, const char* name)
+{
+    const auto count = obj.GetPropertyCount();
+
+    for(asUINT i = 0; i < count; ++i) {
+        if(std::strcmp(obj.GetPropertyName(i), name) == 0)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+template<typename T>
+T
+    getScriptProperty(asIScriptObject& obj, const char* name, int typeId)
+{
+    const auto index = findScriptProperty(obj, name);
+
+    if(index < 0 || obj.GetPropertyTypeId(index) != typeId)
+        throw Leviathan::InvalidState(
+            std::string("script object has no property: ") + name);
+
+    return *static_cast<T*>(obj.GetAddressOfProperty(index));
+}
+
+//! \brief Builds "compound:amount:priority|..." from avgCompoundAmounts
+std::string
+    getInitialCompoundsCode(const Species& species)
+{
+    if(!species.avgCompoundAmounts)
+        return "";
+
+    std::string result;
+
+    for(auto iter = species.avgCompoundAmounts->begin();
+        iter != species.avgCompoundAmounts->end(); ++iter) {
+
+        // The values are InitialCompound script objects
+        auto* value = static_cast<asIScriptObject*>(
+            const_cast<void*>(iter.GetAddressOfValue()));
+
+        if(!value || !(iter.GetTypeId() & asTYPEID_SCRIPTOBJECT))
+            continue;
+
+        const auto& compound = SimulationParameters::compoundRegistry.getTypeData(
+            std::stoul(iter.GetKey()));
+
+        if(!result.empty())
+            result += "|";
+
+        result += compound.internalName + ":" +
+                  std::to_string(getScriptProperty<float>(
+                      *value, "amount", asTYPEID_FLOAT)) +
+                  ":" +
+                  std::to_string(getScriptProperty<int32_t>(
+                      *value, "priority", asTYPEID_INT32));
+    }
+
+    return result;
+}
+// ------------------------------------ //
+// Patch map
+void
+    saveSpecies(SaveWriter& writer, const Species& species)
+{
+    writer.writeString(species.name);
+    writer.writeString(species.genus);
+    writer.writeString(species.epithet);
+    writer.writeString(species.stringCode);
+    writer.writeString(getInitialCompoundsCode(species));
+
+    writer.writeFloat4(species.colour);
+    writer.write(species.isBacteria);
+    writer.writeString(SimulationParameters::membraneRegistry.getInternalName(
+        species.membraneType));
+    writer.write(species.membraneRigidity);
+
+    writer.write(species.aggression);
+    writer.write(species.opportunism);
+    writer.write(species.fear);
+    writer.write(species.activity);
+    writer.write(species.focus);
+
+    writer.write(species.population);
+    writer.write(species.generation);
+}
+
+Species::pointer
+    loadSpecies(SaveReader& reader)
+{
+    auto species = Species::MakeShared<Species>(reader.readString());
+
+    species->genus = reader.readString();
+    species->epithet = reader.readString();
+    species->stringCode = reader.readString();
+    const auto initialCompounds = reader.readString();
+
+    species->colour = reader.readFloat4();
+    species->isBacteria = reader.read<bool>();
+    species->membraneType =
+        SimulationParameters::membraneRegistry.getTypeId(reader.readString());
+    species->membraneRigidity = reader.read<float>();
+
+    species->aggression = reader.read<float>();
+    species->opportunism = reader.read<float>();
+    species->fear = reader.read<float>();
+    species->activity = reader.read<float>();
+    species->focus = reader.read<float>();
+
+    species->population = reader.read<int32_t>();
+    species->generation = reader.read<int32_t>();
+
+    // The organelles and compounds are script objects
+    auto* scripts = ThriveCommon::get() ?
+                        ThriveCommon::get()->getMicrobeScripts() :
+                        nullptr;
+
+    if(!scripts)
+        return species;
+
+    ScriptRunningSetup setup("void Species::restoreSavedSpecies(Species@, "
+                             "const string &in, const string &in)");
+    setup.FullDeclaration = true;
+
+    const auto result = scripts->ExecuteOnModule<void>(setup, false,
+        species.get(), species->stringCode, initialCompounds);
+
+    if(result.Result != SCRIPT_RUN_RESULT::Success)
+        throw Leviathan::InvalidState(
+            "failed to restore organelles of species: " + species->name);
+
+    return species;
+}
+
+void
+    thrive::savePatchMap(SaveWriter& writer, const PatchMap& map)
+{
+    // Patches are written in id order to make saves reproducible
+    std::map<int32_t, Patch::pointer> patches(
+        map.getPatches().begin(), map.getPatches().end());
+
+    // The species are shared between patches so they are written only once
+    std::vector<const Species*> species;
+
+    for(const auto& [id, patch] : patches) {
+        for(const auto& entry : patch->getSpecies()) {
+            if(std::find(species.begin(), species.end(),
+                   entry.species.get()) == species.end())
+                species.push_back(entry.species.get());
+        }
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(species.size()));
+
+    for(const auto* entry : species)
+        saveSpecies(writer, *entry);
+
+    writer.write(map.getCurrentPatchId());
+    writer.write<uint32_t>(static_cast<uint32_t>(patches.size()));
+
+    for(const auto& [id, patch] : patches) {
+
+        writer.write(id);
+        writer.writeString(patch->getName());
+        writer.writeString(patch->getBiomeTemplate().internalName);
+
+        const auto coordinates = patch->getScreenCoordinates();
+        writer.write(coordinates.X);
+        writer.write(coordinates.Y);
+
+        const auto& compounds = patch->getBiome().compounds;
+        writer.write<uint32_t>(static_cast<uint32_t>(compounds.size()));
+
+        for(const auto& [compoundId, data] : compounds) {
+            writer.writeString(
+                SimulationParameters::compoundRegistry.getInternalName(
+                    compoundId));
+            writer.write(data.amount);
+            writer.write(data.density);
+            writer.write(data.dissolved);
+        }
+
+        const auto& neighbours = patch->getNeighbours();
+        writer.write<uint32_t>(static_cast<uint32_t>(neighbours.size()));
+
+        for(auto neighbour : neighbours)
+            writer.write(neighbour);
+
+        writer.write<uint32_t>(
+            static_cast<uint32_t>(patch->getSpecies().size()));
+
+        for(const auto& entry : patch->getSpecies()) {
+            writer.write<uint32_t>(static_cast<uint32_t>(
+                std::find(species.begin(), species.end(),
+                    entry.species.get()) -
+                species.begin()));
+            writer.write<int32_t>(entry.population);
+        }
+    }
+}
+
+PatchMap::pointer
+    thrive::loadPatchMap(SaveReader& reader)
+{
+    const auto speciesCount = reader.read<uint32_t>();
+
+    if(speciesCount > MAX_SAVED_COUNT)
+        throw Leviathan::InvalidState("save has too many species");
+
+    std::vector<Species::pointer> species;
+    species.reserve(speciesCount);
+
+    for(uint32_t i = 0; i < speciesCount; ++i)
+        species.push_back(loadSpecies(reader));
+
+    auto map = PatchMap::MakeShared<PatchMap>();
+
+    const auto currentPatch = reader.read<int32_t>();
+    const auto patchCount = reader.read<uint32_t>();
+
+    if(patchCount > MAX_SAVED_COUNT)
+        throw Leviathan::InvalidState("save has too many patches");
+
+    for(uint32_t i = 0; i < patchCount; ++i) {
+
+        const auto id = reader.read<int32_t>();
+        const auto name = reader.readString();
+
+        auto patch = Patch::MakeShared<Patch>(name, id,
+            SimulationParameters::biomeRegistry.getTypeData(
+                reader.readString()));
+
+        Float2 coordinates;
+        coordinates.X = reader.read<float>();
+        coordinates.Y = reader.read<float>();
+        patch->setScreenCoordinates(coordinates);
+
+        auto& compounds = patch->getBiome().compounds;
+        compounds.clear();
+
+        const auto compoundCount = reader.read<uint32_t>();
+
+        for(uint32_t j = 0; j < compoundCount; ++j) {
+
+            const auto compoundId =
+                SimulationParameters::compoundRegistry.getTypeId(
+                    reader.readString());
+
+            BiomeCompoundData data;
+            data.amount = reader.read<float>();
+            data.density = reader.read<double>();
+            data.dissolved = reader.read<double>();
+
+            compounds[compoundId] = data;
+        }
+
+        const auto neighbourCount = reader.read<uint32_t>();
+
+        for(uint32_t j = 0; j < neighbourCount; ++j)
+            patch->addNeighbour(reader.read<int32_t>());
+
+        const auto patchSpeciesCount = reader.read<uint32_t>();
+
+        for(uint32_t j = 0; j < patchSpeciesCount; ++j) {
+
+            const auto index = reader.read<uint32_t>();
+            const auto population = reader.read<int32_t>();
+
+            if(index >= species.size())
+                throw Leviathan::InvalidState("save has invalid species index");
+
+            patch->addSpecies(species[index], population);
+        }
+
+        map->addPatch(patch);
+    }
+
+    if(!map->setCurrentPatch(currentPatch))
+        throw Leviathan::InvalidState("saved current patch doesn't exist");
+
+    return map;
+}
+// ------------------------------------ //
+// Microbes
+void
+    saveMicrobeScriptProperties(SaveWriter& writer, asIScriptObject& microbe)
+{
+    auto* engine = microbe.GetEngine();
+
+    for(const char* name : SAVED_MICROBE_SCRIPT_PROPERTIES) {
+
+        const auto index = findScriptProperty(microbe, name);
+
+        if(index < 0) {
+            writer.write<int32_t>(asTYPEID_VOID);
+            continue;
+        }
+
+        const auto typeId = microbe.GetPropertyTypeId(index);
+        const auto size = engine->GetSizeOfPrimitiveType(typeId);
+
+        writer.write<int32_t>(typeId);
+        writer.write<uint8_t>(static_cast<uint8_t>(size));
+        writer.writeRaw(microbe.GetAddressOfProperty(index), size);
+    }
+}
+
+void
+    loadMicrobeScriptProperties(SaveReader& reader, asIScriptObject* microbe)
+{
+    for(const char* name : SAVED_MICROBE_SCRIPT_PROPERTIES) {
+
+        const auto typeId = reader.read<int32_t>();
+
+        if(typeId == asTYPEID_VOID)
+            continue;
+
+        const auto size = reader.read<uint8_t>();
+
+        std::array<uint8_t, 8> value;
+
+        if(size > value.size())
+            throw Leviathan::InvalidState("saved script property is too large");
+
+        reader.readRaw(value.data(), size);
+
+        if(!microbe)
+            continue;
+
+        // The scripts may have changed since the save was made
+        const auto index = findScriptProperty(*microbe, name);
+
+        if(index < 0 || microbe->GetPropertyTypeId(index) != typeId) {
+            LOG_WARNING(std::string("Saved MicrobeComponent property "
+                                    "changed type or was removed: ") +
+                        name);
+            continue;
+        }
+
+        std::memcpy(microbe->GetAddressOfProperty(index), value.data(), size);
+    }
+}
+
+void
+    thrive::saveMicrobes(SaveWriter& writer,
+        CellStageWorld& world,
+        ObjectID player)
+{
+    auto microbeComponents = world.GetScriptComponentHolder("MicrobeComponent");
+
+    if(!microbeComponents)
+        throw Leviathan::InvalidState("world has no MicrobeComponents");
+
+    // The world keeps this alive
+    microbeComponents->Release();
+
+    std::vector<std::tuple<ObjectID, asIScriptObject*>> microbes;
+
+    for(ObjectID entity : world.GetEntities()) {
+
+        const auto* stats = world.GetComponentPtr_MicrobeStatsComponent(entity);
+
+        // Dormant microbes are pooled by the SpawnSystem and can be recreated
+        if(!stats || stats->dead || stats->dormant)
+            continue;
+
+        auto* microbe = microbeComponents->Find(entity);
+
+        if(!microbe)
+            continue;
+
+        // The holder keeps this alive
+        microbe->Release();
+        microbes.emplace_back(entity, microbe);
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(microbes.size()));
+
+    for(const auto& [entity, microbe] : microbes) {
+
+        // This is verified by PlayerHoverInfoSystem
+        const auto* species =
+            *static_cast<const Species**>(microbe->GetAddressOfProperty(0));
+
+        writer.writeString(species ? species->name : "");
+        writer.write(entity == player);
+
+        const auto& position = world.GetComponent_Position(entity);
+        writer.writeFloat3(position.Members._Position);
+        writer.writeFloat4(Float4(position.Members._Orientation.X,
+            position.Members._Orientation.Y, position.Members._Orientation.Z,
+            position.Members._Orientation.W));
+
+        const auto* spawned = world.GetComponentPtr_SpawnedComponent(entity);
+        writer.write<double>(spawned ? spawned->spawnRadiusSqr : 0.0);
+
+        const auto& bag = world.GetComponent_CompoundBagComponent(entity);
+        writer.write<uint32_t>(static_cast<uint32_t>(bag.compounds.size()));
+
+        for(const auto& [compoundId, data] : bag.compounds) {
+            writer.writeString(
+                SimulationParameters::compoundRegistry.getInternalName(
+                    compoundId));
+            writer.write(data.amount);
+        }
+
+        const auto& stats = world.GetComponent_MicrobeStatsComponent(entity);
+        writer.write(stats.hitpoints);
+        writer.write(stats.maxHitpoints);
+        writer.write(stats.remainingBandwidth);
+        writer.write(stats.agentEmissionCooldown);
+        writer.write(stats.compoundCollectionTimer);
+        writer.write(stats.pendingAgentDamage);
+        writer.write(stats.deathTimer);
+        writer.write(stats.movementFactor);
+        writer.write(stats.escapeInterval);
+        writer.write(stats.engulfMode);
+        writer.write(stats.hasEscaped);
+
+        saveMicrobeScriptProperties(writer, *microbe);
+    }
+}
+
+ObjectID
+    thrive::loadMicrobes(SaveReader& reader, CellStageWorld& world)
+{
+    auto* scripts = ThriveCommon::get()->getMicrobeScripts();
+
+    if(!scripts)
+        throw Leviathan::InvalidState("microbe scripts are not loaded");
+
+    auto microbeComponents = world.GetScriptComponentHolder("MicrobeComponent");
+
+    if(!microbeComponents)
+        throw Leviathan::InvalidState("world has no MicrobeComponents");
+
+    microbeComponents->Release();
+
+    ObjectID player = NULL_OBJECT;
+
+    const auto count = reader.read<uint32_t>();
+
+    if(count > MAX_SAVED_COUNT)
+        throw Leviathan::InvalidState("save has too many microbes");
+
+    for(uint32_t i = 0; i < count; ++i) {
+
+        const auto speciesName = reader.readString();
+        const auto isPlayer = reader.read<bool>();
+        const auto position = reader.readFloat3();
+        const auto orientation = reader.readFloat4();
+        const auto spawnRadiusSqr = reader.read<double>();
+
+        ScriptRunningSetup setup("ObjectID MicrobeOperations::spawnMicrobe("
+                                 "CellStageWorld@, Float3, const string &in, "
+                                 "bool, bool)");
+        setup.FullDeclaration = true;
+
+        const auto result = scripts->ExecuteOnModule<ObjectID>(
+            setup, false, &world, position, speciesName, !isPlayer, false);
+
+        ObjectID entity = NULL_OBJECT;
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+            LOG_ERROR("Failed to respawn saved microbe of species: " +
+                      speciesName);
+        } else {
+            entity = result.Value;
+        }
+
+        // The rest is still read to get to the next microbe
+        auto* bag = entity != NULL_OBJECT ?
+                        world.GetComponentPtr_CompoundBagComponent(entity) :
+                        nullptr;
+
+        if(bag) {
+            for(auto& [compoundId, data] : bag->compounds)
+                data.amount = 0;
+        }
+
+        const auto compoundCount = reader.read<uint32_t>();
+
+        for(uint32_t j = 0; j < compoundCount; ++j) {
+
+            const auto compoundName = reader.readString();
+            const auto amount = reader.read<double>();
+
+            if(bag)
+                bag->setCompound(
+                    SimulationParameters::compoundRegistry.getTypeId(
+                        compoundName),
+                    amount);
+        }
+
+        MicrobeStatsComponent ignoredStats;
+        auto* stats = entity != NULL_OBJECT ?
+                          world.GetComponentPtr_MicrobeStatsComponent(entity) :
+                          nullptr;
+
+        if(!stats)
+            stats = &ignoredStats;
+
+        stats->hitpoints = reader.read<float>();
+        stats->maxHitpoints = reader.read<float>();
+        stats->remainingBandwidth = reader.read<float>();
+        stats->agentEmissionCooldown = reader.read<float>();
+        stats->compoundCollectionTimer = reader.read<float>();
+        stats->pendingAgentDamage = reader.read<float>();
+        stats->deathTimer = reader.read<float>();
+        stats->movementFactor = reader.read<float>();
+        stats->escapeInterval = reader.read<float>();
+        stats->engulfMode = reader.read<bool>();
+        stats->hasEscaped = reader.read<bool>();
+
+        asIScriptObject* microbe =
+            entity != NULL_OBJECT ? microbeComponents->Find(entity) : nullptr;
+
+        if(microbe)
+            microbe->Release();
+
+        loadMicrobeScriptProperties(reader, microbe);
+
+        if(entity == NULL_OBJECT)
+            continue;
+
+        // Membrane health is updated by MicrobeStatsSystem when this differs
+        stats->previousHitpoints = -1;
+
+        auto& positionComponent = world.GetComponent_Position(entity);
+        positionComponent.Members._Orientation =
+            Quaternion(orientation.X, orientation.Y, orientation.Z,
+                orientation.W);
+        positionComponent.Marked = true;
+
+        auto* physics = world.GetComponentPtr_Physics(entity);
+
+        if(physics)
+            physics->JumpTo(positionComponent);
+
+        if(spawnRadiusSqr > 0 && !world.GetComponentPtr_SpawnedComponent(entity))
+            world.Create_SpawnedComponent(entity, spawnRadiusSqr);
+
+        if(isPlayer)
+            player = entity;
+    }
+
+    return player;
+}
+// ------------------------------------ //
+void
+    thrive::writeCellStageSave(std::ostream& stream,
+        CellStageWorld& world,
+        const PatchMap& map,
+        ObjectID player)
+{
+    CellStageSaveSnapshot snapshot;
+    takeCellStageSnapshot(snapshot, world, map, player);
+    writeCellStageSave(stream, snapshot);
+}
+
+void
+    thrive::takeCellStageSnapshot(CellStageSaveSnapshot& snapshot,
+        CellStageWorld& world,
+        const PatchMap& map,
+        ObjectID player)
+{
+    {
+        std::ostringstream stream;
+        SaveWriter writer(stream);
+        savePatchMap(writer, map);
+        snapshot.patchMap = stream.str();
+    }
+
+    {
+        std::ostringstream stream;
+        SaveWriter writer(stream);
+        saveMicrobes(writer, world, player);
+        snapshot.microbes = stream.str();
+    }
+
+    world.GetCompoundCloudSystem().takeSnapshot(snapshot.clouds);
+}
+
+void
+    thrive::writeCellStageSave(std::ostream& stream,
+        const CellStageSaveSnapshot& snapshot)
+{
+    SaveWriter writer(stream);
+    writer.writeHeader();
+
+    writer.beginSection(SAVE_SECTION::PATCH_MAP);
+    writer.writeRaw(snapshot.patchMap.data(), snapshot.patchMap.size());
+    writer.endSection();
+
+    writer.beginSection(SAVE_SECTION::MICROBES);
+    writer.writeRaw(snapshot.microbes.data(), snapshot.microbes.size());
+    writer.endSection();
+
+    writer.beginSection(SAVE_SECTION::COMPOUND_CLOUDS);
+    snapshot.clouds.write(writer);
+    writer.endSection();
+
+    writer.writeEnd();
+}
+// ------------------------------------ //
+// CellStageSaveLoader
+CellStageSaveLoader::CellStageSaveLoader(std::unique_ptr<std::istream>&& stream) :
+    m_stream(std::move(stream)), m_reader(*m_stream)
+{
+    if(!m_stream->good())
+        throw Leviathan::InvalidState("can't read save file");
+
+    m_reader.readHeader();
+}
+
+PatchMap::pointer
+    CellStageSaveLoader::loadPatchMap()
+{
+    SAVE_SECTION section;
+
+    if(!m_reader.nextSection(section) || section != SAVE_SECTION::PATCH_MAP)
+        throw Leviathan::InvalidState("save doesn't start with the patch map");
+
+    return thrive::loadPatchMap(m_reader);
+}
+
+bool
+    CellStageSaveLoader::loadNextSection(CellStageWorld& world)
+{
+    SAVE_SECTION section;
+
+    if(!m_reader.nextSection(section))
+        return false;
+
+    switch(section) {
+    case SAVE_SECTION::MICROBES:
+        m_player = loadMicrobes(m_reader, world);
+        break;
+    case SAVE_SECTION::COMPOUND_CLOUDS:
+        world.GetCompoundCloudSystem().loadClouds(world, m_reader);
+        break;
+    default:
+        LOG_WARNING("CellStageSaveLoader: skipping unknown save section: " +
+                    std::to_string(static_cast<uint32_t>(section)));
+    }
+
+    return true;
+}
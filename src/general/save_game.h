@@ -0,0 +1,293 @@
+#pragma once
+
+#include "microbe_stage/compound_cloud_system.h"
+#include "microbe_stage/patch.h"
+
+#include <Common/Types.h>
+#include <Entities/EntityCommon.h>
+
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace thrive {
+
+class CellStageWorld;
+
+//! The first bytes of every save file ("TRVS" when read as text)
+constexpr uint32_t SAVE_FILE_MAGIC = 0x53565254;
+
+//! Needs to be incremented whenever the layout of any section changes. Only
+//! saves of this version can be loaded, so also add the change here:
+//! - 1: first binary format, grids stored as raw floats
+//! - 2: grids stored with the lossless CloudGridCodec
+//! - 3: the engulfing state and death timer of microbes moved to
+//!   MicrobeStatsComponent
+constexpr uint32_t SAVE_FILE_VERSION = 3;
+
+//! The sections of a save file. They are written in this order. Loading skips
+//! sections it doesn't know about
+enum class SAVE_SECTION : uint32_t {
+    END = 0,
+    PATCH_MAP = 1,
+    MICROBES = 2,
+    COMPOUND_CLOUDS = 3
+};
+
+/**
+ * @brief Writes the binary data that save files are made of
+ *
+ * Values are written in the byte order of the host. All the platforms Thrive
+ * runs on are little endian.
+ */
+class SaveWriter {
+public:
+    SaveWriter(std::ostream& stream);
+
+    //! \brief Writes the magic and the version number
+    void
+        writeHeader();
+
+    //! \brief Starts a section. The section is buffered so that its length
+    //! can be written before it
+    void
+        beginSection(SAVE_SECTION section);
+
+    void
+        endSection();
+
+    //! \brief Writes the section that marks the end of the save
+    void
+        writeEnd();
+
+    template<typename T>
+    void
+        write(T value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "only plain values can be "
+                                               "written with this");
+        writeRaw(&value, sizeof(T));
+    }
+
+    void
+        writeString(const std::string& value);
+
+    void
+        writeFloat3(const Float3& value);
+
+    void
+        writeFloat4(const Float4& value);
+
+    //! \brief Writes a density grid of a cloud
+    //! \param data width * height values stored one column after another
+    //!
+    //! The grid is stored losslessly with CloudGridCodec so mostly empty
+    //! grids take little space
+    void
+        writeGrid(const float* data, uint32_t width, uint32_t height);
+
+    void
+        writeRaw(const void* data, size_t length);
+
+private:
+    std::ostream& m_stream;
+
+    //! Reused for encoding grids
+    std::string m_gridBuffer;
+
+    //! Contents of the current section
+    std::string m_section;
+    SAVE_SECTION m_sectionType = SAVE_SECTION::END;
+    bool m_inSection = false;
+};
+
+/**
+ * @brief Reads data written by SaveWriter
+ *
+ * The read methods throw Leviathan::InvalidState if the data is truncated or
+ * would go past the end of the current section. The file and section headers
+ * are read by readHeader and nextSection, everything else has to be inside a
+ * section
+ */
+class SaveReader {
+public:
+    SaveReader(std::istream& stream);
+
+    //! \exception Leviathan::InvalidState if this isn't a save or the version
+    //! is not supported
+    void
+        readHeader();
+
+    //! \brief Moves to the start of the next section
+    //!
+    //! Skips anything that was left unread in the current section
+    //! \returns False once the end of the save is reached
+    bool
+        nextSection(SAVE_SECTION& section);
+
+    //! \brief Skips the rest of the current section
+    void
+        skipSection();
+
+    template<typename T>
+    T
+        read()
+    {
+        static_assert(std::is_arithmetic_v<T>, "only plain values can be "
+                                               "read with this");
+        T value;
+        readRaw(&value, sizeof(T));
+        return value;
+    }
+
+    std::string
+        readString();
+
+    Float3
+        readFloat3();
+
+    Float4
+        readFloat4();
+
+    //! \brief Reads a density grid into grid
+    //! \exception Leviathan::InvalidState if the saved grid is not the same
+    //! size as grid
+    void
+        readGrid(std::vector<std::vector<float>>& grid);
+
+    //! \brief Skips over a density grid
+    void
+        skipGrid();
+
+    void
+        readRaw(void* data, size_t length);
+
+    //! \brief Skips length bytes of the current section
+    void
+        skipRaw(uint64_t length);
+
+    uint64_t
+        getSectionRemaining() const
+    {
+        return m_sectionRemaining;
+    }
+
+private:
+    //! \brief Reads a value that isn't inside a section, like the headers
+    template<typename T>
+    T
+        _readUnbounded()
+    {
+        T value;
+        _readStream(&value, sizeof(T));
+        return value;
+    }
+
+    //! \brief Reads from the stream without checking the section length
+    void
+        _readStream(void* data, size_t length);
+
+private:
+    std::istream& m_stream;
+
+    uint64_t m_sectionRemaining = 0;
+};
+
+//! \brief Writes the patch map and all the species in it
+void
+    savePatchMap(SaveWriter& writer, const PatchMap& map);
+
+//! \brief Reads a patch map written by savePatchMap
+//!
+//! The organelles of the species are recreated through the scripts. When the
+//! microbe scripts are not loaded only the stringCode is restored
+PatchMap::pointer
+    loadPatchMap(SaveReader& reader);
+
+//! \brief Writes all the alive microbes in world
+void
+    saveMicrobes(SaveWriter& writer, CellStageWorld& world, ObjectID player);
+
+//! \brief Respawns the microbes written by saveMicrobes
+//!
+//! The species of the microbes need to be in the current patch map of world
+//! \returns The player microbe or NULL_OBJECT if the save had no player
+ObjectID
+    loadMicrobes(SaveReader& reader, CellStageWorld& world);
+
+//! \brief Writes a full save of the cell stage to stream
+void
+    writeCellStageSave(std::ostream& stream,
+        CellStageWorld& world,
+        const PatchMap& map,
+        ObjectID player);
+
+/**
+ * @brief Loads a save one section at a time
+ *
+ * The world needs to be set up before loadPatchMap is called. After setting the
+ * patch map as the current one loadNextSection is called until it returns
+ * false, this allows spreading the loading over multiple frames
+ */
+class CellStageSaveLoader {
+public:
+    //! \exception Leviathan::InvalidState if the stream is not a save
+    CellStageSaveLoader(std::unique_ptr<std::istream>&& stream);
+
+    //! \brief Reads the first section of the save
+    PatchMap::pointer
+        loadPatchMap();
+
+    //! \brief Loads the next section into world
+    //! \returns False once everything is loaded
+    bool
+        loadNextSection(CellStageWorld& world);
+
+    //! \returns The loaded player microbe or NULL_OBJECT
+    ObjectID
+        getPlayer() const
+    {
+        return m_player;
+    }
+
+private:
+    std::unique_ptr<std::istream> m_stream;
+    SaveReader m_reader;
+
+    ObjectID m_player = NULL_OBJECT;
+};
+
+/**
+ * @brief A copy of the cell stage state that can be written to disk on a
+ * background thread
+ *
+ * The patch map and the microbes need the scripts so they are serialized
+ * when the snapshot is taken. They are small compared to the clouds which are
+ * just copied and encoded by writeCellStageSave
+ */
+struct CellStageSaveSnapshot {
+    std::string patchMap;
+    std::string microbes;
+    CompoundCloudsSnapshot clouds;
+};
+
+//! \brief Copies the state of the cell stage into snapshot
+//!
+//! The buffers already in snapshot are reused. Needs to be called on the main
+//! thread
+void
+    takeCellStageSnapshot(CellStageSaveSnapshot& snapshot,
+        CellStageWorld& world,
+        const PatchMap& map,
+        ObjectID player);
+
+//! \brief Writes a save from a snapshot. Can be called on any thread
+void
+    writeCellStageSave(std::ostream& stream,
+        const CellStageSaveSnapshot& snapshot);
+
+} // namespace thrive
@@ -1,5 +1,7 @@
 #include "general/timed_life_system.h"
 
+#include "engine/system_profiler.h"
+
 #include <Entities/GameWorld.h>
 
 using namespace thrive;
@@ -34,6 +36,8 @@ void
         std::unordered_map<ObjectID, TimedLifeComponent*>& components,
         float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(world, "TimedLifeSystem");
+
     for(auto& value : components) {
         TimedLifeComponent* timedLifeComponent = value.second;
         timedLifeComponent->m_timeToLive -= elapsed;
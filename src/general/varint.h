@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Exceptions.h>
+
+#include <cstdint>
+#include <string>
+
+namespace thrive {
+
+//! \brief Appends value as a LEB128 style variable length integer
+inline void
+    appendVarint(std::string& buffer, uint64_t value)
+{
+    while(value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    buffer.push_back(static_cast<char>(value));
+}
+
+//! \brief Reads a variable length integer written by appendVarint
+//! \param position Where to read from, is moved past the read integer
+//! \exception Leviathan::InvalidArgument if the data ends or is invalid
+inline uint64_t
+    readVarint(const std::string& buffer, size_t& position)
+{
+    uint64_t value = 0;
+
+    for(int shift = 0; shift < 64; shift += 7) {
+
+        if(position >= buffer.size())
+            throw Leviathan::InvalidArgument("varint goes past end of data");
+
+        const auto byte = static_cast<uint8_t>(buffer[position++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+        if((byte & 0x80) == 0)
+            return value;
+    }
+
+    throw Leviathan::InvalidArgument("invalid varint");
+}
+
+} // namespace thrive
@@ -0,0 +1,117 @@
+// ------------------------------------ //
+#include "gui_update_channel.h"
+
+#include <Engine.h>
+#include <Events/EventHandler.h>
+#include <Exceptions.h>
+
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+GuiUpdateChannel::GuiUpdateChannel() :
+    m_sender([](const Leviathan::GenericEvent::pointer& batch) {
+        Leviathan::Engine::Get()->GetEventHandler()->CallEvent(batch);
+    })
+{}
+
+GuiUpdateChannel::GuiUpdateChannel(Sender sender) : m_sender(std::move(sender))
+{
+    if(!m_sender)
+        throw Leviathan::InvalidArgument("GuiUpdateChannel needs a sender");
+}
+// ------------------------------------ //
+void
+    GuiUpdateChannel::post(const Leviathan::GenericEvent::pointer& event)
+{
+    ++m_stats.posted;
+
+    const auto type = event->GetType();
+    auto& topic = m_topics[type];
+
+    if(topic.pending) {
+        ++m_stats.coalesced;
+    } else {
+        m_queued.push_back(type);
+    }
+
+    topic.pending = event;
+}
+
+void
+    GuiUpdateChannel::flush()
+{
+    if(m_queued.empty())
+        return;
+
+    auto batch = Leviathan::GenericEvent::MakeShared<Leviathan::GenericEvent>(
+        "GuiUpdateBatch");
+
+    auto vars = batch->GetVariables();
+
+    // This lists the topics as some updates don't have any variables
+    auto topics = std::make_shared<Leviathan::NamedVariableList>("topics");
+    size_t topicCount = 0;
+
+    for(const auto& name : m_queued) {
+
+        auto& topic = m_topics[name];
+
+        Leviathan::GenericEvent::pointer event = std::move(topic.pending);
+
+        // The serialized form covers the names, types and values
+        auto serialized = event->GetVariables()->Serialize();
+
+        if(topic.sentOnce && serialized == topic.lastSent) {
+            ++m_stats.unchanged;
+            continue;
+        }
+
+        topic.lastSent = std::move(serialized);
+        topic.sentOnce = true;
+
+        topics->PushValue(std::make_unique<Leviathan::VariableBlock>(
+            new Leviathan::StringBlock(name)));
+        ++topicCount;
+
+        for(const auto& variable : *event->GetVariables()->GetVec()) {
+
+            auto copy =
+                std::make_shared<Leviathan::NamedVariableList>(*variable);
+            copy->SetName(name + "." + variable->GetName());
+            vars->Add(copy);
+        }
+
+        ++m_stats.sent;
+    }
+
+    m_queued.clear();
+
+    if(topicCount == 0)
+        return;
+
+    vars->Add(topics);
+
+    ++m_stats.batches;
+    m_sender(batch);
+}
+
+void
+    GuiUpdateChannel::reset()
+{
+    m_topics.clear();
+    m_queued.clear();
+}
+// ------------------------------------ //
+std::string
+    GuiUpdateChannel::formatStats() const
+{
+    std::stringstream stream;
+
+    stream << "posted: " << m_stats.posted
+           << ", coalesced: " << m_stats.coalesced
+           << ", unchanged: " << m_stats.unchanged
+           << ", sent: " << m_stats.sent << ", batches: " << m_stats.batches;
+
+    return stream.str();
+}
@@ -0,0 +1,103 @@
+// Thrive Game
+// Copyright (C) 2013-2019  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+//! \file The channel for sending frequent state updates to the GUI
+
+#include <Events/Event.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace thrive {
+
+/**
+ * @brief Sends frequent GUI state updates at most once per tick
+ *
+ * Only the latest update of each topic is kept until flush is called. Updates
+ * that are the same as the last one sent for their topic are dropped and the
+ * rest are sent together as a single GuiUpdateBatch event, so that they
+ * reach the GUI process in one message. gui_common.mjs splits the batch back
+ * into the topics for the handlers registered with onGuiUpdate.
+ * \note This is only for state that the GUI displays. One off notifications
+ * need to be sent with EventHandler::CallEvent to not get dropped
+ */
+class GuiUpdateChannel {
+public:
+    struct Stats {
+        uint64_t posted = 0;
+
+        //! Replaced by a later update of the same topic before being sent
+        uint64_t coalesced = 0;
+
+        //! Same as the previously sent update of the topic
+        uint64_t unchanged = 0;
+
+        uint64_t sent = 0;
+        uint64_t batches = 0;
+    };
+
+    //! Receives the GuiUpdateBatch events
+    using Sender =
+        std::function<void(const Leviathan::GenericEvent::pointer& batch)>;
+
+    //! \brief Creates a channel that sends the batches to the GUI through the
+    //! event handler of the engine
+    GuiUpdateChannel();
+
+    //! \brief Creates a channel that gives the batches to sender
+    //! \exception Leviathan::InvalidArgument if sender is empty
+    GuiUpdateChannel(Sender sender);
+
+    //! \brief Queues event to be sent on the next flush
+    //!
+    //! The type of the event is used as the topic. The variables of the event
+    //! shouldn't be changed after this
+    void
+        post(const Leviathan::GenericEvent::pointer& event);
+
+    //! \brief Sends the queued updates that have changed
+    void
+        flush();
+
+    //! \brief Drops the queued updates and forgets what has been sent
+    //!
+    //! Needs to be called when the GUI is switched so that it gets the full
+    //! state again
+    void
+        reset();
+
+    const Stats&
+        getStats() const
+    {
+        return m_stats;
+    }
+
+    //! \returns The stats as a line for logging
+    std::string
+        formatStats() const;
+
+private:
+    struct Topic {
+        Leviathan::GenericEvent::pointer pending;
+
+        //! The serialized variables of the last sent update
+        std::string lastSent;
+        bool sentOnce = false;
+    };
+
+    const Sender m_sender;
+
+    //! The slots are kept between flushes so that the steady stream of updates
+    //! from the HUD doesn't keep allocating new ones
+    std::unordered_map<std::string, Topic> m_topics;
+
+    //! Topics with a pending update in the order they were first posted
+    std::vector<std::string> m_queued;
+
+    Stats m_stats;
+};
+
+} // namespace thrive
@@ -0,0 +1,362 @@
+// ------------------------------------ //
+#include "js_call_dispatcher.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+namespace {
+
+template<class Entry>
+const Entry*
+    findEntry(const std::unordered_map<uint64_t, Entry>& entries,
+        const std::string& name)
+{
+    const auto found = entries.find(JSCallDispatcher::hashName(name));
+
+    // Different names could have the same hash
+    if(found == entries.end() || found->second.name != name)
+        return nullptr;
+
+    return &found->second;
+}
+
+template<class Entry>
+Entry*
+    findEntry(std::unordered_map<uint64_t, Entry>& entries,
+        const std::string& name)
+{
+    const auto& constEntries = entries;
+    return const_cast<Entry*>(findEntry(constEntries, name));
+}
+
+template<class Entry>
+void
+    checkNameIsFree(const std::unordered_map<uint64_t, Entry>& entries,
+        const std::string& name,
+        uint64_t hash)
+{
+    const auto found = entries.find(hash);
+
+    if(found == entries.end())
+        return;
+
+    if(found->second.name == name)
+        throw Leviathan::InvalidArgument(
+            "JS function or query is already registered: " + name);
+
+    throw Leviathan::InvalidArgument("JS function or query name " + name +
+                                     " has the same hash as " +
+                                     found->second.name);
+}
+
+//! \brief Adds the time until destruction to stats
+class CallTimer {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    CallTimer(JSCallDispatcher::Stats& stats) :
+        m_stats(stats), m_start(Clock::now())
+    {}
+
+    ~CallTimer()
+    {
+        const std::chrono::nanoseconds duration = Clock::now() - m_start;
+
+        ++m_stats.calls;
+        m_stats.total += duration;
+        m_stats.max = std::max(m_stats.max, duration);
+    }
+
+    CallTimer(const CallTimer& other) = delete;
+    CallTimer&
+        operator=(const CallTimer& other) = delete;
+
+private:
+    JSCallDispatcher::Stats& m_stats;
+    const Clock::time_point m_start;
+};
+
+void
+    formatStatsLine(std::stringstream& stream,
+        const std::string& name,
+        const JSCallDispatcher::Stats& stats)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    stream << name << ": calls: " << stats.calls
+           << ", rejected: " << stats.rejected << ", avg: "
+           << (stats.calls > 0 ?
+                      Milliseconds(stats.total).count() / stats.calls :
+                      0)
+           << " ms, max: " << Milliseconds(stats.max).count() << " ms\n";
+}
+
+} // namespace
+// ------------------------------------ //
+const char*
+    thrive::jsArgumentTypeName(JS_ARGUMENT_TYPE type)
+{
+    switch(type) {
+    case JS_ARGUMENT_TYPE::BOOL: return "bool";
+    case JS_ARGUMENT_TYPE::INT: return "int";
+    case JS_ARGUMENT_TYPE::DOUBLE: return "double";
+    case JS_ARGUMENT_TYPE::STRING: return "string";
+    }
+
+    return "unknown";
+}
+// ------------------------------------ //
+// JSCallArguments
+JS_ARGUMENT_TYPE
+    JSCallArguments::getType(size_t index) const
+{
+    // The variant alternatives are in the same order as the enum
+    return static_cast<JS_ARGUMENT_TYPE>(_get(index).index());
+}
+
+bool
+    JSCallArguments::getBool(size_t index) const
+{
+    const auto* value = std::get_if<bool>(&_get(index));
+
+    if(!value)
+        throw Leviathan::InvalidArgument(
+            "JS argument " + std::to_string(index) + " is not a bool");
+
+    return *value;
+}
+
+int32_t
+    JSCallArguments::getInt(size_t index) const
+{
+    const auto* value = std::get_if<int32_t>(&_get(index));
+
+    if(!value)
+        throw Leviathan::InvalidArgument(
+            "JS argument " + std::to_string(index) + " is not an int");
+
+    return *value;
+}
+
+double
+    JSCallArguments::getDouble(size_t index) const
+{
+    const auto& value = _get(index);
+
+    if(const auto* integer = std::get_if<int32_t>(&value); integer)
+        return *integer;
+
+    const auto* number = std::get_if<double>(&value);
+
+    if(!number)
+        throw Leviathan::InvalidArgument(
+            "JS argument " + std::to_string(index) + " is not a number");
+
+    return *number;
+}
+
+const std::string&
+    JSCallArguments::getString(size_t index) const
+{
+    const auto* value = std::get_if<std::string>(&_get(index));
+
+    if(!value)
+        throw Leviathan::InvalidArgument(
+            "JS argument " + std::to_string(index) + " is not a string");
+
+    return *value;
+}
+
+const JSCallArguments::Value&
+    JSCallArguments::_get(size_t index) const
+{
+    if(index >= m_values.size())
+        throw Leviathan::InvalidArgument(
+            "JS argument index out of range: " + std::to_string(index));
+
+    return m_values[index];
+}
+// ------------------------------------ //
+// JSCallDispatcher
+void
+    JSCallDispatcher::registerFunction(const std::string& name,
+        std::vector<JS_ARGUMENT_TYPE> arguments,
+        FunctionHandler handler,
+        bool checkArguments)
+{
+    const auto hash = hashName(name);
+    checkNameIsFree(m_functions, name, hash);
+
+    if(!handler)
+        throw Leviathan::InvalidArgument("JS function has no handler: " + name);
+
+    m_functions[hash] = Function{
+        name, std::move(arguments), checkArguments, std::move(handler), {}};
+}
+
+void
+    JSCallDispatcher::registerQuery(const std::string& name,
+        int securityLevel,
+        QueryHandler handler)
+{
+    const auto hash = hashName(name);
+    checkNameIsFree(m_queries, name, hash);
+
+    if(!handler)
+        throw Leviathan::InvalidArgument("JS query has no handler: " + name);
+
+    m_queries[hash] = Query{name, securityLevel, std::move(handler), {}};
+}
+// ------------------------------------ //
+const std::vector<JS_ARGUMENT_TYPE>*
+    JSCallDispatcher::getArgumentTypes(const std::string& name) const
+{
+    const auto* function = findEntry(m_functions, name);
+
+    if(!function || !function->checkArguments)
+        return nullptr;
+
+    return &function->arguments;
+}
+
+std::string
+    JSCallDispatcher::formatArgumentTypes(
+        const std::vector<JS_ARGUMENT_TYPE>& types)
+{
+    if(types.empty())
+        return "nothing";
+
+    std::string result;
+
+    for(const auto type : types) {
+
+        if(!result.empty())
+            result += ", ";
+
+        result += jsArgumentTypeName(type);
+    }
+
+    return result;
+}
+// ------------------------------------ //
+bool
+    JSCallDispatcher::callFunction(const std::string& name,
+        const JSCallArguments& arguments)
+{
+    auto* function = findEntry(m_functions, name);
+
+    if(!function)
+        return false;
+
+    if(function->checkArguments && !_checkArguments(*function, arguments)) {
+
+        LOG_ERROR("JSCallDispatcher: invalid arguments for " + name +
+                  ", expected: " + formatArgumentTypes(function->arguments));
+        ++function->stats.rejected;
+        return true;
+    }
+
+    CallTimer timer(function->stats);
+    function->handler(arguments);
+    return true;
+}
+
+int
+    JSCallDispatcher::getQuerySecurityLevel(const std::string& name) const
+{
+    const auto* query = findEntry(m_queries, name);
+    return query ? query->securityLevel : -1;
+}
+
+bool
+    JSCallDispatcher::runQuery(const std::string& name, std::string& result)
+{
+    auto* query = findEntry(m_queries, name);
+
+    if(!query)
+        return false;
+
+    CallTimer timer(query->stats);
+    result = query->handler();
+    return true;
+}
+// ------------------------------------ //
+const JSCallDispatcher::Stats&
+    JSCallDispatcher::getStats(const std::string& name) const
+{
+    if(const auto* function = findEntry(m_functions, name); function)
+        return function->stats;
+
+    if(const auto* query = findEntry(m_queries, name); query)
+        return query->stats;
+
+    throw Leviathan::NotFound("no JS function or query named: " + name);
+}
+
+std::string
+    JSCallDispatcher::formatStats() const
+{
+    // Sorted by name to keep the order stable
+    std::vector<std::pair<std::string, const Stats*>> called;
+
+    for(const auto& [hash, function] : m_functions) {
+        if(function.stats.calls > 0 || function.stats.rejected > 0)
+            called.emplace_back(function.name, &function.stats);
+    }
+
+    for(const auto& [hash, query] : m_queries) {
+        if(query.stats.calls > 0)
+            called.emplace_back(query.name, &query.stats);
+    }
+
+    std::sort(called.begin(), called.end());
+
+    std::stringstream stream;
+
+    for(const auto& [name, stats] : called)
+        formatStatsLine(stream, name, *stats);
+
+    return stream.str();
+}
+
+uint64_t
+    JSCallDispatcher::hashName(const std::string& name)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+
+    for(const auto character : name) {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+// ------------------------------------ //
+bool
+    JSCallDispatcher::_checkArguments(const Function& function,
+        const JSCallArguments& arguments)
+{
+    if(arguments.size() != function.arguments.size())
+        return false;
+
+    for(size_t i = 0; i < arguments.size(); ++i) {
+
+        const auto expected = function.arguments[i];
+        const auto type = arguments.getType(i);
+
+        // JavaScript numbers that happen to be whole are sent as ints
+        if(expected == JS_ARGUMENT_TYPE::DOUBLE &&
+            type == JS_ARGUMENT_TYPE::INT)
+            continue;
+
+        if(type != expected)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,182 @@
+// Thrive Game
+// Copyright (C) 2013-2019  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+//! \file Table of the functions and queries the GUI can call in the main
+//! process
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace thrive {
+
+enum class JS_ARGUMENT_TYPE : uint8_t { BOOL, INT, DOUBLE, STRING };
+
+//! \returns The name of type for error messages
+const char*
+    jsArgumentTypeName(JS_ARGUMENT_TYPE type);
+
+//! \brief Arguments of a call from the GUI converted to C++ types
+class JSCallArguments {
+public:
+    using Value = std::variant<bool, int32_t, double, std::string>;
+
+    void
+        add(Value value)
+    {
+        m_values.push_back(std::move(value));
+    }
+
+    size_t
+        size() const
+    {
+        return m_values.size();
+    }
+
+    JS_ARGUMENT_TYPE
+        getType(size_t index) const;
+
+    //! \exception Leviathan::InvalidArgument if index is out of range or the
+    //! argument has a different type
+    bool
+        getBool(size_t index) const;
+
+    //! \copydoc getBool
+    int32_t
+        getInt(size_t index) const;
+
+    //! \copydoc getBool
+    //! \note Int arguments are also accepted as JavaScript doesn't separate
+    //! them
+    double
+        getDouble(size_t index) const;
+
+    //! \copydoc getBool
+    const std::string&
+        getString(size_t index) const;
+
+private:
+    const Value&
+        _get(size_t index) const;
+
+private:
+    std::vector<Value> m_values;
+};
+
+/**
+ * @brief Resolves the calls the GUI makes by name
+ *
+ * The names are hashed once when registering so each call only hashes the
+ * incoming name once. The argument types declared for a function are checked
+ * before the handler is called so the handlers can use the typed getters
+ * without worrying about what the GUI sent. The time taken by each handler is
+ * recorded.
+ *
+ * The builtin functions are registered in thrive_js_interface.cpp. Other
+ * C++ code and scripts can add their own at startup, which the GUI calls with
+ * Thrive.call(name, ...).
+ */
+class JSCallDispatcher {
+public:
+    using FunctionHandler = std::function<void(const JSCallArguments&)>;
+    using QueryHandler = std::function<std::string()>;
+
+    struct Stats {
+        uint64_t calls = 0;
+
+        //! Calls that didn't match the declared arguments
+        uint64_t rejected = 0;
+
+        std::chrono::nanoseconds total = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds max = std::chrono::nanoseconds(0);
+    };
+
+    //! \brief Adds a function the GUI can call
+    //! \param arguments The types of the arguments. When checkArguments is
+    //! false the handler is responsible for checking them
+    //! \exception Leviathan::InvalidArgument if name is already registered
+    void
+        registerFunction(const std::string& name,
+            std::vector<JS_ARGUMENT_TYPE> arguments,
+            FunctionHandler handler,
+            bool checkArguments = true);
+
+    //! \brief Adds a query that returns a string to the GUI
+    //! \param securityLevel The Leviathan::GUI::VIEW_SECURITYLEVEL the view
+    //! needs for this
+    //! \exception Leviathan::InvalidArgument if name is already registered
+    void
+        registerQuery(const std::string& name,
+            int securityLevel,
+            QueryHandler handler);
+
+    //! \returns The declared argument types of a function or null if there
+    //! isn't one with name or the arguments aren't checked
+    const std::vector<JS_ARGUMENT_TYPE>*
+        getArgumentTypes(const std::string& name) const;
+
+    //! \returns The argument types formatted like "string, bool"
+    static std::string
+        formatArgumentTypes(const std::vector<JS_ARGUMENT_TYPE>& types);
+
+    //! \brief Calls the handler of name
+    //! \returns False if there is no function with name
+    //! \note Arguments not matching the declared ones are logged and the
+    //! handler isn't called, but true is still returned
+    bool
+        callFunction(const std::string& name, const JSCallArguments& arguments);
+
+    //! \returns The security level a view needs to run the query or -1 if
+    //! there is no query with name
+    int
+        getQuerySecurityLevel(const std::string& name) const;
+
+    //! \brief Runs a query
+    //! \returns False if there is no query with name
+    //! \note The caller needs to check the security level
+    bool
+        runQuery(const std::string& name, std::string& result);
+
+    //! \returns The stats of the function or query called name
+    //! \exception Leviathan::NotFound if there isn't one
+    const Stats&
+        getStats(const std::string& name) const;
+
+    //! \returns A line for each function and query that has been called
+    std::string
+        formatStats() const;
+
+    static uint64_t
+        hashName(const std::string& name);
+
+private:
+    struct Function {
+        std::string name;
+        std::vector<JS_ARGUMENT_TYPE> arguments;
+        bool checkArguments;
+        FunctionHandler handler;
+        Stats stats;
+    };
+
+    struct Query {
+        std::string name;
+        int securityLevel;
+        QueryHandler handler;
+        Stats stats;
+    };
+
+    //! \returns True if arguments match the declared ones
+    static bool
+        _checkArguments(const Function& function,
+            const JSCallArguments& arguments);
+
+private:
+    std::unordered_map<uint64_t, Function> m_functions;
+    std::unordered_map<uint64_t, Query> m_queries;
+};
+
+} // namespace thrive
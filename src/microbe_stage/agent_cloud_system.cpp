@@ -1,143 +1,443 @@
 #include "microbe_stage/agent_cloud_system.h"
-// #include "microbe_stage/membrane_system.h"
-
-// #include "bullet/collision_system.h"
-// #include "bullet/rigid_body_system.h"
-// #include "engine/component_factory.h"
-// #include "engine/engine.h"
-// #include "engine/entity_filter.h"
-// #include "engine/entity.h"
-// #include "engine/game_state.h"
-// #include "engine/player_data.h"
-// #include "engine/serialization.h"
-// #include "game.h"
-// #include "ogre/scene_node_system.h"
-// #include "scripting/luajit.h"
-// #include "util/make_unique.h"
-
-// #include <iostream>
-// #include <errno.h>
-// #include <stdio.h>
-// #include <OgreMeshManager.h>
-// #include <OgreMaterialManager.h>
-// #include <OgreMaterial.h>
-// #include <OgreTextureManager.h>
-// #include <OgreTechnique.h>
-// #include <OgreRoot.h>
-// #include <OgreSubMesh.h>
-
-// #include <string.h>
-// #include <cstdio>
-
-// #include <chrono>
-
-#include <Entities/GameWorld.h>
+
+#include "microbe_stage/membrane_system.h"
+#include "microbe_stage/microbe_stats_system.h"
+#include "microbe_stage/simulation_parameters.h"
+
+#include "ThriveGame.h"
+
+#include "engine/player_data.h"
+#include "generated/cell_stage_world.h"
+
+#include <Rendering/GeometryHelpers.h>
+#include <Rendering/Graphics.h>
+#include <bsfCore/Image/BsTexture.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
 
 using namespace thrive;
 
+constexpr auto AGENT_TEXTURE_BYTES_PER_ELEMENT = 4;
+constexpr auto AGENT_BS_PIXEL_FORMAT = bs::PF_RGBA8;
+
 ////////////////////////////////////////////////////////////////////////////////
 // AgentCloudComponent
 ////////////////////////////////////////////////////////////////////////////////
-
-// void AgentCloudComponent::luaBindings(
-//     sol::state &lua
-// ){
-//     lua.new_usertype<AgentCloudComponent>("AgentCloudComponent",
-
-//         "new", sol::factories([](){
-//                 return std::make_unique<AgentCloudComponent>();
-//             }),
-
-//         COMPONENT_BINDINGS(AgentCloudComponent),
-
-//         "initialize", &AgentCloudComponent::initialize,
-//         "direction", &AgentCloudComponent::direction,
-//         "potency", &AgentCloudComponent::potency,
-//         "width", sol::readonly(&AgentCloudComponent::width),
-//         "height", sol::readonly(&AgentCloudComponent::height),
-//         "gridSize", sol::readonly(&AgentCloudComponent::gridSize)
-//     );
-// }
-
-AgentCloudComponent::AgentCloudComponent(CompoundId id,
-    float red,
-    float green,
-    float blue) :
+AgentCloudComponent::AgentCloudComponent(AgentCloudSystem& owner,
+    CompoundId compoundId,
+    const Float3& position) :
     Leviathan::Component(TYPE),
-    color(red, green, blue, 1.f), m_compoundId(id)
-{}
-
-// void
-// AgentCloudComponent::load(
-//     const StorageContainer& storage
-// ) {
-//     Component::load(storage);
+    m_position(position), m_compoundId(compoundId), m_owner(owner)
+{
+    m_density.resize(CLOUD_SIMULATION_WIDTH,
+        std::vector<float>(CLOUD_SIMULATION_HEIGHT, 0));
+    m_oldDens.resize(CLOUD_SIMULATION_WIDTH,
+        std::vector<float>(CLOUD_SIMULATION_HEIGHT, 0));
+    m_emitters.resize(CLOUD_SIMULATION_WIDTH,
+        std::vector<uint32_t>(CLOUD_SIMULATION_HEIGHT, 0));
+}
 
-//     m_compoundId = storage.get<CompoundId>("id", NULL_COMPOUND);
-//     color = storage.get<Ogre::ColourValue>("color",
-//     Ogre::ColourValue(0,0,0)); width = storage.get<int>("width", 0); height =
-//     storage.get<int>("height", 0); gridSize = storage.get<float>("gridSize",
-//     0.0);
+AgentCloudComponent::~AgentCloudComponent()
+{
+    LEVIATHAN_ASSERT(
+        !m_sceneNode && !m_renderable, "AgentCloudComponent not Released");
 
+    m_owner.tileReportDestroyed(this);
+}
 
-// }
+void
+    AgentCloudComponent::Release(Leviathan::Scene* scene)
+{
+    if(m_renderable) {
+        m_renderable->DetachFromParent();
+        m_renderable = nullptr;
+    }
 
-// StorageContainer
-// AgentCloudComponent::storage() const {
-//     StorageContainer storage = Component::storage();
+    if(m_sceneNode) {
+        m_sceneNode->DetachFromParent();
+        m_sceneNode = nullptr;
+    }
+}
+// ------------------------------------ //
+void
+    AgentCloudComponent::addAgent(float amount,
+        size_t x,
+        size_t y,
+        uint32_t emitterTag)
+{
+    const float added = amount * AGENT_FIELD_DENSITY_SCALE;
 
-//     storage.set<CompoundId>("id", m_compoundId);
-//     storage.set<Ogre::ColourValue>("color", color);
-//     storage.set<int>("width", width);
-//     storage.set<int>("height", height);
-//     storage.set<float>("gridSize", gridSize);
+    // The stronger agent decides who is immune in a grid cell
+    if(m_density[x][y] < added)
+        m_emitters[x][y] = emitterTag;
 
-//     return storage;
-// }
+    m_density[x][y] += added;
+    m_totalDensity += added;
+}
 
 float
-    AgentCloudComponent::getPotency()
+    AgentCloudComponent::takeAgent(size_t x, size_t y, uint32_t immuneTag)
 {
+    const float density = m_density[x][y];
 
-    // if (x >= 0 && x < width && y >= 0 && y < height)
-    //{
-    //    return static_cast<int>(density[x][y]);
-    //}
+    if(density <= 0 || m_emitters[x][y] == immuneTag)
+        return 0;
 
-    return potency;
+    m_density[x][y] = 0;
+    m_emitters[x][y] = 0;
+    m_totalDensity -= density;
+
+    return density / AGENT_FIELD_DENSITY_SCALE;
+}
+
+float
+    AgentCloudComponent::amountAt(size_t x, size_t y) const
+{
+    return m_density[x][y] / AGENT_FIELD_DENSITY_SCALE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // AgentCloudSystem
 ////////////////////////////////////////////////////////////////////////////////
+void
+    AgentCloudSystem::Init(CellStageWorld& world)
+{
+    // Skip if no graphics
+    if(!Engine::Get()->IsInGraphicalMode())
+        return;
+
+    m_planeMesh = Leviathan::GeometryHelpers::CreateXZPlane(
+        CLOUD_X_EXTENT, CLOUD_Y_EXTENT);
+
+    m_perlinNoise = Leviathan::Texture::MakeShared<Leviathan::Texture>(
+        Engine::Get()->GetGraphics()->LoadTextureByName("PerlinNoise.jpg"));
+
+    LEVIATHAN_ASSERT(m_perlinNoise, "failed to load perlin noise texture");
+}
 
 void
-    AgentCloudSystem::Run(GameWorld& world)
+    AgentCloudSystem::Release(CellStageWorld& world)
 {
-    // const int dt = Leviathan::TICKSPEED;
+    emptyAllAgents(world);
 
-    auto& index = CachedComponents.GetIndex();
-    for(auto iter = index.begin(); iter != index.end(); ++iter) {
+    m_planeMesh = nullptr;
+    m_perlinNoise = nullptr;
+}
+// ------------------------------------ //
+uint32_t
+    AgentCloudSystem::speciesTag(const std::string& speciesName)
+{
+    // 0 is reserved for no emitter
+    return static_cast<uint32_t>(std::hash<std::string>()(speciesName)) | 1;
+}
 
-        // This does not work currently, don't do anything with this
-        DEBUG_BREAK;
+void
+    AgentCloudSystem::emitAgent(CellStageWorld& world,
+        CompoundId agent,
+        const Float3& position,
+        const Float3& direction,
+        float amount,
+        const std::string& emitterSpecies)
+{
+    if(amount <= 0)
+        return;
+
+    const auto tag = speciesTag(emitterSpecies);
+    const auto normalized = direction.HAddAbs() > 0 ?
+                                direction.Normalize() :
+                                Float3(0, 0, 1);
+
+    // One point per grid cell along the spray
+    constexpr auto steps =
+        static_cast<int>(AGENT_EMISSION_RANGE / CLOUD_RESOLUTION) + 1;
+
+    const float amountPerStep = amount / steps;
 
-        // Leviathan::Position& position = std::get<0>(*iter->second);
-        // AgentCloudComponent& agent = std::get<1>(*iter->second);
-        // Leviathan::RenderNode& renderNode = std::get<2>(*iter->second);
+    for(int i = 0; i < steps; ++i) {
 
+        const auto point = position + normalized * (i * CLOUD_RESOLUTION);
 
-        // if(agent.potency > 0.5) {
-        //     agent.potency *= .99;
-        // } else {
-        //     world.DestroyEntity(iter->first);
-        //     continue;
-        // }
+        AgentCloudComponent& tile = _getOrCreateTile(world, agent, point);
 
-        // position.Members._Position += agent.direction * (dt / 1000.f);
-        // position.Marked = true;
+        const auto [x, y] = CompoundCloudSystem::convertWorldToCloudLocal(
+            tile.m_position, point);
 
-        // renderNode.Scale = Float3(agent.potency);
-        // renderNode.Marked = true;
+        tile.addAgent(amountPerStep, x, y, tag);
     }
 }
+
+float
+    AgentCloudSystem::amountAt(CompoundId agent,
+        const Float3& worldPosition) const
+{
+    for(const auto& [id, tile] : m_managedTiles) {
+
+        if(tile->m_compoundId != agent ||
+            !CompoundCloudSystem::cloudContainsPosition(
+                tile->m_position, worldPosition))
+            continue;
+
+        const auto [x, y] = CompoundCloudSystem::convertWorldToCloudLocal(
+            tile->m_position, worldPosition);
+
+        return tile->amountAt(x, y);
+    }
+
+    return 0;
+}
+
+void
+    AgentCloudSystem::emptyAllAgents(CellStageWorld& world)
+{
+    // The destruction callback unregisters them so they are deleted like this
+    while(!m_managedTiles.empty()) {
+
+        world.DestroyEntity(m_managedTiles.begin()->first);
+    }
+}
+// ------------------------------------ //
+void
+    AgentCloudSystem::Run(CellStageWorld& world, float elapsed)
+{
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "AgentCloudSystem");
+
+    if(!world.GetNetworkSettings().IsAuthoritative)
+        return;
+
+    if(m_managedTiles.empty())
+        return;
+
+    for(const auto& [id, tile] : m_managedTiles) {
+
+        if(tile->m_queuedForRemoval)
+            continue;
+
+        _processTile(*tile, elapsed, world.GetFluidSystem());
+
+        if(tile->m_totalDensity < 1) {
+
+            tile->m_queuedForRemoval = true;
+            world.QueueDestroyEntity(id);
+        }
+    }
+
+    _applyDamage();
+}
+
+void
+    AgentCloudSystem::_processTile(AgentCloudComponent& tile,
+        float elapsed,
+        FluidSystem& fluidSystem)
+{
+    // Same scaling as CompoundCloudSystem::processCloud
+    const Float2 pos(tile.m_position.X, tile.m_position.Z);
+
+    CompoundCloudSystem::diffuse(
+        0.007f, tile.m_oldDens, tile.m_density, elapsed * 100.f);
+    CompoundCloudSystem::advect(
+        tile.m_oldDens, tile.m_density, elapsed * 100.f, fluidSystem, pos);
+
+    const float decay = std::max(1.f - AGENT_FIELD_DECAY_RATE * elapsed, 0.f);
+
+    float total = 0;
+
+    for(int x = 0; x < CLOUD_SIMULATION_WIDTH; ++x) {
+        for(int y = 0; y < CLOUD_SIMULATION_HEIGHT; ++y) {
+
+            float& density = tile.m_density[x][y];
+            density *= decay;
+
+            if(density < 1) {
+                density = 0;
+                tile.m_emitters[x][y] = 0;
+                continue;
+            }
+
+            total += density;
+
+            // The agent that moved here takes the emitter from a neighbour
+            uint32_t& emitter = tile.m_emitters[x][y];
+
+            if(emitter == 0) {
+                if(x > 0 && tile.m_emitters[x - 1][y] != 0) {
+                    emitter = tile.m_emitters[x - 1][y];
+                } else if(x + 1 < CLOUD_SIMULATION_WIDTH &&
+                          tile.m_emitters[x + 1][y] != 0) {
+                    emitter = tile.m_emitters[x + 1][y];
+                } else if(y > 0 && tile.m_emitters[x][y - 1] != 0) {
+                    emitter = tile.m_emitters[x][y - 1];
+                } else if(y + 1 < CLOUD_SIMULATION_HEIGHT &&
+                          tile.m_emitters[x][y + 1] != 0) {
+                    emitter = tile.m_emitters[x][y + 1];
+                }
+            }
+        }
+    }
+
+    tile.m_totalDensity = total;
+
+    // No graphics check
+    if(!tile.m_texture || tile.m_textureData->isLocked())
+        return;
+
+    CompoundCloudSystem::fillCloudChannel(tile.m_density, 0,
+        tile.m_textureData->getRowPitch(), tile.m_textureData->getData());
+
+    tile.m_texture->GetInternal()->writeData(tile.m_textureData, 0, 0, true);
+}
+
+void
+    AgentCloudSystem::_applyDamage()
+{
+    for(auto& value : CachedComponents.GetIndex()) {
+
+        MicrobeStatsComponent& stats = std::get<0>(*value.second);
+
+        if(stats.dead || stats.dormant)
+            continue;
+
+        const Float3 origin = std::get<1>(*value.second).Members._Position;
+        const MembraneComponent& membrane = std::get<2>(*value.second);
+
+        // Same radius as what the CompoundAbsorberSystem uses
+        const auto radius =
+            std::max(membrane.calculateEncompassingCircleRadius(), 3.0f);
+        const auto localRadius = radius / CLOUD_RESOLUTION;
+        const auto localRadiusSquared = localRadius * localRadius;
+
+        float taken = 0;
+
+        for(const auto& [id, tile] : m_managedTiles) {
+
+            if(!CompoundCloudSystem::cloudContainsPositionWithRadius(
+                   tile->m_position, origin, radius))
+                continue;
+
+            const auto [relativeX, relativeY] =
+                CompoundCloudSystem::convertWorldToCloudLocalForGrab(
+                    tile->m_position, origin);
+
+            for(float x = relativeX - localRadius; x <= relativeX + localRadius;
+                x += 1) {
+                for(float y = relativeY - localRadius;
+                    y <= relativeY + localRadius; y += 1) {
+
+                    if(x < 0 || y < 0 ||
+                        std::pow(x - relativeX, 2) + std::pow(y - relativeY, 2) >
+                            localRadiusSquared)
+                        continue;
+
+                    const size_t localX = static_cast<size_t>(x);
+                    const size_t localY = static_cast<size_t>(y);
+
+                    if(localX < CLOUD_SIMULATION_WIDTH &&
+                        localY < CLOUD_SIMULATION_HEIGHT) {
+                        taken += tile->takeAgent(
+                            localX, localY, stats.agentSpeciesTag);
+                    }
+                }
+            }
+        }
+
+        if(taken > 0)
+            stats.pendingAgentDamage += taken * AGENT_DAMAGE_PER_UNIT;
+    }
+}
+// ------------------------------------ //
+AgentCloudComponent&
+    AgentCloudSystem::_getOrCreateTile(CellStageWorld& world,
+        CompoundId agent,
+        const Float3& worldPosition)
+{
+    for(const auto& [id, tile] : m_managedTiles) {
+
+        if(!tile->m_queuedForRemoval && tile->m_compoundId == agent &&
+            CompoundCloudSystem::cloudContainsPosition(
+                tile->m_position, worldPosition))
+            return *tile;
+    }
+
+    const auto entity = world.CreateEntity();
+
+    AgentCloudComponent& tile = world.Create_AgentCloudComponent(entity, *this,
+        agent,
+        CompoundCloudSystem::calculateGridCenterForPlayerPos(worldPosition));
+
+    m_managedTiles[entity] = &tile;
+
+    _initializeTile(tile, world.GetScene());
+    return tile;
+}
+
+void
+    AgentCloudSystem::_initializeTile(AgentCloudComponent& tile,
+        Leviathan::Scene* scene)
+{
+    // Skip if no graphics
+    if(!Engine::Get()->IsInGraphicalMode())
+        return;
+
+    tile.m_sceneNode = scene->CreateSceneNode();
+
+    tile.m_renderable =
+        Leviathan::Renderable::MakeShared<Leviathan::Renderable>(
+            *tile.m_sceneNode);
+
+    tile.m_renderable->SetMesh(m_planeMesh);
+
+    tile.m_sceneNode->SetPosition(
+        Float3(tile.m_position.X, CLOUD_Y_COORDINATE, tile.m_position.Z));
+
+    tile.m_textureData = bs::PixelData::create(CLOUD_SIMULATION_WIDTH,
+        CLOUD_SIMULATION_HEIGHT, 1, AGENT_BS_PIXEL_FORMAT);
+
+    LEVIATHAN_ASSERT(bs::PixelUtil::getNumElemBytes(AGENT_BS_PIXEL_FORMAT) ==
+                         AGENT_TEXTURE_BYTES_PER_ELEMENT,
+        "Pixel format bytes has changed");
+
+    // Only the first channel is used so the others stay zero
+    std::memset(static_cast<uint8_t*>(tile.m_textureData->getData()), 0,
+        tile.m_textureData->getSize());
+
+    tile.m_texture = Leviathan::Texture::MakeShared<Leviathan::Texture>(
+        bs::Texture::create(tile.m_textureData, bs::TU_DYNAMIC));
+
+    // The compound cloud shader is used with only the first colour set
+    auto shader =
+        Engine::Get()->GetGraphics()->LoadShaderByName("compound_cloud.bsl");
+
+    auto material = Leviathan::Material::MakeShared<Leviathan::Material>(
+        Leviathan::Shader::MakeShared<Leviathan::Shader>(shader));
+    material->SetTexture("gDensityTex", tile.m_texture);
+
+    material->SetFloat4("gCloudColour1",
+        SimulationParameters::compoundRegistry.getTypeData(tile.m_compoundId)
+            .colour);
+    material->SetFloat4("gCloudColour2", Float4(0, 0, 0, 0));
+    material->SetFloat4("gCloudColour3", Float4(0, 0, 0, 0));
+    material->SetFloat4("gCloudColour4", Float4(0, 0, 0, 0));
+
+    material->SetTexture("gNoiseTex", m_perlinNoise);
+
+    tile.m_renderable->SetMaterial(material);
+}
+// ------------------------------------ //
+void
+    AgentCloudSystem::tileReportDestroyed(AgentCloudComponent* tile)
+{
+    for(auto iter = m_managedTiles.begin(); iter != m_managedTiles.end();
+        ++iter) {
+
+        if(iter->second == tile) {
+            m_managedTiles.erase(iter);
+            return;
+        }
+    }
+
+    LOG_WARNING("AgentCloudSystem: non-registered AgentCloudComponent "
+                "reported that it was destroyed");
+}
@@ -3,119 +3,180 @@
 #include "engine/component_types.h"
 #include "engine/typedefs.h"
 
-#include "general/perlin_noise.h"
+#include "microbe_stage/compound_cloud_system.h"
 #include "microbe_stage/compounds.h"
 
 #include <Entities/Component.h>
+#include <Entities/Components.h>
 #include <Entities/System.h>
+#include <Rendering/Renderable.h>
+#include <Rendering/SceneNode.h>
 
 #include <vector>
 
 namespace thrive {
 
+class AgentCloudSystem;
+class CellStageWorld;
+class MembraneComponent;
+class MicrobeStatsComponent;
+
+//! Agent amounts are stored multiplied by this in the field. The shared
+//! advection kernel skips densities below 1 so small amounts would otherwise
+//! never move
+constexpr float AGENT_FIELD_DENSITY_SCALE = 1000.f;
+
+//! Fraction of agent in the field that decays each second
+constexpr float AGENT_FIELD_DECAY_RATE = 0.2f;
+
+//! How far in front of the emitter agents are sprayed into the field
+constexpr float AGENT_EMISSION_RANGE = 15.f;
+
+//! Damage for each unit of agent that touches a cell
+constexpr float AGENT_DAMAGE_PER_UNIT = 10.f;
+
 /**
- * @brief Agents clouds that flow in the environment.
+ * @brief One tile of the agent (toxin) field
+ *
+ * The tiles use the same layout and simulation resolution as
+ * CompoundCloudComponent, see \ref how_compound_clouds_work. Unlike compound
+ * clouds these are only created where agents are emitted and are destroyed
+ * once all of the agent in them has decayed.
  */
 class AgentCloudComponent : public Leviathan::Component {
+    friend AgentCloudSystem;
+
 public:
-    /// The size of the compound cloud grid.
-    int width, height;
-    float gridSize;
+    AgentCloudComponent(AgentCloudSystem& owner,
+        CompoundId compoundId,
+        const Float3& position);
+
+    ~AgentCloudComponent();
 
-    Float3 direction;
+    void
+        Release(Leviathan::Scene* scene);
 
-    float potency;
+    //! \brief Adds agent at cloud local coordinates
+    //! \param emitterTag Cells with the same tag are not damaged by this
+    void
+        addAgent(float amount, size_t x, size_t y, uint32_t emitterTag);
 
-    /// The 2D array that contains the current compound clouds and those from
-    /// last frame.
-    std::vector<std::vector<float>> density;
-    std::vector<std::vector<float>> oldDens;
+    //! \brief Takes all the agent at cloud local coordinates
+    //! \returns The taken amount or 0 if the agent there has immuneTag
+    float
+        takeAgent(size_t x, size_t y, uint32_t immuneTag);
 
-    /// The color of the compound cloud.
-    Float4 color;
+    //! \returns The amount of agent at cloud local coordinates
+    float
+        amountAt(size_t x, size_t y) const;
 
-    // Helpers for networking
-    inline auto
-        getRed() const
+    CompoundId
+        getCompoundId() const
     {
-        return color.X;
+        return m_compoundId;
     }
-    inline auto
-        getGreen() const
-    {
-        return color.Y;
-    }
-    inline auto
-        getBlue() const
+
+    auto
+        getPosition() const
     {
-        return color.Z;
+        return m_position;
     }
 
-    /**
-     * @brief The compound id.
-     */
-    CompoundId m_compoundId = NULL_COMPOUND;
-
     REFERENCE_HANDLE_UNCOUNTED_TYPE(AgentCloudComponent);
 
     static constexpr auto TYPE =
         componentTypeConvert(THRIVE_COMPONENT::AGENT_CLOUD);
 
-public:
-    AgentCloudComponent(CompoundId Id, float red, float green, float blue);
-
-    // /**
-    // * @brief Lua bindings
-    // *
-    // * Exposes:
-    // * - CompoundCloudComponent()
-    // *
-    // * @return
-    // */
-    // static void luaBindings(sol::state &lua);
-
-    // void
-    // load(
-    //     const StorageContainer& storage
-    // ) override;
-
-    // StorageContainer
-    // storage() const override;
-
-    /// Rate should be less than one.
-    float
-        getPotency();
-};
+protected:
+    Leviathan::SceneNode::pointer m_sceneNode;
+    Leviathan::Renderable::pointer m_renderable;
 
+    Leviathan::Texture::pointer m_texture;
+    bs::SPtr<bs::PixelData> m_textureData;
+
+    //! The center point of the tile
+    Float3 m_position;
+
+    //! Agent densities, same as the densities in CompoundCloudComponent
+    std::vector<std::vector<float>> m_density;
+    std::vector<std::vector<float>> m_oldDens;
+
+    //! The emitter tag of the agent in each grid cell. 0 is no emitter
+    std::vector<std::vector<uint32_t>> m_emitters;
+
+    //! Sum of m_density, updated by AgentCloudSystem::Run
+    float m_totalDensity = 0;
+
+    //! Set when empty and the entity destroy has been queued
+    bool m_queuedForRemoval = false;
+
+    CompoundId m_compoundId = NULL_COMPOUND;
 
+    AgentCloudSystem& m_owner;
+};
 
 /**
- * @brief Moves the compound clouds.
- * @note This system currently does nothing but is kept for the future when this
- * is planned to be used
+ * @brief Simulates the agent field and damages cells that touch it
+ *
+ * The agent tiles are moved with the same diffusion and advection kernels as
+ * the compound clouds. Damage is accumulated in
+ * MicrobeStatsComponent::pendingAgentDamage and applied by the scripts.
  */
 class AgentCloudSystem
-    : public Leviathan::System<std::tuple<Leviathan::Position&,
-          AgentCloudComponent&,
-          Leviathan::RenderNode&>> {
+    : public Leviathan::System<std::tuple<MicrobeStatsComponent&,
+          Leviathan::Position&,
+          MembraneComponent&>> {
+    friend AgentCloudComponent;
+
 public:
+    void
+        Init(CellStageWorld& world);
+
+    //! \brief Destroys all agent tiles
+    void
+        Release(CellStageWorld& world);
+
+    void
+        Run(CellStageWorld& world, float elapsed);
+
     /**
-     * @brief Updates the system
+     * @brief Sprays agent into the field
+     *
+     * The agent is spread along a line of AGENT_EMISSION_RANGE starting from
+     * position towards direction
+     * @param emitterSpecies Cells of this species are not damaged by the agent
      */
     void
-        Run(GameWorld& world);
+        emitAgent(CellStageWorld& world,
+            CompoundId agent,
+            const Float3& position,
+            const Float3& direction,
+            float amount,
+            const std::string& emitterSpecies);
+
+    //! \returns The amount of agent at worldPosition
+    float
+        amountAt(CompoundId agent, const Float3& worldPosition) const;
+
+    //! \brief Clears all agents
+    void
+        emptyAllAgents(CellStageWorld& world);
+
+    //! \brief Converts a species name to the tag that is stored in the field
+    static uint32_t
+        speciesTag(const std::string& speciesName);
 
     void
         CreateNodes(
-            const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
+            const std::vector<std::tuple<MicrobeStatsComponent*, ObjectID>>&
                 firstdata,
-            const std::vector<std::tuple<AgentCloudComponent*, ObjectID>>&
+            const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
                 seconddata,
-            const std::vector<std::tuple<Leviathan::RenderNode*, ObjectID>>&
+            const std::vector<std::tuple<MembraneComponent*, ObjectID>>&
                 thirddata,
-            const ComponentHolder<Leviathan::Position>& firstholder,
-            const ComponentHolder<AgentCloudComponent>& secondholder,
-            const ComponentHolder<Leviathan::RenderNode>& thirdholder)
+            const ComponentHolder<MicrobeStatsComponent>& firstholder,
+            const ComponentHolder<Leviathan::Position>& secondholder,
+            const ComponentHolder<MembraneComponent>& thirdholder)
     {
         TupleCachedComponentCollectionHelper(CachedComponents, firstdata,
             seconddata, thirddata, firstholder, secondholder, thirdholder);
@@ -123,17 +184,53 @@ public:
 
     void
         DestroyNodes(
-            const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
+            const std::vector<std::tuple<MicrobeStatsComponent*, ObjectID>>&
                 firstdata,
-            const std::vector<std::tuple<AgentCloudComponent*, ObjectID>>&
+            const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
                 seconddata,
-            const std::vector<std::tuple<Leviathan::RenderNode*, ObjectID>>&
+            const std::vector<std::tuple<MembraneComponent*, ObjectID>>&
                 thirddata)
     {
         CachedComponents.RemoveBasedOnKeyTupleList(firstdata);
         CachedComponents.RemoveBasedOnKeyTupleList(seconddata);
         CachedComponents.RemoveBasedOnKeyTupleList(thirddata);
     }
+
+protected:
+    //! \brief Removes destroyed tiles from m_managedTiles
+    void
+        tileReportDestroyed(AgentCloudComponent* tile);
+
+private:
+    //! \returns The tile for agent containing worldPosition, creating it if
+    //! it doesn't exist
+    AgentCloudComponent&
+        _getOrCreateTile(CellStageWorld& world,
+            CompoundId agent,
+            const Float3& worldPosition);
+
+    //! \brief Moves, decays and uploads the densities of a tile
+    void
+        _processTile(AgentCloudComponent& tile,
+            float elapsed,
+            FluidSystem& fluidSystem);
+
+    //! \brief Takes the agent touching cells and adds their damage
+    void
+        _applyDamage();
+
+    void
+        _initializeTile(AgentCloudComponent& tile, Leviathan::Scene* scene);
+
+private:
+    //! All the existing tiles
+    //! \note Like in CompoundCloudSystem these are not removed directly by the
+    //! GameWorld so the destructor of AgentCloudComponent reports them
+    std::unordered_map<ObjectID, AgentCloudComponent*> m_managedTiles;
+
+    Leviathan::Mesh::pointer m_planeMesh;
+
+    Leviathan::Texture::pointer m_perlinNoise;
 };
 
 } // namespace thrive
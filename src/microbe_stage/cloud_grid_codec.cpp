@@ -0,0 +1,289 @@
+// ------------------------------------ //
+#include "cloud_grid_codec.h"
+
+#include "general/varint.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace thrive;
+// ------------------------------------ //
+//! Zero runs shorter than this are stored as values as the run lengths would
+//! take more space than the zeros
+constexpr size_t MIN_ZERO_RUN = 3;
+
+//! bits, step, zeroThreshold, count
+constexpr size_t HEADER_SIZE = 1 + 4 + 4 + 4;
+
+namespace {
+
+struct Header {
+    uint8_t bits;
+    float step;
+    float zeroThreshold;
+    uint32_t count;
+};
+
+template<typename T>
+void
+    appendRaw(std::string& encoded, T value)
+{
+    encoded.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+Header
+    readHeader(const std::string& encoded)
+{
+    if(encoded.size() < HEADER_SIZE)
+        throw Leviathan::InvalidArgument("encoded cloud grid is truncated");
+
+    Header header;
+    header.bits = static_cast<uint8_t>(encoded[0]);
+    std::memcpy(&header.step, encoded.data() + 1, 4);
+    std::memcpy(&header.zeroThreshold, encoded.data() + 5, 4);
+    std::memcpy(&header.count, encoded.data() + 9, 4);
+
+    if(header.bits != 8 && header.bits != 16 && header.bits != 32)
+        throw Leviathan::InvalidArgument(
+            "encoded cloud grid has invalid value size");
+
+    return header;
+}
+
+//! \returns The largest value that fits in bits when quantizing
+int32_t
+    maxQuantized(uint8_t bits)
+{
+    return (1 << (bits - 1)) - 1;
+}
+
+} // namespace
+// ------------------------------------ //
+CloudGridCodec::CloudGridCodec(const CloudCodecSettings& settings) :
+    m_settings(settings)
+{
+    if(settings.bits != 8 && settings.bits != 16 && settings.bits != 32)
+        throw Leviathan::InvalidArgument("bits needs to be 8, 16 or 32");
+
+    if(settings.zeroThreshold < 0)
+        throw Leviathan::InvalidArgument("zeroThreshold can't be negative");
+}
+// ------------------------------------ //
+void
+    CloudGridCodec::encode(
+        const float* data, size_t count, std::string& encoded) const
+{
+    _encode(data, nullptr, count, encoded);
+}
+
+void
+    CloudGridCodec::encodeDelta(const float* data,
+        const float* previous,
+        size_t count,
+        std::string& encoded) const
+{
+    if(!previous)
+        throw Leviathan::InvalidArgument("no previous grid given");
+
+    _encode(data, previous, count, encoded);
+}
+
+void
+    CloudGridCodec::decode(const std::string& encoded, float* data, size_t count)
+{
+    _decode(encoded, data, count, false);
+}
+
+void
+    CloudGridCodec::decodeDelta(
+        const std::string& encoded, float* data, size_t count)
+{
+    _decode(encoded, data, count, true);
+}
+
+float
+    CloudGridCodec::getMaxError(const std::string& encoded, float maxValue)
+{
+    const auto header = readHeader(encoded);
+
+    // The values stored as zero are within the threshold apart from the
+    // rounding of calculating a difference
+    if(header.bits == 32)
+        return header.zeroThreshold * (1 + FLT_EPSILON);
+
+    const float maxStored =
+        header.step * maxQuantized(header.bits) + header.zeroThreshold;
+
+    // Calculating a difference, quantizing it and multiplying it back each
+    // round by at most half of FLT_EPSILON relative to the stored values.
+    // Adding a difference to the previous value rounds relative to the
+    // decoded value. The margin is larger than the sum of those
+    const float rounding = FLT_EPSILON * (2 * maxStored + maxValue);
+
+    return std::max(header.zeroThreshold, header.step / 2) + rounding;
+}
+// ------------------------------------ //
+void
+    CloudGridCodec::_encode(const float* data,
+        const float* previous,
+        size_t count,
+        std::string& encoded) const
+{
+    if(count > UINT32_MAX)
+        throw Leviathan::InvalidArgument("too large cloud grid");
+
+    const auto valueAt = [&](size_t index) {
+        return previous ? data[index] - previous[index] : data[index];
+    };
+
+    // The step is picked so that the largest value fits
+    float step = 0;
+
+    if(m_settings.bits != 32) {
+        float maxValue = 0;
+
+        for(size_t i = 0; i < count; ++i)
+            maxValue = std::max(maxValue, std::abs(valueAt(i)));
+
+        step = maxValue / maxQuantized(m_settings.bits);
+    }
+
+    // Values as they are stored, 0 means a zero value
+    std::vector<uint32_t> words(count);
+
+    for(size_t i = 0; i < count; ++i) {
+
+        const float value = valueAt(i);
+
+        if(std::abs(value) <= m_settings.zeroThreshold || value == 0) {
+            words[i] = 0;
+        } else if(m_settings.bits == 32) {
+
+            // Deltas are the changed bits so that adding them isn't rounded.
+            // Only unchanged values give zero
+            std::memcpy(&words[i], data + i, sizeof(float));
+
+            if(previous) {
+                uint32_t previousWord;
+                std::memcpy(&previousWord, previous + i, sizeof(float));
+                words[i] ^= previousWord;
+            }
+        } else {
+            words[i] = static_cast<uint32_t>(
+                static_cast<int32_t>(std::lround(value / step)));
+        }
+    }
+
+    encoded.clear();
+    encoded.push_back(static_cast<char>(m_settings.bits));
+    appendRaw(encoded, step);
+    appendRaw(encoded, m_settings.zeroThreshold);
+    appendRaw(encoded, static_cast<uint32_t>(count));
+
+    const size_t bytes = m_settings.bits / 8;
+    size_t index = 0;
+
+    while(index < count) {
+
+        const size_t zerosStart = index;
+        while(index < count && words[index] == 0)
+            ++index;
+
+        const size_t valuesStart = index;
+
+        while(index < count) {
+
+            if(words[index] != 0) {
+                ++index;
+                continue;
+            }
+
+            size_t zerosEnd = index;
+            while(zerosEnd < count && words[zerosEnd] == 0 &&
+                  zerosEnd - index < MIN_ZERO_RUN)
+                ++zerosEnd;
+
+            if(zerosEnd == count || zerosEnd - index >= MIN_ZERO_RUN)
+                break;
+
+            index = zerosEnd;
+        }
+
+        appendVarint(encoded, valuesStart - zerosStart);
+        appendVarint(encoded, index - valuesStart);
+
+        // Always stored as little endian
+        for(size_t i = valuesStart; i < index; ++i) {
+            for(size_t byte = 0; byte < bytes; ++byte)
+                encoded.push_back(
+                    static_cast<char>((words[i] >> (byte * 8)) & 0xff));
+        }
+    }
+}
+
+void
+    CloudGridCodec::_decode(
+        const std::string& encoded, float* data, size_t count, bool delta)
+{
+    const auto header = readHeader(encoded);
+
+    if(header.count != count)
+        throw Leviathan::InvalidArgument(
+            "encoded cloud grid has wrong number of values");
+
+    const size_t bytes = header.bits / 8;
+    size_t position = HEADER_SIZE;
+    size_t index = 0;
+
+    while(index < count) {
+
+        const auto zeros = readVarint(encoded, position);
+        const auto values = readVarint(encoded, position);
+
+        if(zeros > count - index || values > count - index - zeros)
+            throw Leviathan::InvalidArgument(
+                "encoded cloud grid has too many values");
+
+        if(values * bytes > encoded.size() - position)
+            throw Leviathan::InvalidArgument("encoded cloud grid is truncated");
+
+        if(!delta)
+            std::fill(data + index, data + index + zeros, 0.f);
+
+        index += zeros;
+
+        for(uint64_t i = 0; i < values; ++i, ++index) {
+
+            uint32_t word = 0;
+
+            for(size_t byte = 0; byte < bytes; ++byte)
+                word |= static_cast<uint32_t>(
+                            static_cast<uint8_t>(encoded[position++]))
+                        << (byte * 8);
+
+            if(header.bits == 32) {
+
+                if(delta) {
+                    uint32_t previous;
+                    std::memcpy(&previous, data + index, sizeof(float));
+                    word ^= previous;
+                }
+
+                std::memcpy(data + index, &word, sizeof(float));
+                continue;
+            }
+
+            const float value = (header.bits == 8 ?
+                                        static_cast<int8_t>(word) :
+                                        static_cast<int16_t>(word)) *
+                                header.step;
+
+            data[index] = delta ? data[index] + value : value;
+        }
+    }
+}
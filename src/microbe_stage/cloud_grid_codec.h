@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace thrive {
+
+//! \brief How CloudGridCodec stores the values of a grid
+struct CloudCodecSettings {
+    //! Bits per stored value. 8 and 16 quantize the values, 32 stores the
+    //! floats exactly
+    uint8_t bits = 16;
+
+    //! Values (or differences when encoding a delta) with an absolute value
+    //! at most this are stored as zero. Needs to be 0 for lossless coding
+    float zeroThreshold = 0.f;
+};
+
+/**
+ * @brief Encodes compound cloud density grids compactly
+ *
+ * Most of a density grid is empty so the values are stored as runs of zeros
+ * and runs of values. The values are quantized to the configured number of
+ * bits using a step calculated from the largest value in the grid. The
+ * decoded values are within getMaxError of the encoded ones.
+ *
+ * Deltas store the difference to a previous grid, which makes sending a grid
+ * that has changed in only some places cheap. The previous grid given to
+ * encodeDelta must be the one the decoding side has, ie. the previously
+ * decoded grid and not the original values, otherwise the quantization errors
+ * accumulate. With 32 bits the deltas store which bits of the floats changed
+ * so they are exact like the full grids.
+ *
+ * The encoded data starts with a small header and run lengths are stored as
+ * variable length integers. Values are stored as little endian.
+ */
+class CloudGridCodec {
+public:
+    //! \exception Leviathan::InvalidArgument if the settings are invalid
+    CloudGridCodec(const CloudCodecSettings& settings = CloudCodecSettings());
+
+    //! \brief Encodes count values from data into encoded
+    //!
+    //! The old contents of encoded are replaced but its memory is reused
+    void
+        encode(const float* data, size_t count, std::string& encoded) const;
+
+    //! \brief Encodes the difference between data and previous
+    void
+        encodeDelta(const float* data,
+            const float* previous,
+            size_t count,
+            std::string& encoded) const;
+
+    //! \brief Decodes a grid from encode into data
+    //! \exception Leviathan::InvalidArgument if encoded is corrupt or doesn't
+    //! have count values
+    static void
+        decode(const std::string& encoded, float* data, size_t count);
+
+    //! \brief Applies a delta from encodeDelta to data which needs to
+    //! contain the previous grid
+    //! \exception Leviathan::InvalidArgument if encoded is corrupt or doesn't
+    //! have count values
+    static void
+        decodeDelta(const std::string& encoded, float* data, size_t count);
+
+    //! \returns The largest difference a decoded value can have from the
+    //! encoded one, including the float rounding errors
+    //! \param maxValue The largest absolute value in the decoded grid. Only
+    //! needed for deltas as adding a difference to a value is rounded relative
+    //! to the value
+    static float
+        getMaxError(const std::string& encoded, float maxValue = 0);
+
+    const CloudCodecSettings&
+        getSettings() const
+    {
+        return m_settings;
+    }
+
+private:
+    void
+        _encode(const float* data,
+            const float* previous,
+            size_t count,
+            std::string& encoded) const;
+
+    static void
+        _decode(const std::string& encoded,
+            float* data,
+            size_t count,
+            bool delta);
+
+private:
+    CloudCodecSettings m_settings;
+};
+
+} // namespace thrive
@@ -0,0 +1,306 @@
+// ------------------------------------ //
+#include "cloud_streaming.h"
+
+#include "general/varint.h"
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace thrive;
+// ------------------------------------ //
+namespace {
+
+template<typename T>
+void
+    appendRaw(std::string& message, T value)
+{
+    message.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T
+    readRaw(const std::string& message, size_t& position)
+{
+    if(message.size() - position < sizeof(T))
+        throw Leviathan::InvalidArgument("cloud stream message is truncated");
+
+    T value;
+    std::memcpy(&value, message.data() + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+}
+
+void
+    appendFloat3(std::string& message, const Float3& value)
+{
+    appendRaw(message, value.X);
+    appendRaw(message, value.Y);
+    appendRaw(message, value.Z);
+}
+
+Float3
+    readFloat3(const std::string& message, size_t& position)
+{
+    const auto x = readRaw<float>(message, position);
+    const auto y = readRaw<float>(message, position);
+    const auto z = readRaw<float>(message, position);
+    return Float3(x, y, z);
+}
+
+//! \returns A string that identifies a cloud tile
+std::string
+    tileKey(const Float3& position, const std::string& typeName)
+{
+    return typeName + "@" + std::to_string(position.X) + "," +
+           std::to_string(position.Z);
+}
+
+} // namespace
+// ------------------------------------ //
+// CloudStreamServer
+CloudStreamServer::CloudStreamServer(
+    const CloudCodecSettings& settings, float interval) :
+    m_codec(settings),
+    m_interval(interval)
+{
+    if(interval <= 0)
+        throw Leviathan::InvalidArgument("interval must be positive");
+}
+// ------------------------------------ //
+void
+    CloudStreamServer::update(const CompoundCloudSystem& clouds,
+        float elapsed,
+        const std::vector<std::tuple<int32_t, Float3>>& players,
+        const SendCallback& send)
+{
+    m_timeSinceSend += elapsed;
+
+    if(m_timeSinceSend < m_interval)
+        return;
+
+    m_timeSinceSend = 0;
+
+    if(players.empty())
+        return;
+
+    clouds.takeSnapshot(m_snapshot);
+
+    std::vector<std::string> sentKeys;
+
+    for(const auto& [player, position] : players) {
+
+        auto& baselines = m_players[player];
+        sentKeys.clear();
+
+        for(const auto& cloud : m_snapshot.clouds) {
+
+            if(!CompoundCloudSystem::cloudContainsPositionWithRadius(
+                   cloud.position, position, CLOUD_STREAM_RADIUS))
+                continue;
+
+            sentKeys.push_back(tileKey(cloud.position, cloud.typeName));
+            _sendTile(player, cloud, baselines[sentKeys.back()], send);
+        }
+
+        // The player will get full tiles if they come close to the other tiles
+        // again
+        for(auto iter = baselines.begin(); iter != baselines.end();) {
+
+            if(std::find(sentKeys.begin(), sentKeys.end(), iter->first) ==
+                sentKeys.end()) {
+                iter = baselines.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+void
+    CloudStreamServer::removePlayer(int32_t player)
+{
+    m_players.erase(player);
+}
+// ------------------------------------ //
+void
+    CloudStreamServer::_sendTile(int32_t player,
+        const CompoundCloudsSnapshot::Cloud& cloud,
+        TileBaseline& baseline,
+        const SendCallback& send)
+{
+    m_message.clear();
+    m_message.push_back(static_cast<char>(CLOUD_STREAM_MESSAGE_VERSION));
+    appendRaw(m_message, m_interval);
+    appendFloat3(m_message, m_snapshot.gridCenter);
+    appendFloat3(m_message, cloud.position);
+    appendVarint(m_message, cloud.typeName.size());
+    m_message.append(cloud.typeName);
+
+    uint8_t usedGrids = 0;
+
+    for(int i = 0; i < CLOUDS_IN_ONE; ++i) {
+        if(!cloud.grids[i].data.empty())
+            usedGrids |= 1 << i;
+    }
+
+    m_message.push_back(static_cast<char>(usedGrids));
+
+    for(int i = 0; i < CLOUDS_IN_ONE; ++i) {
+
+        const auto& grid = cloud.grids[i];
+        auto& previous = baseline[i];
+
+        if(grid.data.empty())
+            continue;
+
+        const size_t count = grid.data.size();
+        const bool delta = previous.size() == count;
+
+        // The baseline is updated with the decoded values so that the
+        // quantization errors don't accumulate on the client
+        if(delta) {
+            m_codec.encodeDelta(
+                grid.data.data(), previous.data(), count, m_encoded);
+            CloudGridCodec::decodeDelta(m_encoded, previous.data(), count);
+        } else {
+            m_codec.encode(grid.data.data(), count, m_encoded);
+            previous.resize(count);
+            CloudGridCodec::decode(m_encoded, previous.data(), count);
+        }
+
+        m_message.push_back(delta ? 1 : 0);
+        appendVarint(m_message, grid.width);
+        appendVarint(m_message, grid.height);
+        appendVarint(m_message, m_encoded.size());
+        m_message.append(m_encoded);
+    }
+
+    send(player, m_message);
+}
+// ------------------------------------ //
+// CloudStreamReceiver
+void
+    CloudStreamReceiver::receive(const std::string& message)
+{
+    size_t position = 0;
+
+    if(readRaw<uint8_t>(message, position) != CLOUD_STREAM_MESSAGE_VERSION)
+        throw Leviathan::InvalidArgument(
+            "cloud stream message has unknown version");
+
+    const auto interval = readRaw<float>(message, position);
+
+    if(!(interval > 0))
+        throw Leviathan::InvalidArgument(
+            "cloud stream message has invalid interval");
+
+    const auto gridCenter = readFloat3(message, position);
+    const auto tilePosition = readFloat3(message, position);
+
+    const auto nameLength = readVarint(message, position);
+
+    if(nameLength > message.size() - position)
+        throw Leviathan::InvalidArgument("cloud stream message is truncated");
+
+    const auto typeName = message.substr(position, nameLength);
+    position += nameLength;
+
+    const auto usedGrids = readRaw<uint8_t>(message, position);
+
+    StreamedCloudTile* tile = nullptr;
+
+    for(auto& existing : m_tiles) {
+        if(existing.position == tilePosition && existing.typeName == typeName) {
+            tile = &existing;
+            break;
+        }
+    }
+
+    if(!tile) {
+        m_tiles.emplace_back();
+        tile = &m_tiles.back();
+        tile->position = tilePosition;
+        tile->typeName = typeName;
+    }
+
+    for(int i = 0; i < CLOUDS_IN_ONE; ++i) {
+
+        auto& grid = tile->grids[i];
+
+        if((usedGrids & (1 << i)) == 0) {
+            grid = CompoundCloudsSnapshot::Grid();
+            continue;
+        }
+
+        const bool delta = readRaw<uint8_t>(message, position) != 0;
+        const auto width = readVarint(message, position);
+        const auto height = readVarint(message, position);
+
+        // The server clouds are always this size. Checked before anything is
+        // allocated so that a bad message can't make the client run out of
+        // memory
+        if(width != static_cast<uint64_t>(CLOUD_SIMULATION_WIDTH) ||
+            height != static_cast<uint64_t>(CLOUD_SIMULATION_HEIGHT))
+            throw Leviathan::InvalidArgument(
+                "cloud stream message has wrong grid size");
+
+        const auto length = readVarint(message, position);
+
+        if(length > message.size() - position)
+            throw Leviathan::InvalidArgument(
+                "cloud stream message is truncated");
+
+        const auto encoded = message.substr(position, length);
+        position += length;
+
+        const size_t count = width * height;
+
+        if(delta) {
+
+            if(grid.width != width || grid.height != height)
+                throw Leviathan::InvalidArgument(
+                    "cloud stream delta for a tile that hasn't been received");
+
+            CloudGridCodec::decodeDelta(encoded, grid.data.data(), count);
+        } else {
+
+            grid.width = static_cast<uint32_t>(width);
+            grid.height = static_cast<uint32_t>(height);
+            grid.data.resize(count);
+            CloudGridCodec::decode(encoded, grid.data.data(), count);
+        }
+    }
+
+    m_interval = interval;
+
+    // Tiles the server no longer has are dropped
+    if(gridCenter != m_gridCenter) {
+
+        m_gridCenter = gridCenter;
+
+        const auto positions =
+            CompoundCloudSystem::calculateGridPositions(gridCenter);
+
+        m_tiles.erase(std::remove_if(m_tiles.begin(), m_tiles.end(),
+                          [&](const StreamedCloudTile& existing) {
+                              return std::find(positions.begin(),
+                                         positions.end(), existing.position) ==
+                                     positions.end();
+                          }),
+            m_tiles.end());
+    }
+}
+// ------------------------------------ //
+const StreamedCloudTile*
+    CloudStreamReceiver::findTile(
+        const Float3& position, const std::string& typeName) const
+{
+    for(const auto& tile : m_tiles) {
+        if(tile.position == position && tile.typeName == typeName)
+            return &tile;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "microbe_stage/cloud_grid_codec.h"
+#include "microbe_stage/compound_cloud_system.h"
+
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace thrive {
+
+//! How often the server sends cloud updates, in seconds
+constexpr auto CLOUD_STREAM_INTERVAL = 0.25f;
+
+//! Cloud tiles that have any part this close to a player are streamed to them
+constexpr auto CLOUD_STREAM_RADIUS = static_cast<float>(CLOUD_WIDTH);
+
+constexpr uint8_t CLOUD_STREAM_MESSAGE_VERSION = 1;
+
+/**
+ * @brief Server side of cloud streaming. Sends the cloud tiles near each
+ * player as quantized deltas
+ *
+ * Every CLOUD_STREAM_INTERVAL the tiles close to a player are encoded
+ * against what that player was last sent and passed to the send callback, one
+ * message per tile. The messages need to be delivered reliably and in order
+ * as each delta builds on the previous one. The server shards send them in
+ * THRIVE_PACKET_TYPE::CLOUD_STREAM packets.
+ */
+class CloudStreamServer {
+public:
+    using SendCallback =
+        std::function<void(int32_t player, const std::string& message)>;
+
+    CloudStreamServer(
+        const CloudCodecSettings& settings = CloudCodecSettings{8, 1.f},
+        float interval = CLOUD_STREAM_INTERVAL);
+
+    //! \brief Sends updates if enough time has passed since the last ones
+    //! \param players The players and the positions of their cells
+    void
+        update(const CompoundCloudSystem& clouds,
+            float elapsed,
+            const std::vector<std::tuple<int32_t, Float3>>& players,
+            const SendCallback& send);
+
+    //! \brief Forgets what was sent to player. The next update sends them
+    //! full tiles
+    void
+        removePlayer(int32_t player);
+
+private:
+    //! The tile contents the player has, ie. the decoded values
+    using TileBaseline = std::array<std::vector<float>, CLOUDS_IN_ONE>;
+
+    void
+        _sendTile(int32_t player,
+            const CompoundCloudsSnapshot::Cloud& cloud,
+            TileBaseline& baseline,
+            const SendCallback& send);
+
+private:
+    CloudGridCodec m_codec;
+    const float m_interval;
+    float m_timeSinceSend = 0;
+
+    CompoundCloudsSnapshot m_snapshot;
+
+    //! Sent tiles of each player by tile key
+    std::unordered_map<int32_t, std::map<std::string, TileBaseline>> m_players;
+
+    //! Reused buffers
+    std::string m_message;
+    std::string m_encoded;
+};
+
+//! \brief A cloud tile received from the server
+struct StreamedCloudTile {
+    Float3 position;
+    std::string typeName;
+
+    //! Empty for unused slots
+    std::array<CompoundCloudsSnapshot::Grid, CLOUDS_IN_ONE> grids;
+};
+
+/**
+ * @brief Client side of cloud streaming. Decodes the messages from
+ * CloudStreamServer
+ *
+ * CompoundCloudSystem blends its clouds towards the received tiles instead of
+ * simulating them when it has a receiver set
+ */
+class CloudStreamReceiver {
+public:
+    //! \brief Applies a message
+    //! \exception Leviathan::InvalidArgument if the message is invalid or a
+    //! delta is received for a tile that doesn't have a full update yet
+    void
+        receive(const std::string& message);
+
+    //! \returns The tile at position with typeName as the first type or null
+    const StreamedCloudTile*
+        findTile(const Float3& position, const std::string& typeName) const;
+
+    bool
+        hasData() const
+    {
+        return !m_tiles.empty();
+    }
+
+    //! \returns The cloud grid center of the server
+    Float3
+        getGridCenter() const
+    {
+        return m_gridCenter;
+    }
+
+    //! \returns How often the server sends updates
+    float
+        getInterval() const
+    {
+        return m_interval;
+    }
+
+private:
+    std::vector<StreamedCloudTile> m_tiles;
+
+    Float3 m_gridCenter = Float3(0, 0, 0);
+    float m_interval = CLOUD_STREAM_INTERVAL;
+};
+
+} // namespace thrive
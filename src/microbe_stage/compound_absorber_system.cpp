@@ -32,6 +32,23 @@ float
     }
 }
 
+void
+    CompoundAbsorberComponent::getAbsorbedAmounts(CScriptArray& result) const
+{
+    const auto count = static_cast<asUINT>(
+        SimulationParameters::compoundRegistry.getSize());
+
+    result.Resize(count);
+
+    for(asUINT id = 0; id < count; ++id)
+        *static_cast<float*>(result.At(id)) = 0.f;
+
+    for(const auto& [id, amount] : m_absorbedCompounds) {
+        if(id < count)
+            *static_cast<float*>(result.At(id)) = amount;
+    }
+}
+
 bool
     CompoundAbsorberComponent::canAbsorbCompound(CompoundId id) const
 {
@@ -131,6 +148,9 @@ void
         std::unordered_map<ObjectID, CompoundCloudComponent*>& clouds,
         float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "CompoundAbsorberSystem");
+
     auto& absorbersIndex = m_absorbers.CachedComponents.GetIndex();
     auto& agentsIndex = m_agents.CachedComponents.GetIndex();
     UNUSED(agentsIndex);
@@ -79,6 +79,17 @@ public:
     float
         absorbedCompoundAmount(CompoundId id) const;
 
+    /**
+     * @brief Writes the absorbed amounts of all compounds into result
+     *
+     * @param result
+     *   An array<float> that is resized to the number of registered
+     *   compounds and indexed by CompoundId. Compounds that weren't absorbed
+     *   are 0. Reuse the same array between calls to avoid allocations
+     */
+    void
+        getAbsorbedAmounts(CScriptArray& result) const;
+
     /**
      * @brief Whether an compound can be absorbed
      *
@@ -1,15 +1,19 @@
 #include "microbe_stage/compound_cloud_system.h"
+#include "microbe_stage/cloud_streaming.h"
 #include "microbe_stage/simulation_parameters.h"
 
 #include "ThriveGame.h"
 
 #include "engine/player_data.h"
+#include "engine/tracing.h"
+#include "general/save_game.h"
 #include "generated/cell_stage_world.h"
 
 #include <Rendering/GeometryHelpers.h>
 #include <Rendering/Graphics.h>
 #include <bsfCore/Image/BsTexture.h>
 
+#include <algorithm>
 #include <atomic>
 
 using namespace thrive;
@@ -472,6 +476,123 @@ void
         cloud.second->clearContents();
     }
 }
+
+void
+    CompoundCloudSystem::saveClouds(SaveWriter& writer) const
+{
+    CompoundCloudsSnapshot snapshot;
+    takeSnapshot(snapshot);
+    snapshot.write(writer);
+}
+
+void
+    CompoundCloudSystem::takeSnapshot(CompoundCloudsSnapshot& snapshot) const
+{
+    snapshot.gridCenter = m_cloudGridCenter;
+    snapshot.clouds.resize(m_managedClouds.size());
+
+    size_t index = 0;
+
+    for(const auto& [id, cloud] : m_managedClouds) {
+
+        auto& target = snapshot.clouds[index++];
+
+        target.position = cloud->m_position;
+        target.typeName = _getCloudTypeName(*cloud);
+
+        const std::vector<std::vector<float>>* densities[CLOUDS_IN_ONE] = {
+            &cloud->m_density1, &cloud->m_density2, &cloud->m_density3,
+            &cloud->m_density4};
+
+        for(int i = 0; i < CLOUDS_IN_ONE; ++i) {
+
+            const auto& density = *densities[i];
+            auto& grid = target.grids[i];
+
+            grid.width = static_cast<uint32_t>(density.size());
+            grid.height =
+                static_cast<uint32_t>(density.empty() ? 0 : density[0].size());
+            grid.data.resize(grid.width * grid.height);
+
+            for(uint32_t x = 0; x < grid.width; ++x)
+                std::copy(density[x].begin(), density[x].end(),
+                    grid.data.begin() + x * grid.height);
+        }
+    }
+}
+
+void
+    CompoundCloudSystem::loadClouds(CellStageWorld& world, SaveReader& reader)
+{
+    const auto center = reader.readFloat3();
+
+    if(!m_cloudTypes.empty())
+        doSpawnCycle(world, center);
+
+    const auto count = reader.read<uint32_t>();
+
+    for(uint32_t i = 0; i < count; ++i) {
+
+        const auto position = reader.readFloat3();
+        const auto typeName = reader.readString();
+
+        CompoundCloudComponent* target = nullptr;
+
+        for(const auto& [id, cloud] : m_managedClouds) {
+
+            if(cloud->m_position != position)
+                continue;
+
+            if(!typeName.empty() && _getCloudTypeName(*cloud) == typeName) {
+                target = cloud;
+                break;
+            }
+        }
+
+        if(!target) {
+            LOG_WARNING("CompoundCloudSystem: loadClouds: no cloud for saved "
+                        "cloud type: " +
+                        typeName);
+
+            for(int grid = 0; grid < CLOUDS_IN_ONE; ++grid)
+                reader.skipGrid();
+            continue;
+        }
+
+        reader.readGrid(target->m_density1);
+        reader.readGrid(target->m_density2);
+        reader.readGrid(target->m_density3);
+        reader.readGrid(target->m_density4);
+    }
+}
+
+std::string
+    CompoundCloudSystem::_getCloudTypeName(
+        const CompoundCloudComponent& cloud) const
+{
+    const auto type = std::find_if(m_cloudTypes.begin(), m_cloudTypes.end(),
+        [&](const Compound& compound) {
+            return compound.id == cloud.m_compoundId1;
+        });
+
+    return type != m_cloudTypes.end() ? type->internalName : "";
+}
+
+void
+    CompoundCloudsSnapshot::write(SaveWriter& writer) const
+{
+    writer.writeFloat3(gridCenter);
+    writer.write<uint32_t>(static_cast<uint32_t>(clouds.size()));
+
+    for(const auto& cloud : clouds) {
+
+        writer.writeFloat3(cloud.position);
+        writer.writeString(cloud.typeName);
+
+        for(const auto& grid : cloud.grids)
+            writer.writeGrid(grid.data.data(), grid.width, grid.height);
+    }
+}
 // ------------------------------------ //
 bool
     CompoundCloudSystem::cloudContainsPosition(const Float3& cloudPosition,
@@ -552,8 +673,16 @@ Float3
 void
     CompoundCloudSystem::Run(CellStageWorld& world, float elapsed)
 {
-    if(!world.GetNetworkSettings().IsAuthoritative)
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "CompoundCloudSystem");
+
+    if(!world.GetNetworkSettings().IsAuthoritative) {
+
+        // Clients only show what the server sends
+        if(m_streamReceiver)
+            _showStreamedClouds(world, elapsed);
         return;
+    }
 
     Float3 position = Float3(0, 0, 0);
 
@@ -916,6 +1045,8 @@ void
         float elapsed,
         FluidSystem& fluidSystem)
 {
+    TraceZone zone("CompoundCloudSystem::processCloud");
+
     elapsed *= 100.f;
     Float2 pos(cloud.m_position.X, cloud.m_position.Z);
 
@@ -943,6 +1074,12 @@ void
         advect(cloud.m_oldDens4, cloud.m_density4, elapsed, fluidSystem, pos);
     }
 
+    _updateCloudTexture(cloud);
+}
+
+void
+    CompoundCloudSystem::_updateCloudTexture(CompoundCloudComponent& cloud)
+{
     // No graphics check
     if(!cloud.m_texture)
         return;
@@ -994,6 +1131,54 @@ void
     cloud.m_texture->GetInternal()->writeData(cloud.m_textureData1, 0, 0, true);
 }
 
+void
+    CompoundCloudSystem::_showStreamedClouds(
+        CellStageWorld& world, float elapsed)
+{
+    if(!m_streamReceiver->hasData() || m_cloudTypes.empty())
+        return;
+
+    doSpawnCycle(world, m_streamReceiver->getGridCenter());
+
+    // The received contents are reached by the time the next update arrives
+    const float fraction =
+        std::min(1.f, elapsed / m_streamReceiver->getInterval());
+
+    for(auto& [id, cloud] : m_managedClouds) {
+
+        const auto* tile = m_streamReceiver->findTile(
+            cloud->m_position, _getCloudTypeName(*cloud));
+
+        if(!tile)
+            continue;
+
+        std::vector<std::vector<float>>* densities[CLOUDS_IN_ONE] = {
+            &cloud->m_density1, &cloud->m_density2, &cloud->m_density3,
+            &cloud->m_density4};
+
+        for(int i = 0; i < CLOUDS_IN_ONE; ++i) {
+
+            auto& density = *densities[i];
+            const auto& grid = tile->grids[i];
+
+            if(density.size() != grid.width ||
+                (!density.empty() && density[0].size() != grid.height))
+                continue;
+
+            for(uint32_t x = 0; x < grid.width; ++x) {
+
+                const float* target = grid.data.data() + x * grid.height;
+                auto& column = density[x];
+
+                for(uint32_t y = 0; y < grid.height; ++y)
+                    column[y] += (target[y] - column[y]) * fraction;
+            }
+        }
+
+        _updateCloudTexture(*cloud);
+    }
+}
+
 void
     CompoundCloudSystem::fillCloudChannel(
         const std::vector<std::vector<float>>& density,
@@ -1027,9 +1212,12 @@ void
         const std::vector<std::vector<float>>& density,
         float dt)
 {
+    const int width = static_cast<int>(density.size());
+    const int height = static_cast<int>(density[0].size());
+
     float a = dt * diffRate;
-    for(int x = 1; x < CLOUD_SIMULATION_WIDTH - 1; x++) {
-        for(int y = 1; y < CLOUD_SIMULATION_HEIGHT - 1; y++) {
+    for(int x = 1; x < width - 1; x++) {
+        for(int y = 1; y < height - 1; y++) {
             oldDens[x][y] = density[x][y] * (1 - a) +
                             (oldDens[x - 1][y] + oldDens[x + 1][y] +
                                 oldDens[x][y - 1] + oldDens[x][y + 1]) *
@@ -1045,16 +1233,19 @@ void
         FluidSystem& fluidSystem,
         Float2 pos)
 {
-    for(int x = 0; x < CLOUD_SIMULATION_WIDTH; x++) {
-        for(int y = 0; y < CLOUD_SIMULATION_HEIGHT; y++) {
+    const int width = static_cast<int>(density.size());
+    const int height = static_cast<int>(density[0].size());
+
+    for(int x = 0; x < width; x++) {
+        for(int y = 0; y < height; y++) {
             density[x][y] = 0;
         }
     }
 
     // TODO: this is probably the place to move the compounds on the edges into
     // the next cloud (instead of not handling them here)
-    for(size_t x = 1; x < CLOUD_SIMULATION_WIDTH - 1; x++) {
-        for(size_t y = 1; y < CLOUD_SIMULATION_HEIGHT - 1; y++) {
+    for(int x = 1; x < width - 1; x++) {
+        for(int y = 1; y < height - 1; y++) {
             if(oldDens[x][y] > 1) {
                 constexpr float viscosity =
                     0.0525f; // TODO: give each cloud a viscosity value in the
@@ -1066,8 +1257,8 @@ void
                 float dx = x + dt * velocity.X;
                 float dy = y + dt * velocity.Y;
 
-                dx = std::clamp(dx, 0.5f, CLOUD_SIMULATION_WIDTH - 1.5f);
-                dy = std::clamp(dy, 0.5f, CLOUD_SIMULATION_HEIGHT - 1.5f);
+                dx = std::clamp(dx, 0.5f, width - 1.5f);
+                dy = std::clamp(dy, 0.5f, height - 1.5f);
 
                 const int x0 = static_cast<int>(dx);
                 const int x1 = x0 + 1;
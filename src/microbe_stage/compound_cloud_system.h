@@ -11,14 +11,20 @@
 #include <Rendering/Renderable.h>
 #include <Rendering/SceneNode.h>
 
+#include <array>
+#include <memory>
+#include <string>
 #include <vector>
 
 
 namespace thrive {
 class FluidSystem;
+class SaveReader;
+class SaveWriter;
 
 class CompoundCloudSystem;
 class CellStageWorld;
+class CloudStreamReceiver;
 
 // Don't touch these without changing the explanation below
 constexpr auto CLOUDS_IN_ONE = 4;
@@ -327,6 +333,38 @@ protected:
     CompoundCloudSystem& m_owner;
 };
 
+/**
+ * @brief A copy of the contents of all the clouds
+ *
+ * Taken on the main thread by CompoundCloudSystem::takeSnapshot and then
+ * written to a save on a background thread
+ */
+struct CompoundCloudsSnapshot {
+    struct Grid {
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        //! The densities stored one column after another
+        std::vector<float> data;
+    };
+
+    struct Cloud {
+        Float3 position;
+
+        //! The name of the first compound type of the cloud
+        std::string typeName;
+
+        std::array<Grid, CLOUDS_IN_ONE> grids;
+    };
+
+    //! \brief Writes the snapshot in the format loadClouds reads
+    void
+        write(SaveWriter& writer) const;
+
+    Float3 gridCenter;
+    std::vector<Cloud> clouds;
+};
+
 
 
 //! \brief Moves the compound clouds.
@@ -386,6 +424,34 @@ public:
     void
         emptyAllClouds();
 
+    //! \brief Writes the contents of all clouds to a save
+    void
+        saveClouds(SaveWriter& writer) const;
+
+    //! \brief Copies the contents of all clouds into snapshot
+    //!
+    //! The buffers in snapshot are reused so taking repeated snapshots into
+    //! the same object doesn't allocate
+    void
+        takeSnapshot(CompoundCloudsSnapshot& snapshot) const;
+
+    //! \brief Makes this show the clouds received from a server
+    //!
+    //! When the world isn't authoritative the clouds are not simulated and
+    //! their contents are instead moved towards the contents in receiver.
+    //! Set to null to stop
+    void
+        setStreamReceiver(const std::shared_ptr<CloudStreamReceiver>& receiver)
+    {
+        m_streamReceiver = receiver;
+    }
+
+    //! \brief Restores the cloud contents written by saveClouds
+    //!
+    //! The clouds are first moved to where they were when the save was made
+    void
+        loadClouds(CellStageWorld& world, SaveReader& reader);
+
     /**
      * @brief Shuts the system down releasing all current compound cloud
      * entities
@@ -472,6 +538,28 @@ public:
     static Float3
         calculateGridCenterForPlayerPos(const Float3& pos);
 
+    //! \brief Writes density to one channel of a cloud texture
+    //! \note These kernels are shared with AgentCloudSystem. They work on
+    //! grids of any size, the size is taken from density
+    static void
+        fillCloudChannel(const std::vector<std::vector<float>>& density,
+            size_t index,
+            size_t rowBytes,
+            uint8_t* pDest);
+
+    static void
+        diffuse(float diffRate,
+            std::vector<std::vector<float>>& oldDens,
+            const std::vector<std::vector<float>>& density,
+            float dt);
+
+    static void
+        advect(const std::vector<std::vector<float>>& oldDens,
+            std::vector<std::vector<float>>& density,
+            float dt,
+            FluidSystem& fluidSystem,
+            Float2 pos);
+
 protected:
     //! \brief Removes deleted clouds from m_managedClouds
     void
@@ -501,27 +589,25 @@ private:
             float elapsed,
             FluidSystem& fluidSystem);
 
+    //! \brief Copies the densities of cloud to its texture
     void
-        initializeCloud(CompoundCloudComponent& cloud, Leviathan::Scene* scene);
+        _updateCloudTexture(CompoundCloudComponent& cloud);
 
+    //! \brief Moves the clouds towards the contents from m_streamReceiver
     void
-        fillCloudChannel(const std::vector<std::vector<float>>& density,
-            size_t index,
-            size_t rowBytes,
-            uint8_t* pDest);
+        _showStreamedClouds(CellStageWorld& world, float elapsed);
 
-    void
-        diffuse(float diffRate,
-            std::vector<std::vector<float>>& oldDens,
-            const std::vector<std::vector<float>>& density,
-            float dt);
+    //! \returns The name of the first compound type in cloud. Empty if not
+    //! registered
+    //!
+    //! The ids of the cloud types may change so this is used to identify the
+    //! clouds in saves and over the network
+    std::string
+        _getCloudTypeName(const CompoundCloudComponent& cloud) const;
 
     void
-        advect(const std::vector<std::vector<float>>& oldDens,
-            std::vector<std::vector<float>>& density,
-            float dt,
-            FluidSystem& fluidSystem,
-            Float2 pos);
+        initializeCloud(CompoundCloudComponent& cloud, Leviathan::Scene* scene);
+
 
 private:
     //! This system now spawns these entities when it needs them
@@ -546,6 +632,9 @@ private:
 
     //! This is here to not have to allocate memory every tick
     std::vector<CompoundCloudComponent*> m_tooFarAwayClouds;
+
+    //! Clouds from the server on a client
+    std::shared_ptr<CloudStreamReceiver> m_streamReceiver;
 };
 
 } // namespace thrive
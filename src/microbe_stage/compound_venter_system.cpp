@@ -40,6 +40,9 @@ float
 void
     CompoundVenterSystem::Run(CellStageWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "CompoundVenterSystem");
+
     if(!world.GetNetworkSettings().IsAuthoritative)
         return;
 
@@ -0,0 +1,255 @@
+// ------------------------------------ //
+#include "energy_balance_model.h"
+
+#include "microbe_constants.h"
+#include "organelle_table.h"
+#include "process_system.h"
+#include "simulation_parameters.h"
+
+#include <Exceptions.h>
+
+using namespace thrive;
+// ------------------------------------ //
+// Constants for computing energy balances
+constexpr auto FLAGELLA_COMPONENT_NAME = "movement";
+
+// ------------------------------------ //
+void
+    EnergyBalanceModel::setBiome(const Biome& biome,
+        const Patch::pointer& patch)
+{
+    if(m_biome != &biome) {
+        m_biome = &biome;
+        m_energy.clear();
+        m_typeEfficiencies.reset();
+    }
+
+    m_patch = patch;
+}
+
+void
+    EnergyBalanceModel::setMembrane(const MembraneType& membrane)
+{
+    // Only the total osmoregulation cost depends on the membrane so nothing
+    // cached needs to be cleared
+    m_osmoregulationFactor = membrane.osmoregulationFactor;
+}
+// ------------------------------------ //
+void
+    EnergyBalanceModel::addOrganelle(
+        const OrganelleTemplate::pointer& organelle)
+{
+    if(!organelle)
+        throw Leviathan::InvalidArgument("organelle is null");
+
+    auto& placed = m_placed[organelle->getName()];
+
+    placed.organelle = organelle;
+    ++placed.count;
+    ++m_organelleCount;
+}
+
+void
+    EnergyBalanceModel::removeOrganelle(
+        const OrganelleTemplate::pointer& organelle)
+{
+    if(!organelle)
+        throw Leviathan::InvalidArgument("organelle is null");
+
+    const auto found = m_placed.find(organelle->getName());
+
+    if(found == m_placed.end())
+        throw Leviathan::InvalidArgument(
+            "organelle type has not been added: " + organelle->getName());
+
+    if(--found->second.count <= 0)
+        m_placed.erase(found);
+
+    --m_organelleCount;
+}
+
+void
+    EnergyBalanceModel::clearOrganelles()
+{
+    m_placed.clear();
+    m_organelleCount = 0;
+}
+// ------------------------------------ //
+EnergyBalance::pointer
+    EnergyBalanceModel::getBalance()
+{
+    if(!m_biome)
+        throw Leviathan::InvalidState("biome has not been set");
+
+    auto result = EnergyBalance::MakeShared<EnergyBalance>();
+
+    float totalATPProduction = 0.f;
+    float processATPConsumption = 0.f;
+    float movementATPConsumption = 0.f;
+
+    uint64_t hexCount = 0;
+
+    for(const auto& [name, placed] : m_placed) {
+
+        const auto& energy = _getEnergy(*placed.organelle);
+
+        const float production = energy.production * placed.count;
+        const float processConsumption =
+            energy.processConsumption * placed.count;
+        const float movementConsumption =
+            energy.movementConsumption * placed.count;
+
+        if(production != 0.f)
+            result->addProduction(name, production);
+
+        if(processConsumption + movementConsumption != 0.f)
+            result->addConsumption(
+                name, processConsumption + movementConsumption);
+
+        totalATPProduction += production;
+        processATPConsumption += processConsumption;
+        movementATPConsumption += movementConsumption;
+        hexCount += energy.hexCount * placed.count;
+    }
+
+    // Add movement consumption together
+    const float baseMovementCost = BASE_MOVEMENT_ATP_COST * hexCount;
+    const auto totalMovementConsumption =
+        movementATPConsumption + baseMovementCost;
+
+    result->addConsumption("baseMovement", baseMovementCost);
+
+    // Add osmoregulation
+    const float osmoregulation =
+        ATP_COST_FOR_OSMOREGULATION * hexCount * m_osmoregulationFactor;
+
+    result->addConsumption("osmoregulation", osmoregulation);
+
+    // Compute totals
+    const auto totalATPConsumption =
+        processATPConsumption + totalMovementConsumption + osmoregulation;
+
+    result->totalProduction = totalATPProduction;
+    result->totalConsumption = totalATPConsumption;
+    result->balanceStationary = totalATPProduction - totalATPConsumption;
+    result->balance = result->balanceStationary + totalMovementConsumption;
+
+    return result;
+}
+
+ProcessEfficiencies::pointer
+    EnergyBalanceModel::getOrganelleTypeEfficiencies()
+{
+    if(!m_biome)
+        throw Leviathan::InvalidState("biome has not been set");
+
+    if(!m_typeEfficiencies) {
+
+        std::vector<OrganelleTemplate::pointer> organelles;
+
+        for(const auto& [name, organelle] :
+            OrganelleTable::getOrganelleDefinitions())
+            organelles.push_back(organelle);
+
+        m_typeEfficiencies = ProcessSystem::computeOrganelleProcessEfficiencies(
+            organelles, *m_biome);
+    }
+
+    return m_typeEfficiencies;
+}
+// ------------------------------------ //
+const EnergyBalanceModel::OrganelleEnergy&
+    EnergyBalanceModel::_getEnergy(const OrganelleTemplate& organelle)
+{
+    const auto cached = m_energy.find(&organelle);
+
+    if(cached != m_energy.end())
+        return cached->second;
+
+    const auto atp = SimulationParameters::compoundRegistry.getTypeId("atp");
+
+    OrganelleEnergy energy;
+
+    for(const auto& process : organelle.getProcesses()) {
+
+        const auto processData =
+            calculateProcessMaximumSpeed(process, *m_biome);
+
+        const auto consumed =
+            ProcessSpeedInformation::find(processData.inputs, atp);
+
+        if(consumed)
+            energy.processConsumption += consumed->amount;
+
+        const auto produced =
+            ProcessSpeedInformation::find(processData.outputs, atp);
+
+        if(produced)
+            energy.production += produced->amount;
+    }
+
+    // Take special cell components that take energy into account
+    if(organelle.hasComponent(FLAGELLA_COMPONENT_NAME))
+        energy.movementConsumption = FLAGELLA_ENERGY_COST;
+
+    energy.hexCount = organelle.getHexCount();
+
+    return m_energy.emplace(&organelle, energy).first->second;
+}
+// ------------------------------------ //
+void
+    EnergyBalanceModel::setPatchWrapper(Patch* patch)
+{
+    if(!patch)
+        throw Leviathan::InvalidArgument("patch is null");
+
+    // Takes over the reference given by the script
+    const auto wrapped = Patch::WrapPtr(patch);
+    setBiome(wrapped->getBiome(), wrapped);
+}
+
+void
+    EnergyBalanceModel::setMembraneWrapper(MembraneTypeId membrane)
+{
+    setMembrane(SimulationParameters::membraneRegistry.getTypeData(membrane));
+}
+
+void
+    EnergyBalanceModel::addOrganelleWrapper(const OrganelleTemplate& organelle)
+{
+    addOrganelle(OrganelleTemplate::pointer(
+        const_cast<OrganelleTemplate*>(&organelle)));
+}
+
+void
+    EnergyBalanceModel::removeOrganelleWrapper(
+        const OrganelleTemplate& organelle)
+{
+    removeOrganelle(OrganelleTemplate::pointer(
+        const_cast<OrganelleTemplate*>(&organelle)));
+}
+
+EnergyBalance*
+    EnergyBalanceModel::getBalanceWrapper()
+{
+    auto result = getBalance();
+
+    // Reference for the caller
+    result->AddRef();
+    return result.get();
+}
+
+ProcessEfficiencies*
+    EnergyBalanceModel::getOrganelleTypeEfficienciesWrapper()
+{
+    auto result = getOrganelleTypeEfficiencies();
+
+    result->AddRef();
+    return result.get();
+}
+
+EnergyBalanceModel*
+    EnergyBalanceModel::factory()
+{
+    return new EnergyBalanceModel();
+}
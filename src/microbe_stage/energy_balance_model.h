@@ -0,0 +1,127 @@
+#pragma once
+
+#include "membrane_types.h"
+#include "organelle_template.h"
+#include "patch.h"
+#include "process_information.h"
+
+#include <Common/ReferenceCounted.h>
+
+#include <map>
+#include <unordered_map>
+
+namespace thrive {
+
+//! \brief Keeps the energy balance of a cell up to date as organelles are
+//! added and removed
+//!
+//! The ATP use of each organelle type is calculated once per biome and the
+//! balance is summed from the organelle counts. The cached numbers are only
+//! thrown away when the biome changes
+class EnergyBalanceModel : public Leviathan::ReferenceCounted {
+protected:
+    // These are protected for only constructing properly reference
+    // counted instances through MakeShared
+    friend ReferenceCounted;
+    EnergyBalanceModel() = default;
+
+    //! ATP use of a single organelle of some type
+    struct OrganelleEnergy {
+        float production = 0.f;
+        float processConsumption = 0.f;
+        float movementConsumption = 0.f;
+        uint64_t hexCount = 0;
+    };
+
+    struct PlacedType {
+        OrganelleTemplate::pointer organelle;
+        int count = 0;
+    };
+
+public:
+    //! \brief Sets the biome the balance is calculated in
+    //!
+    //! Clears the cached organelle numbers if the biome changes
+    //! \param patch Keeps the biome alive, may be null if the caller keeps
+    //! biome alive
+    void
+        setBiome(const Biome& biome, const Patch::pointer& patch = nullptr);
+
+    void
+        setMembrane(const MembraneType& membrane);
+
+    void
+        addOrganelle(const OrganelleTemplate::pointer& organelle);
+
+    //! \exception Leviathan::InvalidArgument if organelle hasn't been added
+    void
+        removeOrganelle(const OrganelleTemplate::pointer& organelle);
+
+    //! \brief Removes all organelles but keeps the cached numbers
+    void
+        clearOrganelles();
+
+    //! \exception Leviathan::InvalidState if setBiome hasn't been called
+    EnergyBalance::pointer
+        getBalance();
+
+    //! \brief Process efficiencies of all the organelle types in the biome
+    //!
+    //! Calculated once per biome
+    //! \exception Leviathan::InvalidState if setBiome hasn't been called
+    ProcessEfficiencies::pointer
+        getOrganelleTypeEfficiencies();
+
+    //! \returns The number of organelles added
+    uint64_t
+        getOrganelleCount() const
+    {
+        return m_organelleCount;
+    }
+
+    // Script wrappers
+    void
+        setPatchWrapper(Patch* patch);
+
+    void
+        setMembraneWrapper(MembraneTypeId membrane);
+
+    void
+        addOrganelleWrapper(const OrganelleTemplate& organelle);
+
+    void
+        removeOrganelleWrapper(const OrganelleTemplate& organelle);
+
+    EnergyBalance*
+        getBalanceWrapper();
+
+    ProcessEfficiencies*
+        getOrganelleTypeEfficienciesWrapper();
+
+    //! Factory for scripts
+    static EnergyBalanceModel*
+        factory();
+
+    REFERENCE_COUNTED_PTR_TYPE(EnergyBalanceModel);
+
+private:
+    const OrganelleEnergy&
+        _getEnergy(const OrganelleTemplate& organelle);
+
+private:
+    const Biome* m_biome = nullptr;
+    Patch::pointer m_patch;
+
+    float m_osmoregulationFactor = 1.f;
+
+    //! Cached per organelle type numbers for m_biome
+    std::unordered_map<const OrganelleTemplate*, OrganelleEnergy> m_energy;
+    ProcessEfficiencies::pointer m_typeEfficiencies;
+
+    //! The organelles in the cell by name. Sorted to keep the balance entries
+    //! in a stable order
+    std::map<std::string, PlacedType> m_placed;
+    uint64_t m_organelleCount = 0;
+};
+
+} // namespace thrive
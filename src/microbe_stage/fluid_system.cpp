@@ -1,5 +1,7 @@
 #include "fluid_system.h"
 
+#include "engine/system_profiler.h"
+
 using namespace thrive;
 
 const Float2 FluidSystem::scale(0.05f, 0.05f);
@@ -14,6 +16,8 @@ FluidSystem::FluidSystem() :
 void
     FluidSystem::Run(GameWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(world, "FluidSystem");
+
     millisecondsPassed += elapsed / 1000.f;
 
     for(auto& [id, components] : CachedComponents.GetIndex()) {
@@ -27,6 +27,7 @@ generator.addInclude 'microbe_stage/spawn_system.h'
 generator.addInclude 'microbe_stage/agent_cloud_system.h'
 generator.addInclude 'microbe_stage/compound_absorber_system.h'
 generator.addInclude 'microbe_stage/microbe_camera_system.h'
+generator.addInclude 'microbe_stage/microbe_stats_system.h'
 generator.addInclude 'microbe_stage/player_microbe_control.h'
 generator.addInclude 'microbe_stage/microbe_editor_key_handler.h'
 generator.addInclude 'microbe_stage/player_hover_info.h'
@@ -34,6 +35,7 @@ generator.addInclude 'microbe_stage/patch_manager.h'
 generator.addInclude 'general/properties_component.h'
 generator.addInclude 'general/timed_life_system.h'
 generator.addInclude 'general/timed_world_operations.h'
+generator.addInclude 'engine/system_profiler.h'
 
 cellWorld = GameWorldClass.new(
   'CellStageWorld',
@@ -72,22 +74,20 @@ cellWorld = GameWorldClass.new(
                         ],
                         releaseparams: ['GetScene()'],
                         nosynchronize: true),
-    EntityComponent.new('AgentCloudComponent', [ConstructorInfo.new(
-      [
-        Variable.new('compoundId', 'CompoundId',
-                     noRef: true,
-                     memberaccess: 'm_compoundId'),
-        Variable.new('red', 'float',
-                     noRef: true,
-                     memberaccess: 'getRed()'),
-        Variable.new('green', 'float',
-                     noRef: true,
-                     memberaccess: 'getGreen()'),
-        Variable.new('blue', 'float',
-                     noRef: true,
-                     memberaccess: 'getBlue()')
-      ]
-    )]),
+    EntityComponent.new('AgentCloudComponent', [
+                          # Only AgentCloudSystem creates these
+                          ConstructorInfo.new(
+                            [
+                              Variable.new('owner', 'AgentCloudSystem',
+                                           noConst: true),
+                              Variable.new('compoundId', 'CompoundId',
+                                           noRef: true),
+                              Variable.new('position', 'Float3')
+                            ], noangelscript: true
+                          )
+                        ],
+                        releaseparams: ['GetScene()'],
+                        nosynchronize: true),
     EntityComponent.new('SpawnedComponent', [ConstructorInfo.new(
       [
         Variable.new('newSpawnRadius', 'double',
@@ -103,8 +103,9 @@ cellWorld = GameWorldClass.new(
       ]
     )],
                         nosynchronize: true),
-    EntityComponent.new('AgentProperties', [ConstructorInfo.new([])]),
-    EntityComponent.new('DamageOnTouchComponent', [ConstructorInfo.new([])])
+    EntityComponent.new('DamageOnTouchComponent', [ConstructorInfo.new([])]),
+    EntityComponent.new('MicrobeStatsComponent', [ConstructorInfo.new([])],
+                        nosynchronize: true)
 
   ],
   systems: [
@@ -137,8 +138,18 @@ cellWorld = GameWorldClass.new(
                                     nonMethodParam: true)
                      ]),
 
-    EntitySystem.new('AgentCloudSystem', %w[Position AgentCloudComponent RenderNode],
-                     runtick: { group: 5, parameters: [] }),
+    EntitySystem.new('AgentCloudSystem', %w[MicrobeStatsComponent Position
+                                            MembraneComponent],
+                     runtick: { group: 52, parameters: ['elapsed'] },
+                     visibletoscripts: true,
+                     init: [
+                       Variable.new('*this', '',
+                                    nonMethodParam: true)
+                     ],
+                     release: [
+                       Variable.new('*this', '',
+                                    nonMethodParam: true)
+                     ]),
 
     EntitySystem.new('CompoundAbsorberSystem', %w[AgentCloudComponent Position
                                                   MembraneComponent
@@ -147,6 +158,12 @@ cellWorld = GameWorldClass.new(
                        'ComponentCompoundCloudComponent.GetIndex()', 'elapsed'
                      ] }),
 
+    EntitySystem.new('MicrobeStatsSystem', %w[MicrobeStatsComponent
+                                              CompoundBagComponent
+                                              CompoundAbsorberComponent
+                                              MembraneComponent],
+                     runtick: { group: 7, parameters: ['elapsed'] }),
+
     EntitySystem.new('MicrobeCameraSystem', [],
                      runtick: { group: 1000, parameters: ['elapsed'] }),
     EntitySystem.new('PlayerMicrobeControlSystem', [],
@@ -167,7 +184,9 @@ cellWorld = GameWorldClass.new(
   ],
   perworlddata: [
     Variable.new('_PatchManager', 'PatchManager'),
-    Variable.new('_TimedWorldOperations', 'TimedWorldOperations')
+    Variable.new('_TimedWorldOperations', 'TimedWorldOperations'),
+    # The native systems time their runs with this
+    Variable.new('_SystemProfiler', 'SystemProfiler')
   ]
 )
 
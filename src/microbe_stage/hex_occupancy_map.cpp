@@ -0,0 +1,130 @@
+// ------------------------------------ //
+#include "hex_occupancy_map.h"
+
+#include "general/hex.h"
+#include "organelle_template.h"
+
+#include <Exceptions.h>
+
+using namespace thrive;
+// ------------------------------------ //
+int32_t
+    HexOccupancyMap::add(const std::vector<Int2>& hexes, int q, int r)
+{
+    const auto index = static_cast<int32_t>(m_entryHexes.size());
+
+    std::vector<int64_t> encoded;
+    encoded.reserve(hexes.size());
+
+    for(const auto& hex : hexes) {
+
+        const auto key = Hex::encodeAxial(hex.X + q, hex.Y + r);
+        encoded.push_back(key);
+
+        if(!m_occupants.emplace(key, index).second)
+            m_hasOverlaps = true;
+    }
+
+    m_entryHexes.push_back(std::move(encoded));
+    return index;
+}
+
+int32_t
+    HexOccupancyMap::getAt(int q, int r) const
+{
+    const auto found = m_occupants.find(Hex::encodeAxial(q, r));
+
+    if(found == m_occupants.end())
+        return EMPTY;
+
+    return found->second;
+}
+
+bool
+    HexOccupancyMap::isFree(const std::vector<Int2>& hexes, int q, int r) const
+{
+    for(const auto& hex : hexes) {
+        if(m_occupants.find(Hex::encodeAxial(hex.X + q, hex.Y + r)) !=
+            m_occupants.end())
+            return false;
+    }
+
+    return true;
+}
+
+void
+    HexOccupancyMap::removeAt(uint32_t index)
+{
+    if(index >= m_entryHexes.size())
+        throw Leviathan::InvalidArgument("index out of range");
+
+    m_entryHexes.erase(m_entryHexes.begin() + index);
+
+    // A hex of the removed entry may also be covered by a later entry which
+    // now needs to be found there
+    if(m_hasOverlaps) {
+        _rebuild();
+        return;
+    }
+
+    for(auto iter = m_occupants.begin(); iter != m_occupants.end();) {
+
+        const auto occupant = static_cast<uint32_t>(iter->second);
+
+        if(occupant == index) {
+            iter = m_occupants.erase(iter);
+            continue;
+        }
+
+        if(occupant > index)
+            --iter->second;
+
+        ++iter;
+    }
+}
+
+void
+    HexOccupancyMap::clear()
+{
+    m_occupants.clear();
+    m_entryHexes.clear();
+    m_hasOverlaps = false;
+}
+// ------------------------------------ //
+int32_t
+    HexOccupancyMap::addOrganelle(const OrganelleTemplate& organelle,
+        int q,
+        int r,
+        int rotation)
+{
+    return add(organelle.getRotatedHexes(rotation), q, r);
+}
+
+bool
+    HexOccupancyMap::canPlaceOrganelle(const OrganelleTemplate& organelle,
+        int q,
+        int r,
+        int rotation) const
+{
+    return isFree(organelle.getRotatedHexes(rotation), q, r);
+}
+
+HexOccupancyMap*
+    HexOccupancyMap::factory()
+{
+    return new HexOccupancyMap();
+}
+// ------------------------------------ //
+void
+    HexOccupancyMap::_rebuild()
+{
+    m_occupants.clear();
+    m_hasOverlaps = false;
+
+    for(size_t i = 0; i < m_entryHexes.size(); ++i) {
+        for(const auto key : m_entryHexes[i]) {
+            if(!m_occupants.emplace(key, static_cast<int32_t>(i)).second)
+                m_hasOverlaps = true;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <Common/ReferenceCounted.h>
+#include <Common/Types.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace thrive {
+
+class OrganelleTemplate;
+
+//! \brief Maps hexes to the organelle that occupies them
+//!
+//! Entries are identified by their index, which is the same as the index of
+//! the organelle in the array this map is kept in sync with. Removing an entry
+//! shifts the later indices down by one just like array::removeAt does
+//! \note Keys are made with Hex::encodeAxial
+class HexOccupancyMap : public Leviathan::ReferenceCounted {
+protected:
+    // These are protected for only constructing properly reference
+    // counted instances through MakeShared
+    friend ReferenceCounted;
+    HexOccupancyMap() = default;
+
+public:
+    //! Returned by getAt when no entry is at a hex
+    static constexpr int32_t EMPTY = -1;
+
+    //! \brief Adds a new entry covering the hexes offset by (q, r)
+    //!
+    //! If a hex is already occupied the old entry keeps it, the same way a
+    //! linear search would find the organelle that was added first
+    //! \returns The index of the new entry
+    int32_t
+        add(const std::vector<Int2>& hexes, int q, int r);
+
+    //! \returns The index of the entry at (q, r) or EMPTY
+    int32_t
+        getAt(int q, int r) const;
+
+    //! \returns True if none of the hexes offset by (q, r) are occupied
+    bool
+        isFree(const std::vector<Int2>& hexes, int q, int r) const;
+
+    //! \brief Removes the entry at index
+    //! \exception Leviathan::InvalidArgument if index is out of range
+    void
+        removeAt(uint32_t index);
+
+    void
+        clear();
+
+    //! \returns The number of entries
+    uint32_t
+        getCount() const
+    {
+        return static_cast<uint32_t>(m_entryHexes.size());
+    }
+
+    //! \returns The number of occupied hexes
+    uint32_t
+        getOccupiedHexCount() const
+    {
+        return static_cast<uint32_t>(m_occupants.size());
+    }
+
+    // Script wrappers
+    int32_t
+        addOrganelle(const OrganelleTemplate& organelle,
+            int q,
+            int r,
+            int rotation);
+
+    int32_t
+        getAtWrapper(const Int2& hex) const
+    {
+        return getAt(hex.X, hex.Y);
+    }
+
+    bool
+        canPlaceOrganelle(const OrganelleTemplate& organelle,
+            int q,
+            int r,
+            int rotation) const;
+
+    //! Factory for scripts
+    static HexOccupancyMap*
+        factory();
+
+    REFERENCE_COUNTED_PTR_TYPE(HexOccupancyMap);
+
+private:
+    //! Re-adds all entries, used when removing an entry that overlapped
+    //! another one
+    void
+        _rebuild();
+
+private:
+    std::unordered_map<int64_t, int32_t> m_occupants;
+
+    //! The encoded hexes of each entry
+    std::vector<std::vector<int64_t>> m_entryHexes;
+
+    //! True once an entry has been added that overlaps an earlier one
+    bool m_hasOverlaps = false;
+};
+
+} // namespace thrive
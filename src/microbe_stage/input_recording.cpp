@@ -0,0 +1,203 @@
+// ------------------------------------ //
+#include "input_recording.h"
+
+#include <Exceptions.h>
+
+#include <limits>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+constexpr auto INPUT_RECORDING_HEADER = "thrive_input_recording";
+constexpr auto INPUT_RECORDING_VERSION = 1;
+
+namespace {
+
+std::string
+    actionsToString(const ControlIntent& intent)
+{
+    std::string result;
+
+    if(intent.engulf)
+        result += 'e';
+    if(intent.toxin)
+        result += 't';
+    if(intent.glucoseCloud)
+        result += 'g';
+    if(intent.phosphateCloud)
+        result += 'p';
+    if(intent.ammoniaCloud)
+        result += 'a';
+
+    return result.empty() ? "-" : result;
+}
+
+//! \returns False if actions has unknown letters
+bool
+    parseActions(const std::string& actions, ControlIntent& intent)
+{
+    if(actions == "-")
+        return true;
+
+    for(const auto letter : actions) {
+        switch(letter) {
+        case 'e': intent.engulf = true; break;
+        case 't': intent.toxin = true; break;
+        case 'g': intent.glucoseCloud = true; break;
+        case 'p': intent.phosphateCloud = true; break;
+        case 'a': intent.ammoniaCloud = true; break;
+        default: return false;
+        }
+    }
+
+    return true;
+}
+
+[[noreturn]] void
+    throwInvalidLine(size_t line, const std::string& message)
+{
+    throw Leviathan::InvalidArgument(
+        "input recording line " + std::to_string(line) + ": " + message);
+}
+
+} // namespace
+// ------------------------------------ //
+bool
+    ControlIntent::hasSameState(const ControlIntent& other) const
+{
+    return movement == other.movement && lookPoint == other.lookPoint &&
+           glucoseCloud == other.glucoseCloud &&
+           phosphateCloud == other.phosphateCloud &&
+           ammoniaCloud == other.ammoniaCloud;
+}
+// ------------------------------------ //
+InputRecorder::InputRecorder(uint32_t seed) : m_seed(seed) {}
+
+void
+    InputRecorder::record(const ControlIntent& intent)
+{
+    if(m_ticks == 0 || intent.engulf || intent.toxin ||
+        !intent.hasSameState(m_previous))
+        m_entries.push_back({m_ticks, intent});
+
+    m_previous = intent;
+    ++m_ticks;
+}
+
+std::string
+    InputRecorder::toString() const
+{
+    std::ostringstream stream;
+
+    // Enough digits that the floats are read back exactly
+    stream.precision(std::numeric_limits<float>::max_digits10);
+
+    stream << INPUT_RECORDING_HEADER << ' ' << INPUT_RECORDING_VERSION << '\n';
+    stream << "seed " << m_seed << '\n';
+
+    for(const auto& entry : m_entries) {
+
+        const auto& intent = entry.intent;
+
+        stream << entry.tick << ' ' << intent.movement.X << ' '
+               << intent.movement.Z << ' ' << intent.lookPoint.X << ' '
+               << intent.lookPoint.Z << ' ' << actionsToString(intent) << '\n';
+    }
+
+    stream << "end " << m_ticks << '\n';
+
+    return stream.str();
+}
+// ------------------------------------ //
+InputReplay::InputReplay(const std::string& recording)
+{
+    std::istringstream lines(recording);
+    std::string line;
+    size_t lineNumber = 0;
+
+    const auto nextLine = [&]() {
+        ++lineNumber;
+
+        if(!std::getline(lines, line))
+            throwInvalidLine(lineNumber, "unexpected end of the recording");
+
+        return std::istringstream(line);
+    };
+
+    {
+        auto stream = nextLine();
+        std::string header;
+        int version = 0;
+
+        if(!(stream >> header >> version) || header != INPUT_RECORDING_HEADER)
+            throwInvalidLine(lineNumber, "not an input recording");
+
+        if(version != INPUT_RECORDING_VERSION)
+            throwInvalidLine(lineNumber,
+                "unsupported version: " + std::to_string(version));
+    }
+
+    {
+        auto stream = nextLine();
+        std::string name;
+
+        if(!(stream >> name >> m_seed) || name != "seed")
+            throwInvalidLine(lineNumber, "expected the seed");
+    }
+
+    while(true) {
+
+        auto stream = nextLine();
+
+        // The end is checked first as it doesn't start with a number
+        if(line.compare(0, 4, "end ") == 0) {
+
+            std::string name;
+
+            if(!(stream >> name >> m_ticks))
+                throwInvalidLine(lineNumber, "expected the tick count");
+
+            if(!m_entries.empty() && m_entries.back().tick >= m_ticks)
+                throwInvalidLine(lineNumber, "entries after the end");
+
+            break;
+        }
+
+        RecordedIntent entry;
+        std::string actions;
+
+        if(!(stream >> entry.tick >> entry.intent.movement.X >>
+                entry.intent.movement.Z >> entry.intent.lookPoint.X >>
+                entry.intent.lookPoint.Z >> actions))
+            throwInvalidLine(lineNumber, "malformed entry");
+
+        if(!parseActions(actions, entry.intent))
+            throwInvalidLine(lineNumber, "unknown actions: " + actions);
+
+        if(!m_entries.empty() && m_entries.back().tick >= entry.tick)
+            throwInvalidLine(lineNumber, "ticks are not increasing");
+
+        m_entries.push_back(entry);
+    }
+}
+
+ControlIntent
+    InputReplay::next()
+{
+    if(isFinished())
+        return m_current;
+
+    // The instant actions only happen on the tick they were recorded on
+    m_current.engulf = false;
+    m_current.toxin = false;
+
+    if(m_nextEntry < m_entries.size() &&
+        m_entries[m_nextEntry].tick == m_tick) {
+
+        m_current = m_entries[m_nextEntry].intent;
+        ++m_nextEntry;
+    }
+
+    ++m_tick;
+    return m_current;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Common/Types.h>
+
+#include <string>
+#include <vector>
+
+namespace thrive {
+
+//! \brief What the player wanted their cell to do during one tick
+struct ControlIntent {
+    //! Normalized movement direction on the XZ plane
+    Float3 movement = Float3(0, 0, 0);
+
+    //! The world position the cell turns towards
+    Float3 lookPoint = Float3(0, 0, 0);
+
+    bool engulf = false;
+    bool toxin = false;
+
+    //! The cloud spawning cheats
+    bool glucoseCloud = false;
+    bool phosphateCloud = false;
+    bool ammoniaCloud = false;
+
+    //! \returns True if the parts that last over multiple ticks are the
+    //! same. engulf and toxin only affect the tick they are in
+    bool
+        hasSameState(const ControlIntent& other) const;
+};
+
+//! \brief A ControlIntent and the tick it started on
+struct RecordedIntent {
+    uint64_t tick = 0;
+    ControlIntent intent;
+};
+
+/**
+ * @brief Records the player control intents of a cell stage session
+ *
+ * Together with the random seed the session was started with this is enough
+ * to replay the session with InputReplay. Only the ticks where the intent
+ * changes are stored. The recording is text with one entry per line:
+ * \code
+ * thrive_input_recording 1
+ * seed <seed>
+ * <tick> <movement x> <movement z> <look x> <look z> <actions>
+ * end <tick count>
+ * \endcode
+ * actions is "-" or some of the letters e (engulf), t (toxin), g (glucose
+ * cloud), p (phosphate cloud) and a (ammonia cloud).
+ */
+class InputRecorder {
+public:
+    //! \param seed The seed the random generator was set to when the session
+    //! started
+    InputRecorder(uint32_t seed);
+
+    //! \brief Records the intent of the next tick
+    //!
+    //! Needs to be called on every world tick, with a default intent when
+    //! there is no living player cell, for the replay to stay in step
+    void
+        record(const ControlIntent& intent);
+
+    //! \returns The recording in the format InputReplay reads
+    std::string
+        toString() const;
+
+    uint32_t
+        getSeed() const
+    {
+        return m_seed;
+    }
+
+    uint64_t
+        getTickCount() const
+    {
+        return m_ticks;
+    }
+
+private:
+    const uint32_t m_seed;
+    uint64_t m_ticks = 0;
+
+    std::vector<RecordedIntent> m_entries;
+    ControlIntent m_previous;
+};
+
+//! \brief Plays back a recording made by InputRecorder one tick at a time
+class InputReplay {
+public:
+    //! \exception Leviathan::InvalidArgument if recording is malformed
+    InputReplay(const std::string& recording);
+
+    //! \returns The intent of the next tick
+    //! \note Keeps returning the last intent once finished
+    ControlIntent
+        next();
+
+    bool
+        isFinished() const
+    {
+        return m_tick >= m_ticks;
+    }
+
+    uint32_t
+        getSeed() const
+    {
+        return m_seed;
+    }
+
+    uint64_t
+        getTickCount() const
+    {
+        return m_ticks;
+    }
+
+private:
+    uint32_t m_seed = 0;
+    uint64_t m_ticks = 0;
+
+    std::vector<RecordedIntent> m_entries;
+    size_t m_nextEntry = 0;
+
+    uint64_t m_tick = 0;
+    ControlIntent m_current;
+};
+
+} // namespace thrive
@@ -1,4 +1,5 @@
 #include "membrane_system.h"
+#include "engine/tracing.h"
 #include "engine/typedefs.h"
 
 #include <Engine.h>
@@ -403,6 +404,8 @@ Leviathan::Material::pointer
 void
     MembraneComponent::Initialize()
 {
+    TraceZone zone("MembraneComponent::Initialize");
+
     for(const auto& pos : organellePositions) {
         if(std::abs(pos.X) + 1 > cellDimensions) {
             cellDimensions = std::abs(pos.X) + 1;
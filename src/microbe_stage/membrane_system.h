@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/component_types.h"
+#include "engine/system_profiler.h"
 #include "membrane_types.h"
 #include "simulation_parameters.h"
 
@@ -231,6 +232,8 @@ public:
     void
         Run(GameWorld& world, Leviathan::Scene* scene)
     {
+        SystemProfiler::ScopedTimer timer(world, "MembraneSystem");
+
         auto& index = CachedComponents.GetIndex();
         for(auto iter = index.begin(); iter != index.end(); ++iter) {
 
@@ -3,6 +3,7 @@
 #include "ThriveGame.h"
 
 #include "engine/player_data.h"
+#include "engine/system_profiler.h"
 
 #include <Entities/Components.h>
 #include <Entities/GameWorld.h>
@@ -33,6 +34,8 @@ void
 void
     MicrobeCameraSystem::Run(Leviathan::GameWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(world, "MicrobeCameraSystem");
+
     if(m_cameraEntity == 0)
         return;
 
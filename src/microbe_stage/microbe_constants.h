@@ -0,0 +1,78 @@
+#pragma once
+
+//! \file Gameplay constants used by both the C++ code and the scripts. These
+//! are registered to the scripts as const globals so that the values are
+//! defined only here
+
+namespace thrive {
+
+// Cell colours
+constexpr float MIN_COLOR = 0.0f;
+constexpr float MAX_COLOR = 0.9f;
+
+constexpr float MIN_OPACITY = 0.5f;
+constexpr float MAX_OPACITY = 1.8f;
+
+constexpr float MIN_OPACITY_CHITIN = 0.4f;
+constexpr float MAX_OPACITY_CHITIN = 1.2f;
+
+// Mutation chances
+constexpr float MUTATION_BACTERIA_TO_EUKARYOTE = 1.0f;
+constexpr float MUTATION_CREATION_RATE = 0.1f;
+constexpr float MUTATION_EXTRA_CREATION_RATE = 0.1f;
+constexpr float MUTATION_DELETION_RATE = 0.1f;
+constexpr float MUTATION_REPLACEMENT_RATE = 0.1f;
+
+// Max fear and agression and activity
+constexpr float MAX_SPECIES_AGRESSION = 400.0f;
+constexpr float MAX_SPECIES_FEAR = 400.0f;
+constexpr float MAX_SPECIES_ACTIVITY = 400.0f;
+constexpr float MAX_SPECIES_FOCUS = 400.0f;
+constexpr float MAX_SPECIES_OPPORTUNISM = 400.0f;
+
+// Personality mutation
+constexpr float MAX_SPECIES_PERSONALITY_MUTATION = 20.0f;
+constexpr float MIN_SPECIES_PERSONALITY_MUTATION = -20.0f;
+
+//! Osmoregulation ATP cost per hex
+constexpr float ATP_COST_FOR_OSMOREGULATION = 1.0f;
+
+//! BASE MOVEMENT COST ATP cost
+//! Cancels out a little bit more then one cytoplasm's glycolysis
+//! Note: this is applied *per* hex
+constexpr float BASE_MOVEMENT_ATP_COST = 1.0f;
+
+constexpr float FLAGELLA_ENERGY_COST = 7.1f;
+
+constexpr float DEFAULT_HEALTH = 100.0f;
+//! Amount of health per second regenerated
+constexpr float REGENERATION_RATE = 1.0f;
+
+//! Amount the microbes maxmimum bandwidth increases with per organelle
+//! added. This is a temporary replacement for microbe surface area
+constexpr float BANDWIDTH_PER_ORGANELLE = 1.0f;
+
+//! The of time it takes for the microbe to regenerate an amount of
+//! bandwidth equal to maxBandwidth
+constexpr float BANDWIDTH_REFILL_DURATION = 0.8f;
+
+//! The amount of time between each loop to maintaining a fill level below
+//! STORAGE_EJECTION_THRESHHOLD and eject useless compounds
+constexpr float EXCESS_COMPOUND_COLLECTION_INTERVAL = 1.0f;
+
+//! The speed reduction when a cell is in engulfing mode
+constexpr float ENGULFING_MOVEMENT_DIVISION = 2.0f;
+
+//! The speed reduction when a cell is being engulfed
+constexpr float ENGULFED_MOVEMENT_DIVISION = 10.0f;
+
+//! The amount of ATP per second spent on being on engulfing mode
+constexpr float ENGULFING_ATP_COST_SECOND = 1.5f;
+
+//! The amount of hp per second of damage from being engulfed
+constexpr float ENGULF_DAMAGE = 45.0f;
+
+//! How long a cell that escaped being engulfed is still considered chased
+constexpr float CREATURE_ESCAPE_INTERVAL = 5000.0f;
+
+} // namespace thrive
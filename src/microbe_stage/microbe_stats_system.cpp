@@ -0,0 +1,294 @@
+// ------------------------------------ //
+#include "microbe_stats_system.h"
+
+#include "microbe_stage/agent_cloud_system.h"
+#include "microbe_stage/compound_absorber_system.h"
+#include "microbe_stage/membrane_system.h"
+#include "microbe_stage/process_system.h"
+#include "microbe_stage/simulation_parameters.h"
+
+#include "generated/cell_stage_world.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace thrive;
+// ------------------------------------ //
+MicrobeStatsComponent::MicrobeStatsComponent() : Leviathan::Component(TYPE) {}
+
+void
+    MicrobeStatsComponent::setAgentSpecies(const std::string& speciesName)
+{
+    agentSpeciesTag = AgentCloudSystem::speciesTag(speciesName);
+}
+
+void
+    MicrobeStatsComponent::flashMembrane(float duration, const Float4& colour)
+{
+    if(flashDuration <= 0) {
+        flashColour = colour;
+        flashDuration = duration;
+    }
+}
+
+void
+    MicrobeStatsComponent::removeEngulfedEffect(MicrobeStatsComponent* hostile)
+{
+    // This kept getting doubled for some reason, so it is just set to default
+    movementFactor = 1;
+    wasBeingEngulfed = false;
+    isBeingEngulfed = false;
+
+    if(hostile)
+        hostile->isCurrentlyEngulfing = false;
+
+    hostileEngulfer = NULL_OBJECT;
+}
+// ------------------------------------ //
+double
+    MicrobeStatsSystem::storeCompound(MicrobeStatsComponent& stats,
+        CompoundBagComponent& bag,
+        const MembraneComponent& membrane,
+        CompoundId compound,
+        double amount)
+{
+    // Bandwidth limit, same as MicrobeOperations::getBandwidth
+    const double volume =
+        SimulationParameters::compoundRegistry.getTypeData(compound).volume;
+
+    const double usedBandwidth = std::min(
+        amount * volume, static_cast<double>(stats.remainingBandwidth));
+    stats.remainingBandwidth -= static_cast<float>(usedBandwidth);
+
+    double storedAmount = usedBandwidth / volume;
+
+    if(membrane.rawMembraneType)
+        storedAmount *= membrane.rawMembraneType->resourceAbsorptionFactor;
+
+    storedAmount = std::min(storedAmount, stats.capacity);
+
+    if(bag.getCompoundAmount(compound) + amount <= stats.capacity) {
+        bag.giveCompound(compound, storedAmount);
+        stats.stored += storedAmount;
+    }
+
+    return amount - storedAmount;
+}
+// ------------------------------------ //
+void
+    MicrobeStatsSystem::Run(CellStageWorld& world, float elapsed)
+{
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "MicrobeStatsSystem");
+
+    if(m_atpId == NULL_COMPOUND)
+        m_atpId = SimulationParameters::compoundRegistry.getTypeId("atp");
+
+    for(auto& value : CachedComponents.GetIndex()) {
+
+        MicrobeStatsComponent& stats = std::get<0>(*value.second);
+        CompoundBagComponent& bag = std::get<1>(*value.second);
+        CompoundAbsorberComponent& absorber = std::get<2>(*value.second);
+        MembraneComponent& membrane = std::get<3>(*value.second);
+
+        if(stats.dormant)
+            continue;
+
+        if(stats.dead) {
+            stats.deathTimer -= elapsed;
+            stats.flashDuration = 0;
+            continue;
+        }
+
+        stats.movementFactor = 1;
+        stats.agentEmissionCooldown -= elapsed;
+
+        // Storage
+        stats.stored = bag.getStorageSpaceUsed();
+
+        // This is only used in the process sytem to make sure you
+        // dont add anymore when out of space for a specific
+        // compound
+        bag.storageSpace = stats.capacity;
+
+        // The absorber is toggled based on the remaining bandwidth
+        if(stats.remainingBandwidth < 1) {
+            absorber.disable();
+        } else {
+            absorber.enable();
+        }
+
+        const float addedBandwidth =
+            elapsed * 2700.f * (stats.maxBandwidth / BANDWIDTH_REFILL_DURATION);
+
+        stats.remainingBandwidth = std::min(
+            stats.remainingBandwidth + addedBandwidth, stats.maxBandwidth);
+
+        // Store the compounds absorbed from clouds if there is room
+        for(const auto& [compound, amount] : absorber.m_absorbedCompounds) {
+
+            if(amount > 0.0 &&
+                amount + bag.getCompoundAmount(compound) <= stats.capacity) {
+                storeCompound(stats, bag, membrane, compound,
+                    std::min(stats.capacity, static_cast<double>(amount)));
+            }
+        }
+
+        // Regenerate health
+        if(stats.hitpoints < stats.maxHitpoints &&
+            bag.getCompoundAmount(m_atpId) >= 1.0) {
+
+            stats.hitpoints = std::min(
+                stats.hitpoints + REGENERATION_RATE * elapsed,
+                stats.maxHitpoints);
+        }
+
+        // There is an osmoregulation cost
+        if(membrane.rawMembraneType) {
+            const double osmoCost =
+                stats.totalHexCount *
+                membrane.rawMembraneType->osmoregulationFactor *
+                ATP_COST_FOR_OSMOREGULATION * elapsed;
+
+            stats.stored -= bag.takeCompound(m_atpId, osmoCost);
+        }
+
+        // Reset compound absorption
+        absorber.setAbsorbtionCapacity(stats.capacity);
+
+        // The scripts handle what happens each interval
+        stats.compoundCollectionTimer += elapsed;
+
+        while(stats.compoundCollectionTimer >
+              EXCESS_COMPOUND_COLLECTION_INTERVAL) {
+            stats.compoundCollectionTimer -=
+                EXCESS_COMPOUND_COLLECTION_INTERVAL;
+            ++stats.pendingCompoundCollections;
+        }
+
+        if(stats.hitpoints != stats.previousHitpoints)
+            membrane.setHealthFraction(stats.hitpoints / stats.maxHitpoints);
+
+        stats.previousHitpoints = stats.hitpoints;
+
+        _updateFlashing(stats, membrane, elapsed);
+        _updateEngulfing(world, value.first, stats, bag, elapsed);
+    }
+}
+
+void
+    MicrobeStatsSystem::_updateFlashing(MicrobeStatsComponent& stats,
+        MembraneComponent& membrane,
+        float elapsed)
+{
+    if(stats.flashDuration <= 0 || stats.flashColour == Float4(0, 0, 0, 0))
+        return;
+
+    stats.flashDuration -= elapsed;
+
+    // How frequently it flashes
+    if(std::fmod(stats.flashDuration, 0.6f) < 0.3f) {
+        membrane.setColour(stats.flashColour);
+    } else {
+        membrane.setColour(stats.membraneColour);
+    }
+
+    if(stats.flashDuration <= 0) {
+        stats.flashDuration = 0;
+        membrane.setColour(stats.membraneColour);
+    }
+}
+
+void
+    MicrobeStatsSystem::_updateEngulfing(CellStageWorld& world,
+        ObjectID entity,
+        MicrobeStatsComponent& stats,
+        CompoundBagComponent& bag,
+        float elapsed)
+{
+    if(stats.engulfMode) {
+
+        const float cost = ENGULFING_ATP_COST_SECOND * elapsed;
+        const double taken = bag.takeCompound(m_atpId, cost);
+        stats.stored -= taken;
+
+        // Too little ATP disables engulfing, same as
+        // MicrobeOperations::toggleEngulfMode
+        if(taken < cost - 0.001f) {
+            stats.movementFactor /= ENGULFING_MOVEMENT_DIVISION;
+            stats.engulfMode = false;
+        }
+
+        stats.flashMembrane(1, Float4(0.2f, 0.5f, 1.0f, 0.5f));
+    }
+
+    if(stats.engulfMode)
+        stats.movementFactor /= ENGULFING_MOVEMENT_DIVISION;
+
+    if(stats.isBeingEngulfed) {
+
+        stats.movementFactor /= ENGULFED_MOVEMENT_DIVISION;
+        stats.pendingEngulfDamage += ENGULF_DAMAGE * elapsed;
+        stats.wasBeingEngulfed = true;
+
+    } else if(stats.wasBeingEngulfed) {
+
+        // The scripts don't give the population bonus to the player species
+        stats.hasEscaped = true;
+        stats.escapeInterval = 0;
+
+        stats.removeEngulfedEffect(
+            stats.hostileEngulfer != NULL_OBJECT ?
+                world.GetComponentPtr_MicrobeStatsComponent(
+                    stats.hostileEngulfer) :
+                nullptr);
+    }
+
+    // Still considered to be chased for CREATURE_ESCAPE_INTERVAL
+    if(stats.hasEscaped) {
+
+        stats.escapeInterval += elapsed;
+
+        if(stats.escapeInterval >= CREATURE_ESCAPE_INTERVAL) {
+            stats.hasEscaped = false;
+            stats.escapeInterval = 0;
+            ++stats.pendingEscapes;
+        }
+    }
+
+    // Check whether this should not be being engulfed anymore
+    if(stats.hostileEngulfer == NULL_OBJECT) {
+        stats.isBeingEngulfed = false;
+        return;
+    }
+
+    const auto* predator =
+        world.GetComponentPtr_MicrobeStatsComponent(stats.hostileEngulfer);
+    const auto* predatorMembrane =
+        world.GetComponentPtr_MembraneComponent(stats.hostileEngulfer);
+    const auto* predatorPosition =
+        world.GetComponentPtr_Position(stats.hostileEngulfer);
+    const auto* ourPosition = world.GetComponentPtr_Position(entity);
+
+    // Can't be engulfed by something that isn't a cell
+    if(!predator || !predatorMembrane || !predatorPosition || !ourPosition) {
+        stats.hostileEngulfer = NULL_OBJECT;
+        stats.isBeingEngulfed = false;
+        return;
+    }
+
+    float radius = predatorMembrane->calculateEncompassingCircleRadius();
+
+    if(predator->isBacteria)
+        radius /= 2;
+
+    // This is compared to the squared distance like the scripts always did
+    const float distanceSquared =
+        (ourPosition->Members._Position - predatorPosition->Members._Position)
+            .LengthSquared();
+
+    if(!predator->engulfMode || predator->dead || distanceSquared >= radius) {
+        stats.hostileEngulfer = NULL_OBJECT;
+        stats.isBeingEngulfed = false;
+    }
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "engine/component_types.h"
+#include "engine/typedefs.h"
+#include "microbe_stage/microbe_constants.h"
+
+#include <Common/Types.h>
+#include <Entities/Component.h>
+#include <Entities/System.h>
+
+namespace thrive {
+
+class CellStageWorld;
+class CompoundBagComponent;
+class CompoundAbsorberComponent;
+class MembraneComponent;
+
+/**
+ * @brief The numeric state of a microbe that is updated every tick
+ *
+ * The script MicrobeComponent forwards its matching properties to this so
+ * that the per tick updates don't need to go through scripts
+ */
+class MicrobeStatsComponent : public Leviathan::Component {
+public:
+    MicrobeStatsComponent();
+
+    REFERENCE_HANDLE_UNCOUNTED_TYPE(MicrobeStatsComponent);
+
+    float hitpoints = DEFAULT_HEALTH;
+    float previousHitpoints = DEFAULT_HEALTH;
+    float maxHitpoints = DEFAULT_HEALTH;
+
+    //! The amount of each individual compound that can be stored
+    double capacity = 0;
+    //! Total amount of stored compounds. Used by the AI
+    double stored = 0;
+
+    float maxBandwidth = 10.0f * BANDWIDTH_PER_ORGANELLE;
+    float remainingBandwidth = 0;
+
+    float agentEmissionCooldown = 0;
+    float compoundCollectionTimer = EXCESS_COMPOUND_COLLECTION_INTERVAL;
+
+    int totalHexCount = 0;
+
+    bool dead = false;
+    //! True while pooled by the SpawnSystem
+    bool dormant = false;
+
+    //! How many compound collection intervals have passed that the scripts
+    //! haven't handled yet (atp damage and purging compounds)
+    int pendingCompoundCollections = 0;
+
+    //! Damage from agents in the AgentCloudSystem field that the scripts
+    //! haven't applied yet
+    float pendingAgentDamage = 0;
+
+    //! Agents emitted by cells with the same tag don't damage this cell
+    //! \see AgentCloudSystem::speciesTag
+    uint32_t agentSpeciesTag = 0;
+
+    //! The colour of the species. The membrane goes back to this after
+    //! flashing
+    Float4 membraneColour = Float4(1, 1, 1, 1);
+    float flashDuration = 0;
+    Float4 flashColour = Float4(0, 0, 0, 0);
+
+    //! Counts down while dead. The scripts remove or respawn the cell once
+    //! this runs out
+    float deathTimer = 0;
+
+    //! Multiplied on the movement speed. Recalculated every tick
+    float movementFactor = 1;
+
+    bool engulfMode = false;
+    bool isBeingEngulfed = false;
+    bool wasBeingEngulfed = false;
+    bool isCurrentlyEngulfing = false;
+
+    //! The cell engulfing this one
+    ObjectID hostileEngulfer = NULL_OBJECT;
+
+    //! True for CREATURE_ESCAPE_INTERVAL after escaping being engulfed
+    bool hasEscaped = false;
+    float escapeInterval = 0;
+
+    //! Bacteria engulf only within half of their membrane radius
+    bool isBacteria = false;
+
+    //! Damage from being engulfed that the scripts haven't applied yet
+    float pendingEngulfDamage = 0;
+
+    //! How many times the escape interval has ended that the scripts haven't
+    //! given the population bonus for yet
+    int pendingEscapes = 0;
+
+    //! \brief Starts flashing the membrane unless it is already flashing
+    void
+        flashMembrane(float duration, const Float4& colour);
+
+    //! \brief Stops being engulfed
+    //! \param hostile The stats of the engulfer. Can be null
+    void
+        removeEngulfedEffect(MicrobeStatsComponent* hostile);
+
+    void
+        setAgentSpecies(const std::string& speciesName);
+
+    static constexpr auto TYPE =
+        componentTypeConvert(THRIVE_COMPONENT::MICROBE_STATS);
+};
+
+/**
+ * @brief Handles the numeric per tick updates of alive microbes
+ *
+ * Handles storage, bandwidth, absorbing compounds, health regeneration,
+ * osmoregulation, flashing, the engulfing state and the death timer. Things
+ * that trigger effects (damage, sounds, population changes, removing dead
+ * cells) are left to the script MicrobeSystem through the pending values of
+ * MicrobeStatsComponent. Reproduction is also still in the script as it grows
+ * and splits the script organelles.
+ */
+class MicrobeStatsSystem
+    : public Leviathan::System<std::tuple<MicrobeStatsComponent&,
+          CompoundBagComponent&,
+          CompoundAbsorberComponent&,
+          MembraneComponent&>> {
+public:
+    void
+        Run(CellStageWorld& world, float elapsed);
+
+    //! \brief Stores compound in a microbe limited by its bandwidth
+    //! \returns The amount that wasn't stored
+    //! \note This has to match MicrobeOperations::storeCompound
+    static double
+        storeCompound(MicrobeStatsComponent& stats,
+            CompoundBagComponent& bag,
+            const MembraneComponent& membrane,
+            CompoundId compound,
+            double amount);
+
+    void
+        CreateNodes(
+            const std::vector<std::tuple<MicrobeStatsComponent*, ObjectID>>&
+                firstdata,
+            const std::vector<std::tuple<CompoundBagComponent*, ObjectID>>&
+                seconddata,
+            const std::vector<std::tuple<CompoundAbsorberComponent*, ObjectID>>&
+                thirddata,
+            const std::vector<std::tuple<MembraneComponent*, ObjectID>>&
+                fourthdata,
+            const ComponentHolder<MicrobeStatsComponent>& firstholder,
+            const ComponentHolder<CompoundBagComponent>& secondholder,
+            const ComponentHolder<CompoundAbsorberComponent>& thirdholder,
+            const ComponentHolder<MembraneComponent>& fourthholder)
+    {
+        TupleCachedComponentCollectionHelper(CachedComponents, firstdata,
+            seconddata, thirddata, fourthdata, firstholder, secondholder,
+            thirdholder, fourthholder);
+    }
+
+    void
+        DestroyNodes(
+            const std::vector<std::tuple<MicrobeStatsComponent*, ObjectID>>&
+                firstdata,
+            const std::vector<std::tuple<CompoundBagComponent*, ObjectID>>&
+                seconddata,
+            const std::vector<std::tuple<CompoundAbsorberComponent*, ObjectID>>&
+                thirddata,
+            const std::vector<std::tuple<MembraneComponent*, ObjectID>>&
+                fourthdata)
+    {
+        CachedComponents.RemoveBasedOnKeyTupleList(firstdata);
+        CachedComponents.RemoveBasedOnKeyTupleList(seconddata);
+        CachedComponents.RemoveBasedOnKeyTupleList(thirddata);
+        CachedComponents.RemoveBasedOnKeyTupleList(fourthdata);
+    }
+
+private:
+    void
+        _updateFlashing(MicrobeStatsComponent& stats,
+            MembraneComponent& membrane,
+            float elapsed);
+
+    void
+        _updateEngulfing(CellStageWorld& world,
+            ObjectID entity,
+            MicrobeStatsComponent& stats,
+            CompoundBagComponent& bag,
+            float elapsed);
+
+private:
+    //! Looked up on the first run
+    CompoundId m_atpId = NULL_COMPOUND;
+};
+
+} // namespace thrive
@@ -35,6 +35,13 @@ public:
     static CScriptArray*
         getOrganelleNames();
 
+    //! \brief All the organelle types by name
+    static const auto&
+        getOrganelleDefinitions()
+    {
+        return mainOrganelleTable;
+    }
+
 private:
     static std::unordered_map<std::string, OrganelleTemplate::pointer>
         mainOrganelleTable;
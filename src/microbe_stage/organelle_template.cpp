@@ -15,6 +15,13 @@ using namespace thrive;
 // ------------------------------------ //
 constexpr auto ORGANELLE_FACTORY_NAME_PREFIX = "organelleFactory_";
 
+//! \returns The index in the rotation tables for rotation degrees
+inline size_t
+    rotationToIndex(int rotation)
+{
+    return ((rotation / 60) % HEX_ROTATIONS + HEX_ROTATIONS) % HEX_ROTATIONS;
+}
+
 // ------------------------------------ //
 // OrganelleTemplate::OrganelleComponentType
 OrganelleTemplate::OrganelleComponentType::OrganelleComponentType(
@@ -173,6 +180,8 @@ OrganelleTemplate::OrganelleTemplate(const OrganelleType& parameters) :
                 "Adding hex to organelle failed: " + Convert::ToString(hex));
     }
 
+    createRotatedHexes();
+
     // Calculate organelleCost and compoundsLeft
     calculateCost(m_initialComposition);
 
@@ -180,9 +189,8 @@ OrganelleTemplate::OrganelleTemplate(const OrganelleType& parameters) :
 }
 OrganelleTemplate::~OrganelleTemplate()
 {
-    // Don't leak cached script arrays
-    for(auto& pair : m_rotatedHexesCache) {
-        SAFE_RELEASE(pair.second);
+    for(auto& hexes : m_rotatedHexesScript) {
+        SAFE_RELEASE(hexes);
     }
 
     SAFE_RELEASE(m_initialCompositionDictionary);
@@ -199,48 +207,20 @@ bool
     return false;
 }
 // ------------------------------------ //
-std::vector<Int2>
+const std::vector<Int2>&
     OrganelleTemplate::getRotatedHexes(int rotation) const
 {
-    const int times = rotation / 60;
-
-    std::vector<Int2> result;
-    result.reserve(m_hexes.size());
-
-    for(const auto& hex : m_hexes) {
-
-        result.push_back(Hex::rotateAxialNTimes(hex, times));
-    }
-
-    return result;
+    return m_rotatedHexes[rotationToIndex(rotation)];
 }
 
 const CScriptArray*
     OrganelleTemplate::getRotatedHexesWrapper(int rotation) const
 {
-    const int times = rotation / 60;
-
-    // Check cache
-    const auto cached = m_rotatedHexesCache.find(times);
-
-    if(cached != m_rotatedHexesCache.end()) {
-        // Need to add a reference for the returned value
-        if(cached->second)
-            cached->second->AddRef();
-        return cached->second;
-    }
-
-    // Not cached, need to calculate
-    const auto resultData = getRotatedHexes(rotation);
-
-    auto result = Leviathan::ConvertVectorToASArray(resultData,
-        Leviathan::ScriptExecutor::Get()->GetASEngine(), "array<Int2>");
-
-    m_rotatedHexesCache.insert(std::make_pair(times, result));
-
-    // Add our cached reference
-    result->AddRef();
+    auto* result = m_rotatedHexesScript[rotationToIndex(rotation)];
 
+    // Need to add a reference for the returned value
+    if(result)
+        result->AddRef();
     return result;
 }
 // ------------------------------------ //
@@ -350,6 +330,24 @@ void
     }
 }
 // ------------------------------------ //
+void
+    OrganelleTemplate::createRotatedHexes()
+{
+    auto* engine = Leviathan::ScriptExecutor::Get()->GetASEngine();
+
+    for(int times = 0; times < HEX_ROTATIONS; ++times) {
+
+        auto& rotated = m_rotatedHexes[times];
+        rotated.reserve(m_hexes.size());
+
+        for(const auto& hex : m_hexes)
+            rotated.push_back(Hex::rotateAxialNTimes(hex, times));
+
+        m_rotatedHexesScript[times] =
+            Leviathan::ConvertVectorToASArray(rotated, engine, "array<Int2>");
+    }
+}
+
 void
     OrganelleTemplate::createScriptInitialComposition()
 {
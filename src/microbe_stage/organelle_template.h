@@ -7,6 +7,7 @@
 #include <Common/ReferenceCounted.h>
 #include <Common/Types.h>
 
+#include <array>
 #include <variant>
 
 class asIScriptFunction;
@@ -15,6 +16,9 @@ class CScriptDictionary;
 
 namespace thrive {
 
+//! The number of distinct rotations of a hex shape, one per 60 degrees
+constexpr auto HEX_ROTATIONS = 6;
+
 //! \brief Represents the type of an organelle
 //!
 //! Actual concrete placed organelles are PlacedOrganelle objects. There should
@@ -73,11 +77,14 @@ public:
     }
 
     //! \returns The hexes but rotated (rotation degrees)
-    std::vector<Int2>
+    //! \note The rotations are calculated when this is created so this is
+    //! thread safe and doesn't allocate
+    const std::vector<Int2>&
         getRotatedHexes(int rotation) const;
 
-    //! \brief Script wrapper for rotated hexes, but also caches them
-    //! \note This is not thread safe due to the caching
+    //! \brief Script wrapper for rotated hexes
+    //!
+    //! All callers share the same read only array
     const CScriptArray*
         getRotatedHexesWrapper(int rotation) const;
 
@@ -196,6 +203,10 @@ private:
     void
         createScriptInitialComposition();
 
+    //! Fills m_rotatedHexes and the script arrays of them
+    void
+        createRotatedHexes();
+
 public:
     const std::string m_name;
     const float m_mass;
@@ -211,9 +222,12 @@ private:
     // array<OrganelleComponentFactory@> components;
     std::vector<Int2> m_hexes;
 
-    //! Stores rotated hexes
-    //! The key is the number of times the rotation is done and not degrees.
-    mutable std::map<int, CScriptArray*> m_rotatedHexesCache;
+    //! The hexes in all the rotations. Indexed by the number of times the
+    //! rotation is done and not degrees
+    std::array<std::vector<Int2>, HEX_ROTATIONS> m_rotatedHexes;
+
+    //! m_rotatedHexes in script accessible form
+    std::array<CScriptArray*, HEX_ROTATIONS> m_rotatedHexesScript{};
 
     //! The initial amount of compounds this organelle consists of
     OrganelleComposition m_initialComposition;
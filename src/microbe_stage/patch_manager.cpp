@@ -15,6 +15,10 @@ constexpr auto CLOUD_SPAWN_RADIUS = 150;
 constexpr auto STARTING_SPAWN_DENSITY = 70000.0f;
 constexpr auto MAX_SPAWN_DENSITY = 20000.0f;
 
+//! How many out of range entities of each spawn type are kept around for reuse
+constexpr auto MAX_POOLED_CHUNKS = 20;
+constexpr auto MAX_POOLED_MICROBES = 10;
+
 PatchManager::PatchManager(GameWorld& world) :
     Leviathan::PerWorldData(world),
     cellWorld(dynamic_cast<CellStageWorld&>(world))
@@ -122,6 +126,38 @@ void
                 },
                 chunk.density, MICROBE_SPAWN_RADIUS),
             chunk.name, chunk.density);
+
+        cellWorld.GetSpawnSystem().setSpawnTypeRecycling(
+            chunkSpawners.back().id,
+            [](CellStageWorld& world, ObjectID entity) {
+                ScriptRunningSetup setup("deactivateChunk");
+
+                auto result =
+                    ThriveCommon::get()
+                        ->getMicrobeScripts()
+                        ->ExecuteOnModule<bool>(setup, false, &world, entity);
+
+                return result.Result == SCRIPT_RUN_RESULT::Success &&
+                       result.Value;
+            },
+            [=](CellStageWorld& world, ObjectID entity, Float3 pos) {
+                ScriptRunningSetup setup("recycleChunk");
+
+                auto result =
+                    ThriveCommon::get()
+                        ->getMicrobeScripts()
+                        ->ExecuteOnModule<bool>(
+                            setup, false, &world, &chunk, entity, pos);
+
+                if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+                    LOG_ERROR("Failed to run chunk recycle");
+                    return false;
+                }
+
+                return result.Value;
+            },
+            MAX_POOLED_CHUNKS);
     }
 }
 
@@ -289,6 +325,48 @@ void
                 },
                 density, MICROBE_SPAWN_RADIUS),
             name, density);
+
+        // Bacteria spawn as colonies so recycling a single cell would change
+        // what spawns
+        if(!speciesInPatch.species->isBacteria) {
+            cellWorld.GetSpawnSystem().setSpawnTypeRecycling(
+                microbeSpawners.back().id,
+                [](CellStageWorld& world, ObjectID entity) {
+                    ScriptRunningSetup setup(
+                        "bool MicrobeOperations::deactivateSpawnedMicrobe("
+                        "CellStageWorld@, ObjectID)");
+                    setup.FullDeclaration = true;
+
+                    auto result = ThriveCommon::get()
+                                      ->getMicrobeScripts()
+                                      ->ExecuteOnModule<bool>(
+                                          setup, false, &world, entity);
+
+                    return result.Result == SCRIPT_RUN_RESULT::Success &&
+                           result.Value;
+                },
+                [](CellStageWorld& world, ObjectID entity, Float3 pos) {
+                    ScriptRunningSetup setup(
+                        "bool MicrobeOperations::recycleSpawnedMicrobe("
+                        "CellStageWorld@, ObjectID, const Float3 &in)");
+                    setup.FullDeclaration = true;
+
+                    auto result = ThriveCommon::get()
+                                      ->getMicrobeScripts()
+                                      ->ExecuteOnModule<bool>(
+                                          setup, false, &world, entity, pos);
+
+                    if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+                        LOG_ERROR("Failed to run "
+                                  "MicrobeOperations::recycleSpawnedMicrobe");
+                        return false;
+                    }
+
+                    return result.Value;
+                },
+                MAX_POOLED_MICROBES);
+        }
     }
 }
 // ------------------------------------ //
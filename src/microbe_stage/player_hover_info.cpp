@@ -2,6 +2,7 @@
 
 #include "ThriveGame.h"
 #include "engine/player_data.h"
+#include "gui_update_channel.h"
 #include "microbe_stage/compound_cloud_system.h"
 #include "microbe_stage/membrane_system.h"
 #include "microbe_stage/player_microbe_control.h"
@@ -26,6 +27,9 @@ PlayerHoverInfoSystem::PlayerHoverInfoSystem()
 void
     PlayerHoverInfoSystem::Run(CellStageWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "PlayerHoverInfoSystem");
+
     // Only on client
     if(!ThriveGame::Get())
         return;
@@ -181,5 +185,5 @@ void
     // well (cells don't have one so that wouldn't work for them but for things
     // like floating organelles etc.)
 
-    Engine::Get()->GetEventHandler()->CallEvent(event);
+    ThriveGame::Get()->guiUpdates().post(event);
 }
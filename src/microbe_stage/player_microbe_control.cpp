@@ -3,6 +3,7 @@
 #include "ThriveGame.h"
 #include "engine/player_data.h"
 #include "generated/cell_stage_world.h"
+#include "microbe_stage/microbe_stats_system.h"
 #include "microbe_stage/simulation_parameters.h"
 
 #include <Addons/GameModule.h>
@@ -269,46 +270,81 @@ PlayerMicrobeControlSystem::~PlayerMicrobeControlSystem()
 void
     PlayerMicrobeControlSystem::Run(CellStageWorld& world)
 {
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "PlayerMicrobeControlSystem");
+
     // Only on client
-    ThriveGame* game = ThriveGame::Get();
-    if(!game)
+    ThriveGame* thrive = ThriveGame::Get();
+    if(!thrive)
         return;
 
-    ObjectID controlledEntity = game->playerData().activeCreature();
+    const ObjectID controlledEntity = thrive->playerData().activeCreature();
+    auto module = thrive->getMicrobeScripts();
 
-    if(controlledEntity == NULL_OBJECT)
-        return;
+    // The recording needs an entry for every tick so that a replay stays in
+    // step with the world. The ticks without a living player cell get an
+    // empty intent
+    ControlIntent intent;
+    bool controlling = false;
+
+    // A missing module is skipped here to allow running better in unit tests.
+    // This makes finding errors about this a bit more difficult but the game
+    // shouldn't start with invalid scripts
+    if(module && isControllable(world, controlledEntity)) {
+
+        try {
+            intent.lookPoint = getTargetPoint(world);
+            controlling = true;
+        } catch(const Leviathan::InvalidState& e) {
+
+            LOG_ERROR("PlayerMicrobeControlSystem: cannot run because world "
+                      "has no active camera, exception: ");
+            e.PrintToLog();
+        }
+    }
 
-    ThriveGame* thrive = ThriveGame::Get();
+    if(controlling) {
 
-    Float3 lookPoint;
+        auto input = thrive->getPlayerInput();
 
-    try {
-        lookPoint = getTargetPoint(world);
-    } catch(const Leviathan::InvalidState& e) {
+        intent.movement = input->getMovement().Normalize();
+        intent.engulf = input->getPressedEngulf();
+        intent.toxin = input->getPressedToxin();
+        intent.glucoseCloud = input->getSpamClouds();
+        intent.phosphateCloud = input->getCheatPhosphateCloudsDown();
+        intent.ammoniaCloud = input->getCheatAmmoniaCloudsDown();
 
-        LOG_ERROR("PlayerMicrobeControlSystem: cannot run because world has no "
-                  "active camera, exception: ");
-        e.PrintToLog();
-        return;
+        input->setPressedEngulf(false);
+        input->setPressedToxin(false);
     }
 
-    const Float3 movementDirection = thrive->getPlayerInput()->getMovement();
+    if(auto recorder = thrive->getInputRecorder(); recorder)
+        recorder->record(intent);
 
-    auto module = thrive->getMicrobeScripts();
+    if(controlling)
+        applyIntent(world, *module, controlledEntity, intent);
+}
 
-    if(!module) {
-        // Skip here to allow running better in unit tests
-        // This makes finding errors about this a bit more difficult but the
-        // game shouldn't start with invalid scripts
-        // LOG_FATAL("PlayerMicrobeControlSystem: microbe scripts aren't
-        // loaded");
-        return;
-    }
+bool
+    PlayerMicrobeControlSystem::isControllable(CellStageWorld& world,
+        ObjectID entity)
+{
+    if(entity == NULL_OBJECT)
+        return false;
+
+    const auto* stats = world.GetComponentPtr_MicrobeStatsComponent(entity);
+    return stats && !stats->dead;
+}
 
+void
+    PlayerMicrobeControlSystem::applyIntent(CellStageWorld& world,
+        Leviathan::GameModule& module,
+        ObjectID controlledEntity,
+        const ControlIntent& intent)
+{
     ScriptRunningSetup setup("applyCellMovementControl");
-    auto result = module->ExecuteOnModule<void>(setup, false, &world,
-        controlledEntity, movementDirection.Normalize(), lookPoint);
+    auto result = module.ExecuteOnModule<void>(setup, false, &world,
+        controlledEntity, intent.movement, intent.lookPoint);
 
     if(result.Result != SCRIPT_RUN_RESULT::Success) {
         LOG_WARNING("PlayerMicrobeControlSystem: failed to Run script "
@@ -316,12 +352,10 @@ void
     }
 
     // Activate engulf mode
-    if(thrive->getPlayerInput()->getPressedEngulf()) {
-
-        thrive->getPlayerInput()->setPressedEngulf(false);
+    if(intent.engulf) {
 
         ScriptRunningSetup setup("applyEngulfMode");
-        auto result = module->ExecuteOnModule<void>(
+        auto result = module.ExecuteOnModule<void>(
             setup, false, &world, controlledEntity);
 
         if(result.Result != SCRIPT_RUN_RESULT::Success) {
@@ -331,12 +365,10 @@ void
     }
 
     // Fire Toxin
-    if(thrive->getPlayerInput()->getPressedToxin()) {
-
-        thrive->getPlayerInput()->setPressedToxin(false);
+    if(intent.toxin) {
 
         ScriptRunningSetup setup("playerShootToxin");
-        auto result = module->ExecuteOnModule<void>(
+        auto result = module.ExecuteOnModule<void>(
             setup, false, &world, controlledEntity);
 
         if(result.Result != SCRIPT_RUN_RESULT::Success) {
@@ -345,25 +377,25 @@ void
         }
     }
 
-    if(thrive->getPlayerInput()->getSpamClouds()) {
+    if(intent.glucoseCloud) {
 
         world.GetCompoundCloudSystem().addCloud(
             SimulationParameters::compoundRegistry.getTypeId("glucose"), 15000,
-            lookPoint);
+            intent.lookPoint);
     }
 
-    if(thrive->getPlayerInput()->getCheatPhosphateCloudsDown()) {
+    if(intent.phosphateCloud) {
 
         world.GetCompoundCloudSystem().addCloud(
             SimulationParameters::compoundRegistry.getTypeId("phosphates"),
-            15000, lookPoint);
+            15000, intent.lookPoint);
     }
 
-    if(thrive->getPlayerInput()->getCheatAmmoniaCloudsDown()) {
+    if(intent.ammoniaCloud) {
 
         world.GetCompoundCloudSystem().addCloud(
             SimulationParameters::compoundRegistry.getTypeId("ammonia"), 15000,
-            lookPoint);
+            intent.lookPoint);
     }
 }
 // ------------------------------------ //
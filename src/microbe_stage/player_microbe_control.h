@@ -1,9 +1,12 @@
 #pragma once
 
+#include "microbe_stage/input_recording.h"
+
 #include <Input/InputController.h>
 #include <Input/Key.h>
 
 namespace Leviathan {
+class GameModule;
 class ScriptComponentHolder;
 }
 
@@ -35,6 +38,12 @@ public:
         m_enabled = enabled;
     }
 
+    bool
+        isEnabled() const
+    {
+        return m_enabled;
+    }
+
     inline Float3
         getMovement() const
     {
@@ -154,6 +163,21 @@ public:
     static Float3
         getTargetPoint(Leviathan::GameWorld& worldWithCamera);
 
+    //! \returns True if entity is a living cell that the player input or a
+    //! replay can control
+    static bool
+        isControllable(CellStageWorld& world, ObjectID entity);
+
+    //! \brief Makes the controlled cell do what intent says
+    //!
+    //! Both the player input and input replays go through this so that a
+    //! replay runs the same scripts as the recorded session
+    static void
+        applyIntent(CellStageWorld& world,
+            Leviathan::GameModule& module,
+            ObjectID controlledEntity,
+            const ControlIntent& intent);
+
 private:
     Leviathan::ScriptComponentHolder* Holder = nullptr;
 };
@@ -0,0 +1,224 @@
+// ------------------------------------ //
+#include "process_information.h"
+
+#include <json/json.h>
+
+#include <memory>
+#include <sstream>
+
+using namespace thrive;
+// ------------------------------------ //
+// The GUI payloads have one record per line with tab separated fields. The
+// first record names the payload type and version
+namespace {
+
+void
+    writeCompounds(std::ostream& stream,
+        const char* type,
+        const std::vector<ProcessCompoundSpeed>& compounds,
+        bool environmental)
+{
+    for(const auto& compound : compounds) {
+        stream << type << '\t' << compound.internalName << '\t'
+               << compound.name << '\t' << compound.amount;
+
+        if(environmental)
+            stream << '\t' << compound.availableAmount << '\t'
+                   << compound.availableRate;
+
+        stream << '\n';
+    }
+}
+
+void
+    writeErrors(std::ostream& stream, const std::vector<std::string>& errors)
+{
+    for(const auto& error : errors)
+        stream << "error\t" << error << '\n';
+}
+
+Json::Value
+    compoundsToJSON(const std::vector<ProcessCompoundSpeed>& compounds,
+        bool environmental)
+{
+    Json::Value result;
+
+    for(const auto& compound : compounds) {
+        Json::Value obj;
+
+        obj["id"] = compound.id;
+        obj["amount"] = compound.amount;
+        obj["name"] = compound.name;
+
+        if(environmental) {
+            obj["availableAmount"] = compound.availableAmount;
+            obj["availableRate"] = compound.availableRate;
+        }
+
+        result[compound.internalName] = obj;
+    }
+
+    return result;
+}
+
+Json::Value
+    errorsToJSON(const std::vector<std::string>& errors)
+{
+    Json::Value result(Json::arrayValue);
+
+    for(const auto& error : errors)
+        result.append(error);
+
+    return result;
+}
+
+std::string
+    writeJSON(const Json::Value& value)
+{
+    std::stringstream sstream;
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+
+    writer->write(value, &sstream);
+
+    return sstream.str();
+}
+
+} // namespace
+// ------------------------------------ //
+const ProcessCompoundSpeed*
+    ProcessSpeedInformation::find(
+        const std::vector<ProcessCompoundSpeed>& list,
+        CompoundId compound)
+{
+    for(const auto& entry : list) {
+        if(entry.id == compound)
+            return &entry;
+    }
+
+    return nullptr;
+}
+// ------------------------------------ //
+std::string
+    ProcessEfficiencies::toGUIPayload() const
+{
+    std::stringstream stream;
+
+    stream << "process_efficiencies\t" << PROCESS_PAYLOAD_VERSION << '\n';
+
+    for(const auto& organelle : organelles) {
+
+        stream << "organelle\t" << organelle.name << '\n';
+
+        for(const auto& process : organelle.processes) {
+
+            stream << "process\t" << process.name << '\t'
+                   << process.processName << '\t' << process.speedFactor
+                   << '\n';
+
+            writeCompounds(stream, "input", process.inputs, false);
+            writeCompounds(stream, "output", process.outputs, false);
+            writeCompounds(
+                stream, "environment", process.environment, true);
+        }
+    }
+
+    writeErrors(stream, errors);
+
+    return stream.str();
+}
+
+std::string
+    ProcessEfficiencies::toJSON() const
+{
+    Json::Value value(Json::objectValue);
+    Json::Value organellesData(Json::objectValue);
+
+    for(const auto& organelle : organelles) {
+
+        Json::Value processes;
+
+        for(const auto& process : organelle.processes) {
+
+            Json::Value obj;
+            obj["name"] = process.name;
+            obj["processName"] = process.processName;
+            obj["processId"] = process.processId;
+            obj["inputs"] = compoundsToJSON(process.inputs, false);
+            obj["outputs"] = compoundsToJSON(process.outputs, false);
+            obj["environment"] = compoundsToJSON(process.environment, true);
+            obj["speedFactor"] = process.speedFactor;
+
+            processes.append(obj);
+        }
+
+        organellesData[organelle.name]["processes"] = processes;
+    }
+
+    value["organelles"] = organellesData;
+
+    if(!errors.empty())
+        value["errors"] = errorsToJSON(errors);
+
+    return writeJSON(value);
+}
+// ------------------------------------ //
+void
+    EnergyBalance::addProduction(const std::string& source, float amount)
+{
+    production[source] += amount;
+}
+
+void
+    EnergyBalance::addConsumption(const std::string& source, float amount)
+{
+    consumption[source] += amount;
+}
+
+std::string
+    EnergyBalance::toGUIPayload() const
+{
+    std::stringstream stream;
+
+    stream << "energy_balance\t" << PROCESS_PAYLOAD_VERSION << '\n';
+
+    stream << "total\t" << totalProduction << '\t' << totalConsumption << '\t'
+           << balance << '\t' << balanceStationary << '\n';
+
+    for(const auto& [source, amount] : production)
+        stream << "production\t" << source << '\t' << amount << '\n';
+
+    for(const auto& [source, amount] : consumption)
+        stream << "consumption\t" << source << '\t' << amount << '\n';
+
+    writeErrors(stream, errors);
+
+    return stream.str();
+}
+
+std::string
+    EnergyBalance::toJSON() const
+{
+    Json::Value value(Json::objectValue);
+    Json::Value productionData(Json::objectValue);
+    Json::Value consumptionData(Json::objectValue);
+
+    for(const auto& [source, amount] : production)
+        productionData[source] = amount;
+
+    for(const auto& [source, amount] : consumption)
+        consumptionData[source] = amount;
+
+    value["production"] = productionData;
+    value["consumption"] = consumptionData;
+    value["total"]["production"] = totalProduction;
+    value["total"]["consumption"] = totalConsumption;
+    value["total"]["balance"] = balance;
+    value["total"]["balanceStationary"] = balanceStationary;
+
+    if(!errors.empty())
+        value["errors"] = errorsToJSON(errors);
+
+    return writeJSON(value);
+}
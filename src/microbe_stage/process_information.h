@@ -0,0 +1,114 @@
+#pragma once
+
+#include "engine/typedefs.h"
+
+#include <Common/ReferenceCounted.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace thrive {
+
+//! Version of the GUI payloads. Increment when the format changes and update
+//! parseProcessPayload in microbe_editor.mjs to match
+constexpr auto PROCESS_PAYLOAD_VERSION = 1;
+
+//! \brief Amount of a compound used or made by a process at its maximum speed
+struct ProcessCompoundSpeed {
+    CompoundId id = NULL_COMPOUND;
+    std::string internalName;
+    std::string name;
+
+    //! Per second amount at the process speed
+    float amount = 0.f;
+
+    //! Only set for environmental compounds
+    float availableAmount = 0.f;
+    float availableRate = 0.f;
+};
+
+//! \brief Maximum speed of a process in a biome
+struct ProcessSpeedInformation {
+    BioProcessId processId = 0;
+    std::string name;
+    std::string processName;
+
+    float speedFactor = 1.f;
+
+    std::vector<ProcessCompoundSpeed> inputs;
+    std::vector<ProcessCompoundSpeed> outputs;
+    std::vector<ProcessCompoundSpeed> environment;
+
+    //! \returns The entry for compound in the list or null
+    static const ProcessCompoundSpeed*
+        find(const std::vector<ProcessCompoundSpeed>& list,
+            CompoundId compound);
+};
+
+//! \brief Result of ProcessSystem::computeOrganelleProcessEfficiencies
+class ProcessEfficiencies : public Leviathan::ReferenceCounted {
+public:
+    struct Organelle {
+        std::string name;
+        std::vector<ProcessSpeedInformation> processes;
+    };
+
+protected:
+    // These are protected for only constructing properly reference
+    // counted instances through MakeShared
+    friend ReferenceCounted;
+    ProcessEfficiencies() = default;
+
+public:
+    //! \brief Compact format for sending to the GUI
+    std::string
+        toGUIPayload() const;
+
+    //! \brief Human readable format for debugging
+    std::string
+        toJSON() const;
+
+    REFERENCE_COUNTED_PTR_TYPE(ProcessEfficiencies);
+
+    std::vector<Organelle> organelles;
+    std::vector<std::string> errors;
+};
+
+//! \brief Result of ProcessSystem::computeEnergyBalance
+class EnergyBalance : public Leviathan::ReferenceCounted {
+protected:
+    friend ReferenceCounted;
+    EnergyBalance() = default;
+
+public:
+    void
+        addProduction(const std::string& source, float amount);
+
+    void
+        addConsumption(const std::string& source, float amount);
+
+    //! \brief Compact format for sending to the GUI
+    std::string
+        toGUIPayload() const;
+
+    //! \brief Human readable format for debugging
+    std::string
+        toJSON() const;
+
+    REFERENCE_COUNTED_PTR_TYPE(EnergyBalance);
+
+    //! ATP production and consumption per source. The sources are organelle
+    //! names and the special costs "baseMovement" and "osmoregulation"
+    std::map<std::string, float> production;
+    std::map<std::string, float> consumption;
+
+    float totalProduction = 0.f;
+    float totalConsumption = 0.f;
+    float balance = 0.f;
+    float balanceStationary = 0.f;
+
+    std::vector<std::string> errors;
+};
+
+} // namespace thrive
@@ -1,12 +1,14 @@
 // ------------------------------------ //
 #include "process_system.h"
 
+#include "energy_balance_model.h"
+#include "engine/system_profiler.h"
+#include "engine/tracing.h"
 #include "general/thrive_math.h"
 #include "simulation_parameters.h"
 
 #include <Entities/GameWorld.h>
-
-#include <json/json.h>
+#include <add_on/scriptarray/scriptarray.h>
 
 #include <algorithm>
 #include <cmath>
@@ -14,15 +16,6 @@
 #include <map>
 
 using namespace thrive;
-// ------------------------------------ //
-// Constants for computing energy balances
-constexpr auto FLAGELLA_COMPONENT_NAME = "movement";
-
-// These constants must match what is in configs.as
-constexpr auto FLAGELLA_ENERGY_COST = 7.1f;
-constexpr auto ATP_COST_FOR_OSMOREGULATION = 1.0f;
-constexpr auto BASE_MOVEMENT_ATP_COST = 1.0f;
-
 // ------------------------------------ //
 ProcessorComponent::ProcessorComponent() : Leviathan::Component(TYPE) {}
 
@@ -100,6 +93,59 @@ double
     return amt;
 }
 
+void
+    CompoundBagComponent::getCompoundAmounts(CScriptArray& result) const
+{
+    const auto count = SimulationParameters::compoundRegistry.getSize();
+
+    result.Resize(static_cast<asUINT>(count));
+
+    for(size_t id = 0; id < count; ++id) {
+
+        const auto iter = compounds.find(static_cast<CompoundId>(id));
+
+        *static_cast<double*>(result.At(static_cast<asUINT>(id))) =
+            iter != compounds.end() ? iter->second.amount : 0.0;
+    }
+}
+
+double
+    CompoundBagComponent::takeCompounds(const CScriptArray& amounts,
+        CScriptArray& taken)
+{
+    const auto count = amounts.GetSize();
+
+    taken.Resize(count);
+
+    double total = 0;
+
+    for(asUINT id = 0; id < count; ++id) {
+
+        const double toTake = *static_cast<const double*>(amounts.At(id));
+
+        const double amount =
+            toTake > 0 ? takeCompound(static_cast<CompoundId>(id), toTake) : 0;
+
+        *static_cast<double*>(taken.At(id)) = amount;
+        total += amount;
+    }
+
+    return total;
+}
+
+void
+    CompoundBagComponent::giveCompounds(const CScriptArray& amounts,
+        double multiplier)
+{
+    for(asUINT id = 0; id < amounts.GetSize(); ++id) {
+
+        const double amount = *static_cast<const double*>(amounts.At(id));
+
+        if(amount != 0)
+            giveCompound(static_cast<CompoundId>(id), amount * multiplier);
+    }
+}
+
 double
     CompoundBagComponent::getPrice(CompoundId compoundId)
 {
@@ -116,6 +162,9 @@ double
 void
     ProcessSystem::Run(GameWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(world, "ProcessSystem");
+    TraceZone zone("ProcessSystem::Run");
+
     if(!world.GetNetworkSettings().IsAuthoritative)
         return;
 
@@ -291,19 +340,16 @@ double
     return currentBiome.getCompound(compoundData)->dissolved;
 }
 // ------------------------------------ //
-Json::Value
-    calculateProcessMaximumSpeed(const TweakedProcess::pointer& process,
+ProcessSpeedInformation
+    thrive::calculateProcessMaximumSpeed(const TweakedProcess::pointer& process,
         const Biome& biome)
 {
-    Json::Value result;
+    ProcessSpeedInformation result;
 
     const float multiplier = process->getTweakRate();
 
     float speedFactor = 1.f;
 
-    Json::Value environmentInputs;
-    Json::Value inputs;
-
     // Environmental inputs need to be processed first
     for(const auto& [compoundId, amount] : process->process.inputs) {
         const auto& data =
@@ -313,25 +359,26 @@ Json::Value
 
         // Environmental compound that can limit the rate
 
-        Json::Value obj;
+        ProcessCompoundSpeed compound;
 
-        obj["id"] = compoundId;
-        obj["amount"] = amount;
-        obj["name"] = data.displayName;
+        compound.id = compoundId;
+        compound.amount = amount;
+        compound.internalName = data.internalName;
+        compound.name = data.displayName;
 
         const auto availableInEnvironment =
             biome.getCompound(compoundId)->dissolved;
 
-        obj["availableAmount"] = availableInEnvironment;
+        compound.availableAmount = availableInEnvironment;
 
         // More than needed environment value boosts the effectiveness
         float availableRate = availableInEnvironment / amount;
 
-        obj["availableRate"] = availableRate;
+        compound.availableRate = availableRate;
 
         speedFactor *= availableRate;
 
-        environmentInputs[data.internalName] = obj;
+        result.environment.push_back(std::move(compound));
     }
 
     speedFactor *= multiplier;
@@ -345,203 +392,88 @@ Json::Value
 
         // Normal, cloud input
 
-        Json::Value obj;
-        obj["id"] = compoundId;
-        obj["amount"] = amount * speedFactor;
-        obj["name"] = data.displayName;
+        ProcessCompoundSpeed compound;
+        compound.id = compoundId;
+        compound.amount = amount * speedFactor;
+        compound.internalName = data.internalName;
+        compound.name = data.displayName;
 
-        inputs[data.internalName] = obj;
+        result.inputs.push_back(std::move(compound));
     }
 
-    Json::Value outputs;
-
     for(const auto& [compoundId, amount] : process->process.outputs) {
-        Json::Value obj;
-
-        obj["id"] = compoundId;
-        obj["amount"] = amount * speedFactor;
-
         const auto& data =
             SimulationParameters::compoundRegistry.getTypeData(compoundId);
 
-        obj["name"] = data.displayName;
+        ProcessCompoundSpeed compound;
+        compound.id = compoundId;
+        compound.amount = amount * speedFactor;
+        compound.internalName = data.internalName;
+        compound.name = data.displayName;
 
-        outputs[data.internalName] = obj;
+        result.outputs.push_back(std::move(compound));
     }
 
-    result["name"] = process->process.displayName;
-    result["processName"] = process->process.internalName;
-    result["processId"] = process->process.id;
-    result["inputs"] = inputs;
-    result["outputs"] = outputs;
-    result["environment"] = environmentInputs;
-    result["speedFactor"] = speedFactor;
+    result.name = process->process.displayName;
+    result.processName = process->process.internalName;
+    result.processId = process->process.id;
+    result.speedFactor = speedFactor;
 
     return result;
 }
 
-std::string
+ProcessEfficiencies::pointer
     ProcessSystem::computeOrganelleProcessEfficiencies(
         const std::vector<OrganelleTemplate::pointer>& organelles,
-        const Biome& biome) const
+        const Biome& biome)
 {
-    Json::Value value(Json::objectValue);
-    Json::Value organellesData(Json::objectValue);
-    Json::Value errors(Json::arrayValue);
+    auto result = ProcessEfficiencies::MakeShared<ProcessEfficiencies>();
 
     for(const auto& organelle : organelles) {
         if(!organelle) {
-            errors.append(Json::Value("organelle pointer is null"));
+            result->errors.push_back("organelle pointer is null");
             continue;
         }
 
-        const auto& name = organelle->getName();
-
-        Json::Value obj;
-        Json::Value processes;
+        ProcessEfficiencies::Organelle data;
+        data.name = organelle->getName();
 
         for(const auto& process : organelle->getProcesses()) {
 
-            processes.append(calculateProcessMaximumSpeed(process, biome));
+            data.processes.push_back(
+                calculateProcessMaximumSpeed(process, biome));
         }
 
-        obj["processes"] = processes;
-
-        organellesData[name] = obj;
+        result->organelles.push_back(std::move(data));
     }
 
-    value["organelles"] = organellesData;
-
-    if(errors.size() > 0)
-        value["errors"] = errors;
-
-    std::stringstream sstream;
-    Json::StreamWriterBuilder builder;
-    builder["indentation"] = "";
-    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-
-    writer->write(value, &sstream);
-
-    return sstream.str();
+    return result;
 }
 // ------------------------------------ //
-std::string
+EnergyBalance::pointer
     ProcessSystem::computeEnergyBalance(
         const std::vector<OrganelleTemplate::pointer>& organelles,
         const MembraneType& membraneType,
-        const Biome& biome) const
+        const Biome& biome)
 {
-    Json::Value value(Json::objectValue);
-    Json::Value production(Json::objectValue);
-    Json::Value consumption(Json::objectValue);
-    Json::Value errors(Json::arrayValue);
+    auto model = EnergyBalanceModel::MakeShared<EnergyBalanceModel>();
 
-    float totalATPProduction = 0.f;
-    float processATPConsumption = 0.f;
-    float movementATPConsumption = 0.f;
+    model->setBiome(biome);
+    model->setMembrane(membraneType);
 
-    int hexCount = 0;
+    std::vector<std::string> errors;
 
     for(const auto& organelle : organelles) {
         if(!organelle) {
-            errors.append(Json::Value("organelle pointer is null"));
+            errors.push_back("organelle pointer is null");
             continue;
         }
 
-        const auto& name = organelle->getName();
-
-        // This uses the same efficiency computation as
-        // computeOrganelleProcessEfficiencies and just reads data back from the
-        // json results, because I'm too lazy to generalize the efficiency
-        // computation function
-        for(const auto& process : organelle->getProcesses()) {
-            const auto processData =
-                calculateProcessMaximumSpeed(process, biome);
-
-            // Find process inputs and outputs that use/produce ATP and add to
-            // totals
-            if(processData["inputs"]["atp"]) {
-                const auto amount =
-                    processData["inputs"]["atp"]["amount"].asFloat();
-
-                processATPConsumption += amount;
-
-                if(!consumption.isMember(name)) {
-                    consumption[name] = 0.f;
-                }
-
-                consumption[name] = consumption[name].asFloat() + amount;
-            }
-
-            if(processData["outputs"]["atp"]) {
-                const auto amount =
-                    processData["outputs"]["atp"]["amount"].asFloat();
-
-                totalATPProduction += amount;
-
-                if(!production.isMember(name)) {
-                    production[name] = 0.f;
-                }
-
-                production[name] = production[name].asFloat() + amount;
-            }
-        }
-
-        // Take special cell components that take energy into account
-        if(organelle->hasComponent(FLAGELLA_COMPONENT_NAME)) {
-            const auto amount = FLAGELLA_ENERGY_COST;
-
-            movementATPConsumption += amount;
-
-            if(!consumption.isMember(name)) {
-                consumption[name] = 0.f;
-            }
-
-            consumption[name] = consumption[name].asFloat() + amount;
-        }
-
-        // Store hex count
-        hexCount += organelle->getHexCount();
+        model->addOrganelle(organelle);
     }
 
-    // Add movement consumption together
-    const float baseMovementCost = BASE_MOVEMENT_ATP_COST * hexCount;
-    const auto totalMovementConsumption =
-        movementATPConsumption + baseMovementCost;
-
-    consumption["baseMovement"] = baseMovementCost;
+    auto result = model->getBalance();
+    result->errors = std::move(errors);
 
-    // Add osmoregulation
-    const float osmoregulation = ATP_COST_FOR_OSMOREGULATION * hexCount *
-                                 membraneType.osmoregulationFactor;
-
-    consumption["osmoregulation"] = osmoregulation;
-
-    // Compute totals
-    const auto totalATPConsumption =
-        processATPConsumption + totalMovementConsumption + osmoregulation;
-
-    const auto totalBalanceStationary =
-        totalATPProduction - totalATPConsumption;
-    const auto totalBalance = totalBalanceStationary + totalMovementConsumption;
-
-    // Finish building the result object
-    value["production"] = production;
-    value["consumption"] = consumption;
-    value["total"]["production"] = totalATPProduction;
-    value["total"]["consumption"] = totalATPConsumption;
-    value["total"]["balance"] = totalBalance;
-    value["total"]["balanceStationary"] = totalBalanceStationary;
-
-    if(errors.size() > 0)
-        value["errors"] = errors;
-
-    std::stringstream sstream;
-    Json::StreamWriterBuilder builder;
-    builder["indentation"] = "";
-    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-
-    writer->write(value, &sstream);
-
-    return sstream.str();
+    return result;
 }
@@ -3,6 +3,7 @@
 #include "biomes.h"
 #include "membrane_types.h"
 #include "organelle_template.h"
+#include "process_information.h"
 
 #include "engine/component_types.h"
 #include "engine/typedefs.h"
@@ -13,6 +14,8 @@
 #include <unordered_map>
 #include <vector>
 
+class CScriptArray;
+
 namespace Leviathan {
 class GameWorld;
 }
@@ -24,6 +27,11 @@ namespace thrive {
 
 class CellStageWorld;
 
+//! \brief Computes how fast a process runs in biome
+ProcessSpeedInformation
+    calculateProcessMaximumSpeed(const TweakedProcess::pointer& process,
+        const Biome& biome);
+
 //! \brief Specifies what processes a cell can perform
 //! \todo To reduce duplication and excess memory usage the processes should
 //! be moved to a new class ProcessConfiguration
@@ -98,6 +106,25 @@ public:
     void
         setCompound(CompoundId, double);
 
+    //! \brief Writes the amounts of all compounds into result
+    //!
+    //! result is an array<double> that is resized to the number of
+    //! registered compounds and indexed by CompoundId. Scripts should keep
+    //! the same array around between calls to avoid reallocating it
+    void
+        getCompoundAmounts(CScriptArray& result) const;
+
+    //! \brief Takes up to amounts[id] of each compound at once
+    //! \param taken Receives the actually taken amounts indexed by
+    //! CompoundId. Must not be the same array as amounts
+    //! \returns The total taken amount
+    double
+        takeCompounds(const CScriptArray& amounts, CScriptArray& taken);
+
+    //! \brief Gives amounts[id] * multiplier of each compound
+    void
+        giveCompounds(const CScriptArray& amounts, double multiplier);
+
     REFERENCE_HANDLE_UNCOUNTED_TYPE(CompoundBagComponent);
 
     static constexpr auto TYPE =
@@ -148,19 +175,18 @@ public:
 
     //! \brief Computes the process numbers for given organelles given the
     //! active biome data
-    //! \returns The data as a JSON string
-    std::string
+    static ProcessEfficiencies::pointer
         computeOrganelleProcessEfficiencies(
             const std::vector<OrganelleTemplate::pointer>& organelles,
-            const Biome& biome) const;
+            const Biome& biome);
 
     //! \brief Computes the energy balance for the given organelles in biome
-    //! \returns The data as a JSON string
-    std::string
+    //! \see EnergyBalanceModel for updating a balance as a cell is edited
+    static EnergyBalance::pointer
         computeEnergyBalance(
             const std::vector<OrganelleTemplate::pointer>& organelles,
             const MembraneType& membraneType,
-            const Biome& biome) const;
+            const Biome& biome);
 
 
 protected:
@@ -23,6 +23,10 @@
 
 #include <Utility/Random.h>
 
+#include <array>
+#include <chrono>
+#include <cmath>
+
 using namespace thrive;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,8 +61,23 @@ struct SpawnSystem::Implementation {
     std::unordered_map<SpawnerTypeId, SpawnType> spawnTypes;
     Float3 previousPlayerPosition = Float3(0, 0, 0);
     float timeSinceLastUpdate = 0;
+
+    //! Dormant entities that can be reused instead of running the factory
+    std::unordered_map<SpawnerTypeId, std::vector<ObjectID>> pools;
+
+    //! How many live spawned things of each type are in each grid cell
+    std::unordered_map<int64_t, std::unordered_map<SpawnerTypeId, int>>
+        cellCounts;
 };
 
+//! Packs grid cell coordinates into a single key
+static int64_t
+    makeCellKey(int32_t cellX, int32_t cellZ)
+{
+    return (static_cast<int64_t>(cellX) << 32) |
+           static_cast<uint32_t>(cellZ);
+}
+
 // void SpawnSystem::luaBindings(
 //     sol::state &lua
 // ){
@@ -113,6 +132,139 @@ bool
     return true;
 }
 
+bool
+    SpawnSystem::setSpawnTypeRecycling(SpawnerTypeId spawnId,
+        std::function<bool(CellStageWorld&, ObjectID)> deactivateFunction,
+        std::function<bool(CellStageWorld&, ObjectID, Float3)> recycleFunction,
+        size_t maxPooled)
+{
+    const auto found = m_impl->spawnTypes.find(spawnId);
+
+    if(found == m_impl->spawnTypes.end())
+        return false;
+
+    if(maxPooled > 0 && (!deactivateFunction || !recycleFunction))
+        throw Leviathan::InvalidArgument(
+            "recycling needs both deactivate and recycle functions");
+
+    found->second.deactivateFunction = deactivateFunction;
+    found->second.recycleFunction = recycleFunction;
+    found->second.maxPooled = maxPooled;
+    return true;
+}
+
+size_t
+    SpawnSystem::getPooledCount(SpawnerTypeId spawnId) const
+{
+    const auto found = m_impl->pools.find(spawnId);
+
+    if(found == m_impl->pools.end())
+        return 0;
+
+    return found->second.size();
+}
+
+void
+    SpawnSystem::clearPools(CellStageWorld& world)
+{
+    for(const auto& pool : m_impl->pools) {
+        for(ObjectID entity : pool.second)
+            world.QueueDestroyEntity(entity);
+    }
+
+    m_impl->pools.clear();
+}
+
+bool
+    SpawnSystem::poolEntity(CellStageWorld& world,
+        ObjectID entity,
+        SpawnedComponent& spawned)
+{
+    if(spawned.spawnType == NULL_SPAWNER)
+        return false;
+
+    const auto type = m_impl->spawnTypes.find(spawned.spawnType);
+
+    if(type == m_impl->spawnTypes.end() || type->second.maxPooled == 0)
+        return false;
+
+    auto& pool = m_impl->pools[spawned.spawnType];
+
+    if(pool.size() >= type->second.maxPooled)
+        return false;
+
+    if(!type->second.deactivateFunction(world, entity))
+        return false;
+
+    spawned.dormant = true;
+    pool.push_back(entity);
+
+    // Pooled entities don't count towards the density of the cell they left
+    _changeCellCount(spawned.spawnCell, spawned.spawnType, -1);
+    return true;
+}
+
+ObjectID
+    SpawnSystem::recycleFromPool(CellStageWorld& world,
+        const SpawnType& spawnType,
+        const Float3& position,
+        int64_t cell)
+{
+    if(spawnType.maxPooled == 0)
+        return NULL_OBJECT;
+
+    const auto found = m_impl->pools.find(spawnType.id);
+
+    if(found == m_impl->pools.end())
+        return NULL_OBJECT;
+
+    auto& pool = found->second;
+
+    while(!pool.empty()) {
+
+        const ObjectID entity = pool.back();
+        pool.pop_back();
+
+        // Something else may have destroyed the entity while it was dormant
+        const auto cached = CachedComponents.GetIndex().find(entity);
+
+        if(cached == CachedComponents.GetIndex().end())
+            continue;
+
+        SpawnedComponent& spawned = std::get<0>(*cached->second);
+
+        if(!spawnType.recycleFunction(world, entity, position)) {
+            world.QueueDestroyEntity(entity);
+            continue;
+        }
+
+        spawned.dormant = false;
+        spawned.spawnRadiusSqr = spawnType.spawnRadiusSqr;
+        spawned.spawnCell = cell;
+        _changeCellCount(cell, spawnType.id, 1);
+        return entity;
+    }
+
+    return NULL_OBJECT;
+}
+
+void
+    SpawnSystem::_releaseOrphanedPools(CellStageWorld& world)
+{
+    for(auto iter = m_impl->pools.begin(); iter != m_impl->pools.end();) {
+
+        if(m_impl->spawnTypes.find(iter->first) != m_impl->spawnTypes.end()) {
+            ++iter;
+            continue;
+        }
+
+        for(ObjectID entity : iter->second)
+            world.QueueDestroyEntity(entity);
+
+        iter = m_impl->pools.erase(iter);
+    }
+}
+
 void
     SpawnSystem::Release()
 {
@@ -126,6 +278,9 @@ void
         std::tuple<SpawnedComponent&, Leviathan::Position&>>::Clear();
     LOG_INFO("Clearing spawn system spawners");
     m_impl->spawnTypes.clear();
+    // The world destroys the pooled entities when it is cleared
+    m_impl->pools.clear();
+    m_impl->cellCounts.clear();
     m_impl->previousPlayerPosition = Float3(0, 0, 0);
     m_impl->timeSinceLastUpdate = 0;
 }
@@ -138,6 +293,9 @@ SpawnSystem::~SpawnSystem() {}
 void
     SpawnSystem::Run(CellStageWorld& world, float elapsed)
 {
+    SystemProfiler::ScopedTimer timer(
+        world.GetSystemProfiler(), "SpawnSystem");
+
     if(!world.GetNetworkSettings().IsAuthoritative)
         return;
 
@@ -177,108 +335,229 @@ void
 
         // Remove the y-position from player position
         playerPosition.Y = 0;
-        int entitiesDeleted = 0;
-
-        // Despawn entities.
-        for(const auto& entry : CachedComponents.GetIndex()) {
-            // delete a max of two entities per step to reduce lag from deleting
-            // tons of entities at once
-            if(entitiesDeleted < 2) {
-                SpawnedComponent& spawnedComponent = std::get<0>(*entry.second);
-                const Float3 spawnedEntityPosition =
-                    std::get<1>(*entry.second).Members._Position;
-                float squaredDistance =
-                    (playerPosition - spawnedEntityPosition).LengthSquared();
-                // If the entity is too far away from the player, despawn it.
-                if(squaredDistance > spawnedComponent.spawnRadiusSqr) {
-                    entitiesDeleted++;
-                    world.QueueDestroyEntity(entry.first);
-                }
-            } else {
-                // get out of loop if you hit max
-                break;
-            }
+
+        _releaseOrphanedPools(world);
+
+        _despawnFarEntities(world, playerPosition);
+
+        for(const auto& spawnType : m_impl->spawnTypes)
+            _spawnRevealedCells(world, spawnType.second, playerPosition);
+
+        // Updating the previous player location.
+        m_impl->previousPlayerPosition = playerPosition;
+    }
+}
+
+void
+    SpawnSystem::_despawnFarEntities(CellStageWorld& world,
+        const Float3& playerPosition)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto start = Clock::now();
+    const auto budget = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(DESPAWN_TIME_BUDGET));
+
+    for(const auto& entry : CachedComponents.GetIndex()) {
+
+        SpawnedComponent& spawnedComponent = std::get<0>(*entry.second);
+
+        if(spawnedComponent.dormant)
+            continue;
+
+        const Float3 spawnedEntityPosition =
+            std::get<1>(*entry.second).Members._Position;
+        const float squaredDistance =
+            (playerPosition - spawnedEntityPosition).LengthSquared();
+
+        // Entities are allowed to be a grid cell past the spawn radius. This
+        // stops things spawned at the edge of a cell from instantly despawning
+        const float despawnRadius =
+            std::sqrt(spawnedComponent.spawnRadiusSqr) + SPAWN_GRID_CELL_SIZE;
+
+        if(squaredDistance <= despawnRadius * despawnRadius)
+            continue;
+
+        if(!poolEntity(world, entry.first, spawnedComponent))
+            world.QueueDestroyEntity(entry.first);
+
+        // The rest are handled in the next cycles if time ran out. Despawning
+        // is what costs time so the clock is checked only after that
+        if(Clock::now() - start > budget)
+            break;
+    }
+}
+
+void
+    SpawnSystem::_spawnRevealedCells(CellStageWorld& world,
+        const SpawnType& spawnType,
+        const Float3& playerPosition)
+{
+    /*
+    The world is divided into a grid. Each spawn cycle every cell whose center
+    came into the spawn radius since the previous cycle is filled based on the
+    spawn density. Cells that stay in range are not touched so moving back and
+    forth doesn't keep adding more things.
+    */
+    const float radius = static_cast<float>(spawnType.spawnRadius);
+    const float radiusSqr = static_cast<float>(spawnType.spawnRadiusSqr);
+
+    const int32_t minX = static_cast<int32_t>(
+        std::floor((playerPosition.X - radius) / SPAWN_GRID_CELL_SIZE));
+    const int32_t maxX = static_cast<int32_t>(
+        std::floor((playerPosition.X + radius) / SPAWN_GRID_CELL_SIZE));
+    const int32_t minZ = static_cast<int32_t>(
+        std::floor((playerPosition.Z - radius) / SPAWN_GRID_CELL_SIZE));
+    const int32_t maxZ = static_cast<int32_t>(
+        std::floor((playerPosition.Z + radius) / SPAWN_GRID_CELL_SIZE));
+
+    for(int32_t cellX = minX; cellX <= maxX; ++cellX) {
+        for(int32_t cellZ = minZ; cellZ <= maxZ; ++cellZ) {
+
+            const Float3 center((cellX + 0.5f) * SPAWN_GRID_CELL_SIZE, 0,
+                (cellZ + 0.5f) * SPAWN_GRID_CELL_SIZE);
+
+            if((center - playerPosition).LengthSquared() > radiusSqr)
+                continue;
+
+            if((center - m_impl->previousPlayerPosition).LengthSquared() <=
+                radiusSqr)
+                continue;
+
+            _spawnInCell(world, spawnType, cellX, cellZ, playerPosition);
         }
+    }
+}
+
+void
+    SpawnSystem::_spawnInCell(CellStageWorld& world,
+        const SpawnType& spawnType,
+        int32_t cellX,
+        int32_t cellZ,
+        const Float3& playerPosition)
+{
+    Leviathan::Random* random = Leviathan::Random::Get();
+
+    const int64_t cell = makeCellKey(cellX, cellZ);
+
+    // spawnFrequency is the expected count over the whole 2 * radius square
+    // around the player so this gets the expected count for one cell
+    const double expected = spawnType.spawnFrequency /
+                            (4 * spawnType.spawnRadiusSqr) *
+                            SPAWN_GRID_CELL_SIZE * SPAWN_GRID_CELL_SIZE;
+
+    int count = static_cast<int>(expected);
+
+    if(random->GetNumber(0.f, 1.f) < expected - count)
+        ++count;
+
+    // Don't go over the density if there are still things in this cell
+    int existing = 0;
+    const auto cellCounts = m_impl->cellCounts.find(cell);
+
+    if(cellCounts != m_impl->cellCounts.end()) {
+        const auto typeCount = cellCounts->second.find(spawnType.id);
 
-        Leviathan::Random* random = Leviathan::Random::Get();
-
-        // Spawn new entities.
-        for(auto& st : m_impl->spawnTypes) {
-            /*
-            To actually spawn a given entity for a given attempt, two
-            conditions should be met.  The first condition is a random
-            chance that adjusts the spawn frequency to the approprate
-            amount. The second condition is whether the entity will
-            spawn in a valid position.  It is checked when the first
-            condition is met and a position for the entity has been
-            decided.
-
-            To allow more than one entity of each type to spawn per
-            spawn cycle, the SpawnSystem attempts to spawn each given
-            entity multiple times depending on the spawnFrequency.
-            numAttempts stores how many times the SpawnSystem attempts
-            to spawn the given entity.
-            */
-            SpawnType& spawnType = st.second;
-            unsigned numAttempts =
-                std::max(int(spawnType.spawnFrequency * 2), 1);
-            for(unsigned i = 0; i < numAttempts; i++) {
-                if(random->GetNumber(0.0f, numAttempts) <
-                    spawnType.spawnFrequency) {
-                    /*
-                    First condition passed. Choose a location for the entity.
-
-                    A random location in the square of sidelength 2*spawnRadius
-                    centered on the player is chosen. The corners
-                    of the square are outside the spawning region, but they
-                    will fail the second condition, so entities still only
-                    spawn within the spawning region.
-                    */
-                    float distanceX = random->GetNumber(
-                        static_cast<float>(-spawnType.spawnRadius),
-                        spawnType.spawnRadius);
-                    float distanceZ = random->GetNumber(
-                        static_cast<float>(-spawnType.spawnRadius),
-                        spawnType.spawnRadius);
-
-                    // Distance from the player.
-                    Float3 displacement(distanceX, 0, distanceZ);
-                    float squaredDistance = displacement.LengthSquared();
-
-                    // Distance from the location of the player in the previous
-                    // spawn cycle.
-                    Float3 previousDisplacement =
-                        displacement + playerPosition -
-                        m_impl->previousPlayerPosition;
-                    float previousSquaredDistance =
-                        previousDisplacement.LengthSquared();
-
-                    if(squaredDistance <= spawnType.spawnRadiusSqr &&
-                        previousSquaredDistance > spawnType.spawnRadiusSqr) {
-                        // Second condition passed. Spawn the entity.
-                        ObjectID spawnedEntity = spawnType.factoryFunction(
-                            world, playerPosition + displacement);
-
-                        // Giving the new entity a spawn component.
-                        if(spawnedEntity != NULL_OBJECT) {
-
-                            try {
-                                world.Create_SpawnedComponent(
-                                    spawnedEntity, spawnType.spawnRadiusSqr);
-                            } catch(const Leviathan::Exception& e) {
-
-                                LOG_ERROR("SpawnSystem failed to add "
-                                          "SpawnedComponent, "
-                                          "exception:");
-                                e.PrintToLog();
-                            }
-                        }
-                    }
-                }
+        if(typeCount != cellCounts->second.end())
+            existing = typeCount->second;
+    }
+
+    count -= existing;
+
+    if(count <= 0)
+        return;
+
+    // Stratified placement. The cell is split into smaller squares and each
+    // spawned thing goes to a different one at a random offset, which keeps
+    // things from spawning on top of each other
+    constexpr auto strataCount = SPAWN_CELL_STRATA * SPAWN_CELL_STRATA;
+    constexpr float strataSize = SPAWN_GRID_CELL_SIZE / SPAWN_CELL_STRATA;
+
+    std::array<int, strataCount> strata;
+    for(int i = 0; i < strataCount; ++i)
+        strata[i] = i;
+
+    count = std::min(count, strataCount);
+
+    for(int i = 0; i < count; ++i) {
+
+        // Partial Fisher-Yates shuffle to pick unused strata
+        std::swap(strata[i], strata[random->GetNumber(i, strataCount - 1)]);
+
+        const int stratumX = strata[i] % SPAWN_CELL_STRATA;
+        const int stratumZ = strata[i] / SPAWN_CELL_STRATA;
+
+        const Float3 position(cellX * SPAWN_GRID_CELL_SIZE +
+                                  (stratumX + random->GetNumber(0.f, 1.f)) *
+                                      strataSize,
+            0,
+            cellZ * SPAWN_GRID_CELL_SIZE +
+                (stratumZ + random->GetNumber(0.f, 1.f)) * strataSize);
+
+        if((position - playerPosition).LengthSquared() >
+            spawnType.spawnRadiusSqr)
+            continue;
+
+        // Dormant entities are used first as they don't need their
+        // physics and graphics recreated
+        if(recycleFromPool(world, spawnType, position, cell) != NULL_OBJECT)
+            continue;
+
+        ObjectID spawnedEntity = spawnType.factoryFunction(world, position);
+
+        // Giving the new entity a spawn component.
+        if(spawnedEntity != NULL_OBJECT) {
+
+            try {
+                auto& spawned = world.Create_SpawnedComponent(
+                    spawnedEntity, spawnType.spawnRadiusSqr);
+                spawned.spawnType = spawnType.id;
+                spawned.spawnCell = cell;
+                _changeCellCount(cell, spawnType.id, 1);
+            } catch(const Leviathan::Exception& e) {
+
+                LOG_ERROR("SpawnSystem failed to add "
+                          "SpawnedComponent, "
+                          "exception:");
+                e.PrintToLog();
             }
         }
+    }
+}
 
-        // Updating the previous player location.
-        m_impl->previousPlayerPosition = playerPosition;
+void
+    SpawnSystem::_changeCellCount(
+        int64_t cell, SpawnerTypeId spawnType, int change)
+{
+    if(spawnType == NULL_SPAWNER)
+        return;
+
+    auto& counts = m_impl->cellCounts[cell];
+    auto& count = counts[spawnType];
+
+    count += change;
+
+    if(count <= 0) {
+        counts.erase(spawnType);
+
+        if(counts.empty())
+            m_impl->cellCounts.erase(cell);
     }
 }
+
+void
+    SpawnSystem::DestroyNodes(
+        const std::vector<std::tuple<SpawnedComponent*, ObjectID>>& firstdata,
+        const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
+            seconddata)
+{
+    for(const auto& removed : firstdata) {
+        const SpawnedComponent* spawned = std::get<0>(removed);
+
+        if(!spawned->dormant)
+            _changeCellCount(spawned->spawnCell, spawned->spawnType, -1);
+    }
+
+    CachedComponents.RemoveBasedOnKeyTupleList(firstdata);
+    CachedComponents.RemoveBasedOnKeyTupleList(seconddata);
+}
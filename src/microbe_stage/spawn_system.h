@@ -19,6 +19,16 @@ struct SpawnType {
     double spawnFrequency = 0.0;
     std::function<ObjectID(CellStageWorld&, Float3)> factoryFunction;
     SpawnerTypeId id = 0;
+
+    //! Puts an entity that went out of range to sleep so that it can be
+    //! reused later. If this returns false the entity is destroyed instead
+    std::function<bool(CellStageWorld&, ObjectID)> deactivateFunction;
+    //! Wakes up a pooled entity at a new position. If this returns false the
+    //! entity is destroyed and factoryFunction is used instead
+    std::function<bool(CellStageWorld&, ObjectID, Float3)> recycleFunction;
+    //! Max number of dormant entities to keep around for this type. 0
+    //! disables pooling
+    size_t maxPooled = 0;
 };
 
 /**
@@ -60,6 +70,17 @@ public:
 
     double spawnRadiusSqr;
 
+    //! The spawn type that created this. Only entities that have this set can
+    //! be recycled
+    SpawnerTypeId spawnType = NULL_SPAWNER;
+
+    //! True while this entity is sitting in a recycling pool
+    bool dormant = false;
+
+    //! The spawn grid cell this was spawned into. Used to keep track of how
+    //! many things of each type each cell has
+    int64_t spawnCell = 0;
+
     static constexpr auto TYPE =
         componentTypeConvert(THRIVE_COMPONENT::SPAWNED);
 };
@@ -92,6 +113,25 @@ public:
     bool
         updateDensity(SpawnerTypeId spawnId, double spawnDensity);
 
+    //! \brief Enables recycling entities of a spawn type instead of
+    //! destroying and recreating them
+    //! \param maxPooled How many dormant entities can be kept. 0 disables
+    //! \returns False if spawnId is not valid
+    bool
+        setSpawnTypeRecycling(SpawnerTypeId spawnId,
+            std::function<bool(CellStageWorld&, ObjectID)> deactivateFunction,
+            std::function<bool(CellStageWorld&, ObjectID, Float3)>
+                recycleFunction,
+            size_t maxPooled);
+
+    //! \returns The number of dormant entities for a spawn type
+    size_t
+        getPooledCount(SpawnerTypeId spawnId) const;
+
+    //! \brief Destroys all dormant entities
+    void
+        clearPools(CellStageWorld& world);
+
     //! Called before shutdown to clear everything
     //! (called automatically when the world is released)
     void
@@ -116,16 +156,65 @@ public:
         DestroyNodes(const std::vector<std::tuple<SpawnedComponent*, ObjectID>>&
                          firstdata,
             const std::vector<std::tuple<Leviathan::Position*, ObjectID>>&
-                seconddata)
-    {
-        CachedComponents.RemoveBasedOnKeyTupleList(firstdata);
-        CachedComponents.RemoveBasedOnKeyTupleList(seconddata);
-    }
+                seconddata);
+
+private:
+    //! \brief Tries to put an entity into the pool of its spawn type
+    //! \returns True if pooled, false if the caller should destroy it
+    bool
+        poolEntity(CellStageWorld& world,
+            ObjectID entity,
+            SpawnedComponent& spawned);
+
+    //! \brief Reuses a dormant entity of a type, if there is one
+    //! \returns NULL_OBJECT if there wasn't a usable one
+    ObjectID
+        recycleFromPool(CellStageWorld& world,
+            const SpawnType& spawnType,
+            const Float3& position,
+            int64_t cell);
+
+    //! \brief Despawns entities that are out of range until the time budget
+    //! runs out
+    void
+        _despawnFarEntities(CellStageWorld& world, const Float3& playerPosition);
+
+    //! \brief Fills the grid cells that came into range for a spawn type
+    void
+        _spawnRevealedCells(CellStageWorld& world,
+            const SpawnType& spawnType,
+            const Float3& playerPosition);
+
+    //! \brief Spawns things of a type into a single grid cell
+    void
+        _spawnInCell(CellStageWorld& world,
+            const SpawnType& spawnType,
+            int32_t cellX,
+            int32_t cellZ,
+            const Float3& playerPosition);
+
+    //! Updates the count of things of a type in a grid cell
+    void
+        _changeCellCount(int64_t cell, SpawnerTypeId spawnType, int change);
+
+    //! Destroys pooled entities of spawn types that have been removed
+    void
+        _releaseOrphanedPools(CellStageWorld& world);
 
 private:
     // Time between spawn cycles
     static constexpr float SPAWN_INTERVAL = 0.1f;
 
+    //! Size of the squares that the spawn area is divided into
+    static constexpr float SPAWN_GRID_CELL_SIZE = 25.f;
+
+    //! How many strata each grid cell is divided into on each axis when
+    //! picking spawn positions
+    static constexpr int SPAWN_CELL_STRATA = 4;
+
+    //! Max time in seconds spent despawning entities per spawn cycle
+    static constexpr float DESPAWN_TIME_BUDGET = 0.001f;
+
     struct Implementation;
     std::unique_ptr<Implementation> m_impl;
 };
@@ -1,6 +1,7 @@
 // ------------------------------------ //
 #include "script_initializer.h"
 
+#include "microbe_stage/hex_occupancy_map.h"
 #include "microbe_stage/organelle_table.h"
 
 #include <Script/Bindings/BindHelpers.h>
@@ -174,7 +175,66 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    // ------------------------------------ //
+    // HexOccupancyMap
+    ANGELSCRIPT_REGISTER_REF_TYPE("HexOccupancyMap", HexOccupancyMap);
+
+    if(engine->RegisterObjectBehaviour("HexOccupancyMap", asBEHAVE_FACTORY,
+           "HexOccupancyMap@ f()", asFUNCTION(HexOccupancyMap::factory),
+           asCALL_CDECL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "int32 addOrganelle(const OrganelleTemplate &in organelle, int q, "
+           "int r, int rotation)",
+           asMETHOD(HexOccupancyMap, addOrganelle), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
 
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "bool canPlaceOrganelle(const OrganelleTemplate &in organelle, "
+           "int q, int r, int rotation) const",
+           asMETHOD(HexOccupancyMap, canPlaceOrganelle),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "int32 getAt(const Int2 &in hex) const",
+           asMETHOD(HexOccupancyMap, getAtWrapper), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "int32 getAt(int q, int r) const",
+           asMETHOD(HexOccupancyMap, getAt), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "void removeAt(uint32 index)",
+           asMETHOD(HexOccupancyMap, removeAt), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap", "void clear()",
+           asMETHOD(HexOccupancyMap, clear), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "uint32 getCount() const", asMETHOD(HexOccupancyMap, getCount),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("HexOccupancyMap",
+           "uint32 getOccupiedHexCount() const",
+           asMETHOD(HexOccupancyMap, getOccupiedHexCount),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
 
     return true;
 }
@@ -1,9 +1,11 @@
 // ------------------------------------ //
 #include "script_initializer.h"
 
+#include "engine/tracing.h"
 #include "general/timed_life_system.h"
 #include "generated/cell_stage_world.h"
 #include "generated/microbe_editor_world.h"
+#include "microbe_stage/energy_balance_model.h"
 #include "microbe_stage/player_microbe_control.h"
 
 #include <Script/Bindings/BindHelpers.h>
@@ -62,6 +64,119 @@ SpawnerTypeId
         spawnDensity, spawnRadius);
 }
 
+class ScriptSpawnRecyclingWrapper {
+public:
+    //! \note Caller must have incremented ref count already on the funcs
+    ScriptSpawnRecyclingWrapper(
+        asIScriptFunction* deactivate, asIScriptFunction* recycle) :
+        m_deactivate(deactivate),
+        m_recycle(recycle)
+    {
+        if(!m_deactivate || !m_recycle) {
+            if(m_deactivate)
+                m_deactivate->Release();
+            if(m_recycle)
+                m_recycle->Release();
+            throw std::runtime_error(
+                "no func given for ScriptSpawnRecyclingWrapper");
+        }
+    }
+
+    ~ScriptSpawnRecyclingWrapper()
+    {
+        m_deactivate->Release();
+        m_recycle->Release();
+    }
+
+    bool
+        deactivate(CellStageWorld& world, ObjectID entity)
+    {
+        ScriptRunningSetup setup;
+        auto result = Leviathan::ScriptExecutor::Get()->RunScript<bool>(
+            m_deactivate, nullptr, setup, &world, entity);
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+            LOG_ERROR("Failed to run Wrapped SpawnSystem deactivate function");
+            // The entity is destroyed instead
+            return false;
+        }
+
+        return result.Value;
+    }
+
+    bool
+        recycle(CellStageWorld& world, ObjectID entity, Float3 pos)
+    {
+        ScriptRunningSetup setup;
+        auto result = Leviathan::ScriptExecutor::Get()->RunScript<bool>(
+            m_recycle, nullptr, setup, &world, entity, pos);
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+            LOG_ERROR("Failed to run Wrapped SpawnSystem recycle function");
+            return false;
+        }
+
+        return result.Value;
+    }
+
+    asIScriptFunction* m_deactivate;
+    asIScriptFunction* m_recycle;
+};
+
+bool
+    setSpawnTypeRecyclingProxy(SpawnSystem* self,
+        SpawnerTypeId spawnId,
+        asIScriptFunction* deactivate,
+        asIScriptFunction* recycle,
+        uint32_t maxPooled)
+{
+    std::shared_ptr<ScriptSpawnRecyclingWrapper> wrapper;
+
+    try {
+        wrapper =
+            std::make_shared<ScriptSpawnRecyclingWrapper>(deactivate, recycle);
+    } catch(const std::runtime_error& e) {
+        asGetActiveContext()->SetException(e.what());
+        return false;
+    }
+
+    return self->setSpawnTypeRecycling(
+        spawnId,
+        [=](CellStageWorld& world, ObjectID entity) -> bool {
+            return wrapper->deactivate(world, entity);
+        },
+        [=](CellStageWorld& world, ObjectID entity, Float3 pos) -> bool {
+            return wrapper->recycle(world, entity, pos);
+        },
+        maxPooled);
+}
+
+uint32_t
+    getPooledCountProxy(SpawnSystem* self, SpawnerTypeId spawnId)
+{
+    return static_cast<uint32_t>(self->getPooledCount(spawnId));
+}
+
+void
+    emitAgentProxy(AgentCloudSystem* self,
+        CellStageWorld* world,
+        CompoundId agent,
+        const Float3& position,
+        const Float3& direction,
+        float amount,
+        const std::string& emitterSpecies)
+{
+    if(!world) {
+        asGetActiveContext()->SetException("world may not be null");
+        return;
+    }
+
+    self->emitAgent(
+        *world, agent, position, direction, amount, emitterSpecies);
+}
+
 bool
     commonScriptReceivedOrganelleArrayHelper(const CScriptArray* organelles,
         const Patch* patch,
@@ -99,7 +214,7 @@ bool
     return true;
 }
 
-std::string
+ProcessEfficiencies*
     computeOrganelleProcessEfficienciesWrapper(ProcessSystem& self,
         const CScriptArray* organelles,
         const Patch* patch)
@@ -117,13 +232,17 @@ std::string
     std::vector<OrganelleTemplate::pointer> convertedOrganelles;
     if(!commonScriptReceivedOrganelleArrayHelper(
            organelles, patch, convertedOrganelles))
-        return "";
+        return nullptr;
 
-    return self.computeOrganelleProcessEfficiencies(
+    auto result = self.computeOrganelleProcessEfficiencies(
         convertedOrganelles, patch->getBiome());
+
+    // Reference for the caller
+    result->AddRef();
+    return result.get();
 }
 
-std::string
+EnergyBalance*
     computeEnergyBalanceWrapper(ProcessSystem& self,
         const CScriptArray* organelles,
         const MembraneTypeId membraneType,
@@ -142,11 +261,14 @@ std::string
     std::vector<OrganelleTemplate::pointer> convertedOrganelles;
     if(!commonScriptReceivedOrganelleArrayHelper(
            organelles, patch, convertedOrganelles))
-        return "";
+        return nullptr;
 
-    return self.computeEnergyBalance(convertedOrganelles,
+    auto result = self.computeEnergyBalance(convertedOrganelles,
         SimulationParameters::membraneRegistry.getTypeData(membraneType),
         patch->getBiome());
+
+    result->AddRef();
+    return result.get();
 }
 // ------------------------------------ //
 class WorldEffectScript : public WorldEffect {
@@ -220,6 +342,146 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    if(engine->RegisterFuncdef(
+           "bool SpawnDeactivateFunc(CellStageWorld@ world, ObjectID entity)") <
+        0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterFuncdef("bool SpawnRecycleFunc(CellStageWorld@ world, "
+                               "ObjectID entity, Float3 pos)") < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("SpawnSystem",
+           "bool setSpawnTypeRecycling(SpawnerTypeId spawnId, "
+           "SpawnDeactivateFunc@ deactivate, SpawnRecycleFunc@ recycle, "
+           "uint maxPooled)",
+           asFUNCTION(setSpawnTypeRecyclingProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("SpawnSystem",
+           "uint getPooledCount(SpawnerTypeId spawnId) const",
+           asFUNCTION(getPooledCountProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    // Process query results
+    ANGELSCRIPT_REGISTER_REF_TYPE("ProcessEfficiencies", ProcessEfficiencies);
+
+    if(engine->RegisterObjectMethod("ProcessEfficiencies",
+           "string toGUIPayload() const",
+           asMETHOD(ProcessEfficiencies, toGUIPayload), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("ProcessEfficiencies",
+           "string toJSON() const", asMETHOD(ProcessEfficiencies, toJSON),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    ANGELSCRIPT_REGISTER_REF_TYPE("EnergyBalance", EnergyBalance);
+
+    if(engine->RegisterObjectProperty("EnergyBalance",
+           "const float totalProduction",
+           asOFFSET(EnergyBalance, totalProduction)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("EnergyBalance",
+           "const float totalConsumption",
+           asOFFSET(EnergyBalance, totalConsumption)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("EnergyBalance", "const float balance",
+           asOFFSET(EnergyBalance, balance)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("EnergyBalance",
+           "const float balanceStationary",
+           asOFFSET(EnergyBalance, balanceStationary)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalance",
+           "string toGUIPayload() const",
+           asMETHOD(EnergyBalance, toGUIPayload), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalance", "string toJSON() const",
+           asMETHOD(EnergyBalance, toJSON), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    ANGELSCRIPT_REGISTER_REF_TYPE("EnergyBalanceModel", EnergyBalanceModel);
+
+    if(engine->RegisterObjectBehaviour("EnergyBalanceModel", asBEHAVE_FACTORY,
+           "EnergyBalanceModel@ f()", asFUNCTION(EnergyBalanceModel::factory),
+           asCALL_CDECL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "void setPatch(Patch@ patch)",
+           asMETHOD(EnergyBalanceModel, setPatchWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "void setMembrane(MembraneTypeId membrane)",
+           asMETHOD(EnergyBalanceModel, setMembraneWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "void addOrganelle(const OrganelleTemplate &in organelle)",
+           asMETHOD(EnergyBalanceModel, addOrganelleWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "void removeOrganelle(const OrganelleTemplate &in organelle)",
+           asMETHOD(EnergyBalanceModel, removeOrganelleWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "void clearOrganelles()",
+           asMETHOD(EnergyBalanceModel, clearOrganelles),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "EnergyBalance@ getBalance()",
+           asMETHOD(EnergyBalanceModel, getBalanceWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "ProcessEfficiencies@ getOrganelleTypeEfficiencies()",
+           asMETHOD(EnergyBalanceModel, getOrganelleTypeEfficienciesWrapper),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("EnergyBalanceModel",
+           "uint64 getOrganelleCount() const",
+           asMETHOD(EnergyBalanceModel, getOrganelleCount),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     // Process System
     if(engine->RegisterObjectType(
            "ProcessSystem", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
@@ -239,7 +501,7 @@ bool
     }
 
     if(engine->RegisterObjectMethod("ProcessSystem",
-           "string computeOrganelleProcessEfficiencies(const "
+           "ProcessEfficiencies@ computeOrganelleProcessEfficiencies(const "
            "array<OrganelleTemplate@>@ organelles, const Patch@ patch)",
            asFUNCTION(computeOrganelleProcessEfficienciesWrapper),
            asCALL_CDECL_OBJFIRST) < 0) {
@@ -247,7 +509,7 @@ bool
     }
 
     if(engine->RegisterObjectMethod("ProcessSystem",
-           "string computeOrganelleProcessEfficiencies(const "
+           "ProcessEfficiencies@ computeOrganelleProcessEfficiencies(const "
            "array<const OrganelleTemplate@>@ organelles, const Patch@ patch)",
            asFUNCTION(computeOrganelleProcessEfficienciesWrapper),
            asCALL_CDECL_OBJFIRST) < 0) {
@@ -255,7 +517,7 @@ bool
     }
 
     if(engine->RegisterObjectMethod("ProcessSystem",
-           "string computeEnergyBalance(const "
+           "EnergyBalance@ computeEnergyBalance(const "
            "array<const OrganelleTemplate@>@ organelles, const MembraneTypeId "
            "membraneType, const Patch@ patch)",
            asFUNCTION(computeEnergyBalanceWrapper),
@@ -291,6 +553,28 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    // ------------------------------------ //
+    // AgentCloudSystem
+    if(engine->RegisterObjectType(
+           "AgentCloudSystem", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("AgentCloudSystem",
+           "void emitAgent(CellStageWorld@ world, CompoundId agent, "
+           "const Float3 &in position, const Float3 &in direction, "
+           "float amount, const string &in emitterSpecies)",
+           asFUNCTION(emitAgentProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("AgentCloudSystem",
+           "float amountAt(CompoundId agent, const Float3 &in worldPosition) "
+           "const",
+           asMETHOD(AgentCloudSystem, amountAt), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     // ------------------------------------ //
     // PlayerMicrobeControlSystem
 
@@ -344,3 +628,73 @@ bool
 
     return true;
 }
+// ------------------------------------ //
+//! \brief Times the Run of a script system for the profiler and the trace
+struct ScriptSystemTimer {
+    ScriptSystemTimer(GameWorld& world, const char* system) :
+        timer(world, system), zone(system, "script")
+    {}
+
+    SystemProfiler::ScopedTimer timer;
+    TraceZone zone;
+};
+
+void
+    systemTimerConstructor(
+        GameWorld* world, const std::string& system, void* memory)
+{
+    if(!world) {
+        asGetActiveContext()->SetException("world may not be null");
+        return;
+    }
+
+    // The timers keep only a pointer to the name
+    new(memory) ScriptSystemTimer(*world, SystemProfiler::internName(system));
+}
+
+void
+    systemTimerDestructor(void* memory)
+{
+    static_cast<ScriptSystemTimer*>(memory)->~ScriptSystemTimer();
+}
+
+bool
+    thrive::registerSystemProfiler(asIScriptEngine* engine)
+{
+    if(engine->RegisterObjectType(
+           "SystemProfiler", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("SystemProfiler", "string toJSON() const",
+           asMETHOD(SystemProfiler, toJSON), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("SystemProfiler", "string toCSV() const",
+           asMETHOD(SystemProfiler, toCSV), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    // Script systems keep one of these as a local variable in their Run to
+    // show up in the statistics and the trace. It has no opAssign so it can't
+    // be copied
+    if(engine->RegisterObjectType("SystemTimer", sizeof(ScriptSystemTimer),
+           asOBJ_VALUE | asOBJ_APP_CLASS_CD) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectBehaviour("SystemTimer", asBEHAVE_CONSTRUCT,
+           "void f(GameWorld@ world, const string &in system)",
+           asFUNCTION(systemTimerConstructor), asCALL_CDECL_OBJLAST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectBehaviour("SystemTimer", asBEHAVE_DESTRUCT,
+           "void f()", asFUNCTION(systemTimerDestructor),
+           asCALL_CDECL_OBJLAST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    return true;
+}
@@ -5,9 +5,148 @@
 #include "generated/microbe_editor_world.h"
 
 #include <Script/Bindings/StandardWorldBindHelper.h>
+#include <add_on/scriptarray/scriptarray.h>
+
+#include <boost/scope_exit.hpp>
 
 using namespace thrive;
 // ------------------------------------ //
+// Bulk access helpers. These write into arrays owned by the script so that
+// processing all compounds or many entities is a single call
+bool
+    checkBulkArray(const CScriptArray* array, int wantedTypeId)
+{
+    if(!array) {
+        asGetActiveContext()->SetException("bulk array may not be null");
+        return false;
+    }
+
+    if(array->GetElementTypeId() != wantedTypeId) {
+        asGetActiveContext()->SetException("bulk array type mismatch");
+        return false;
+    }
+
+    return true;
+}
+
+void
+    getCompoundAmountsProxy(const CompoundBagComponent* self,
+        CScriptArray* result)
+{
+    BOOST_SCOPE_EXIT(&result)
+    {
+        if(result)
+            result->Release();
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    if(!checkBulkArray(result, asTYPEID_DOUBLE))
+        return;
+
+    self->getCompoundAmounts(*result);
+}
+
+double
+    takeCompoundsProxy(CompoundBagComponent* self,
+        const CScriptArray* amounts,
+        CScriptArray* taken)
+{
+    BOOST_SCOPE_EXIT(&amounts, &taken)
+    {
+        if(amounts)
+            amounts->Release();
+
+        if(taken)
+            taken->Release();
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    if(!checkBulkArray(amounts, asTYPEID_DOUBLE) ||
+        !checkBulkArray(taken, asTYPEID_DOUBLE))
+        return 0;
+
+    if(amounts == taken) {
+        asGetActiveContext()->SetException(
+            "takeCompounds amounts and taken must be different arrays");
+        return 0;
+    }
+
+    return self->takeCompounds(*amounts, *taken);
+}
+
+void
+    giveCompoundsProxy(CompoundBagComponent* self,
+        const CScriptArray* amounts,
+        double multiplier)
+{
+    BOOST_SCOPE_EXIT(&amounts)
+    {
+        if(amounts)
+            amounts->Release();
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    if(!checkBulkArray(amounts, asTYPEID_DOUBLE))
+        return;
+
+    self->giveCompounds(*amounts, multiplier);
+}
+
+void
+    getAbsorbedAmountsProxy(const CompoundAbsorberComponent* self,
+        CScriptArray* result)
+{
+    BOOST_SCOPE_EXIT(&result)
+    {
+        if(result)
+            result->Release();
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    if(!checkBulkArray(result, asTYPEID_FLOAT))
+        return;
+
+    self->getAbsorbedAmounts(*result);
+}
+
+//! \brief Gets the amount of a compound in many entities at once
+//!
+//! Entities without a CompoundBagComponent get an amount of -1
+void
+    cellStageGetCompoundAmountsProxy(CellStageWorld* self,
+        const CScriptArray* entities,
+        CompoundId compound,
+        CScriptArray* result)
+{
+    BOOST_SCOPE_EXIT(&entities, &result)
+    {
+        if(entities)
+            entities->Release();
+
+        if(result)
+            result->Release();
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    if(!checkBulkArray(entities, asTYPEID_INT32) ||
+        !checkBulkArray(result, asTYPEID_DOUBLE))
+        return;
+
+    const auto count = entities->GetSize();
+    result->Resize(count);
+
+    for(asUINT i = 0; i < count; ++i) {
+
+        const auto entity = *static_cast<const ObjectID*>(entities->At(i));
+
+        CompoundBagComponent* bag =
+            self->GetComponentPtr_CompoundBagComponent(entity);
+
+        *static_cast<double*>(result->At(i)) =
+            bag ? bag->getCompoundAmount(compound) : -1.0;
+    }
+}
+// ------------------------------------ //
 template<class WorldType>
 bool
     bindCellStageMethods(asIScriptEngine* engine, const char* classname)
@@ -18,6 +157,14 @@ bool
 
 #include "generated/cell_stage_bindings.h"
 
+    if(engine->RegisterObjectMethod(classname,
+           "void getCompoundAmounts(const array<ObjectID>@ entities, "
+           "CompoundId compound, array<double>@ result)",
+           asFUNCTION(cellStageGetCompoundAmountsProxy),
+           asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     ANGLESCRIPT_BASE_CLASS_CASTS_NO_REF(Leviathan::StandardWorld,
         "StandardWorld", CellStageWorld, "CellStageWorld");
 
@@ -49,6 +196,8 @@ static uint16_t EngulfableComponentTYPEProxy =
     static_cast<uint16_t>(EngulfableComponent::TYPE);
 static uint16_t DamageOnTouchComponentTYPEProxy =
     static_cast<uint16_t>(DamageOnTouchComponent::TYPE);
+static uint16_t MicrobeStatsComponentTYPEProxy =
+    static_cast<uint16_t>(MicrobeStatsComponent::TYPE);
 static uint16_t SpawnedComponentTYPEProxy =
     static_cast<uint16_t>(SpawnedComponent::TYPE);
 static uint16_t AgentCloudComponentTYPEProxy =
@@ -65,8 +214,6 @@ static uint16_t CompoundAbsorberComponentTYPEProxy =
     static_cast<uint16_t>(CompoundAbsorberComponent::TYPE);
 static uint16_t TimedLifeComponentTYPEProxy =
     static_cast<uint16_t>(TimedLifeComponent::TYPE);
-static uint16_t AgentPropertiesTYPEProxy =
-    static_cast<uint16_t>(AgentProperties::TYPE);
 
 //! Helper for bindThriveComponentTypes
 bool
@@ -215,6 +362,197 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    // ------------------------------------ //
+    if(engine->RegisterObjectType(
+           "MicrobeStatsComponent", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(!bindComponentTypeId(
+           engine, "MicrobeStatsComponent", &MicrobeStatsComponentTYPEProxy))
+        return false;
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float hitpoints",
+           asOFFSET(MicrobeStatsComponent, hitpoints)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float previousHitpoints",
+           asOFFSET(MicrobeStatsComponent, previousHitpoints)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float maxHitpoints",
+           asOFFSET(MicrobeStatsComponent, maxHitpoints)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "double capacity",
+           asOFFSET(MicrobeStatsComponent, capacity)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "double stored",
+           asOFFSET(MicrobeStatsComponent, stored)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float maxBandwidth",
+           asOFFSET(MicrobeStatsComponent, maxBandwidth)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float remainingBandwidth",
+           asOFFSET(MicrobeStatsComponent, remainingBandwidth)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float agentEmissionCooldown",
+           asOFFSET(MicrobeStatsComponent, agentEmissionCooldown)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float compoundCollectionTimer",
+           asOFFSET(MicrobeStatsComponent, compoundCollectionTimer)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "int totalHexCount",
+           asOFFSET(MicrobeStatsComponent, totalHexCount)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool dead",
+           asOFFSET(MicrobeStatsComponent, dead)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool dormant",
+           asOFFSET(MicrobeStatsComponent, dormant)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "int pendingCompoundCollections",
+           asOFFSET(MicrobeStatsComponent, pendingCompoundCollections)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float pendingAgentDamage",
+           asOFFSET(MicrobeStatsComponent, pendingAgentDamage)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "Float4 membraneColour",
+           asOFFSET(MicrobeStatsComponent, membraneColour)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float flashDuration",
+           asOFFSET(MicrobeStatsComponent, flashDuration)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "Float4 flashColour",
+           asOFFSET(MicrobeStatsComponent, flashColour)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float deathTimer",
+           asOFFSET(MicrobeStatsComponent, deathTimer)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float movementFactor",
+           asOFFSET(MicrobeStatsComponent, movementFactor)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool engulfMode",
+           asOFFSET(MicrobeStatsComponent, engulfMode)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool isBeingEngulfed",
+           asOFFSET(MicrobeStatsComponent, isBeingEngulfed)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool wasBeingEngulfed",
+           asOFFSET(MicrobeStatsComponent, wasBeingEngulfed)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool isCurrentlyEngulfing",
+           asOFFSET(MicrobeStatsComponent, isCurrentlyEngulfing)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "ObjectID hostileEngulfer",
+           asOFFSET(MicrobeStatsComponent, hostileEngulfer)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool hasEscaped",
+           asOFFSET(MicrobeStatsComponent, hasEscaped)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float escapeInterval",
+           asOFFSET(MicrobeStatsComponent, escapeInterval)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "bool isBacteria",
+           asOFFSET(MicrobeStatsComponent, isBacteria)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "float pendingEngulfDamage",
+           asOFFSET(MicrobeStatsComponent, pendingEngulfDamage)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectProperty("MicrobeStatsComponent",
+           "int pendingEscapes",
+           asOFFSET(MicrobeStatsComponent, pendingEscapes)) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("MicrobeStatsComponent",
+           "void setAgentSpecies(const string &in speciesName)",
+           asMETHOD(MicrobeStatsComponent, setAgentSpecies),
+           asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     // ------------------------------------ //
     if(engine->RegisterObjectType(
            "SpawnedComponent", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
@@ -377,6 +715,26 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    if(engine->RegisterObjectMethod("CompoundBagComponent",
+           "void getCompoundAmounts(array<double>@ result) const",
+           asFUNCTION(getCompoundAmountsProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("CompoundBagComponent",
+           "double takeCompounds(const array<double>@ amounts, "
+           "array<double>@ taken)",
+           asFUNCTION(takeCompoundsProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("CompoundBagComponent",
+           "void giveCompounds(const array<double>@ amounts, "
+           "double multiplier = 1)",
+           asFUNCTION(giveCompoundsProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     if(engine->RegisterObjectProperty("CompoundBagComponent",
            "double storageSpace",
            asOFFSET(CompoundBagComponent, storageSpace)) < 0) {
@@ -436,6 +794,12 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    if(engine->RegisterObjectMethod("CompoundAbsorberComponent",
+           "void getAbsorbedAmounts(array<float>@ result) const",
+           asFUNCTION(getAbsorbedAmountsProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     if(engine->RegisterObjectMethod("CompoundAbsorberComponent",
            "void setAbsorbtionCapacity(double capacity)",
            asMETHOD(CompoundAbsorberComponent, setAbsorbtionCapacity),
@@ -460,49 +824,6 @@ bool
            engine, "TimedLifeComponent", &TimedLifeComponentTYPEProxy))
         return false;
 
-    if(engine->RegisterObjectType(
-           "AgentProperties", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(!bindComponentTypeId(
-           engine, "AgentProperties", &AgentPropertiesTYPEProxy))
-        return false;
-
-    if(engine->RegisterObjectMethod("AgentProperties",
-           "void setSpeciesName(string newString)",
-           asMETHOD(AgentProperties, setSpeciesName), asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(engine->RegisterObjectMethod("AgentProperties",
-           "void setParentEntity(ObjectID parentId)",
-           asMETHOD(AgentProperties, setParentEntity), asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(engine->RegisterObjectMethod("AgentProperties",
-           "void setAgentType(string newString)",
-           asMETHOD(AgentProperties, setAgentType), asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(engine->RegisterObjectMethod("AgentProperties",
-           "string getSpeciesName()", asMETHOD(AgentProperties, getSpeciesName),
-           asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(engine->RegisterObjectMethod("AgentProperties",
-           "ObjectID getParentEntity()",
-           asMETHOD(AgentProperties, getParentEntity), asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
-
-    if(engine->RegisterObjectMethod("AgentProperties", "string getAgentType()",
-           asMETHOD(AgentProperties, getAgentType), asCALL_THISCALL) < 0) {
-        ANGELSCRIPT_REGISTERFAIL;
-    }
     return true;
 }
 // ------------------------------------ //
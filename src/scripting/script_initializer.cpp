@@ -7,15 +7,110 @@
 #include "general/hex.h"
 #include "general/locked_map.h"
 #include "general/properties_component.h"
+#include "microbe_stage/microbe_constants.h"
 #include "microbe_stage/species.h"
 
 #include "ThriveGame.h"
+#include "js_call_dispatcher.h"
 
 #include <Script/Bindings/BindHelpers.h>
 #include <Script/ScriptExecutor.h>
 
+#include <initializer_list>
+#include <string>
+#include <utility>
+
 using namespace thrive;
 // ------------------------------------ //
+class ScriptJSFunctionWrapper {
+public:
+    //! \note Caller must have incremented ref count already on func
+    ScriptJSFunctionWrapper(asIScriptFunction* func) : m_func(func)
+    {
+        if(!m_func)
+            throw InvalidArgument("no func given to ScriptJSFunctionWrapper");
+    }
+
+    ~ScriptJSFunctionWrapper()
+    {
+        m_func->Release();
+    }
+
+    void
+        run(const JSCallArguments& arguments)
+    {
+        ScriptRunningSetup setup;
+        auto result = Leviathan::ScriptExecutor::Get()->RunScript<void>(
+            m_func, nullptr, setup, const_cast<JSCallArguments*>(&arguments));
+
+        if(result.Result != SCRIPT_RUN_RESULT::Success) {
+
+            LOG_ERROR("Failed to run script JS function handler");
+        }
+    }
+
+    asIScriptFunction* m_func;
+};
+
+//! \note The script handlers check the argument types themselves with the
+//! typed getters
+void
+    registerJSFunctionProxy(ThriveGame* self,
+        const std::string& name,
+        asIScriptFunction* func)
+{
+    auto wrapper = std::make_shared<ScriptJSFunctionWrapper>(func);
+
+    self->jsCalls().registerFunction(name, {},
+        [=](const JSCallArguments& arguments) { wrapper->run(arguments); },
+        false);
+}
+
+bool
+    registerJSCallArguments(asIScriptEngine* engine)
+{
+    if(engine->RegisterObjectType(
+           "JSCallArguments", 0, asOBJ_REF | asOBJ_NOCOUNT) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("JSCallArguments", "uint64 size() const",
+           asMETHOD(JSCallArguments, size), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("JSCallArguments",
+           "bool getBool(uint64 index) const",
+           asMETHOD(JSCallArguments, getBool), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("JSCallArguments",
+           "int getInt(uint64 index) const",
+           asMETHOD(JSCallArguments, getInt), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("JSCallArguments",
+           "double getDouble(uint64 index) const",
+           asMETHOD(JSCallArguments, getDouble), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterObjectMethod("JSCallArguments",
+           "const string& getString(uint64 index) const",
+           asMETHOD(JSCallArguments, getString), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    if(engine->RegisterFuncdef(
+           "void JSFunctionHandler(const JSCallArguments@ arguments)") < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    return true;
+}
+
 bool
     registerLockedMap(asIScriptEngine* engine)
 {
@@ -204,6 +299,61 @@ bool
     return true;
 }
 
+//! Registers the constants in microbe_constants.h as const script globals
+bool
+    registerMicrobeConstants(asIScriptEngine* engine)
+{
+    const std::initializer_list<std::pair<const char*, const float*>>
+        constants = {
+            {"MIN_COLOR", &MIN_COLOR},
+            {"MAX_COLOR", &MAX_COLOR},
+            {"MIN_OPACITY", &MIN_OPACITY},
+            {"MAX_OPACITY", &MAX_OPACITY},
+            {"MIN_OPACITY_CHITIN", &MIN_OPACITY_CHITIN},
+            {"MAX_OPACITY_CHITIN", &MAX_OPACITY_CHITIN},
+            {"MUTATION_BACTERIA_TO_EUKARYOTE", &MUTATION_BACTERIA_TO_EUKARYOTE},
+            {"MUTATION_CREATION_RATE", &MUTATION_CREATION_RATE},
+            {"MUTATION_EXTRA_CREATION_RATE", &MUTATION_EXTRA_CREATION_RATE},
+            {"MUTATION_DELETION_RATE", &MUTATION_DELETION_RATE},
+            {"MUTATION_REPLACEMENT_RATE", &MUTATION_REPLACEMENT_RATE},
+            {"MAX_SPECIES_AGRESSION", &MAX_SPECIES_AGRESSION},
+            {"MAX_SPECIES_FEAR", &MAX_SPECIES_FEAR},
+            {"MAX_SPECIES_ACTIVITY", &MAX_SPECIES_ACTIVITY},
+            {"MAX_SPECIES_FOCUS", &MAX_SPECIES_FOCUS},
+            {"MAX_SPECIES_OPPORTUNISM", &MAX_SPECIES_OPPORTUNISM},
+            {"MAX_SPECIES_PERSONALITY_MUTATION",
+                &MAX_SPECIES_PERSONALITY_MUTATION},
+            {"MIN_SPECIES_PERSONALITY_MUTATION",
+                &MIN_SPECIES_PERSONALITY_MUTATION},
+            {"ATP_COST_FOR_OSMOREGULATION", &ATP_COST_FOR_OSMOREGULATION},
+            {"BASE_MOVEMENT_ATP_COST", &BASE_MOVEMENT_ATP_COST},
+            {"FLAGELLA_ENERGY_COST", &FLAGELLA_ENERGY_COST},
+            {"DEFAULT_HEALTH", &DEFAULT_HEALTH},
+            {"REGENERATION_RATE", &REGENERATION_RATE},
+            {"BANDWIDTH_PER_ORGANELLE", &BANDWIDTH_PER_ORGANELLE},
+            {"BANDWIDTH_REFILL_DURATION", &BANDWIDTH_REFILL_DURATION},
+            {"EXCESS_COMPOUND_COLLECTION_INTERVAL",
+                &EXCESS_COMPOUND_COLLECTION_INTERVAL},
+            {"ENGULFING_MOVEMENT_DIVISION", &ENGULFING_MOVEMENT_DIVISION},
+            {"ENGULFED_MOVEMENT_DIVISION", &ENGULFED_MOVEMENT_DIVISION},
+            {"ENGULFING_ATP_COST_SECOND", &ENGULFING_ATP_COST_SECOND},
+            {"ENGULF_DAMAGE", &ENGULF_DAMAGE},
+            {"CREATURE_ESCAPE_INTERVAL", &CREATURE_ESCAPE_INTERVAL},
+        };
+
+    for(const auto& constant : constants) {
+
+        const auto declaration = std::string("const float ") + constant.first;
+
+        if(engine->RegisterGlobalProperty(declaration.c_str(),
+               const_cast<float*>(constant.second)) < 0) {
+            ANGELSCRIPT_REGISTERFAIL;
+        }
+    }
+
+    return true;
+}
+
 bool
     registerHexFunctions(asIScriptEngine* engine)
 {
@@ -477,6 +627,14 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    // For the mutations made outside auto-evo
+    if(engine->RegisterGlobalFunction(
+           "Species@ getMutationForSpecies(const Species@ species)",
+           asFUNCTION(autoevo::getMutationForSpeciesWrapper),
+           asCALL_CDECL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     return true;
 }
 
@@ -543,12 +701,21 @@ bool
     if(!registerHexFunctions(engine))
         return false;
 
+    if(!registerMicrobeConstants(engine))
+        return false;
+
     if(!registerTimedWorldOperations(engine))
         return false;
 
+    if(!registerSystemProfiler(engine))
+        return false;
+
     if(!registerAutoEvo(engine))
         return false;
 
+    if(!registerJSCallArguments(engine))
+        return false;
+
     if(engine->RegisterObjectType("ThriveGame", 0, asOBJ_REF | asOBJ_NOCOUNT) <
         0) {
         ANGELSCRIPT_REGISTERFAIL;
@@ -615,6 +782,20 @@ bool
         ANGELSCRIPT_REGISTERFAIL;
     }
 
+    if(engine->RegisterObjectMethod("ThriveGame",
+           "void postGuiUpdate(GenericEvent@+ event)",
+           asMETHOD(ThriveGame, postGuiUpdate), asCALL_THISCALL) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
+    // The GUI calls these with Thrive.call(name, ...)
+    if(engine->RegisterObjectMethod("ThriveGame",
+           "void registerJSFunction(const string &in name, "
+           "JSFunctionHandler@ handler)",
+           asFUNCTION(registerJSFunctionProxy), asCALL_CDECL_OBJFIRST) < 0) {
+        ANGELSCRIPT_REGISTERFAIL;
+    }
+
     if(engine->RegisterObjectMethod("ThriveGame",
            "void addExternalPopulationEffect(Species@ species, int32 change, "
            "const string &in reason)",
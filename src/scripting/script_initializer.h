@@ -29,6 +29,9 @@ bool
 bool
     registerTimedWorldOperations(asIScriptEngine* engine);
 
+bool
+    registerSystemProfiler(asIScriptEngine* engine);
+
 bool
     registerTweakedProcess(asIScriptEngine* engine);
 
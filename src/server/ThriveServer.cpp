@@ -2,7 +2,9 @@
 #include "ThriveServer.h"
 
 #include "engine/player_data.h"
+#include "engine/tracing.h"
 #include "general/global_keypresses.h"
+#include "world_shard.h"
 
 #include "generated/cell_stage_world.h"
 #include "generated/microbe_editor_world.h"
@@ -10,6 +12,7 @@
 #include "microbe_stage/simulation_parameters.h"
 #include "scripting/script_initializer.h"
 #include "thrive_net_handler.h"
+#include "thrive_packets.h"
 #include "thrive_version.h"
 #include "thrive_world_factory.h"
 
@@ -24,19 +27,109 @@
 #include <Script/Bindings/StandardWorldBindHelper.h>
 #include <Script/ScriptExecutor.h>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 using namespace thrive;
 // ------------------------------------ //
+constexpr auto DEFAULT_SERVER_TICK_RATE = 20;
+constexpr auto DEFAULT_SERVER_MAX_CATCH_UP_TICKS = 5;
+constexpr auto DEFAULT_SERVER_WORLD_SHARDS = 1;
+
+//! How often the tick statistics are printed, in seconds
+constexpr auto TICK_STATS_REPORT_INTERVAL = 60.f;
+
+namespace {
+
+PatchMap::pointer
+    generateNewPatchMap(Leviathan::GameModule& scripts)
+{
+    ScriptRunningSetup setup("generatePatchMap");
+    auto returned = scripts.ExecuteOnModule<PatchMap*>(setup, false);
+
+    if(returned.Result != SCRIPT_RUN_RESULT::Success || !returned.Value) {
+        LOG_ERROR("ThriveServer: failed to run generatePatchMap");
+        return nullptr;
+    }
+
+    // We are keeping a reference to the result
+    returned.Value->AddRef();
+
+    return PatchMap::WrapPtr(returned.Value);
+}
+
+} // namespace
+
 //! Contains properties that would need unnecessary large includes in the header
 class ThriveServer::Implementation {
 public:
-    Implementation(ThriveServer& game) : m_game(game), m_playerData("player") {}
+    Implementation(ThriveServer& game) : m_game(game), m_playerData("player")
+    {}
+
+    //! \returns The shard the player is in or null
+    WorldShard*
+        findPlayerShard(int32_t playerId)
+    {
+        std::lock_guard<std::mutex> lock(m_playerShardsMutex);
+
+        const auto found = m_playerShards.find(playerId);
+
+        if(found == m_playerShards.end())
+            return nullptr;
+
+        return found->second;
+    }
+
+    void
+        setPlayerShard(int32_t playerId, WorldShard* shard)
+    {
+        std::lock_guard<std::mutex> lock(m_playerShardsMutex);
+
+        if(shard) {
+            m_playerShards[playerId] = shard;
+        } else {
+            m_playerShards.erase(playerId);
+        }
+    }
+
+    WorldShard*
+        findPatchShard(int32_t patchId)
+    {
+        for(const auto& shard : m_shards) {
+            if(shard->getPatchId() == patchId)
+                return shard.get();
+        }
+
+        return nullptr;
+    }
 
     ThriveServer& m_game;
 
     PlayerData m_playerData;
 
-    std::shared_ptr<CellStageWorld> m_cellStage;
+    int m_tickRate = DEFAULT_SERVER_TICK_RATE;
+    int m_maxCatchUpTicks = DEFAULT_SERVER_MAX_CATCH_UP_TICKS;
+    int m_shardCount = DEFAULT_SERVER_WORLD_SHARDS;
+
+    //! The worlds of the server. New players join the first one
+    std::vector<std::unique_ptr<WorldShard>> m_shards;
+
+    //! The shard each player is in or is moving to. The shards add and
+    //! remove the players on their own threads, so this is kept here for
+    //! the network thread
+    std::unordered_map<int32_t, WorldShard*> m_playerShards;
+    std::mutex m_playerShardsMutex;
+
+    //! Time since the tick statistics were printed
+    float m_timeSinceTickReport = 0;
+
+    //! The statistics printed in the last report
+    std::vector<ShardStats> m_lastShardStats;
+
+    //! When not empty a trace is recorded while running and written here
+    std::string m_traceFile;
+
     // std::shared_ptr<MicrobeEditorWorld> m_microbeEditor;
 
     // std::shared_ptr<PlayerMicrobeControl> m_cellStageKeys;
@@ -84,21 +177,91 @@ void
 void
     ThriveServer::setupServerWorlds()
 {
-    Leviathan::Engine* engine = Engine::GetEngine();
-
     LOG_INFO("Starting server game state");
 
-    // Create world if not already created //
-    if(!m_impl->m_cellStage) {
-        LOG_INFO("ThriveServer: startNewGame: Creating new cellstage world");
-        m_impl->m_cellStage =
-            std::dynamic_pointer_cast<CellStageWorld>(engine->CreateWorld(
-                nullptr, static_cast<int>(THRIVE_WORLD_TYPE::CELL_STAGE),
-                createPhysicsMaterials(),
-                Leviathan::WorldNetworkSettings::GetSettingsForServer()));
+    _applyTickSettings();
+
+    if(m_impl->m_shards.empty()) {
+
+        // One shard is created for each patch, up to the configured count
+        std::vector<int32_t> patchIds;
+
+        const auto map = generateNewPatchMap(*getMicrobeScripts());
+
+        if(!map) {
+            MarkAsClosing();
+            return;
+        }
+
+        for(const auto& [id, patch] : map->getPatches())
+            patchIds.push_back(id);
+
+        std::sort(patchIds.begin(), patchIds.end());
+
+        if(patchIds.size() < static_cast<size_t>(m_impl->m_shardCount))
+            LOG_WARNING("ThriveServer: patch map only has " +
+                        std::to_string(patchIds.size()) +
+                        " patches, not creating more shards than that");
+
+        if(patchIds.size() > static_cast<size_t>(m_impl->m_shardCount))
+            patchIds.resize(m_impl->m_shardCount);
+
+        for(int32_t patchId : patchIds) {
+            if(!_createShard(patchId)) {
+                MarkAsClosing();
+                return;
+            }
+        }
+    }
+
+    LEVIATHAN_ASSERT(!m_impl->m_shards.empty(), "World shard creation failed");
+
+    LOG_INFO("ThriveServer: running " +
+             std::to_string(m_impl->m_shards.size()) + " world shards");
+
+    for(const auto& shard : m_impl->m_shards)
+        shard->start();
+
+    // Allow players joining
+    m_network->SetServerAllowPlayers(true);
+    m_network->SetServerStatus(Leviathan::SERVER_STATUS::Running);
+}
+
+bool
+    ThriveServer::_createShard(int32_t patchId)
+{
+    LOG_INFO("ThriveServer: creating cell stage world for patch " +
+             std::to_string(patchId));
+
+    // The world isn't created through the engine so that the engine doesn't
+    // tick it. It is ticked by the shard at the server tick rate.
+    // Without a window no rendering resources are created for it
+    auto world = std::make_shared<CellStageWorld>(createPhysicsMaterials());
+
+    if(!world->Init(
+           Leviathan::WorldNetworkSettings::GetSettingsForServer(), nullptr)) {
+        LOG_ERROR("ThriveServer: cell stage world init failed");
+        return false;
     }
 
-    LEVIATHAN_ASSERT(m_impl->m_cellStage, "Cell stage world creation failed");
+    // Each world has its own copy of the map as the current patch differs
+    const auto map = generateNewPatchMap(*getMicrobeScripts());
+
+    if(!map || !map->setCurrentPatch(patchId)) {
+        LOG_ERROR("ThriveServer: failed to create patch map for shard");
+        world->Release();
+        return false;
+    }
+
+    try {
+        world->GetPatchManager().setNewMap(map);
+    } catch(const Leviathan::Exception& e) {
+        LOG_ERROR("ThriveServer: something is wrong with the patch map, "
+                  "exception: ");
+        e.PrintToLog();
+        world->Release();
+        return false;
+    }
 
     // Setup compound clouds //
 
@@ -107,8 +270,6 @@ void
 
     LEVIATHAN_ASSERT(SimulationParameters::compoundRegistry.getSize() > 0,
         "compound registry is empty when creating cloud entities for them");
-    std::unordered_map<Leviathan::ObjectID, thrive::CompoundCloudComponent> u =
-        {};
 
     std::vector<Compound> clouds;
 
@@ -123,8 +284,7 @@ void
         clouds.push_back(data);
     }
 
-    m_impl->m_cellStage->GetCompoundCloudSystem().registerCloudTypes(
-        *m_impl->m_cellStage, clouds);
+    world->GetCompoundCloudSystem().registerCloudTypes(*world, clouds);
 
     // Let the script do setup //
     // This registers all the script defined systems to run and be
@@ -136,34 +296,24 @@ void
     ScriptRunningSetup setup;
     setup.SetEntrypoint("setupScriptsForWorld_Server");
 
-    auto result = getMicrobeScripts()->ExecuteOnModule<void>(
-        setup, false, m_impl->m_cellStage.get());
+    auto result =
+        getMicrobeScripts()->ExecuteOnModule<void>(setup, false, world.get());
 
     if(result.Result != SCRIPT_RUN_RESULT::Success) {
 
         LOG_ERROR(
             "Failed to run script setup function: " + setup.Entryfunction);
-        MarkAsClosing();
-        return;
+        world->Release();
+        return false;
     }
 
     LOG_INFO("Finished calling setupScriptsForWorld");
 
-    // // Spawn player //
-    // setup = ScriptRunningSetup("setupPlayer");
-
-    // result = getMicrobeScripts()->ExecuteOnModule<void>(
-    //     setup, false, m_impl->m_cellStage.get());
-
-    // if(result.Result != SCRIPT_RUN_RESULT::Success) {
+    world->GetPatchManager().applyPatchSettings();
 
-    //     LOG_ERROR("Failed to spawn player!");
-    //     return;
-    // }
-
-    // Allow players joining
-    m_network->SetServerAllowPlayers(true);
-    m_network->SetServerStatus(Leviathan::SERVER_STATUS::Running);
+    m_impl->m_shards.push_back(std::make_unique<WorldShard>(patchId, world,
+        static_cast<float>(m_impl->m_tickRate), m_impl->m_maxCatchUpTicks));
+    return true;
 }
 // ------------------------------------ //
 void
@@ -172,54 +322,277 @@ void
 {
     LOG_INFO("ThriveServer spawning player");
 
+    // New players join the first shard
+    WorldShard& shard = *m_impl->m_shards.front();
+    m_impl->setPlayerShard(player->GetID(), &shard);
+
+    shard.queueTask([this, player](WorldShard& shard) {
+        _spawnPlayerInShard(shard, player);
+    });
+}
+
+void
+    ThriveServer::removePlayer(int32_t playerId)
+{
+    WorldShard* shard = m_impl->findPlayerShard(playerId);
+
+    if(!shard)
+        return;
+
+    LOG_INFO("ThriveServer: removing player " + std::to_string(playerId));
+
+    // This also stops a move to another patch that is in progress
+    m_impl->setPlayerShard(playerId, nullptr);
+
+    shard->queueTask(
+        [playerId](WorldShard& shard) { shard.removePlayer(playerId); });
+}
+
+WorldShard*
+    ThriveServer::getPlayerShard(int32_t playerId)
+{
+    return m_impl->findPlayerShard(playerId);
+}
+
+bool
+    ThriveServer::movePlayerToPatch(int32_t playerId, int32_t patchId)
+{
+    WorldShard* source = m_impl->findPlayerShard(playerId);
+    WorldShard* target = m_impl->findPatchShard(patchId);
+
+    if(!source) {
+        LOG_ERROR("ThriveServer: can't move unknown player: " +
+                  std::to_string(playerId));
+        return false;
+    }
+
+    if(!target) {
+        LOG_ERROR("ThriveServer: no shard simulates patch: " +
+                  std::to_string(patchId));
+        return false;
+    }
+
+    if(source == target)
+        return true;
+
+    LOG_INFO("ThriveServer: moving player " + std::to_string(playerId) +
+             " to patch " + std::to_string(patchId));
+
+    // Messages from the player go to the new shard from now on
+    m_impl->setPlayerShard(playerId, target);
+
+    // The cell is removed on the thread of the old shard and then the new
+    // shard spawns the player on its own thread
+    source->queueTask([this, playerId, target](WorldShard& shard) {
+        const auto player = shard.removePlayer(playerId);
+
+        if(!player)
+            return;
+
+        target->queueTask([this, player](WorldShard& shard) {
+            // The client needs to receive the new world before it can be
+            // given control of anything in it
+            shard.getWorld()->SetPlayerReceiveWorld(player);
+
+            _spawnPlayerInShard(shard, player);
+        });
+    });
+
+    return true;
+}
+
+bool
+    ThriveServer::_spawnPlayerInShard(WorldShard& shard,
+        const std::shared_ptr<Leviathan::ConnectedPlayer>& player)
+{
+    // The player left or moved on before this got to run
+    if(m_impl->findPlayerShard(player->GetID()) != &shard)
+        return false;
+
+    CellStageWorld& world = *shard.getWorld();
+
     ScriptRunningSetup setup;
     setup.SetEntrypoint("spawnPlayer_Server");
 
-    auto result = getMicrobeScripts()->ExecuteOnModule<ObjectID>(
-        setup, false, m_impl->m_cellStage.get());
+    auto result =
+        getMicrobeScripts()->ExecuteOnModule<ObjectID>(setup, false, &world);
 
     if(result.Result != SCRIPT_RUN_RESULT::Success) {
 
         LOG_ERROR(
             "Failed to run player spawn function: " + setup.Entryfunction);
-        return;
+        return false;
     }
 
     ObjectID playerEntity = result.Value;
 
     try {
-        m_impl->m_cellStage->GetComponent_Sendable(playerEntity);
+        world.GetComponent_Sendable(playerEntity);
     } catch(const Leviathan::NotFound&) {
-        LEVIATHAN_ASSERT(
-            false, "spawn player on server didn't create sendable component");
+        LEVIATHAN_ASSERT(false,
+            "spawn player on server didn't create sendable component");
     }
 
     try {
-        m_impl->m_cellStage->GetComponent_MembraneComponent(playerEntity);
+        world.GetComponent_MembraneComponent(playerEntity);
     } catch(const Leviathan::NotFound&) {
-        LEVIATHAN_ASSERT(
-            false, "spawn player on server didn't create membrane component");
+        LEVIATHAN_ASSERT(false,
+            "spawn player on server didn't create membrane component");
+    }
+
+    world.SetLocalControl(playerEntity, true, player->GetConnection());
+
+    // Like in single player the player species is added to the patch they
+    // are in
+    const auto map = world.GetPatchManager().getCurrentMap();
+    const auto playerSpecies = map->findSpeciesByName("Default");
+
+    if(playerSpecies && map->getCurrentPatch()->addSpecies(playerSpecies, 0))
+        LOG_INFO("Player species added to patch " +
+                 std::to_string(shard.getPatchId()));
+
+    shard.addPlayer(player->GetID(), player, playerEntity);
+    return true;
+}
+
+const std::vector<ShardStats>&
+    ThriveServer::getLastShardStats() const
+{
+    return m_impl->m_lastShardStats;
+}
+
+WorldShard*
+    ThriveServer::getShardForWorld(int32_t worldId)
+{
+    for(const auto& shard : m_impl->m_shards) {
+        if(shard->getWorld()->GetID() == worldId)
+            return shard.get();
     }
 
-    m_impl->m_cellStage->SetLocalControl(
-        playerEntity, true, player->GetConnection());
+    return nullptr;
 }
 // ------------------------------------ //
 CellStageWorld*
     ThriveServer::getCellStage()
 {
-    return m_impl->m_cellStage.get();
+    return getCellStageShared().get();
 }
 
 std::shared_ptr<CellStageWorld>
     ThriveServer::getCellStageShared()
 {
-    return m_impl->m_cellStage;
+    if(m_impl->m_shards.empty())
+        return nullptr;
+
+    return m_impl->m_shards.front()->getWorld();
+}
+
+WorldShard*
+    ThriveServer::getCellStageShard()
+{
+    if(m_impl->m_shards.empty())
+        return nullptr;
+
+    return m_impl->m_shards.front().get();
 }
 // ------------------------------------ //
 void
     ThriveServer::Tick(float elapsed)
-{}
+{
+    if(!m_impl || m_impl->m_shards.empty())
+        return;
+
+    // The shards tick themselves on their own threads. This only reports how
+    // they are doing
+    m_impl->m_timeSinceTickReport += elapsed;
+
+    if(m_impl->m_timeSinceTickReport < TICK_STATS_REPORT_INTERVAL)
+        return;
+
+    m_impl->m_timeSinceTickReport = 0;
+    m_impl->m_lastShardStats.clear();
+
+    for(const auto& shard : m_impl->m_shards) {
+
+        const auto stats = shard->takeStats();
+        m_impl->m_lastShardStats.push_back(stats);
+
+        const auto message =
+            "ThriveServer: shard " + std::to_string(shard->getPatchId()) +
+            ": players: " + std::to_string(stats.players) +
+            ", ticks: " + std::to_string(stats.ticks.ticks) +
+            ", overran: " + std::to_string(stats.ticks.overrunTicks) +
+            ", dropped: " + std::to_string(stats.ticks.droppedTicks) +
+            ", average: " +
+            std::to_string(stats.ticks.getAverageTickMilliseconds()) +
+            "ms, max: " +
+            std::to_string(
+                std::chrono::duration<float, std::milli>(
+                    stats.ticks.maxTickTime)
+                    .count()) +
+            "ms, cpu: " + std::to_string(stats.getCpuUsage() * 100) +
+            "%, cloud stream bytes: " + std::to_string(stats.cloudStreamBytes) +
+            ", entity states: " + std::to_string(stats.entityStates) +
+            ", entity state bytes: " + std::to_string(stats.entityStateBytes);
+
+        if(stats.ticks.overrunTicks > 0 || stats.ticks.droppedTicks > 0) {
+            LOG_WARNING(message);
+        } else {
+            LOG_INFO(message);
+        }
+
+        std::string systems;
+
+        for(const auto& system : stats.systems) {
+            systems += "\n  " + system.name +
+                       ": average: " + std::to_string(system.average) +
+                       "ms, max: " + std::to_string(system.max) + "ms";
+        }
+
+        if(!systems.empty())
+            LOG_INFO("ThriveServer: shard " +
+                     std::to_string(shard->getPatchId()) +
+                     " system times:" + systems);
+    }
+}
+
+void
+    ThriveServer::_applyTickSettings()
+{
+    int tickRate = DEFAULT_SERVER_TICK_RATE;
+    int maxCatchUp = DEFAULT_SERVER_MAX_CATCH_UP_TICKS;
+    int shards = DEFAULT_SERVER_WORLD_SHARDS;
+
+    {
+        GameConfiguration* configuration = GameConfiguration::Get();
+        GUARD_LOCK_OTHER(configuration);
+        NamedVars* vars = configuration->AccessVariables(guard);
+
+        vars->GetValueAndConvertTo<int>("ServerTickRate", tickRate);
+        vars->GetValueAndConvertTo<int>("ServerMaxCatchUpTicks", maxCatchUp);
+        vars->GetValueAndConvertTo<int>("ServerWorldShards", shards);
+    }
+
+    if(tickRate < 1 || maxCatchUp < 1) {
+        LOG_WARNING("ThriveServer: invalid tick settings in configuration, "
+                    "using defaults");
+        tickRate = DEFAULT_SERVER_TICK_RATE;
+        maxCatchUp = DEFAULT_SERVER_MAX_CATCH_UP_TICKS;
+    }
+
+    if(shards < 1) {
+        LOG_WARNING("ThriveServer: invalid world shard count in "
+                    "configuration, using default");
+        shards = DEFAULT_SERVER_WORLD_SHARDS;
+    }
+
+    m_impl->m_tickRate = tickRate;
+    m_impl->m_maxCatchUpTicks = maxCatchUp;
+    m_impl->m_shardCount = shards;
+
+    LOG_INFO("ThriveServer: ticking worlds " + std::to_string(tickRate) +
+             " times per second");
+}
 
 void
     ThriveServer::CustomizeEnginePostLoad()
@@ -248,24 +621,54 @@ void
         return;
     }
 
+    // The clients receive data in these
+    registerThrivePackets();
+
+    {
+        GameConfiguration* configuration = GameConfiguration::Get();
+        GUARD_LOCK_OTHER(configuration);
+        NamedVars* vars = configuration->AccessVariables(guard);
+
+        vars->GetValueAndConvertTo<std::string>(
+            "ServerTraceFile", m_impl->m_traceFile);
+    }
+
+    if(!m_impl->m_traceFile.empty()) {
+        LOG_INFO("ThriveServer: recording a trace to: " + m_impl->m_traceFile);
+        Tracer::setThreadName("Main");
+        Tracer::start();
+    }
+
     setupServerWorlds();
 }
 // ------------------------------------ //
 void
     ThriveServer::EnginePreShutdown()
 {
+    if(Tracer::isRecording()) {
+        Tracer::stop();
+
+        if(!Tracer::writeChromeTrace(m_impl->m_traceFile))
+            LOG_ERROR(
+                "ThriveServer: failed to write trace: " + m_impl->m_traceFile);
+    }
+
+    // The worlds can't be ticking while they are released
+    for(const auto& shard : m_impl->m_shards)
+        shard->stop();
+
     // Shutdown scripting first to allow it to still do anything it wants //
     releaseScripts();
 
-    if(m_impl->m_cellStage != nullptr)
-        m_impl->m_cellStage->Release();
+    for(const auto& shard : m_impl->m_shards)
+        shard->getWorld()->Release();
 
     // And garbage collect //
     // This is needed here as otherwise script destructors might use the deleted
     // world
     Leviathan::ScriptExecutor::Get()->CollectGarbage();
 
-    m_impl->m_cellStage.reset();
+    m_impl->m_shards.clear();
 
     m_impl.reset();
 
@@ -284,6 +687,32 @@ void
         vars->AddVar("DefaultServerPort", new VariableBlock(int(53226)));
         configobj->MarkModified(guard);
     }
+
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<int>("ServerTickRate")) {
+        vars->AddVar("ServerTickRate",
+            new VariableBlock(int(DEFAULT_SERVER_TICK_RATE)));
+        configobj->MarkModified(guard);
+    }
+
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<int>(
+           "ServerMaxCatchUpTicks")) {
+        vars->AddVar("ServerMaxCatchUpTicks",
+            new VariableBlock(int(DEFAULT_SERVER_MAX_CATCH_UP_TICKS)));
+        configobj->MarkModified(guard);
+    }
+
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<int>("ServerWorldShards")) {
+        vars->AddVar("ServerWorldShards",
+            new VariableBlock(int(DEFAULT_SERVER_WORLD_SHARDS)));
+        configobj->MarkModified(guard);
+    }
+
+    // Empty to not record a trace
+    if(vars->ShouldAddValueIfNotFoundOrWrongType<std::string>(
+           "ServerTraceFile")) {
+        vars->AddVar("ServerTraceFile", new VariableBlock(std::string("")));
+        configobj->MarkModified(guard);
+    }
 }
 
 void
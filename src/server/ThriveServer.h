@@ -8,9 +8,13 @@
 
 #include "Application/ServerApplication.h"
 
+#include <vector>
+
 namespace thrive {
 
 class CellStageWorld;
+class WorldShard;
+struct ShardStats;
 
 //! This is the main thrive server class that is created in main.cpp and then
 //! handles running the engine and the event loop
@@ -26,16 +30,50 @@ public:
     void
         setupServerWorlds();
 
+    //! \returns The world of the first shard. New players join this
     CellStageWorld*
         getCellStage();
 
     std::shared_ptr<CellStageWorld>
         getCellStageShared();
 
+    //! \returns The first shard or null
+    WorldShard*
+        getCellStageShard();
+
+    //! \returns The shard with the world or null
+    WorldShard*
+        getShardForWorld(int32_t worldId);
 
+    //! \brief Adds a player to the first shard. The cell is spawned on the
+    //! thread of the shard
     void
         spawnPlayer(const std::shared_ptr<Leviathan::ConnectedPlayer>& player);
 
+    //! \brief Removes a disconnected player from their shard and destroys
+    //! their cell
+    void
+        removePlayer(int32_t playerId);
+
+    //! \returns The shard the player is in or is moving to, or null
+    //! \note Can be called from any thread
+    WorldShard*
+        getPlayerShard(int32_t playerId);
+
+    //! \brief Moves a player to the shard simulating a patch
+    //!
+    //! The player's cell is destroyed in the old world and a new one is
+    //! spawned in the new world. Both happen on the threads of the shards.
+    //! Clients request this with MOVE_TO_PATCH_COMMAND when they move to a
+    //! patch in the editor
+    //! \returns False if the player or the patch isn't found
+    bool
+        movePlayerToPatch(int32_t playerId, int32_t patchId);
+
+    //! \returns The statistics of each shard printed in the last report
+    const std::vector<ShardStats>&
+        getLastShardStats() const;
+
 
     // ------------------------------------ //
     // Hooking into the engine, and overridden methods from base application
@@ -68,6 +106,20 @@ public:
         InitLoadCustomScriptTypes(asIScriptEngine* engine) override;
 
 private:
+    //! \brief Reads the tick rate settings from the configuration
+    void
+        _applyTickSettings();
+
+    //! \brief Creates and sets up a world for simulating a patch
+    //! \returns False on failure
+    bool
+        _createShard(int32_t patchId);
+
+    //! \note Needs to be called on the thread of the shard
+    bool
+        _spawnPlayerInShard(WorldShard& shard,
+            const std::shared_ptr<Leviathan::ConnectedPlayer>& player);
+
 protected:
     Leviathan::NetworkInterface*
         _GetApplicationPacketHandler() override;
@@ -2,9 +2,61 @@
 #include "thrive_server_net_handler.h"
 
 #include "ThriveServer.h"
+#include "thrive_net_handler.h"
+#include "world_shard.h"
+
 #include "generated/cell_stage_world.h"
+#include "thrive_packets.h"
+
+#include <Networking/CommandHandler.h>
+#include <Networking/ConnectedPlayer.h>
+#include <Networking/Connection.h>
+#include <Networking/NetworkRequest.h>
+#include <Networking/NetworkResponse.h>
+
+#include <sstream>
+
 using namespace thrive;
 // ------------------------------------ //
+namespace {
+
+//! \brief Handles MOVE_TO_PATCH_COMMAND from the players
+class MoveToPatchCommandHandler : public Leviathan::CustomCommandHandler {
+public:
+    bool
+        CanHandleCommand(const std::string& cmd) const override
+    {
+        return cmd == MOVE_TO_PATCH_COMMAND;
+    }
+
+    void
+        ExecuteCommand(const std::string& wholecommand,
+            Leviathan::CommandSender* sender) override
+    {
+        auto player = dynamic_cast<Leviathan::ConnectedPlayer*>(sender);
+
+        if(!player) {
+            LOG_WARNING("ThriveServerNetHandler: patch move command not "
+                        "sent by a player");
+            return;
+        }
+
+        std::istringstream stream(wholecommand);
+        std::string command;
+        int32_t patchId;
+
+        if(!(stream >> command >> patchId)) {
+            LOG_WARNING("ThriveServerNetHandler: invalid patch move command: " +
+                        wholecommand);
+            return;
+        }
+
+        ThriveServer::get()->movePlayerToPatch(player->GetID(), patchId);
+    }
+};
+
+} // namespace
+// ------------------------------------ //
 ThriveServerNetHandler::ThriveServerNetHandler() :
     NetworkServerInterface(10,
         "Thrive multiplayer prototype server",
@@ -13,6 +65,98 @@ ThriveServerNetHandler::ThriveServerNetHandler() :
 
 ThriveServerNetHandler::~ThriveServerNetHandler() {}
 // ------------------------------------ //
+void
+    ThriveServerNetHandler::HandleRequestPacket(
+        std::shared_ptr<Leviathan::NetworkRequest> request,
+        Leviathan::Connection& connection)
+{
+    // Joining sends the world to the player, so the world can't be ticking
+    // at the same time
+    if(request->GetType() == Leviathan::NETWORK_REQUEST_TYPE::JoinGame) {
+
+        const auto player = GetPlayerForConnection(connection);
+        auto* shard = ThriveServer::get()->getCellStageShard();
+
+        if(player && shard) {
+            shard->queueTask([this, request, player](WorldShard&) {
+                NetworkServerInterface::HandleRequestPacket(
+                    request, *player->GetConnection());
+            });
+            return;
+        }
+    }
+
+    NetworkServerInterface::HandleRequestPacket(request, connection);
+}
+
+void
+    ThriveServerNetHandler::HandleResponseOnlyPacket(
+        std::shared_ptr<Leviathan::NetworkResponse> message,
+        Leviathan::Connection& connection)
+{
+    // The players send the state of the cells they control
+    if(message->GetType() == Leviathan::NETWORK_RESPONSE_TYPE::EntityUpdate) {
+
+        const auto player = GetPlayerForConnection(connection);
+        auto* shard =
+            player ? ThriveServer::get()->getPlayerShard(player->GetID()) :
+                     nullptr;
+
+        if(shard) {
+            shard->queueTask([this, message, player](WorldShard&) {
+                NetworkServerInterface::HandleResponseOnlyPacket(
+                    message, *player->GetConnection());
+            });
+            return;
+        }
+    }
+
+    const auto* packet = getThrivePacket(*message);
+
+    if(packet) {
+
+        if(packet->getType() != THRIVE_PACKET_TYPE::ENTITY_STATES_ACK) {
+            LOG_WARNING("ThriveServerNetHandler: unexpected Thrive packet "
+                        "type from a client: " +
+                        std::to_string(static_cast<int>(packet->getType())));
+            return;
+        }
+
+        const auto player = GetPlayerForConnection(connection);
+        auto* shard =
+            player ? ThriveServer::get()->getPlayerShard(player->GetID()) :
+                     nullptr;
+
+        if(!shard)
+            return;
+
+        uint32_t sequence;
+
+        try {
+            sequence = readEntityStatesAck(*packet);
+        } catch(const Leviathan::InvalidArgument&) {
+            LOG_WARNING("ThriveServerNetHandler: invalid entity state "
+                        "acknowledgement");
+            return;
+        }
+
+        shard->queueTask([id = player->GetID(), sequence](WorldShard& shard) {
+            shard.acknowledgeEntityStates(id, sequence);
+        });
+        return;
+    }
+
+    NetworkServerInterface::HandleResponseOnlyPacket(message, connection);
+}
+// ------------------------------------ //
+void
+    ThriveServerNetHandler::RegisterCustomCommandHandlers(
+        Leviathan::CommandHandler* addhere)
+{
+    addhere->RegisterCustomCommandHandler(
+        std::make_shared<MoveToPatchCommandHandler>());
+}
+// ------------------------------------ //
 std::shared_ptr<GameWorld>
     ThriveServerNetHandler::_GetWorldForJoinTarget(const std::string& options)
 {
@@ -22,9 +166,9 @@ std::shared_ptr<GameWorld>
 GameWorld*
     ThriveServerNetHandler::_GetWorldForEntityMessage(int32_t worldid)
 {
-    auto world = ThriveServer::get()->getCellStage();
+    auto shard = ThriveServer::get()->getShardForWorld(worldid);
 
-    if(world->GetID() != worldid) {
+    if(!shard) {
 
         LOG_ERROR(
             "ThriveServerNetHandler: got request for non-cellstage world id: " +
@@ -32,7 +176,9 @@ GameWorld*
         return nullptr;
     }
 
-    return world;
+    // The entity messages are handed to the threads of the shards, so this is
+    // called between the ticks of the world
+    return shard->getWorld().get();
 }
 
 void
@@ -42,3 +188,10 @@ void
 {
     return ThriveServer::get()->spawnPlayer(player);
 }
+
+void
+    ThriveServerNetHandler::_OnPlayerDisconnect(
+        const std::shared_ptr<Leviathan::ConnectedPlayer>& player)
+{
+    ThriveServer::get()->removePlayer(player->GetID());
+}
@@ -15,7 +15,24 @@ public:
     ThriveServerNetHandler();
     virtual ~ThriveServerNetHandler();
 
+    //! \brief Hands join requests to the thread of the first shard
+    void
+        HandleRequestPacket(std::shared_ptr<Leviathan::NetworkRequest> request,
+            Leviathan::Connection& connection) override;
+
+    //! \brief Hands the entity updates and the entity state acknowledgements
+    //! of the players to the threads of their shards
+    void
+        HandleResponseOnlyPacket(
+            std::shared_ptr<Leviathan::NetworkResponse> message,
+            Leviathan::Connection& connection) override;
+
 protected:
+    //! \brief Adds the handler for the patch move requests of the clients
+    void
+        RegisterCustomCommandHandlers(
+            Leviathan::CommandHandler* addhere) override;
+
     std::shared_ptr<GameWorld>
         _GetWorldForJoinTarget(const std::string& options) override;
 
@@ -26,5 +43,10 @@ protected:
         _OnPlayerJoinedWorld(
             const std::shared_ptr<Leviathan::ConnectedPlayer>& player,
             const std::shared_ptr<GameWorld>& world) override;
+
+    //! \brief Removes the player from their shard
+    void
+        _OnPlayerDisconnect(
+            const std::shared_ptr<Leviathan::ConnectedPlayer>& player) override;
 };
 } // namespace thrive
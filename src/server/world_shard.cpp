@@ -0,0 +1,373 @@
+// ------------------------------------ //
+#include "world_shard.h"
+
+#include "engine/tracing.h"
+#include "generated/cell_stage_world.h"
+#include "thrive_packets.h"
+
+#include <Exceptions.h>
+#include <Networking/ConnectedPlayer.h>
+#include <Networking/Connection.h>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+using namespace thrive;
+// ------------------------------------ //
+//! Players are sent entities this close to their cell
+constexpr auto PLAYER_INTEREST_RADIUS = 250.f;
+
+//! Entity state bytes per second each player is allowed
+constexpr auto PLAYER_UPDATE_BANDWIDTH = 24000;
+
+//! The other players' cells gain priority this much faster than the other
+//! entities, so the players always see what the others are doing
+constexpr auto PLAYER_ENTITY_PRIORITY = 4.f;
+
+namespace {
+
+//! \returns The CPU time used by the calling thread or a negative value if
+//! that can't be measured on this platform
+std::chrono::nanoseconds
+    threadCpuTime()
+{
+#ifdef __linux__
+    timespec time;
+
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0)
+        return std::chrono::seconds(time.tv_sec) +
+               std::chrono::nanoseconds(time.tv_nsec);
+#endif //__linux__
+
+    return std::chrono::nanoseconds(-1);
+}
+
+} // namespace
+// ------------------------------------ //
+WorldShard::WorldShard(int32_t patchId,
+    const std::shared_ptr<CellStageWorld>& world,
+    float tickRate,
+    int maxCatchUpTicks) :
+    m_patchId(patchId),
+    m_world(world), m_ticker(tickRate, maxCatchUpTicks)
+{
+    if(!world)
+        throw Leviathan::InvalidArgument("shard needs a world");
+}
+
+WorldShard::~WorldShard()
+{
+    stop();
+}
+// ------------------------------------ //
+void
+    WorldShard::start()
+{
+    if(m_thread.joinable())
+        throw Leviathan::InvalidState("shard is already running");
+
+    m_stopThread = false;
+    m_thread = std::thread(&WorldShard::_runThread, this);
+}
+
+void
+    WorldShard::stop()
+{
+    if(!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        m_stopThread = true;
+    }
+
+    m_wakeUp.notify_all();
+    m_thread.join();
+}
+
+void
+    WorldShard::queueTask(Task task)
+{
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_tasks.push_back(std::move(task));
+}
+// ------------------------------------ //
+int
+    WorldShard::update()
+{
+    return update(FixedRateTicker::Clock::now());
+}
+
+int
+    WorldShard::update(FixedRateTicker::Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_updateMutex);
+
+    if(!m_statsStarted) {
+        m_statsStarted = true;
+        m_statsStart = now;
+    }
+
+    const auto cpuStart = threadCpuTime();
+
+    const auto ticks =
+        m_ticker.update(now, [this](float elapsed) { _tick(elapsed); });
+
+    // Without a thread CPU clock takeStats uses the tick times
+    if(cpuStart.count() >= 0 && m_cpuTime.count() >= 0) {
+        m_cpuTime += threadCpuTime() - cpuStart;
+    } else {
+        m_cpuTime = std::chrono::nanoseconds(-1);
+    }
+
+    return ticks;
+}
+// ------------------------------------ //
+void
+    WorldShard::addPlayer(int32_t playerId,
+        const std::shared_ptr<Leviathan::ConnectedPlayer>& player,
+        ObjectID entity)
+{
+    m_players[playerId] = Player{player, entity};
+}
+
+std::shared_ptr<Leviathan::ConnectedPlayer>
+    WorldShard::removePlayer(int32_t playerId)
+{
+    const auto found = m_players.find(playerId);
+
+    if(found == m_players.end())
+        return nullptr;
+
+    const auto player = found->second;
+    m_players.erase(found);
+
+    m_world->QueueDestroyEntity(player.entity);
+    m_cloudStream.removePlayer(playerId);
+    m_interest.removeObserver(playerId);
+    m_baselines.removeObserver(playerId);
+
+    return player.connection;
+}
+
+bool
+    WorldShard::hasPlayer(int32_t playerId) const
+{
+    return m_players.find(playerId) != m_players.end();
+}
+
+void
+    WorldShard::acknowledgeEntityStates(int32_t playerId, uint32_t sequence)
+{
+    if(hasPlayer(playerId))
+        m_baselines.acknowledge(playerId, sequence);
+}
+// ------------------------------------ //
+ShardStats
+    WorldShard::takeStats()
+{
+    return takeStats(FixedRateTicker::Clock::now());
+}
+
+ShardStats
+    WorldShard::takeStats(FixedRateTicker::Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_updateMutex);
+
+    ShardStats stats;
+    stats.ticks = m_ticker.getStats();
+    stats.players = m_players.size();
+    stats.cloudStreamBytes = m_cloudStreamBytes;
+    stats.entityStates = m_entityStates;
+    stats.entityStateBytes = m_entityStateBytes;
+    stats.systems = m_world->GetSystemProfiler().getStats();
+
+    if(m_statsStarted)
+        stats.wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now - m_statsStart);
+
+    stats.cpuTime = m_cpuTime.count() >= 0 ? m_cpuTime :
+                                             stats.ticks.totalTickTime;
+
+    m_ticker.resetStats();
+    m_statsStart = now;
+    m_cloudStreamBytes = 0;
+    m_entityStates = 0;
+    m_entityStateBytes = 0;
+
+    if(m_cpuTime.count() >= 0)
+        m_cpuTime = std::chrono::nanoseconds(0);
+
+    return stats;
+}
+// ------------------------------------ //
+void
+    WorldShard::_runThread()
+{
+    Tracer::setThreadName("Shard " + std::to_string(m_patchId));
+
+    while(!m_stopThread) {
+
+        update();
+
+        std::unique_lock<std::mutex> lock(m_tasksMutex);
+
+        m_wakeUp.wait_for(lock,
+            m_ticker.getTimeUntilNextTick(FixedRateTicker::Clock::now()),
+            [this]() { return m_stopThread.load(); });
+    }
+}
+
+void
+    WorldShard::_runTasks()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        m_runningTasks.swap(m_tasks);
+    }
+
+    for(const auto& task : m_runningTasks)
+        task(*this);
+
+    m_runningTasks.clear();
+}
+
+void
+    WorldShard::_tick(float elapsed)
+{
+    TraceZone zone("WorldShard::tick");
+
+    // The changes from the network are applied between the ticks
+    _runTasks();
+
+    const auto start = SystemProfiler::Clock::now();
+
+    m_world->Tick(elapsed);
+
+    // The time the systems didn't time is mostly the script systems
+    m_world->GetSystemProfiler().addTickTotal(
+        SystemProfiler::Clock::now() - start);
+
+    _streamClouds(elapsed);
+    _replicateEntities(elapsed);
+}
+
+void
+    WorldShard::_streamClouds(float elapsed)
+{
+    m_cloudStreamPlayers.clear();
+
+    for(const auto& [playerId, player] : m_players) {
+
+        const auto* position = m_world->GetComponentPtr_Position(player.entity);
+
+        if(position)
+            m_cloudStreamPlayers.emplace_back(
+                playerId, position->Members._Position);
+    }
+
+    m_cloudStream.update(m_world->GetCompoundCloudSystem(), elapsed,
+        m_cloudStreamPlayers,
+        [this](int32_t playerId, const std::string& message) {
+            const auto found = m_players.find(playerId);
+
+            if(found == m_players.end())
+                return;
+
+            m_cloudStreamBytes += message.size();
+
+            // The deltas build on each other so these can't be lost
+            found->second.connection->GetConnection()->SendPacketToConnection(
+                makeThrivePacket(THRIVE_PACKET_TYPE::CLOUD_STREAM, message),
+                Leviathan::RECEIVE_GUARANTEE::Critical);
+        });
+}
+
+void
+    WorldShard::_replicateEntities(float elapsed)
+{
+    if(m_players.empty())
+        return;
+
+    auto& world = *m_world;
+
+    m_replicatedEntities.clear();
+
+    const auto& sendable = world.GetComponentIndex_Sendable();
+
+    for(auto iter = sendable.begin(); iter != sendable.end(); ++iter) {
+
+        const auto* position = world.GetComponentPtr_Position(iter->first);
+
+        if(!position)
+            continue;
+
+        ReplicatedEntity entity;
+        entity.entity = iter->first;
+        entity.position = position->Members._Position;
+
+        for(const auto& [playerId, player] : m_players) {
+            if(player.entity == iter->first) {
+                entity.priority = PLAYER_ENTITY_PRIORITY;
+                break;
+            }
+        }
+
+        m_replicatedEntities.push_back(entity);
+    }
+
+    m_interest.setEntities(m_replicatedEntities);
+
+    const auto budget = static_cast<uint32_t>(
+        PLAYER_UPDATE_BANDWIDTH * m_ticker.getTickInterval());
+
+    ++m_entityStateSequence;
+
+    for(const auto& [playerId, player] : m_players) {
+
+        const auto* playerPosition =
+            world.GetComponentPtr_Position(player.entity);
+
+        if(!playerPosition)
+            continue;
+
+        m_interest.updateObserver(playerId, playerPosition->Members._Position,
+            PLAYER_INTEREST_RADIUS, budget);
+
+        m_selected.clear();
+        m_left.clear();
+        m_interest.selectUpdates(playerId, elapsed, m_selected, m_left);
+
+        m_states.clear();
+
+        for(ObjectID entity : m_selected) {
+
+            // The player controls their own cell
+            if(entity == player.entity)
+                continue;
+
+            const auto& position = world.GetComponent_Position(entity);
+
+            m_states.emplace_back(entity, std::string());
+            encodeTransformState(position.Members._Position,
+                position.Members._Orientation, std::get<1>(m_states.back()));
+        }
+
+        if(m_states.empty() && m_left.empty())
+            continue;
+
+        m_baselines.encodeMessage(playerId, m_entityStateSequence, m_states,
+            m_left, m_entityStateMessage);
+
+        m_entityStates += m_states.size();
+        m_entityStateBytes += m_entityStateMessage.size();
+
+        // Lost messages are fine as only acknowledged states are used as
+        // baselines
+        player.connection->GetConnection()->SendPacketToConnection(
+            makeThrivePacket(
+                THRIVE_PACKET_TYPE::ENTITY_STATES, m_entityStateMessage),
+            Leviathan::RECEIVE_GUARANTEE::None);
+    }
+}
@@ -0,0 +1,243 @@
+// Thrive Game
+// Copyright (C) 2013-2018  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+#include "engine/fixed_rate_ticker.h"
+#include "engine/replication.h"
+#include "engine/system_profiler.h"
+#include "microbe_stage/cloud_streaming.h"
+
+#include <Entities/EntityCommon.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Leviathan {
+class ConnectedPlayer;
+}
+
+namespace thrive {
+
+class CellStageWorld;
+
+//! \brief Statistics about one WorldShard
+struct ShardStats {
+    TickerStats ticks;
+
+    //! CPU time used by the worker thread of the shard
+    std::chrono::nanoseconds cpuTime = std::chrono::nanoseconds(0);
+
+    //! The time these statistics cover
+    std::chrono::nanoseconds wallTime = std::chrono::nanoseconds(0);
+
+    size_t players = 0;
+
+    //! Bytes of compound cloud updates sent to the players
+    uint64_t cloudStreamBytes = 0;
+
+    //! Entity states sent to the players and their size in bytes
+    uint64_t entityStates = 0;
+    uint64_t entityStateBytes = 0;
+
+    //! Run times of the systems of the world over the recent ticks
+    std::vector<SystemTimingStats> systems;
+
+    //! \returns The fraction of one core the shard used
+    float
+        getCpuUsage() const
+    {
+        if(wallTime.count() <= 0)
+            return 0;
+
+        return static_cast<float>(cpuTime.count()) / wallTime.count();
+    }
+};
+
+/**
+ * @brief One cell stage world of the server, ticked on its own thread
+ *
+ * Each shard simulates one patch with its own fixed rate ticker and
+ * statistics. The players in the shard receive the entities and the
+ * compound clouds of only this world. After each tick every player is sent the
+ * states of the entities picked for them by a ReplicationInterestManager,
+ * delta compressed against the states they have acknowledged.
+ *
+ * Once started the world belongs to the worker thread of the shard. Other
+ * threads, like the main thread that handles the network messages, must not
+ * touch the world. They queue tasks instead, which the worker runs at the
+ * start of its next tick.
+ */
+class WorldShard {
+public:
+    //! \brief Work for the worker thread. Gets the shard it runs in
+    using Task = std::function<void(WorldShard& shard)>;
+
+    //! \exception Leviathan::InvalidArgument if the tick settings are invalid
+    WorldShard(int32_t patchId,
+        const std::shared_ptr<CellStageWorld>& world,
+        float tickRate,
+        int maxCatchUpTicks);
+
+    //! \brief Stops the worker thread
+    ~WorldShard();
+
+    WorldShard(const WorldShard& other) = delete;
+    WorldShard&
+        operator=(const WorldShard& other) = delete;
+
+    //! \brief Starts the worker thread that ticks the world
+    //! \exception Leviathan::InvalidState if the thread is already running
+    void
+        start();
+
+    //! \brief Stops the worker thread and waits for it to finish its tick.
+    //! Queued tasks that haven't ran are kept
+    void
+        stop();
+
+    bool
+        isRunning() const
+    {
+        return m_thread.joinable();
+    }
+
+    //! \brief Queues a task to run before the next tick. Can be called from
+    //! any thread
+    void
+        queueTask(Task task);
+
+    //! \brief Runs the world ticks that are due
+    //!
+    //! The worker thread calls this. Without a started thread this can be
+    //! called directly
+    //! \returns The number of ticks that were ran
+    int
+        update();
+
+    //! \brief Version of update with a specific current time
+    int
+        update(FixedRateTicker::Clock::time_point now);
+
+    //! \brief Makes entity the cell of a player. The player is sent updates
+    //! from this shard from now on
+    //! \note This and the other player methods are for tasks
+    void
+        addPlayer(int32_t playerId,
+            const std::shared_ptr<Leviathan::ConnectedPlayer>& player,
+            ObjectID entity);
+
+    //! \brief Removes a player and destroys their cell
+    //! \returns The connection of the player or null if they weren't here
+    std::shared_ptr<Leviathan::ConnectedPlayer>
+        removePlayer(int32_t playerId);
+
+    bool
+        hasPlayer(int32_t playerId) const;
+
+    //! \brief Marks an entity state message as received by a player
+    void
+        acknowledgeEntityStates(int32_t playerId, uint32_t sequence);
+
+    //! \brief Returns the statistics since the last call and resets them
+    //!
+    //! Can be called from any thread. Waits for a running tick to end
+    ShardStats
+        takeStats();
+
+    //! \brief Version of takeStats with a specific current time
+    ShardStats
+        takeStats(FixedRateTicker::Clock::time_point now);
+
+    int32_t
+        getPatchId() const
+    {
+        return m_patchId;
+    }
+
+    const std::shared_ptr<CellStageWorld>&
+        getWorld() const
+    {
+        return m_world;
+    }
+
+private:
+    struct Player {
+        std::shared_ptr<Leviathan::ConnectedPlayer> connection;
+        ObjectID entity;
+    };
+
+    void
+        _runThread();
+
+    //! \brief Runs the queued tasks
+    void
+        _runTasks();
+
+    void
+        _tick(float elapsed);
+
+    //! \brief Sends the clouds near the players to them
+    void
+        _streamClouds(float elapsed);
+
+    //! \brief Sends the states of the entities picked for each player
+    void
+        _replicateEntities(float elapsed);
+
+private:
+    const int32_t m_patchId;
+    const std::shared_ptr<CellStageWorld> m_world;
+
+    FixedRateTicker m_ticker;
+
+    std::unordered_map<int32_t, Player> m_players;
+
+    CloudStreamServer m_cloudStream;
+
+    //! Reused for the positions of the players given to m_cloudStream
+    std::vector<std::tuple<int32_t, Float3>> m_cloudStreamPlayers;
+
+    ReplicationInterestManager m_interest;
+    EntityStateBaselines m_baselines;
+
+    //! Sequence number of the last entity state message
+    uint32_t m_entityStateSequence = 0;
+
+    //! Reused by _replicateEntities
+    std::vector<ReplicatedEntity> m_replicatedEntities;
+    std::vector<ObjectID> m_selected;
+    std::vector<ObjectID> m_left;
+    std::vector<std::tuple<ObjectID, std::string>> m_states;
+    std::string m_entityStateMessage;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopThread{false};
+
+    //! Held while updating. The statistics are read with this locked
+    std::mutex m_updateMutex;
+
+    //! Protects m_tasks. The worker waits on m_wakeUp between ticks
+    std::mutex m_tasksMutex;
+    std::condition_variable m_wakeUp;
+    std::vector<Task> m_tasks;
+
+    //! Swapped with m_tasks to run the tasks without holding the lock
+    std::vector<Task> m_runningTasks;
+
+    //! Statistics since the last takeStats call. The time starts from the
+    //! first update
+    std::chrono::nanoseconds m_cpuTime = std::chrono::nanoseconds(0);
+    uint64_t m_cloudStreamBytes = 0;
+    uint64_t m_entityStates = 0;
+    uint64_t m_entityStateBytes = 0;
+    FixedRateTicker::Clock::time_point m_statsStart;
+    bool m_statsStarted = false;
+};
+
+} // namespace thrive
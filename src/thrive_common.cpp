@@ -207,42 +207,6 @@ void
         "cellHitDamageChunk");
 }
 // ------------------------------------ //
-// Agent on cell
-//! \brief Used to skip agents hitting cells of their own species
-bool
-    agentCallback(Leviathan::PhysicalWorld& physicalWorld,
-        Leviathan::PhysicsBody& first,
-        Leviathan::PhysicsBody& second)
-{
-    GameWorld* gameWorld = physicalWorld.GetGameWorld();
-
-    // Now we can do more interetsing things with agents
-    ScriptRunningSetup setup("hitAgent");
-
-    auto returned =
-        ThriveCommon::get()->getMicrobeScripts()->ExecuteOnModule<bool>(setup,
-            false, gameWorld, first.GetOwningEntity(),
-            second.GetOwningEntity());
-
-    if(returned.Result != SCRIPT_RUN_RESULT::Success) {
-        LOG_ERROR("Failed to run script side hitAgent");
-        return true;
-    }
-
-    return returned.Value;
-}
-
-void
-    agentCollidedManifold(Leviathan::PhysicalWorld& physicalWorld,
-        Leviathan::PhysicsBody& first,
-        Leviathan::PhysicsBody& second,
-        const btPersistentManifold& manifold)
-{
-    cellHitSomethingElseManifoldHelper(first, second, manifold,
-        ThriveCommon::get()->getMicrobeScripts(), physicalWorld.GetGameWorld(),
-        "cellHitAgent");
-}
-// ------------------------------------ //
 // Cell on cell
 //! \todo This should return false when either cell is engulfing and apply the
 //! damaging effect
@@ -341,8 +305,6 @@ std::unique_ptr<Leviathan::PhysicsMaterialManager>
     // Setup materials
     auto cellMaterial =
         std::make_unique<Leviathan::PhysicalMaterial>("cell", 1);
-    auto agentMaterial =
-        std::make_unique<Leviathan::PhysicalMaterial>("agentCollision", 3);
     auto engulfableMaterial =
         std::make_unique<Leviathan::PhysicalMaterial>("engulfableMaterial", 4);
     auto chunkDamageMaterial =
@@ -356,10 +318,6 @@ std::unique_ptr<Leviathan::PhysicsMaterialManager>
     cellMaterial->FormPairWith(*chunkDamageMaterial)
         .SetCallbacks(nullptr, nullptr, cellHitDamageChunkManifold);
 
-    // Agents
-    cellMaterial->FormPairWith(*agentMaterial)
-        .SetCallbacks(agentCallback, nullptr, agentCollidedManifold);
-
     // Engulfing and stabbing
     cellMaterial->FormPairWith(*cellMaterial)
         .SetCallbacks(
@@ -368,7 +326,6 @@ std::unique_ptr<Leviathan::PhysicsMaterialManager>
     auto manager = std::make_unique<Leviathan::PhysicsMaterialManager>();
 
     manager->LoadedMaterialAdd(std::move(cellMaterial));
-    manager->LoadedMaterialAdd(std::move(agentMaterial));
     manager->LoadedMaterialAdd(std::move(engulfableMaterial));
     manager->LoadedMaterialAdd(std::move(chunkDamageMaterial));
 
@@ -16,6 +16,152 @@ ThriveJSInterface::~ThriveJSInterface() {}
         return true;                      \
     }
 // ------------------------------------ //
+//! The generic function for calling functions not known in the render process
+constexpr auto THRIVE_JS_CALL_FUNCTION = "call";
+
+namespace {
+
+//! \brief Puts value into list at index as type
+//! \returns False if value isn't of type
+bool
+    encodeArgument(CefListValue& list,
+        size_t index,
+        const CefRefPtr<CefV8Value>& value,
+        JS_ARGUMENT_TYPE type)
+{
+    switch(type) {
+    case JS_ARGUMENT_TYPE::BOOL:
+        if(!value->IsBool())
+            return false;
+
+        list.SetBool(index, value->GetBoolValue());
+        return true;
+    case JS_ARGUMENT_TYPE::INT:
+        if(!value->IsInt())
+            return false;
+
+        list.SetInt(index, value->GetIntValue());
+        return true;
+    case JS_ARGUMENT_TYPE::DOUBLE:
+        if(!value->IsDouble())
+            return false;
+
+        list.SetDouble(index, value->GetDoubleValue());
+        return true;
+    case JS_ARGUMENT_TYPE::STRING:
+        if(!value->IsString())
+            return false;
+
+        list.SetString(index, value->GetStringValue());
+        return true;
+    }
+
+    return false;
+}
+
+//! \brief Finds the type to send value as when the types are not known in
+//! the render process
+//! \returns False if value can't be sent
+bool
+    detectArgumentType(const CefRefPtr<CefV8Value>& value,
+        JS_ARGUMENT_TYPE& type)
+{
+    if(value->IsBool()) {
+        type = JS_ARGUMENT_TYPE::BOOL;
+    } else if(value->IsInt()) {
+        type = JS_ARGUMENT_TYPE::INT;
+    } else if(value->IsDouble()) {
+        type = JS_ARGUMENT_TYPE::DOUBLE;
+    } else if(value->IsString()) {
+        type = JS_ARGUMENT_TYPE::STRING;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+//! \returns False if a value in list has a type that can't be a JS argument
+bool
+    decodeArguments(CefListValue& list,
+        size_t first,
+        JSCallArguments& arguments)
+{
+    for(size_t i = first; i < list.GetSize(); ++i) {
+
+        switch(list.GetType(i)) {
+        case VTYPE_BOOL: arguments.add(list.GetBool(i)); break;
+        case VTYPE_INT:
+            arguments.add(static_cast<int32_t>(list.GetInt(i)));
+            break;
+        case VTYPE_DOUBLE: arguments.add(list.GetDouble(i)); break;
+        case VTYPE_STRING: arguments.add(list.GetString(i).ToString()); break;
+        default: return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+// ------------------------------------ //
+void
+    thrive::registerThriveJSFunctions(JSCallDispatcher& dispatcher)
+{
+    // Only the argument types are used in the render process. The handlers
+    // are only called in the main process
+    dispatcher.registerFunction(
+        "startNewGame", {}, [](const JSCallArguments& arguments) {
+            LOG_INFO("Got start game message from GUI process");
+            ThriveGame::Get()->startNewGame();
+        });
+
+    dispatcher.registerFunction(
+        "editorButtonClicked", {}, [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->editorButtonClicked();
+        });
+
+    dispatcher.registerFunction("freebuildEditorButtonClicked", {},
+        [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->enableFreebuild();
+            ThriveGame::Get()->editorButtonClicked();
+        });
+
+    dispatcher.registerFunction(
+        "finishEditingClicked", {}, [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->finishEditingClicked();
+        });
+
+    dispatcher.registerFunction(
+        "killPlayerCellClicked", {}, [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->killPlayerCellClicked();
+        });
+
+    dispatcher.registerFunction(
+        "exitToMenuClicked", {}, [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->exitToMenuClicked();
+        });
+
+    dispatcher.registerFunction("connectToServer", {JS_ARGUMENT_TYPE::STRING},
+        [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->connectToServer(arguments.getString(0));
+        });
+
+    dispatcher.registerFunction(
+        "disconnectFromServer", {}, [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->disconnectFromServer(true);
+        });
+
+    dispatcher.registerFunction("pause", {JS_ARGUMENT_TYPE::BOOL},
+        [](const JSCallArguments& arguments) {
+            ThriveGame::Get()->pause(arguments.getBool(0));
+        });
+
+    dispatcher.registerQuery("thriveVersion",
+        Leviathan::GUI::VIEW_SECURITYLEVEL_ACCESS_ALL,
+        []() { return std::string(Thrive_VERSIONS); });
+}
+// ------------------------------------ //
 bool
     ThriveJSInterface::ProcessQuery(
         Leviathan::GUI::LeviathanJavaScriptAsync* caller,
@@ -24,19 +170,30 @@ bool
         bool persists,
         CefRefPtr<Callback>& callback)
 {
-    // Do whatever to handle this //
-    if(request == "thriveVersion") {
-        // Check rights //
-        JS_ACCESSCHECKPTR(
-            Leviathan::GUI::VIEW_SECURITYLEVEL_ACCESS_ALL, caller);
-
-        // Return the result //
-        callback->Success(Thrive_VERSIONS);
-        return true;
-    }
+    ThriveGame* game = ThriveGame::Get();
+
+    if(!game)
+        return false;
+
+    auto& dispatcher = game->jsCalls();
+    const std::string name = request.ToString();
+
+    const auto securityLevel = dispatcher.getQuerySecurityLevel(name);
 
     // Not handled //
-    return false;
+    if(securityLevel < 0)
+        return false;
+
+    // Check rights //
+    JS_ACCESSCHECKPTR(
+        static_cast<Leviathan::GUI::VIEW_SECURITYLEVEL>(securityLevel), caller);
+
+    std::string result;
+    dispatcher.runQuery(name, result);
+
+    // Return the result //
+    callback->Success(result);
+    return true;
 }
 
 void
@@ -60,7 +217,9 @@ void
 // ThriveJSHandler
 ThriveJSHandler::ThriveJSHandler(Leviathan::GUI::CefApplication* owner) :
     Owner(owner)
-{}
+{
+    registerThriveJSFunctions(Functions);
+}
 
 ThriveJSHandler::~ThriveJSHandler() {}
 // ------------------------------------ //
@@ -71,96 +230,63 @@ bool
         CefRefPtr<CefV8Value>& retval,
         CefString& exception)
 {
-    if(name == "startNewGame") {
-
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "startNewGame");
-
-        Owner->SendCustomExtensionMessage(message);
-        return true;
-
-    } else if(name == "editorButtonClicked") {
+    auto message = CefProcessMessage::Create("Custom");
+    auto args = message->GetArgumentList();
 
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "editorButtonClicked");
+    const std::string function = name.ToString();
 
-        Owner->SendCustomExtensionMessage(message);
-        return true;
+    if(function == THRIVE_JS_CALL_FUNCTION) {
 
-    } else if(name == "freebuildEditorButtonClicked") {
-
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "freebuildEditorButtonClicked");
-
-        Owner->SendCustomExtensionMessage(message);
-        return true;
+        // The main process checks the arguments against the registered ones
+        if(arguments.size() < 1 || !arguments[0]->IsString()) {
+            // Invalid arguments //
+            exception = "Invalid arguments passed, expected: string name of "
+                        "the function to call";
+            return true;
+        }
 
-    } else if(name == "finishEditingClicked") {
+        args->SetString(0, arguments[0]->GetStringValue());
 
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "finishEditingClicked");
+        for(size_t i = 1; i < arguments.size(); ++i) {
 
-        Owner->SendCustomExtensionMessage(message);
-        return true;
-    } else if(name == "killPlayerCellClicked") {
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "killPlayerCellClicked");
+            JS_ARGUMENT_TYPE type;
 
-        Owner->SendCustomExtensionMessage(message);
-        return true;
-    } else if(name == "exitToMenuClicked") {
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "exitToMenuClicked");
+            if(!detectArgumentType(arguments[i], type) ||
+                !encodeArgument(*args, i, arguments[i], type)) {
+                exception = "Invalid argument " + std::to_string(i) +
+                            ", only bools, numbers and strings can be passed";
+                return true;
+            }
+        }
 
         Owner->SendCustomExtensionMessage(message);
         return true;
-    } else if(name == "connectToServer") {
-
-        if(arguments.size() < 1 || !arguments[0]->IsString()) {
-            // Invalid arguments //
-            exception = "Invalid arguments passed, expected: string";
-            return true;
-        }
+    }
 
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "connectToServer");
-        args->SetString(1, arguments[0]->GetStringValue());
+    const auto* types = Functions.getArgumentTypes(function);
 
-        Owner->SendCustomExtensionMessage(message);
+    if(!types) {
+        // This might be a bit expensive...
+        exception = L"Unknown ThriveJSHandler function: " + name.ToWString();
         return true;
-    } else if(name == "disconnectFromServer") {
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "disconnectFromServer");
+    }
 
-        Owner->SendCustomExtensionMessage(message);
-        return true;
-    } else if(name == "pause") {
+    // Extra arguments are ignored
+    bool valid = arguments.size() >= types->size();
 
-        if(arguments.size() < 1 || !arguments[0]->IsBool()) {
-            // Invalid arguments //
-            exception = "Invalid arguments passed, expected: bool";
-            return true;
-        }
+    args->SetString(0, name);
 
-        auto message = CefProcessMessage::Create("Custom");
-        auto args = message->GetArgumentList();
-        args->SetString(0, "pause");
-        args->SetBool(1, arguments[0]->GetBoolValue());
+    for(size_t i = 0; valid && i < types->size(); ++i)
+        valid = encodeArgument(*args, i + 1, arguments[i], (*types)[i]);
 
-        Owner->SendCustomExtensionMessage(message);
+    if(!valid) {
+        // Invalid arguments //
+        exception = "Invalid arguments passed, expected: " +
+                    JSCallDispatcher::formatArgumentTypes(*types);
         return true;
     }
 
-    // This might be a bit expensive...
-    exception = L"Unknown ThriveJSHandler function: " + name.ToWString();
+    Owner->SendCustomExtensionMessage(message);
     return true;
 }
 // ------------------------------------ //
@@ -179,51 +305,20 @@ bool
         CefProcessId source_process,
         CefRefPtr<CefProcessMessage> message)
 {
-    const auto args = message->GetArgumentList();
-    const auto& customType = args->GetString(0);
-
-    if(customType == "startNewGame") {
-
-        LOG_INFO("Got start game message from GUI process");
-        ThriveGame::Get()->startNewGame();
-        return true;
-
-    } else if(customType == "editorButtonClicked") {
-
-        ThriveGame::Get()->editorButtonClicked();
-        return true;
-
-    } else if(customType == "freebuildEditorButtonClicked") {
+    ThriveGame* game = ThriveGame::Get();
 
-        ThriveGame::Get()->enableFreebuild();
-        ThriveGame::Get()->editorButtonClicked();
-        return true;
-    } else if(customType == "finishEditingClicked") {
-
-        ThriveGame::Get()->finishEditingClicked();
-        return true;
-    } else if(customType == "killPlayerCellClicked") {
-
-        ThriveGame::Get()->killPlayerCellClicked();
-        return true;
-    } else if(customType == "exitToMenuClicked") {
-
-        ThriveGame::Get()->exitToMenuClicked();
-        return true;
-    } else if(customType == "connectToServer") {
+    if(!game)
+        return false;
 
-        ThriveGame::Get()->connectToServer(args->GetString(1));
-        return true;
-    } else if(customType == "disconnectFromServer") {
+    const auto args = message->GetArgumentList();
+    const std::string name = args->GetString(0).ToString();
 
-        ThriveGame::Get()->disconnectFromServer(true);
-        return true;
-    } else if(customType == "pause") {
+    JSCallArguments arguments;
 
-        ThriveGame::Get()->pause(args->GetBool(1));
-        return true;
-    }
+    // Messages with other values aren't sent by ThriveJSHandler
+    if(!decodeArguments(*args, 1, arguments))
+        return false;
 
-    // Not ours
-    return false;
+    // Returns false when this is not ours
+    return game->jsCalls().callFunction(name, arguments);
 }
@@ -5,11 +5,21 @@
 //! process message handler
 #pragma once
 // ------------------------------------ //
+#include "js_call_dispatcher.h"
+
 #include <GUI/GuiCEFApplication.h>
 #include <GUI/LeviathanJavaScriptAsync.h>
 
 namespace thrive {
 
+//! \brief Registers the functions and queries that the GUI always has
+//!
+//! This is used in both processes. The render process only needs the argument
+//! types
+void
+    registerThriveJSFunctions(JSCallDispatcher& dispatcher);
+
+//! \brief Runs the queries registered in ThriveGame::jsCalls
 class ThriveJSInterface : public Leviathan::GUI::JSAsyncCustom {
 public:
     ThriveJSInterface();
@@ -44,9 +54,10 @@ public:
     ~ThriveJSHandler();
 
     //! \brief Handles calls from javascript
-    //! \todo Many of these functions just send a message to the main process so
-    //! maybe they should be implemented as a ThriveJSInterface::ProcessQuery
-    //! instead (like the version retrieve)
+    //!
+    //! The arguments are checked against the registered types and sent to
+    //! the main process. Thrive.call sends the arguments with the types they
+    //! have as the main process registrations aren't known here
     bool
         Execute(const CefString& name,
             CefRefPtr<CefV8Value> object,
@@ -63,13 +74,16 @@ public:
 protected:
     //! Owner stored to be able to use it to bridge our requests to Gui::View
     Leviathan::GUI::CefApplication* Owner;
+
+    //! The builtin functions for looking up their argument types
+    JSCallDispatcher Functions;
 };
 
 CefRefPtr<CefV8Handler>
     makeThriveJSHandler(Leviathan::GUI::CefApplication* application);
 
 //! \brief Receives custom messages into the main process from the render
-//! process
+//! process and calls the matching function in ThriveGame::jsCalls
 class ThriveJSMessageHandler : public Leviathan::GUI::MainProcessSideHandler {
 public:
     bool
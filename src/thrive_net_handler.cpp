@@ -2,10 +2,12 @@
 #include "thrive_net_handler.h"
 
 #include "ThriveGame.h"
+#include "thrive_packets.h"
 
 #include <Engine.h>
 #include <Events/EventHandler.h>
 #include <GUI/GuiManager.h>
+#include <Networking/NetworkResponse.h>
 #include <Physics/PhysicsMaterialManager.h>
 
 using namespace thrive;
@@ -19,6 +21,43 @@ void
 {
     DoJoinDefaultWorld();
 }
+
+void
+    ThriveNetHandler::requestMoveToPatch(int32_t patchId)
+{
+    SendCommandStringToServer(
+        std::string(MOVE_TO_PATCH_COMMAND) + " " + std::to_string(patchId));
+}
+
+void
+    ThriveNetHandler::HandleResponseOnlyPacket(
+        std::shared_ptr<Leviathan::NetworkResponse> message,
+        Leviathan::Connection& connection)
+{
+    const auto* packet = getThrivePacket(*message);
+
+    if(!packet) {
+        NetworkClientInterface::HandleResponseOnlyPacket(message, connection);
+        return;
+    }
+
+    switch(packet->getType()) {
+    case THRIVE_PACKET_TYPE::CLOUD_STREAM:
+        ThriveGame::Get()->receiveCloudStreamMessage(packet->getData());
+        return;
+    case THRIVE_PACKET_TYPE::ENTITY_STATES: {
+        uint32_t sequence;
+
+        if(ThriveGame::Get()->receiveEntityStates(packet->getData(), sequence))
+            sendEntityStatesAck(connection, sequence);
+        return;
+    }
+    case THRIVE_PACKET_TYPE::ENTITY_STATES_ACK: break;
+    }
+
+    LOG_WARNING("ThriveNetHandler: unknown Thrive packet type: " +
+                std::to_string(static_cast<int>(packet->getType())));
+}
 // ------------------------------------ //
 void
     ThriveNetHandler::_OnNewConnectionStatusMessage(const std::string& message)
@@ -9,6 +9,10 @@
 
 namespace thrive {
 
+//! The command clients send to the server to move their cell to another patch.
+//! The patch id follows the command name
+constexpr auto MOVE_TO_PATCH_COMMAND = "movetopatch";
+
 //! \brief Thrive specific NetworkClientInterface
 class ThriveNetHandler : public Leviathan::NetworkClientInterface {
 public:
@@ -19,6 +23,16 @@ public:
     void
         _OnProperlyConnected() override;
 
+    //! \brief Asks the server to move our cell to another patch
+    void
+        requestMoveToPatch(int32_t patchId);
+
+    //! \brief Handles the Thrive packets from the server
+    void
+        HandleResponseOnlyPacket(
+            std::shared_ptr<Leviathan::NetworkResponse> message,
+            Leviathan::Connection& connection) override;
+
 protected:
     //! \brief Used to fire GenericEvents to update GUI status
     void
@@ -0,0 +1,116 @@
+// ------------------------------------ //
+#include "thrive_packets.h"
+
+#include "general/varint.h"
+
+#include <Networking/Connection.h>
+#include <Networking/NetworkResponse.h>
+
+#include <SFML/Network/Packet.hpp>
+
+using namespace thrive;
+// ------------------------------------ //
+namespace {
+
+class ThriveDataPacketFactory
+    : public Leviathan::BaseGameSpecificPacketFactory {
+public:
+    ThriveDataPacketFactory(THRIVE_PACKET_TYPE type) :
+        BaseGameSpecificPacketFactory(static_cast<int>(type), false),
+        m_type(type)
+    {}
+
+    bool
+        SerializeToPacket(Leviathan::GameSpecificPacketData* data,
+            sf::Packet& packet) override
+    {
+        const auto* thrivePacket =
+            static_cast<ThriveDataPacket*>(data->ResponseBaseData);
+
+        packet << thrivePacket->getData();
+        return true;
+    }
+
+    std::shared_ptr<Leviathan::GameSpecificPacketData>
+        UnSerializeObjectFromPacket(sf::Packet& packet) override
+    {
+        std::string data;
+
+        if(!(packet >> data))
+            return nullptr;
+
+        return std::make_shared<Leviathan::GameSpecificPacketData>(
+            new ThriveDataPacket(m_type, std::move(data)));
+    }
+
+private:
+    const THRIVE_PACKET_TYPE m_type;
+};
+
+} // namespace
+// ------------------------------------ //
+ThriveDataPacket::ThriveDataPacket(THRIVE_PACKET_TYPE type, std::string data) :
+    BaseGameSpecificResponsePacket(static_cast<int>(type)),
+    m_data(std::move(data))
+{}
+// ------------------------------------ //
+void
+    thrive::registerThrivePackets()
+{
+    auto* handler = Leviathan::GameSpecificPacketHandler::Get();
+
+    // The handler takes ownership of the factories
+    handler->RegisterNewTypeFactory(
+        new ThriveDataPacketFactory(THRIVE_PACKET_TYPE::CLOUD_STREAM));
+    handler->RegisterNewTypeFactory(
+        new ThriveDataPacketFactory(THRIVE_PACKET_TYPE::ENTITY_STATES));
+    handler->RegisterNewTypeFactory(
+        new ThriveDataPacketFactory(THRIVE_PACKET_TYPE::ENTITY_STATES_ACK));
+}
+
+std::shared_ptr<Leviathan::NetworkResponse>
+    thrive::makeThrivePacket(THRIVE_PACKET_TYPE type, std::string data)
+{
+    return std::make_shared<Leviathan::ResponseCustom>(0,
+        std::make_shared<Leviathan::GameSpecificPacketData>(
+            new ThriveDataPacket(type, std::move(data))));
+}
+
+const ThriveDataPacket*
+    thrive::getThrivePacket(const Leviathan::NetworkResponse& response)
+{
+    if(response.GetType() != Leviathan::NETWORK_RESPONSE_TYPE::Custom)
+        return nullptr;
+
+    const auto& custom =
+        static_cast<const Leviathan::ResponseCustom&>(response);
+
+    if(!custom.ActualPacketData || custom.ActualPacketData->IsRequest)
+        return nullptr;
+
+    return dynamic_cast<const ThriveDataPacket*>(
+        custom.ActualPacketData->ResponseBaseData);
+}
+
+void
+    thrive::sendEntityStatesAck(
+        Leviathan::Connection& connection, uint32_t sequence)
+{
+    std::string data;
+    appendVarint(data, sequence);
+
+    // A lost acknowledgement only delays moving to newer baselines
+    connection.SendPacketToConnection(
+        makeThrivePacket(THRIVE_PACKET_TYPE::ENTITY_STATES_ACK, data),
+        Leviathan::RECEIVE_GUARANTEE::None);
+}
+
+uint32_t
+    thrive::readEntityStatesAck(const ThriveDataPacket& packet)
+{
+    if(packet.getType() != THRIVE_PACKET_TYPE::ENTITY_STATES_ACK)
+        throw Leviathan::InvalidArgument("not an entity states ack");
+
+    size_t position = 0;
+    return static_cast<uint32_t>(readVarint(packet.getData(), position));
+}
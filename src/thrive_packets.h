@@ -0,0 +1,84 @@
+// Thrive Game
+// Copyright (C) 2013-2019  Revolutionary Games
+#pragma once
+// ------------------------------------ //
+//! \file Thrive's own network packets between the server and the clients
+
+#include <Networking/GameSpecificPacketHandler.h>
+
+#include <memory>
+#include <string>
+
+namespace Leviathan {
+class Connection;
+class NetworkResponse;
+}
+
+namespace thrive {
+
+//! \brief The kinds of data sent between the server and the clients in
+//! ThriveDataPacket
+enum class THRIVE_PACKET_TYPE : int32_t {
+
+    //! A message from CloudStreamServer
+    CLOUD_STREAM = 1,
+
+    //! Entity states from EntityStateBaselines::encodeMessage
+    ENTITY_STATES = 2,
+
+    //! A client acknowledging an ENTITY_STATES message. Holds the sequence
+    //! number of the message as a varint
+    ENTITY_STATES_ACK = 3
+};
+
+/**
+ * @brief A game specific response packet holding encoded data
+ *
+ * The data is already encoded by the sending code, so the packet only carries
+ * the bytes. Cloud stream messages build on the previous ones and are sent
+ * with RECEIVE_GUARANTEE::Critical. Entity states only build on acknowledged
+ * states so they can be lost
+ */
+class ThriveDataPacket : public Leviathan::BaseGameSpecificResponsePacket {
+public:
+    ThriveDataPacket(THRIVE_PACKET_TYPE type, std::string data);
+
+    THRIVE_PACKET_TYPE
+        getType() const
+    {
+        return static_cast<THRIVE_PACKET_TYPE>(TypeNumber);
+    }
+
+    const std::string&
+        getData() const
+    {
+        return m_data;
+    }
+
+private:
+    std::string m_data;
+};
+
+//! \brief Registers the factories for the Thrive packets. Needs to be called
+//! by the client and the server before connecting
+void
+    registerThrivePackets();
+
+//! \returns A packet for sending data to a client or the server
+std::shared_ptr<Leviathan::NetworkResponse>
+    makeThrivePacket(THRIVE_PACKET_TYPE type, std::string data);
+
+//! \returns The Thrive packet in response or null if it is some other packet
+const ThriveDataPacket*
+    getThrivePacket(const Leviathan::NetworkResponse& response);
+
+//! \brief Tells the server that an ENTITY_STATES message was received
+void
+    sendEntityStatesAck(Leviathan::Connection& connection, uint32_t sequence);
+
+//! \returns The sequence number in an ENTITY_STATES_ACK packet
+//! \exception Leviathan::InvalidArgument if the packet is invalid
+uint32_t
+    readEntityStatesAck(const ThriveDataPacket& packet);
+
+} // namespace thrive
@@ -38,4 +38,9 @@ var Thrive = {};
     native function pause(value);
     Thrive.pause = pause;
 
+    // Calls a function registered in the game at runtime, for example from the
+    // scripts. Usage: Thrive.call("name", arguments...)
+    native function call(name);
+    Thrive.call = call;
+
 }());
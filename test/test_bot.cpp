@@ -0,0 +1,118 @@
+//! Tests the parts of the load testing bot that don't need a server
+#include "bot/bot_input_script.h"
+#include "bot/bot_metrics.h"
+
+#include <Exceptions.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("Bot input script plays back actions in order", "[bot]")
+{
+    BotInputScript script("# Comment\n"
+                          "move 3 4 2\n"
+                          "\n"
+                          "engulf\n"
+                          "wait 1\n"
+                          "toxin\n",
+        1);
+
+    CHECK(script.getActionCount() == 4);
+
+    auto input = script.update(1);
+    CHECK(input.movement.X == Approx(0.6f));
+    CHECK(input.movement.Z == Approx(0.8f));
+    CHECK(!input.toggleEngulf);
+    CHECK(!input.fireToxin);
+
+    // Passes the end of the move and the engulf toggle
+    input = script.update(1.5f);
+    CHECK(input.movement.HAddAbs() == 0);
+    CHECK(input.toggleEngulf);
+    CHECK(!input.fireToxin);
+
+    // The wait ends and the script loops back to the start
+    input = script.update(0.5f);
+    CHECK(input.fireToxin);
+    CHECK(!input.toggleEngulf);
+    CHECK(input.movement.X == Approx(0.6f));
+}
+
+TEST_CASE("Bot input script wander moves in a direction", "[bot]")
+{
+    BotInputScript script("wander 10", 42);
+
+    const auto input = script.update(0.1f);
+    CHECK(input.movement.Length() == Approx(1));
+    CHECK(input.movement.Y == 0);
+}
+
+TEST_CASE("Bot input script rejects invalid scripts", "[bot]")
+{
+    SECTION("Unknown action")
+    {
+        CHECK_THROWS_AS(
+            BotInputScript("jump 1", 1), Leviathan::InvalidArgument);
+    }
+
+    SECTION("Missing duration")
+    {
+        CHECK_THROWS_AS(
+            BotInputScript("move 1 0", 1), Leviathan::InvalidArgument);
+    }
+
+    SECTION("Only instant actions")
+    {
+        CHECK_THROWS_AS(
+            BotInputScript("engulf\ntoxin", 1), Leviathan::InvalidArgument);
+    }
+
+    SECTION("Empty script")
+    {
+        CHECK_THROWS_AS(BotInputScript("", 1), Leviathan::InvalidArgument);
+    }
+}
+
+TEST_CASE("Bot metrics summarize samples", "[bot]")
+{
+    BotMetrics metrics;
+
+    for(int i = 1; i <= 100; ++i)
+        metrics.addSample("tick", static_cast<float>(i));
+
+    CHECK(metrics.hasSeries("tick"));
+    CHECK(!metrics.hasSeries("join"));
+    CHECK_THROWS_AS(metrics.getSummary("join"), Leviathan::NotFound);
+
+    const auto summary = metrics.getSummary("tick");
+
+    CHECK(summary.count == 100);
+    CHECK(summary.min == 1);
+    CHECK(summary.max == 100);
+    CHECK(summary.average == Approx(50.5f));
+    CHECK(summary.p95 == 95);
+
+    CHECK(metrics.formatReport().find("tick: count: 100") != std::string::npos);
+
+    metrics.clear();
+    CHECK(!metrics.hasSeries("tick"));
+}
+
+TEST_CASE("Bot metrics keep only the latest samples", "[bot]")
+{
+    BotMetrics metrics(10);
+
+    for(int i = 1; i <= 25; ++i)
+        metrics.addSample("tick", static_cast<float>(i));
+
+    const auto summary = metrics.getSummary("tick");
+
+    CHECK(summary.count == 10);
+    CHECK(summary.min == 16);
+    CHECK(summary.max == 25);
+    CHECK(summary.average == Approx(20.5f));
+    CHECK(summary.p95 == 25);
+
+    CHECK_THROWS_AS(BotMetrics(0), Leviathan::InvalidArgument);
+}
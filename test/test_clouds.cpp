@@ -1,6 +1,9 @@
 //! Tests compound cloud operations that don't need graphics
 #include "engine/player_data.h"
+#include "general/varint.h"
 #include "generated/cell_stage_world.h"
+#include "microbe_stage/cloud_grid_codec.h"
+#include "microbe_stage/cloud_streaming.h"
 #include "microbe_stage/compound_cloud_system.h"
 #include "test_thrive_game.h"
 
@@ -8,6 +11,9 @@
 #include <LeviathanTest/PartialEngine.h>
 
 #include "catch.hpp"
+
+#include <cmath>
+#include <random>
 using namespace thrive;
 using namespace thrive::test;
 
@@ -623,3 +629,426 @@ TEST_CASE_METHOD(CloudManagerTestsFixture,
     CHECK(cloudGroup2AtOrigin->amountAvailable(5, std::get<0>(centerCoords),
               std::get<1>(centerCoords), 1) == 15);
 }
+
+//! \brief A grid that is empty except for one blob of compounds
+std::vector<float>
+    makeBlobGrid(int centerX, int centerY, float peak)
+{
+    std::vector<float> grid(CLOUD_SIMULATION_WIDTH * CLOUD_SIMULATION_HEIGHT);
+
+    for(int x = 0; x < CLOUD_SIMULATION_WIDTH; ++x) {
+        for(int y = 0; y < CLOUD_SIMULATION_HEIGHT; ++y) {
+
+            const float distance = std::sqrt(static_cast<float>(
+                (x - centerX) * (x - centerX) + (y - centerY) * (y - centerY)));
+
+            if(distance < 10)
+                grid[x * CLOUD_SIMULATION_HEIGHT + y] =
+                    peak * (1 - distance / 10);
+        }
+    }
+
+    return grid;
+}
+
+float
+    maxDifference(const std::vector<float>& first,
+        const std::vector<float>& second)
+{
+    float result = 0;
+
+    for(size_t i = 0; i < first.size(); ++i)
+        result = std::max(result, std::abs(first[i] - second[i]));
+
+    return result;
+}
+
+float
+    maxAbsolute(const std::vector<float>& grid)
+{
+    float result = 0;
+
+    for(float value : grid)
+        result = std::max(result, std::abs(value));
+
+    return result;
+}
+
+TEST_CASE("Cloud grid codec is lossless with 32 bits", "[microbe]")
+{
+    const auto grid = makeBlobGrid(20, 30, 1234.5f);
+
+    CloudGridCodec codec(CloudCodecSettings{32, 0.f});
+
+    std::string encoded;
+    codec.encode(grid.data(), grid.size(), encoded);
+
+    CHECK(CloudGridCodec::getMaxError(encoded) == 0);
+
+    std::vector<float> decoded(grid.size(), 1);
+    CloudGridCodec::decode(encoded, decoded.data(), decoded.size());
+
+    CHECK(decoded == grid);
+
+    // The blob covers only a few percent of the grid
+    CHECK(encoded.size() < grid.size() * sizeof(float) / 10);
+}
+
+TEST_CASE("Cloud grid codec quantization stays within error bounds",
+    "[microbe]")
+{
+    const auto grid = makeBlobGrid(50, 50, 5000.f);
+    const auto rawSize = grid.size() * sizeof(float);
+
+    SECTION("8 bits")
+    {
+        CloudGridCodec codec(CloudCodecSettings{8, 0.5f});
+
+        std::string encoded;
+        codec.encode(grid.data(), grid.size(), encoded);
+
+        const auto maxError = CloudGridCodec::getMaxError(encoded);
+        CHECK(maxError <= 5000.f / 127 / 2 * 1.001f);
+
+        std::vector<float> decoded(grid.size());
+        CloudGridCodec::decode(encoded, decoded.data(), decoded.size());
+
+        CHECK(maxDifference(grid, decoded) <= maxError);
+        CHECK(encoded.size() < rawSize / 30);
+    }
+
+    SECTION("16 bits")
+    {
+        CloudGridCodec codec(CloudCodecSettings{16, 0.5f});
+
+        std::string encoded;
+        codec.encode(grid.data(), grid.size(), encoded);
+
+        // The zero threshold is larger than the quantization error
+        const auto maxError = CloudGridCodec::getMaxError(encoded);
+        CHECK(maxError == Approx(0.5f).epsilon(0.01));
+
+        std::vector<float> decoded(grid.size());
+        CloudGridCodec::decode(encoded, decoded.data(), decoded.size());
+
+        CHECK(maxDifference(grid, decoded) <= maxError);
+        CHECK(encoded.size() < rawSize / 15);
+    }
+}
+
+TEST_CASE("Cloud grid codec deltas", "[microbe]")
+{
+    CloudGridCodec codec(CloudCodecSettings{16, 0.02f});
+
+    auto first = makeBlobGrid(30, 30, 1000.f);
+    const auto secondBlob = makeBlobGrid(70, 70, 1000.f);
+
+    for(size_t i = 0; i < first.size(); ++i)
+        first[i] += secondBlob[i];
+
+    std::string encoded;
+    codec.encode(first.data(), first.size(), encoded);
+
+    const auto fullSize = encoded.size();
+
+    std::vector<float> decoded(first.size());
+    CloudGridCodec::decode(encoded, decoded.data(), decoded.size());
+
+    SECTION("Unchanged grid has a tiny delta")
+    {
+        codec.encodeDelta(
+            first.data(), decoded.data(), first.size(), encoded);
+
+        CHECK(encoded.size() < 32);
+
+        CloudGridCodec::decodeDelta(encoded, decoded.data(), decoded.size());
+        CHECK(maxDifference(first, decoded) <= 0.02f);
+    }
+
+    SECTION("Changes are applied")
+    {
+        // Only one of the blobs changes
+        auto second = first;
+        const auto added = makeBlobGrid(36, 30, 200.f);
+
+        for(size_t i = 0; i < second.size(); ++i)
+            second[i] += added[i];
+
+        codec.encodeDelta(
+            second.data(), decoded.data(), second.size(), encoded);
+
+        CHECK(encoded.size() < fullSize * 3 / 4);
+
+        CloudGridCodec::decodeDelta(encoded, decoded.data(), decoded.size());
+
+        const auto maxError =
+            CloudGridCodec::getMaxError(encoded, maxAbsolute(decoded));
+        CHECK(maxDifference(second, decoded) <= maxError);
+    }
+}
+
+TEST_CASE("Cloud grid codec error bounds hold for random grids", "[microbe]")
+{
+    std::mt19937 random(42);
+    std::bernoulli_distribution coinFlip(0.5);
+
+    // Half of the cells are empty like in real clouds
+    const auto randomGrid = [&](float scale) {
+        std::uniform_real_distribution<float> value(0, scale);
+        std::vector<float> grid(64 * 64);
+
+        for(auto& cell : grid)
+            cell = coinFlip(random) ? 0 : value(random);
+
+        return grid;
+    };
+
+    for(const uint8_t bits : {8, 16}) {
+        for(const float zeroThreshold : {0.f, 0.01f}) {
+            for(const float scale : {0.001f, 1.f, 1000.f, 1000000.f}) {
+
+                INFO("bits: " << static_cast<int>(bits) << " threshold: "
+                              << zeroThreshold << " scale: " << scale);
+
+                CloudGridCodec codec(CloudCodecSettings{bits, zeroThreshold});
+
+                const auto first = randomGrid(scale);
+
+                std::string encoded;
+                codec.encode(first.data(), first.size(), encoded);
+
+                std::vector<float> decoded(first.size());
+                CloudGridCodec::decode(
+                    encoded, decoded.data(), decoded.size());
+
+                CHECK(maxDifference(first, decoded) <=
+                      CloudGridCodec::getMaxError(encoded));
+
+                // Small changes to large values
+                auto second = first;
+                std::uniform_real_distribution<float> change(
+                    -scale / 100, scale / 100);
+
+                for(auto& cell : second) {
+                    if(coinFlip(random))
+                        cell += change(random);
+                }
+
+                codec.encodeDelta(
+                    second.data(), decoded.data(), second.size(), encoded);
+                CloudGridCodec::decodeDelta(
+                    encoded, decoded.data(), decoded.size());
+
+                CHECK(maxDifference(second, decoded) <=
+                      CloudGridCodec::getMaxError(
+                          encoded, maxAbsolute(decoded)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Cloud grid codec 32 bit deltas are exact", "[microbe]")
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+    std::bernoulli_distribution coinFlip(0.5);
+
+    CloudGridCodec codec(CloudCodecSettings{32, 0.f});
+
+    std::vector<float> grid(64 * 64, 0.f);
+    std::vector<float> decoded(grid.size(), 0.f);
+    std::string encoded;
+
+    for(int round = 0; round < 10; ++round) {
+
+        // Values of very different sizes, of which the differences can't be
+        // represented exactly
+        for(auto& cell : grid) {
+            if(coinFlip(random))
+                cell = std::ldexp(mantissa(random), exponent(random));
+        }
+
+        codec.encodeDelta(grid.data(), decoded.data(), grid.size(), encoded);
+
+        CHECK(CloudGridCodec::getMaxError(encoded) == 0);
+
+        CloudGridCodec::decodeDelta(encoded, decoded.data(), decoded.size());
+        CHECK(decoded == grid);
+    }
+}
+
+TEST_CASE("Cloud grid codec rejects invalid data", "[microbe]")
+{
+    const auto grid = makeBlobGrid(10, 10, 100.f);
+    std::vector<float> decoded(grid.size());
+
+    CHECK_THROWS(CloudGridCodec(CloudCodecSettings{12, 0.f}));
+
+    CloudGridCodec codec;
+
+    std::string encoded;
+    codec.encode(grid.data(), grid.size(), encoded);
+
+    // Wrong size
+    CHECK_THROWS(CloudGridCodec::decode(encoded, decoded.data(), 100));
+
+    // Truncated
+    encoded.resize(encoded.size() / 2);
+    CHECK_THROWS(
+        CloudGridCodec::decode(encoded, decoded.data(), decoded.size()));
+
+    CHECK_THROWS(CloudGridCodec::decode("", decoded.data(), decoded.size()));
+}
+
+TEST_CASE_METHOD(CloudManagerTestsFixture,
+    "Streamed clouds match the server clouds", "[microbe][networking]")
+{
+    setCloudsAndRunInitial(
+        {Compound{1, "a", true, true, false, Float4(0, 1, 2, 3)},
+            Compound{2, "b", true, true, false, Float4(3, 4, 5, 1)}});
+
+    auto& clouds = world.GetCompoundCloudSystem();
+
+    clouds.addCloud(1, 4000, Float3(0, 0, 0));
+    clouds.addCloud(2, 1500, Float3(30, 0, 10));
+
+    CloudStreamServer server(CloudCodecSettings{16, 0.01f}, 0.5f);
+    CloudStreamReceiver receiver;
+
+    std::vector<std::string> sent;
+    const auto send = [&](int32_t player, const std::string& message) {
+        CHECK(player == 3);
+        sent.push_back(message);
+    };
+
+    const std::vector<std::tuple<int32_t, Float3>> players{
+        {3, Float3(60, 0, 60)}};
+
+    // Not yet time to send
+    server.update(clouds, 0.2f, players, send);
+    CHECK(sent.empty());
+
+    server.update(clouds, 0.3f, players, send);
+
+    // Only the tiles close to the player are sent
+    REQUIRE(!sent.empty());
+    CHECK(sent.size() < 9);
+
+    size_t fullSize = 0;
+
+    for(const auto& message : sent) {
+        receiver.receive(message);
+        fullSize += message.size();
+    }
+
+    CHECK(receiver.hasData());
+    CHECK(receiver.getInterval() == 0.5f);
+    CHECK(receiver.getGridCenter() == Float3(0, 0, 0));
+
+    const auto checkMatches = [&]() {
+        CompoundCloudsSnapshot snapshot;
+        clouds.takeSnapshot(snapshot);
+
+        const auto* center = receiver.findTile(Float3(0, 0, 0), "a");
+        REQUIRE(center);
+
+        for(const auto& cloud : snapshot.clouds) {
+
+            if(cloud.position != center->position)
+                continue;
+
+            for(int i = 0; i < 2; ++i) {
+
+                CAPTURE(i);
+                REQUIRE(center->grids[i].data.size() ==
+                        cloud.grids[i].data.size());
+                CHECK(maxDifference(cloud.grids[i].data,
+                          center->grids[i].data) < 1.f);
+            }
+        }
+    };
+
+    checkMatches();
+
+    CHECK(receiver.findTile(Float3(0, 0, 0), "b") == nullptr);
+    CHECK(receiver.findTile(Float3(CLOUD_X_EXTENT * 5, 0, 0), "a") == nullptr);
+
+    SECTION("Changes are sent as deltas")
+    {
+        clouds.addCloud(1, 300, Float3(-20, 0, -40));
+
+        sent.clear();
+        server.update(clouds, 0.5f, players, send);
+
+        size_t deltaSize = 0;
+
+        for(const auto& message : sent) {
+            receiver.receive(message);
+            deltaSize += message.size();
+        }
+
+        CHECK(deltaSize < fullSize);
+        checkMatches();
+    }
+
+    SECTION("Removed player gets full tiles again")
+    {
+        server.removePlayer(3);
+
+        sent.clear();
+        server.update(clouds, 0.5f, players, send);
+
+        size_t size = 0;
+
+        for(const auto& message : sent)
+            size += message.size();
+
+        CHECK(size == fullSize);
+    }
+
+    SECTION("Deltas without a full tile are rejected")
+    {
+        clouds.addCloud(1, 300, Float3(-20, 0, -40));
+
+        sent.clear();
+        server.update(clouds, 0.5f, players, send);
+
+        CloudStreamReceiver newReceiver;
+        CHECK_THROWS_AS(
+            newReceiver.receive(sent.front()), Leviathan::InvalidArgument);
+    }
+}
+
+TEST_CASE("Cloud stream receiver rejects invalid messages", "[microbe]")
+{
+    CloudStreamReceiver receiver;
+
+    CHECK_THROWS_AS(receiver.receive(""), Leviathan::InvalidArgument);
+    CHECK_THROWS_AS(receiver.receive(std::string(40, '\x05')),
+        Leviathan::InvalidArgument);
+
+    // Valid start but truncated
+    std::string message(1, static_cast<char>(CLOUD_STREAM_MESSAGE_VERSION));
+    const float interval = 0.25f;
+    message.append(reinterpret_cast<const char*>(&interval), sizeof(float));
+    message.append(10, '\0');
+
+    CHECK_THROWS_AS(receiver.receive(message), Leviathan::InvalidArgument);
+    CHECK(!receiver.hasData());
+
+    // A huge grid is rejected before it is allocated
+    message.resize(1 + sizeof(float) + 2 * 3 * sizeof(float));
+    appendVarint(message, 1);
+    message.push_back('a');
+
+    // Used grids and not a delta
+    message.push_back(1);
+    message.push_back(0);
+
+    appendVarint(message, UINT16_MAX);
+    appendVarint(message, UINT16_MAX);
+    appendVarint(message, 0);
+
+    CHECK_THROWS_AS(receiver.receive(message), Leviathan::InvalidArgument);
+}
@@ -0,0 +1,72 @@
+//! Tests the fixed rate tick driver used by the server
+#include "engine/fixed_rate_ticker.h"
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("Fixed rate ticker runs ticks at the right rate", "[engine]")
+{
+    FixedRateTicker ticker(10, 3);
+    const auto start = FixedRateTicker::Clock::now();
+
+    int ticks = 0;
+    float elapsed = 0;
+
+    const auto callback = [&](float tickElapsed) {
+        ++ticks;
+        elapsed = tickElapsed;
+    };
+
+    // The first update runs a tick right away
+    CHECK(ticker.update(start, callback) == 1);
+    CHECK(elapsed == Approx(0.1f));
+
+    CHECK(ticker.update(start + std::chrono::milliseconds(50), callback) == 0);
+    CHECK(ticker.getTimeUntilNextTick(start + std::chrono::milliseconds(50)) ==
+          std::chrono::milliseconds(50));
+
+    CHECK(ticker.update(start + std::chrono::milliseconds(100), callback) == 1);
+
+    SECTION("Late updates catch up")
+    {
+        CHECK(ticker.update(start + std::chrono::milliseconds(420), callback) ==
+              3);
+        CHECK(ticks == 5);
+        CHECK(ticker.getStats().droppedTicks == 0);
+    }
+
+    SECTION("Ticks beyond the catch up limit are dropped")
+    {
+        CHECK(ticker.update(start + std::chrono::milliseconds(1050),
+                  callback) == 3);
+        CHECK(ticker.getStats().droppedTicks == 6);
+
+        // Back on schedule after dropping
+        CHECK(ticker.update(start + std::chrono::milliseconds(1060),
+                  callback) == 0);
+        CHECK(ticker.update(start + std::chrono::milliseconds(1100),
+                  callback) == 1);
+    }
+
+    CHECK(ticker.getStats().ticks == static_cast<uint64_t>(ticks));
+}
+
+TEST_CASE("Fixed rate ticker counts overrunning ticks", "[engine]")
+{
+    FixedRateTicker ticker(1000, 1);
+
+    ticker.update([](float) {
+        const auto start = FixedRateTicker::Clock::now();
+        while(FixedRateTicker::Clock::now() - start <
+              std::chrono::milliseconds(2)) {
+        }
+    });
+
+    CHECK(ticker.getStats().ticks == 1);
+    CHECK(ticker.getStats().overrunTicks == 1);
+    CHECK(ticker.getStats().getAverageTickMilliseconds() >= 2);
+
+    ticker.resetStats();
+    CHECK(ticker.getStats().ticks == 0);
+}
@@ -0,0 +1,138 @@
+//! Tests the batching of the frequent GUI updates
+#include "gui_update_channel.h"
+
+#include <Exceptions.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+namespace {
+
+Leviathan::GenericEvent::pointer
+    makeUpdate(const std::string& topic, int value)
+{
+    auto event =
+        Leviathan::GenericEvent::MakeShared<Leviathan::GenericEvent>(topic);
+
+    event->GetVariables()->Add(std::make_shared<Leviathan::NamedVariableList>(
+        "value", new Leviathan::IntBlock(value)));
+
+    return event;
+}
+
+//! \returns The names of the variables in batch
+std::vector<std::string>
+    variableNames(const Leviathan::GenericEvent::pointer& batch)
+{
+    std::vector<std::string> names;
+
+    for(const auto& variable : *batch->GetVariables()->GetVec())
+        names.push_back(variable->GetName());
+
+    return names;
+}
+
+} // namespace
+
+TEST_CASE("GUI update channel sends only the latest update of a topic",
+    "[gui]")
+{
+    std::vector<Leviathan::GenericEvent::pointer> sent;
+
+    GuiUpdateChannel channel(
+        [&](const Leviathan::GenericEvent::pointer& batch) {
+            sent.push_back(batch);
+        });
+
+    channel.flush();
+    CHECK(sent.empty());
+
+    channel.post(makeUpdate("PopulationChange", 1));
+    channel.post(makeUpdate("HoverInfo", 5));
+    channel.post(makeUpdate("PopulationChange", 2));
+    channel.post(makeUpdate("PopulationChange", 3));
+
+    CHECK(sent.empty());
+
+    channel.flush();
+
+    REQUIRE(sent.size() == 1);
+    CHECK(sent[0]->GetType() == "GuiUpdateBatch");
+
+    // The topics are in the order they were first posted
+    CHECK(variableNames(sent[0]) ==
+          std::vector<std::string>{
+              "PopulationChange.value", "HoverInfo.value", "topics"});
+
+    int value = 0;
+    REQUIRE(sent[0]->GetVariables()->GetValueAndConvertTo<int>(
+        "PopulationChange.value", value));
+    CHECK(value == 3);
+
+    const auto& stats = channel.getStats();
+    CHECK(stats.posted == 4);
+    CHECK(stats.coalesced == 2);
+    CHECK(stats.sent == 2);
+    CHECK(stats.batches == 1);
+
+    // Nothing is left for the next flush
+    channel.flush();
+    CHECK(sent.size() == 1);
+}
+
+TEST_CASE("GUI update channel skips updates that haven't changed", "[gui]")
+{
+    std::vector<Leviathan::GenericEvent::pointer> sent;
+
+    GuiUpdateChannel channel(
+        [&](const Leviathan::GenericEvent::pointer& batch) {
+            sent.push_back(batch);
+        });
+
+    channel.post(makeUpdate("PopulationChange", 1));
+    channel.post(makeUpdate("HoverInfo", 5));
+    channel.flush();
+    REQUIRE(sent.size() == 1);
+
+    SECTION("Batches with only unchanged updates aren't sent")
+    {
+        channel.post(makeUpdate("PopulationChange", 1));
+        channel.post(makeUpdate("HoverInfo", 5));
+        channel.flush();
+
+        CHECK(sent.size() == 1);
+        CHECK(channel.getStats().unchanged == 2);
+        CHECK(channel.getStats().batches == 1);
+    }
+
+    SECTION("Only the changed topics are sent")
+    {
+        channel.post(makeUpdate("PopulationChange", 2));
+        channel.post(makeUpdate("HoverInfo", 5));
+        channel.flush();
+
+        REQUIRE(sent.size() == 2);
+        CHECK(variableNames(sent[1]) ==
+              std::vector<std::string>{"PopulationChange.value", "topics"});
+        CHECK(channel.getStats().unchanged == 1);
+    }
+
+    SECTION("Reset makes the next updates be sent again")
+    {
+        channel.reset();
+
+        channel.post(makeUpdate("HoverInfo", 5));
+        channel.flush();
+
+        REQUIRE(sent.size() == 2);
+        CHECK(variableNames(sent[1]) ==
+              std::vector<std::string>{"HoverInfo.value", "topics"});
+    }
+}
+
+TEST_CASE("GUI update channel needs a sender", "[gui]")
+{
+    CHECK_THROWS_AS(GuiUpdateChannel(GuiUpdateChannel::Sender()),
+        Leviathan::InvalidArgument);
+}
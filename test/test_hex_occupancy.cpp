@@ -0,0 +1,88 @@
+//! Tests the hex to organelle lookup used for placing organelles
+#include "microbe_stage/hex_occupancy_map.h"
+
+#include <Exceptions.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("Hex occupancy map finds entries by hex", "[microbe]")
+{
+    auto map = HexOccupancyMap::MakeShared<HexOccupancyMap>();
+
+    const std::vector<Int2> single = {Int2(0, 0)};
+    const std::vector<Int2> triple = {Int2(0, 0), Int2(1, 0), Int2(0, 1)};
+
+    CHECK(map->getAt(0, 0) == HexOccupancyMap::EMPTY);
+
+    CHECK(map->add(single, 0, 0) == 0);
+    CHECK(map->add(triple, 2, -1) == 1);
+    CHECK(map->add(single, -3, 4) == 2);
+
+    CHECK(map->getCount() == 3);
+    CHECK(map->getOccupiedHexCount() == 5);
+
+    CHECK(map->getAt(0, 0) == 0);
+    CHECK(map->getAt(2, -1) == 1);
+    CHECK(map->getAt(3, -1) == 1);
+    CHECK(map->getAt(2, 0) == 1);
+    CHECK(map->getAt(-3, 4) == 2);
+    CHECK(map->getAt(1, 0) == HexOccupancyMap::EMPTY);
+
+    CHECK(map->isFree(triple, -1, -1));
+    CHECK(!map->isFree(triple, 1, 0));
+
+    SECTION("Removing shifts the later indices like array::removeAt")
+    {
+        map->removeAt(0);
+
+        CHECK(map->getCount() == 2);
+        CHECK(map->getAt(0, 0) == HexOccupancyMap::EMPTY);
+        CHECK(map->getAt(3, -1) == 0);
+        CHECK(map->getAt(-3, 4) == 1);
+    }
+
+    SECTION("Removing the last entry")
+    {
+        map->removeAt(2);
+
+        CHECK(map->getAt(-3, 4) == HexOccupancyMap::EMPTY);
+        CHECK(map->getAt(2, -1) == 1);
+    }
+
+    SECTION("Out of range index throws")
+    {
+        CHECK_THROWS_AS(map->removeAt(3), Leviathan::InvalidArgument);
+    }
+
+    SECTION("Clear empties the map")
+    {
+        map->clear();
+
+        CHECK(map->getCount() == 0);
+        CHECK(map->getOccupiedHexCount() == 0);
+        CHECK(map->getAt(0, 0) == HexOccupancyMap::EMPTY);
+    }
+}
+
+TEST_CASE("Hex occupancy map keeps the first of overlapping entries",
+    "[microbe]")
+{
+    auto map = HexOccupancyMap::MakeShared<HexOccupancyMap>();
+
+    const std::vector<Int2> pair = {Int2(0, 0), Int2(1, 0)};
+
+    map->add(pair, 0, 0);
+    map->add(pair, 1, 0);
+
+    CHECK(map->getAt(1, 0) == 0);
+    CHECK(map->getAt(2, 0) == 1);
+
+    // The hex shared with the removed entry is now found in the other one
+    map->removeAt(0);
+
+    CHECK(map->getAt(0, 0) == HexOccupancyMap::EMPTY);
+    CHECK(map->getAt(1, 0) == 0);
+    CHECK(map->getAt(2, 0) == 0);
+}
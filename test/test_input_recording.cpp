@@ -0,0 +1,122 @@
+//! Tests recording the player input and reading it back for replays
+#include "microbe_stage/input_recording.h"
+
+#include <Exceptions.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("Input recording reads back the same intents", "[microbe]")
+{
+    InputRecorder recorder(1234);
+
+    ControlIntent moving;
+    moving.movement = Float3(0.6f, 0, 0.8f);
+    moving.lookPoint = Float3(12.345678f, 0, -0.1f);
+
+    ControlIntent engulfing = moving;
+    engulfing.engulf = true;
+    engulfing.glucoseCloud = true;
+
+    std::vector<ControlIntent> session = {ControlIntent(), moving, moving,
+        engulfing, moving, ControlIntent()};
+
+    for(const auto& intent : session)
+        recorder.record(intent);
+
+    CHECK(recorder.getTickCount() == session.size());
+
+    InputReplay replay(recorder.toString());
+
+    CHECK(replay.getSeed() == 1234);
+    CHECK(replay.getTickCount() == session.size());
+
+    for(const auto& expected : session) {
+
+        REQUIRE(!replay.isFinished());
+
+        const auto intent = replay.next();
+
+        CHECK(intent.movement == expected.movement);
+        CHECK(intent.lookPoint == expected.lookPoint);
+        CHECK(intent.engulf == expected.engulf);
+        CHECK(intent.toxin == expected.toxin);
+        CHECK(intent.glucoseCloud == expected.glucoseCloud);
+        CHECK(intent.phosphateCloud == expected.phosphateCloud);
+        CHECK(intent.ammoniaCloud == expected.ammoniaCloud);
+    }
+
+    CHECK(replay.isFinished());
+}
+
+TEST_CASE("Input recording only stores changes", "[microbe]")
+{
+    InputRecorder recorder(1);
+
+    ControlIntent toxin;
+    toxin.toxin = true;
+    toxin.phosphateCloud = true;
+
+    recorder.record(toxin);
+
+    for(int i = 0; i < 100; ++i) {
+        ControlIntent held;
+        held.phosphateCloud = true;
+        recorder.record(held);
+    }
+
+    const auto text = recorder.toString();
+
+    CHECK(text == "thrive_input_recording 1\n"
+                  "seed 1\n"
+                  "0 0 0 0 0 tp\n"
+                  "end 101\n");
+
+    InputReplay replay(text);
+
+    // The toxin is only fired once but the cloud stays
+    CHECK(replay.next().toxin);
+
+    for(int i = 0; i < 100; ++i) {
+        const auto intent = replay.next();
+        CHECK(!intent.toxin);
+        CHECK(intent.phosphateCloud);
+    }
+
+    CHECK(replay.isFinished());
+}
+
+TEST_CASE("Input replay rejects invalid recordings", "[microbe]")
+{
+    CHECK_THROWS_AS(InputReplay(""), Leviathan::InvalidArgument);
+    CHECK_THROWS_AS(
+        InputReplay("some other file\nseed 1\nend 0\n"),
+        Leviathan::InvalidArgument);
+    CHECK_THROWS_AS(InputReplay("thrive_input_recording 2\nseed 1\nend 0\n"),
+        Leviathan::InvalidArgument);
+    CHECK_THROWS_AS(InputReplay("thrive_input_recording 1\nend 0\n"),
+        Leviathan::InvalidArgument);
+
+    // Missing end
+    CHECK_THROWS_AS(
+        InputReplay("thrive_input_recording 1\nseed 1\n0 0 0 0 0 -\n"),
+        Leviathan::InvalidArgument);
+
+    // Unknown action
+    CHECK_THROWS_AS(
+        InputReplay("thrive_input_recording 1\nseed 1\n0 0 0 0 0 x\nend 1\n"),
+        Leviathan::InvalidArgument);
+
+    // Ticks out of order
+    CHECK_THROWS_AS(InputReplay("thrive_input_recording 1\nseed 1\n"
+                                "5 0 0 0 0 -\n3 0 0 0 0 -\nend 10\n"),
+        Leviathan::InvalidArgument);
+
+    // Entry past the end
+    CHECK_THROWS_AS(InputReplay("thrive_input_recording 1\nseed 1\n"
+                                "5 0 0 0 0 -\nend 5\n"),
+        Leviathan::InvalidArgument);
+
+    CHECK_NOTHROW(InputReplay("thrive_input_recording 1\nseed 1\nend 0\n"));
+}
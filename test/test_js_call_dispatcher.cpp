@@ -0,0 +1,120 @@
+//! Tests the lookup and argument checking of the GUI function calls
+#include "js_call_dispatcher.h"
+
+#include <Exceptions.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("JS call dispatcher calls the registered function", "[gui]")
+{
+    JSCallDispatcher dispatcher;
+
+    std::string receivedName;
+    double receivedSpeed = 0;
+
+    dispatcher.registerFunction("setSpeed",
+        {JS_ARGUMENT_TYPE::STRING, JS_ARGUMENT_TYPE::DOUBLE},
+        [&](const JSCallArguments& arguments) {
+            receivedName = arguments.getString(0);
+            receivedSpeed = arguments.getDouble(1);
+        });
+
+    JSCallArguments arguments;
+    arguments.add(std::string("cell"));
+    arguments.add(2.5);
+
+    CHECK(dispatcher.callFunction("setSpeed", arguments));
+    CHECK(receivedName == "cell");
+    CHECK(receivedSpeed == 2.5);
+
+    // Whole numbers come as ints from JavaScript
+    JSCallArguments wholeNumber;
+    wholeNumber.add(std::string("other"));
+    wholeNumber.add(int32_t(3));
+
+    CHECK(dispatcher.callFunction("setSpeed", wholeNumber));
+    CHECK(receivedName == "other");
+    CHECK(receivedSpeed == 3);
+
+    CHECK(dispatcher.getStats("setSpeed").calls == 2);
+    CHECK(dispatcher.getStats("setSpeed").rejected == 0);
+
+    CHECK(!dispatcher.callFunction("setspeed", arguments));
+    CHECK(!dispatcher.callFunction("unknown", arguments));
+}
+
+TEST_CASE("JS call dispatcher rejects wrong arguments", "[gui]")
+{
+    JSCallDispatcher dispatcher;
+
+    int calls = 0;
+
+    dispatcher.registerFunction("pause", {JS_ARGUMENT_TYPE::BOOL},
+        [&](const JSCallArguments&) { ++calls; });
+
+    JSCallArguments none;
+    JSCallArguments wrongType;
+    wrongType.add(std::string("true"));
+
+    // These are handled but the function isn't called
+    CHECK(dispatcher.callFunction("pause", none));
+    CHECK(dispatcher.callFunction("pause", wrongType));
+
+    CHECK(calls == 0);
+    CHECK(dispatcher.getStats("pause").calls == 0);
+    CHECK(dispatcher.getStats("pause").rejected == 2);
+
+    // Unchecked functions get anything
+    dispatcher.registerFunction("anything", {},
+        [&](const JSCallArguments& arguments) {
+            ++calls;
+            CHECK_THROWS_AS(arguments.getInt(0), Leviathan::InvalidArgument);
+            CHECK_THROWS_AS(arguments.getBool(1), Leviathan::InvalidArgument);
+        },
+        false);
+
+    CHECK(dispatcher.callFunction("anything", wrongType));
+    CHECK(calls == 1);
+    CHECK(dispatcher.getArgumentTypes("anything") == nullptr);
+}
+
+TEST_CASE("JS call dispatcher registrations", "[gui]")
+{
+    JSCallDispatcher dispatcher;
+
+    dispatcher.registerFunction(
+        "start", {}, [](const JSCallArguments&) {});
+
+    CHECK_THROWS_AS(dispatcher.registerFunction(
+                        "start", {}, [](const JSCallArguments&) {}),
+        Leviathan::InvalidArgument);
+
+    CHECK_THROWS_AS(dispatcher.registerFunction("noHandler", {}, nullptr),
+        Leviathan::InvalidArgument);
+
+    REQUIRE(dispatcher.getArgumentTypes("start"));
+    CHECK(dispatcher.getArgumentTypes("start")->empty());
+
+    dispatcher.registerQuery("version", 1, []() { return "1.0"; });
+
+    CHECK(dispatcher.getQuerySecurityLevel("version") == 1);
+    CHECK(dispatcher.getQuerySecurityLevel("start") == -1);
+
+    std::string result;
+    CHECK(dispatcher.runQuery("version", result));
+    CHECK(result == "1.0");
+    CHECK(!dispatcher.runQuery("start", result));
+
+    CHECK(dispatcher.getStats("version").calls == 1);
+    CHECK_THROWS_AS(dispatcher.getStats("missing"), Leviathan::NotFound);
+
+    CHECK(dispatcher.formatStats().find("version: calls: 1") !=
+          std::string::npos);
+    CHECK(dispatcher.formatStats().find("start") == std::string::npos);
+
+    CHECK(JSCallDispatcher::formatArgumentTypes(
+              {JS_ARGUMENT_TYPE::STRING, JS_ARGUMENT_TYPE::BOOL}) ==
+          "string, bool");
+}
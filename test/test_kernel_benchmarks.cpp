@@ -0,0 +1,331 @@
+//! Microbenchmarks for the cloud, absorber and process kernels
+//!
+//! These are hidden from the normal test run. Run them with:
+//! ThriveTest "[benchmark]"
+#include "engine/player_data.h"
+#include "generated/cell_stage_world.h"
+#include "microbe_stage/compound_absorber_system.h"
+#include "microbe_stage/compound_cloud_system.h"
+#include "microbe_stage/fluid_system.h"
+#include "microbe_stage/process_system.h"
+#include "microbe_stage/simulation_parameters.h"
+#include "test_thrive_game.h"
+
+#include <LeviathanTest/PartialEngine.h>
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace thrive;
+using namespace thrive::test;
+
+//! The fixtures are filled from this seed so that runs can be compared
+constexpr auto BENCHMARK_SEED = 42;
+
+//! Same as in the cloud textures
+constexpr auto BENCHMARK_TEXTURE_BYTES_PER_ELEMENT = 4;
+
+//! How many times each kernel is timed. The runs before these fill the caches
+constexpr auto BENCHMARK_ITERATIONS = 50;
+constexpr auto BENCHMARK_WARMUP_ITERATIONS = 3;
+
+using DensityGrid = std::vector<std::vector<float>>;
+
+namespace {
+
+DensityGrid
+    makeRandomGrid(std::mt19937& random, size_t size)
+{
+    std::uniform_real_distribution<float> density(0, 1000);
+
+    DensityGrid grid(size, std::vector<float>(size, 0));
+
+    for(auto& column : grid) {
+        for(auto& value : column)
+            value = density(random);
+    }
+
+    return grid;
+}
+
+//! \brief Times kernel BENCHMARK_ITERATIONS times and prints the median and
+//! the fastest run
+//!
+//! The BENCHMARK macro of the bundled Catch version runs its body only once,
+//! which is too noisy to compare. reset is ran before each run without being
+//! timed to keep the kernel input the same
+void
+    runBenchmark(const std::string& name,
+        const std::function<void()>& kernel,
+        const std::function<void()>& reset = nullptr)
+{
+    using Clock = std::chrono::steady_clock;
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    std::vector<Clock::duration> times;
+    times.reserve(BENCHMARK_ITERATIONS);
+
+    for(int i = 0; i < BENCHMARK_WARMUP_ITERATIONS + BENCHMARK_ITERATIONS;
+        ++i) {
+
+        if(reset)
+            reset();
+
+        const auto start = Clock::now();
+        kernel();
+        const auto duration = Clock::now() - start;
+
+        if(i >= BENCHMARK_WARMUP_ITERATIONS)
+            times.push_back(duration);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    std::cout << name << ": median "
+              << Microseconds(times[times.size() / 2]).count() << " us, min "
+              << Microseconds(times.front()).count() << " us ("
+              << BENCHMARK_ITERATIONS << " runs)\n";
+}
+
+std::string
+    benchmarkName(const std::string& kernel, size_t gridSize, int compounds)
+{
+    return kernel + " " + std::to_string(gridSize) + "x" +
+           std::to_string(gridSize) + ", " + std::to_string(compounds) +
+           " compounds";
+}
+
+//! \brief World with the simulation parameters loaded for the system
+//! benchmarks
+class KernelBenchmarkFixture {
+public:
+    KernelBenchmarkFixture()
+    {
+        REQUIRE_NOTHROW(SimulationParameters::init());
+
+        thrive.lightweightInit();
+
+        world.SetRunInBackground(true);
+
+        REQUIRE(world.Init(
+            Leviathan::WorldNetworkSettings::GetSettingsForHybrid(), nullptr));
+
+        // The clouds are spawned around the player
+        const auto player = world.CreateEntity();
+        thrive.playerData().setActiveCreature(player);
+        world.Create_Position(player, Float3(0, 0, 0), Quaternion::IDENTITY);
+    }
+
+    ~KernelBenchmarkFixture()
+    {
+        world.Release();
+    }
+
+    //! \returns A random position in the area covered by the clouds
+    Float3
+        randomPosition()
+    {
+        std::uniform_real_distribution<float> distribution(
+            -CLOUD_X_EXTENT * 1.5f, CLOUD_X_EXTENT * 1.5f);
+
+        const auto x = distribution(random);
+        return Float3(x, 0, distribution(random));
+    }
+
+protected:
+    Leviathan::Test::PartialEngine<false> engine;
+    TestThriveGame thrive{&engine};
+    Leviathan::IDFactory ids;
+
+    CellStageWorld world{nullptr};
+
+    std::mt19937 random{BENCHMARK_SEED};
+};
+
+} // namespace
+
+TEST_CASE("Cloud kernel benchmarks", "[.][benchmark][microbe]")
+{
+    FluidSystem fluidSystem;
+
+    for(const size_t gridSize : {50, CLOUD_SIMULATION_WIDTH, 400}) {
+        for(const int compounds : {1, CLOUDS_IN_ONE}) {
+
+            std::mt19937 random(BENCHMARK_SEED);
+
+            std::vector<DensityGrid> densities;
+            std::vector<DensityGrid> oldDensities;
+
+            for(int i = 0; i < compounds; ++i) {
+                densities.push_back(makeRandomGrid(random, gridSize));
+                oldDensities.push_back(makeRandomGrid(random, gridSize));
+            }
+
+            const auto rowBytes =
+                gridSize * BENCHMARK_TEXTURE_BYTES_PER_ELEMENT;
+            std::vector<uint8_t> texture(rowBytes * gridSize);
+
+            runBenchmark(benchmarkName("diffuse", gridSize, compounds), [&]() {
+                for(int i = 0; i < compounds; ++i)
+                    CompoundCloudSystem::diffuse(
+                        0.007f, oldDensities[i], densities[i], 5.f);
+            });
+
+            runBenchmark(benchmarkName("advect", gridSize, compounds), [&]() {
+                for(int i = 0; i < compounds; ++i)
+                    CompoundCloudSystem::advect(oldDensities[i], densities[i],
+                        5.f, fluidSystem, Float2(0, 0));
+            });
+
+            runBenchmark(
+                benchmarkName("fillCloudChannel", gridSize, compounds), [&]() {
+                    for(int i = 0; i < compounds; ++i)
+                        CompoundCloudSystem::fillCloudChannel(
+                            densities[i], i, rowBytes, texture.data());
+                });
+
+            // Keeps the results from being optimized out
+            CHECK(std::any_of(texture.begin(), texture.end(),
+                [](uint8_t value) { return value != 0; }));
+        }
+    }
+}
+
+TEST_CASE_METHOD(KernelBenchmarkFixture, "Compound absorber benchmarks",
+    "[.][benchmark][microbe]")
+{
+    std::vector<Compound> clouds;
+
+    for(size_t i = 0; i < SimulationParameters::compoundRegistry.getSize();
+        ++i) {
+
+        const auto& data =
+            SimulationParameters::compoundRegistry.getTypeData(i);
+
+        if(data.isCloud)
+            clouds.push_back(data);
+    }
+
+    REQUIRE(!clouds.empty());
+
+    world.GetCompoundCloudSystem().registerCloudTypes(world, clouds);
+
+    // Spawns the clouds
+    world.Tick(1);
+
+    // The cells only absorb the first compounds
+    for(const size_t compounds : {size_t(1), clouds.size()}) {
+
+        // The same clouds are put back before each run as the cells absorb
+        // them
+        std::vector<Float3> positions;
+
+        for(int i = 0; i < 500; ++i)
+            positions.push_back(randomPosition());
+
+        const auto fillClouds = [&]() {
+            world.GetCompoundCloudSystem().emptyAllClouds();
+
+            for(const auto& position : positions) {
+                for(size_t compound = 0; compound < compounds; ++compound)
+                    world.GetCompoundCloudSystem().addCloud(
+                        clouds[compound].id, 50000, position);
+            }
+        };
+
+        for(const int cells : {10, 100, 1000}) {
+
+            std::vector<ObjectID> created;
+
+            for(int i = 0; i < cells; ++i) {
+
+                const auto entity = world.CreateEntity();
+                created.push_back(entity);
+
+                world.Create_Position(
+                    entity, randomPosition(), Quaternion::IDENTITY);
+                world.Create_MembraneComponent(entity, 0);
+
+                auto& absorber = world.Create_CompoundAbsorberComponent(entity);
+                absorber.setAbsorbtionCapacity(1000000);
+
+                for(size_t compound = 0; compound < compounds; ++compound)
+                    absorber.setCanAbsorbCompound(clouds[compound].id, true);
+            }
+
+            // Lets the system find the new entities
+            world.Tick(1);
+
+            runBenchmark("CompoundAbsorberSystem " + std::to_string(cells) +
+                             " cells, " + std::to_string(compounds) +
+                             " compounds",
+                [&]() {
+                    world.GetCompoundAbsorberSystem().Run(world,
+                        world.GetComponentIndex_CompoundCloudComponent(),
+                        0.05f);
+                },
+                fillClouds);
+
+            for(const auto entity : created)
+                world.DestroyEntity(entity);
+        }
+    }
+}
+
+TEST_CASE_METHOD(KernelBenchmarkFixture, "Process system benchmarks",
+    "[.][benchmark][microbe]")
+{
+    world.GetProcessSystem().setProcessBiome(
+        SimulationParameters::biomeRegistry.getTypeData(0));
+
+    const auto processCount =
+        SimulationParameters::bioProcessRegistry.getSize();
+
+    REQUIRE(processCount > 0);
+
+    for(const size_t processes : {size_t(1), processCount}) {
+        for(const int cells : {10, 100, 1000}) {
+
+            std::vector<ObjectID> created;
+
+            for(int i = 0; i < cells; ++i) {
+
+                const auto entity = world.CreateEntity();
+                created.push_back(entity);
+
+                auto& bag = world.Create_CompoundBagComponent(entity);
+                auto& processor = world.Create_ProcessorComponent(entity);
+
+                // Enough space and inputs to not run out during the benchmark
+                bag.storageSpace = 1000000000;
+
+                for(size_t process = 0; process < processes; ++process) {
+
+                    processor.setProcessRate(process, 1);
+
+                    for(const auto& [compound, amount] :
+                        SimulationParameters::bioProcessRegistry
+                            .getTypeData(process)
+                            .inputs)
+                        bag.setCompound(compound, 1000000);
+                }
+            }
+
+            world.Tick(1);
+
+            runBenchmark("ProcessSystem " + std::to_string(cells) +
+                             " cells, " + std::to_string(processes) +
+                             " processes",
+                [&]() { world.GetProcessSystem().Run(world, 0.05f); });
+
+            for(const auto entity : created)
+                world.DestroyEntity(entity);
+        }
+    }
+}
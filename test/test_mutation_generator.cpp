@@ -0,0 +1,157 @@
+//! Tests the native auto-evo mutations
+#include "auto-evo/mutation_generator.h"
+#include "microbe_stage/organelle_table.h"
+#include "microbe_stage/simulation_parameters.h"
+
+#include <Exceptions.h>
+#include <LeviathanTest/PartialEngine.h>
+
+#include "catch.hpp"
+
+#include <array>
+
+using namespace thrive;
+using namespace thrive::autoevo;
+
+namespace {
+
+constexpr std::array<std::array<int, 2>, 6> NEIGHBOURS = {
+    {{0, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, 0}, {-1, 1}}};
+
+void
+    initOrganelles()
+{
+    REQUIRE_NOTHROW(SimulationParameters::init());
+    OrganelleTable::initIfNeeded();
+}
+
+Species::pointer
+    makeParent()
+{
+    auto species = Species::MakeShared<Species>("Parent");
+    species->genus = "Primum";
+    species->epithet = "thrivium";
+    species->stringCode = "N,0,0,0|m,2,-1,0|c,-2,1,120";
+    species->membraneType =
+        SimulationParameters::membraneRegistry.getTypeId("single");
+    species->membraneRigidity = 0.5f;
+    species->colour = Float4(0.1f, 0.2f, 0.3f, 1);
+    species->aggression = 100;
+    return species;
+}
+
+} // namespace
+
+TEST_CASE("Mutation generator repeats mutations with the same seed",
+    "[autoevo]")
+{
+    Leviathan::Test::TestLogger log("Test/test_log.txt");
+    initOrganelles();
+
+    const auto parent = makeParent();
+
+    MutationGenerator first(42);
+    MutationGenerator second(42);
+    MutationGenerator other(43);
+
+    bool otherDiffers = false;
+
+    for(int i = 0; i < 20; ++i) {
+
+        const auto mutated1 = first.createMutatedSpecies(*parent);
+        const auto mutated2 = second.createMutatedSpecies(*parent);
+        const auto mutated3 = other.createMutatedSpecies(*parent);
+
+        REQUIRE(mutated1);
+        REQUIRE(mutated2);
+        REQUIRE(mutated3);
+
+        CHECK(mutated1->name == parent->name);
+        CHECK(mutated1->stringCode == mutated2->stringCode);
+        CHECK(mutated1->isBacteria == mutated2->isBacteria);
+        CHECK(mutated1->membraneType == mutated2->membraneType);
+        CHECK(mutated1->membraneRigidity == mutated2->membraneRigidity);
+        CHECK(mutated1->colour.X == mutated2->colour.X);
+        CHECK(mutated1->colour.W == mutated2->colour.W);
+        CHECK(mutated1->aggression == mutated2->aggression);
+        CHECK(mutated1->opportunism == mutated2->opportunism);
+
+        if(mutated1->stringCode != mutated3->stringCode ||
+            mutated1->colour.X != mutated3->colour.X)
+            otherDiffers = true;
+    }
+
+    CHECK(otherDiffers);
+}
+
+TEST_CASE("Mutation generator places organelles next to existing ones",
+    "[autoevo]")
+{
+    Leviathan::Test::TestLogger log("Test/test_log.txt");
+    initOrganelles();
+
+    MutationGenerator generator(7);
+
+    auto layout = generator.parseStringCode("N,0,0,0|m,2,-1,0");
+    REQUIRE(layout.size() == 2);
+    CHECK(MutationGenerator::toStringCode(layout) == "N,0,0,0|m,2,-1,0");
+
+    auto cytoplasm = OrganelleTable::getOrganelleDefinitions()
+                         .find("cytoplasm")
+                         ->second.get();
+    REQUIRE(cytoplasm);
+
+    for(int i = 0; i < 30; ++i) {
+
+        const OrganelleTemplate& organelle =
+            i % 3 == 0 ? *cytoplasm : generator.getRandomOrganelle(false);
+        REQUIRE(generator.addNextToExisting(layout, organelle));
+    }
+
+    REQUIRE(layout.size() == 32);
+
+    // Every added organelle is free and shares an edge with an earlier one
+    auto occupancy = HexOccupancyMap::MakeShared<HexOccupancyMap>();
+
+    for(size_t i = 0; i < layout.size(); ++i) {
+
+        const auto& placed = layout[i];
+        const auto hexes = placed.type->getRotatedHexes(placed.rotation);
+
+        CHECK(placed.rotation % 60 == 0);
+        REQUIRE(occupancy->isFree(hexes, placed.q, placed.r));
+
+        if(i >= 2) {
+
+            bool touches = false;
+
+            for(const auto& hex : hexes) {
+                for(const auto& offset : NEIGHBOURS) {
+                    if(occupancy->getAt(placed.q + hex.X + offset[0],
+                           placed.r + hex.Y + offset[1]) !=
+                        HexOccupancyMap::EMPTY)
+                        touches = true;
+                }
+            }
+
+            CHECK(touches);
+        }
+
+        occupancy->add(hexes, placed.q, placed.r);
+    }
+
+    SECTION("An empty layout gets the organelle at the origin")
+    {
+        OrganelleLayout empty;
+        REQUIRE(generator.addNextToExisting(empty, *cytoplasm));
+        CHECK(MutationGenerator::toStringCode(empty) == "Y,0,0,0");
+    }
+
+    SECTION("Malformed string codes are rejected")
+    {
+        CHECK_THROWS_AS(generator.parseStringCode("N,0,0"),
+            Leviathan::InvalidArgument);
+        CHECK_THROWS_AS(generator.parseStringCode("N,0,0,0|?,1,0,0"),
+            Leviathan::InvalidArgument);
+    }
+}
@@ -0,0 +1,75 @@
+//! Tests the formats the process query results are sent to the GUI in
+#include "microbe_stage/process_information.h"
+
+#include "catch.hpp"
+
+using namespace thrive;
+
+TEST_CASE("Energy balance GUI payload has the totals and sources",
+    "[microbe]")
+{
+    auto balance = EnergyBalance::MakeShared<EnergyBalance>();
+
+    balance->addProduction("cytoplasm", 4);
+    balance->addProduction("cytoplasm", 6);
+    balance->addConsumption("baseMovement", 1);
+    balance->totalProduction = 10;
+    balance->totalConsumption = 1;
+    balance->balance = 10;
+    balance->balanceStationary = 9;
+
+    CHECK(balance->production["cytoplasm"] == Approx(10));
+
+    CHECK(balance->toGUIPayload() == "energy_balance\t1\n"
+                                     "total\t10\t1\t10\t9\n"
+                                     "production\tcytoplasm\t10\n"
+                                     "consumption\tbaseMovement\t1\n");
+
+    const auto json = balance->toJSON();
+    CHECK(json.find("\"balanceStationary\":9") != std::string::npos);
+    CHECK(json.find("errors") == std::string::npos);
+}
+
+TEST_CASE("Process efficiencies GUI payload lists processes per organelle",
+    "[microbe]")
+{
+    auto efficiencies = ProcessEfficiencies::MakeShared<ProcessEfficiencies>();
+
+    ProcessSpeedInformation process;
+    process.name = "Chemo Synthesis";
+    process.processName = "chemoSynthesis";
+    process.speedFactor = 0.5f;
+
+    ProcessCompoundSpeed input;
+    input.id = 4;
+    input.internalName = "hydrogensulfide";
+    input.name = "Hydrogen Sulfide";
+    input.amount = 0.25f;
+    process.inputs.push_back(input);
+
+    ProcessCompoundSpeed environment;
+    environment.id = 2;
+    environment.internalName = "carbondioxide";
+    environment.name = "Carbon Dioxide";
+    environment.amount = 0.1f;
+    environment.availableAmount = 0.05f;
+    environment.availableRate = 0.5f;
+    process.environment.push_back(environment);
+
+    efficiencies->organelles.push_back({"nucleus", {}});
+    efficiencies->organelles.push_back({"chemoplast", {process}});
+    efficiencies->errors.push_back("organelle pointer is null");
+
+    CHECK(ProcessSpeedInformation::find(process.inputs, 4) ==
+          &process.inputs[0]);
+    CHECK(ProcessSpeedInformation::find(process.outputs, 4) == nullptr);
+
+    CHECK(efficiencies->toGUIPayload() ==
+          "process_efficiencies\t1\n"
+          "organelle\tnucleus\n"
+          "organelle\tchemoplast\n"
+          "process\tChemo Synthesis\tchemoSynthesis\t0.5\n"
+          "input\thydrogensulfide\tHydrogen Sulfide\t0.25\n"
+          "environment\tcarbondioxide\tCarbon Dioxide\t0.1\t0.05\t0.5\n"
+          "error\torganelle pointer is null\n");
+}
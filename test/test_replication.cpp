@@ -0,0 +1,220 @@
+//! Tests the server side entity replication helpers
+#include "engine/replication.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+
+using namespace thrive;
+
+TEST_CASE("Spatial hash grid finds entities in radius", "[networking]")
+{
+    SpatialHashGrid grid(10);
+
+    grid.insert(1, Float3(0, 0, 0));
+    grid.insert(2, Float3(15, 0, 0));
+    grid.insert(3, Float3(-25, 0, -25));
+    grid.insert(4, Float3(100, 0, 100));
+
+    std::vector<ObjectID> result;
+    grid.query(Float3(0, 0, 0), 20, result);
+    std::sort(result.begin(), result.end());
+
+    CHECK(result == std::vector<ObjectID>{1, 2});
+
+    result.clear();
+    grid.query(Float3(-20, 0, -20), 10, result);
+    CHECK(result == std::vector<ObjectID>{3});
+
+    grid.clear();
+    result.clear();
+    grid.query(Float3(0, 0, 0), 1000, result);
+    CHECK(result.empty());
+}
+
+TEST_CASE("Interest manager respects areas and budgets", "[networking]")
+{
+    ReplicationInterestManager manager(20);
+
+    std::vector<ReplicatedEntity> entities;
+    for(ObjectID id = 1; id <= 10; ++id)
+        entities.push_back(ReplicatedEntity{id, Float3(id * 10.f, 0, 0), 10});
+
+    // Far away from the observer
+    entities.push_back(ReplicatedEntity{100, Float3(1000, 0, 0), 10});
+
+    manager.setEntities(entities);
+    manager.updateObserver(1, Float3(0, 0, 0), 200, 30);
+
+    std::vector<ObjectID> selected;
+    std::vector<ObjectID> left;
+
+    manager.selectUpdates(1, 0.1f, selected, left);
+
+    // The closest ones are picked first
+    CHECK(selected == std::vector<ObjectID>{1, 2, 3});
+    CHECK(left.empty());
+
+    // Everything in the area is eventually sent
+    std::vector<ObjectID> sent = selected;
+
+    for(int i = 0; i < 10; ++i) {
+        selected.clear();
+        manager.selectUpdates(1, 0.1f, selected, left);
+        CHECK(selected.size() == 3);
+        sent.insert(sent.end(), selected.begin(), selected.end());
+    }
+
+    for(ObjectID id = 1; id <= 10; ++id)
+        CHECK(std::find(sent.begin(), sent.end(), id) != sent.end());
+
+    CHECK(std::find(sent.begin(), sent.end(), 100) == sent.end());
+
+    SECTION("Entities that leave the area are reported")
+    {
+        manager.updateObserver(1, Float3(1000, 0, 0), 50, 30);
+
+        selected.clear();
+        manager.selectUpdates(1, 0.1f, selected, left);
+
+        CHECK(selected == std::vector<ObjectID>{100});
+        CHECK(left.size() == 10);
+    }
+
+    SECTION("Unknown observer")
+    {
+        CHECK_THROWS(manager.selectUpdates(2, 0.1f, selected, left));
+    }
+}
+
+TEST_CASE("Entity states are delta compressed against acknowledged states",
+    "[networking]")
+{
+    EntityStateBaselines baselines;
+
+    const std::string first(100, 'a');
+    std::string second = first;
+    second[50] = 'b';
+    second += "cd";
+
+    std::string encoded;
+    std::string decoded;
+
+    // Nothing acknowledged yet
+    baselines.encode(1, 5, 1, first, encoded);
+    CHECK(!EntityStateBaselines::isDelta(encoded));
+    EntityStateBaselines::decode(nullptr, encoded, decoded);
+    CHECK(decoded == first);
+
+    baselines.acknowledge(1, 1);
+
+    baselines.encode(1, 5, 2, second, encoded);
+    REQUIRE(EntityStateBaselines::isDelta(encoded));
+    CHECK(EntityStateBaselines::getBaselineSequence(encoded) == 1);
+    CHECK(encoded.size() < 20);
+
+    CHECK_THROWS(EntityStateBaselines::decode(nullptr, encoded, decoded));
+
+    EntityStateBaselines::decode(&first, encoded, decoded);
+    CHECK(decoded == second);
+
+    // Without an acknowledgement the old baseline is still used
+    baselines.encode(1, 5, 3, second, encoded);
+    CHECK(EntityStateBaselines::getBaselineSequence(encoded) == 1);
+
+    baselines.acknowledge(1, 3);
+    baselines.encode(1, 5, 4, second, encoded);
+    CHECK(EntityStateBaselines::getBaselineSequence(encoded) == 3);
+
+    // Other observers have their own baselines
+    baselines.encode(2, 5, 4, second, encoded);
+    CHECK(!EntityStateBaselines::isDelta(encoded));
+}
+
+TEST_CASE("Entity state messages are decoded by the receiver", "[networking]")
+{
+    EntityStateBaselines baselines;
+    EntityStateReceiver receiver;
+
+    std::vector<std::tuple<ObjectID, std::string>> states;
+    states.emplace_back(5, std::string(40, 'a'));
+    states.emplace_back(6, std::string(40, 'b'));
+
+    std::string message;
+    std::vector<std::tuple<ObjectID, std::string>> applied;
+
+    const auto apply = [&](ObjectID entity, const std::string& state) {
+        applied.emplace_back(entity, state);
+    };
+
+    baselines.encodeMessage(1, 1, states, {}, message);
+    CHECK(receiver.receive(message, apply) == 1);
+    CHECK(applied == states);
+
+    baselines.acknowledge(1, 1);
+
+    std::get<1>(states[0])[10] = 'c';
+    baselines.encodeMessage(1, 2, states, {}, message);
+
+    // Mostly deltas against the first message
+    CHECK(message.size() < 30);
+
+    applied.clear();
+    CHECK(receiver.receive(message, apply) == 2);
+    CHECK(applied == states);
+
+    SECTION("Older messages aren't applied")
+    {
+        baselines.encodeMessage(1, 3, states, {}, message);
+        const auto third = message;
+
+        std::get<1>(states[0])[11] = 'd';
+        baselines.encodeMessage(1, 4, states, {}, message);
+
+        applied.clear();
+        CHECK(receiver.receive(message, apply) == 4);
+        CHECK(receiver.receive(third, apply) == 3);
+        CHECK(applied == states);
+    }
+
+    SECTION("Entities that left are forgotten")
+    {
+        baselines.encodeMessage(1, 3, {}, {5}, message);
+        receiver.receive(message, apply);
+        CHECK(receiver.getEntityCount() == 1);
+
+        // Sent whole when it comes back
+        baselines.acknowledge(1, 3);
+        baselines.encodeMessage(1, 4, {states[0]}, {}, message);
+
+        applied.clear();
+        receiver.receive(message, apply);
+        CHECK(applied == std::vector<std::tuple<ObjectID, std::string>>{
+                             states[0]});
+    }
+
+    SECTION("Corrupt message")
+    {
+        message.resize(message.size() / 2);
+        CHECK_THROWS(receiver.receive(message, apply));
+    }
+}
+
+TEST_CASE("Transform states round trip", "[networking]")
+{
+    std::string state;
+    encodeTransformState(
+        Float3(1, 2, 3), Quaternion(0.5f, 0.5f, 0.5f, 0.5f), state);
+
+    Float3 position;
+    Quaternion orientation;
+    decodeTransformState(state, position, orientation);
+
+    CHECK(position.X == 1);
+    CHECK(position.Y == 2);
+    CHECK(position.Z == 3);
+    CHECK(orientation.X == 0.5f);
+    CHECK(orientation.W == 0.5f);
+
+    CHECK_THROWS(decodeTransformState("abc", position, orientation));
+}
@@ -0,0 +1,357 @@
+//! Tests the save format without needing the scripts
+#include "engine/player_data.h"
+#include "general/save_game.h"
+#include "generated/cell_stage_world.h"
+#include "microbe_stage/compound_cloud_system.h"
+#include "microbe_stage/simulation_parameters.h"
+#include "test_thrive_game.h"
+
+#include <LeviathanTest/PartialEngine.h>
+
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace thrive;
+using namespace thrive::test;
+
+TEST_CASE("Save reader reads what save writer writes", "[save]")
+{
+    std::stringstream stream;
+
+    std::vector<std::vector<float>> grid(3, std::vector<float>(2, 0));
+    grid[1][1] = 12.5f;
+    grid[2][0] = 3.f;
+
+    // Stored one column after another
+    std::vector<float> flatGrid;
+    for(const auto& column : grid)
+        flatGrid.insert(flatGrid.end(), column.begin(), column.end());
+
+    {
+        SaveWriter writer(stream);
+        writer.writeHeader();
+
+        writer.beginSection(SAVE_SECTION::PATCH_MAP);
+        writer.write<int32_t>(-5);
+        writer.write<double>(0.25);
+        writer.write(true);
+        writer.writeString("a string");
+        writer.writeFloat3(Float3(1, 2, 3));
+        writer.writeGrid(flatGrid.data(), 3, 2);
+        writer.endSection();
+
+        // Unknown sections are skipped
+        writer.beginSection(static_cast<SAVE_SECTION>(1000));
+        writer.writeString("unknown");
+        writer.endSection();
+
+        writer.beginSection(SAVE_SECTION::MICROBES);
+        writer.write<uint32_t>(42);
+        writer.endSection();
+
+        writer.writeEnd();
+    }
+
+    SaveReader reader(stream);
+    REQUIRE_NOTHROW(reader.readHeader());
+
+    SAVE_SECTION section;
+    REQUIRE(reader.nextSection(section));
+    CHECK(section == SAVE_SECTION::PATCH_MAP);
+
+    CHECK(reader.read<int32_t>() == -5);
+    CHECK(reader.read<double>() == 0.25);
+    CHECK(reader.read<bool>() == true);
+    CHECK(reader.readString() == "a string");
+    CHECK(reader.readFloat3() == Float3(1, 2, 3));
+
+    std::vector<std::vector<float>> loadedGrid(3, std::vector<float>(2, 0));
+    reader.readGrid(loadedGrid);
+    CHECK(loadedGrid == grid);
+    CHECK(reader.getSectionRemaining() == 0);
+
+    REQUIRE(reader.nextSection(section));
+    CHECK(static_cast<uint32_t>(section) == 1000);
+
+    // Leaves the string unread
+    REQUIRE(reader.nextSection(section));
+    CHECK(section == SAVE_SECTION::MICROBES);
+    CHECK(reader.read<uint32_t>() == 42);
+
+    // Reading past the end of a section fails
+    CHECK_THROWS(reader.read<uint32_t>());
+
+    CHECK(!reader.nextSection(section));
+}
+
+TEST_CASE("Save reader rejects invalid data", "[save]")
+{
+    SECTION("Not a save")
+    {
+        std::stringstream stream("this is not a save file");
+        SaveReader reader(stream);
+        CHECK_THROWS(reader.readHeader());
+    }
+
+    SECTION("Wrong grid size")
+    {
+        std::stringstream stream;
+        {
+            SaveWriter writer(stream);
+            writer.writeHeader();
+            writer.beginSection(SAVE_SECTION::COMPOUND_CLOUDS);
+            const std::vector<float> wrongSize(4, 1);
+            writer.writeGrid(wrongSize.data(), 2, 2);
+            writer.endSection();
+            writer.writeEnd();
+        }
+
+        SaveReader reader(stream);
+        reader.readHeader();
+
+        SAVE_SECTION section;
+        REQUIRE(reader.nextSection(section));
+
+        std::vector<std::vector<float>> grid(3, std::vector<float>(3, 0));
+        CHECK_THROWS(reader.readGrid(grid));
+    }
+}
+
+TEST_CASE("Save grids skip runs of zeros", "[save]")
+{
+    std::vector<float> grid(1000, 0);
+    grid[10] = 1;
+    grid[11] = 2;
+    grid[13] = 3;
+    grid[999] = 4;
+
+    std::stringstream stream;
+    {
+        SaveWriter writer(stream);
+        writer.beginSection(SAVE_SECTION::COMPOUND_CLOUDS);
+        writer.writeGrid(grid.data(), 10, 100);
+        writer.writeGrid(grid.data(), 10, 100);
+        writer.endSection();
+        writer.writeEnd();
+    }
+
+    // Much smaller than the 4000 bytes the values take
+    CHECK(stream.str().size() < 150);
+
+    SaveReader reader(stream);
+
+    SAVE_SECTION section;
+    REQUIRE(reader.nextSection(section));
+
+    std::vector<std::vector<float>> loaded(10, std::vector<float>(100, 5));
+    reader.readGrid(loaded);
+
+    for(size_t i = 0; i < grid.size(); ++i)
+        CHECK(loaded[i / 100][i % 100] == grid[i]);
+
+    REQUIRE_NOTHROW(reader.skipGrid());
+    CHECK(reader.getSectionRemaining() == 0);
+}
+
+TEST_CASE("Patch map save round trip", "[save]")
+{
+    Leviathan::Test::TestLogger log("Test/test_log.txt");
+
+    REQUIRE_NOTHROW(SimulationParameters::init());
+
+    auto species1 = Species::MakeShared<Species>("Default");
+    species1->genus = "Primum";
+    species1->epithet = "thrivium";
+    species1->stringCode = "N,0,0,0|m,1,0,0";
+    species1->membraneType =
+        SimulationParameters::membraneRegistry.getTypeId("single");
+    species1->membraneRigidity = 0.5f;
+    species1->colour = Float4(0.1f, 0.2f, 0.3f, 1);
+    species1->aggression = 12;
+    species1->population = 150;
+
+    auto species2 = Species::MakeShared<Species>("Species_2");
+    species2->isBacteria = true;
+    species2->stringCode = "m,0,0,0";
+    species2->membraneType =
+        SimulationParameters::membraneRegistry.getTypeId("double");
+    species2->membraneRigidity = 0;
+
+    auto map = PatchMap::MakeShared<PatchMap>();
+
+    auto patch0 = Patch::MakeShared<Patch>("first", 0,
+        SimulationParameters::biomeRegistry.getTypeData("default"));
+    patch0->setScreenCoordinates(Float2(100, 50));
+    patch0->addNeighbour(1);
+    patch0->addSpecies(species1, 110);
+    patch0->addSpecies(species2, 40);
+
+    const auto atp = SimulationParameters::compoundRegistry.getTypeId("atp");
+    patch0->getBiome().compounds[atp].dissolved = 0.75;
+
+    auto patch1 = Patch::MakeShared<Patch>("second", 1,
+        SimulationParameters::biomeRegistry.getTypeData("tidepool"));
+    patch1->addNeighbour(0);
+    patch1->addSpecies(species1, 40);
+
+    map->addPatch(patch0);
+    map->addPatch(patch1);
+    REQUIRE(map->setCurrentPatch(1));
+
+    std::stringstream stream;
+    {
+        SaveWriter writer(stream);
+        writer.writeHeader();
+        writer.beginSection(SAVE_SECTION::PATCH_MAP);
+        savePatchMap(writer, *map);
+        writer.endSection();
+        writer.writeEnd();
+    }
+
+    SaveReader reader(stream);
+    reader.readHeader();
+
+    SAVE_SECTION section;
+    REQUIRE(reader.nextSection(section));
+    REQUIRE(section == SAVE_SECTION::PATCH_MAP);
+
+    PatchMap::pointer loaded;
+    REQUIRE_NOTHROW(loaded = loadPatchMap(reader));
+    REQUIRE(loaded);
+
+    CHECK(reader.getSectionRemaining() == 0);
+    CHECK(loaded->getCurrentPatchId() == 1);
+    REQUIRE(loaded->getPatches().size() == 2);
+
+    const auto loadedPatch0 = loaded->getPatch(0);
+    REQUIRE(loadedPatch0);
+    CHECK(loadedPatch0->getName() == "first");
+    CHECK(loadedPatch0->getScreenCoordinates() == Float2(100, 50));
+    CHECK(loadedPatch0->getNeighbours().count(1) == 1);
+    CHECK(loadedPatch0->getBiomeTemplate().internalName == "default");
+    CHECK(loadedPatch0->getBiome().getCompound(atp)->dissolved == 0.75);
+    REQUIRE(loadedPatch0->getSpeciesCount() == 2);
+
+    const auto loadedSpecies1 = loadedPatch0->searchSpeciesByName("Default");
+    REQUIRE(loadedSpecies1);
+    CHECK(loadedPatch0->getSpeciesPopulation(loadedSpecies1) == 110);
+    CHECK(loadedSpecies1->genus == "Primum");
+    CHECK(loadedSpecies1->epithet == "thrivium");
+    CHECK(loadedSpecies1->stringCode == species1->stringCode);
+    CHECK(loadedSpecies1->membraneType == species1->membraneType);
+    CHECK(loadedSpecies1->membraneRigidity == 0.5f);
+    CHECK(loadedSpecies1->colour == species1->colour);
+    CHECK(loadedSpecies1->aggression == 12);
+    CHECK(loadedSpecies1->population == 150);
+
+    const auto loadedSpecies2 = loadedPatch0->searchSpeciesByName("Species_2");
+    REQUIRE(loadedSpecies2);
+    CHECK(loadedSpecies2->isBacteria);
+    CHECK(loadedSpecies2->membraneType == species2->membraneType);
+
+    // The species are shared between the patches like before saving
+    const auto loadedPatch1 = loaded->getPatch(1);
+    REQUIRE(loadedPatch1);
+    CHECK(loadedPatch1->getBiomeTemplate().internalName == "tidepool");
+    CHECK(loadedPatch1->searchSpeciesByName("Default") == loadedSpecies1);
+    CHECK(loadedPatch1->getSpeciesPopulation(loadedSpecies1) == 40);
+}
+
+TEST_CASE("Compound cloud save round trip", "[save]")
+{
+    Leviathan::Test::PartialEngine<false> engine;
+    TestThriveGame thrive{&engine};
+    Leviathan::IDFactory ids;
+
+    thrive.lightweightInit();
+
+    CellStageWorld world{nullptr};
+    world.SetRunInBackground(true);
+
+    REQUIRE(world.Init(
+        Leviathan::WorldNetworkSettings::GetSettingsForHybrid(), nullptr));
+
+    const auto player = world.CreateEntity();
+    thrive.playerData().setActiveCreature(player);
+    world.Create_Position(player, Float3(0, 0, 0), Quaternion::IDENTITY);
+
+    world.GetCompoundCloudSystem().registerCloudTypes(world,
+        {Compound{1, "a", true, true, false, Float4(0, 1, 2, 1)},
+            Compound{2, "b", true, true, false, Float4(3, 4, 5, 1)}});
+
+    world.Tick(1);
+
+    const Float3 first(10, 0, 20);
+    const Float3 second(-CLOUD_WIDTH * 2, 0, 5);
+
+    REQUIRE(world.GetCompoundCloudSystem().addCloud(1, 1000, first));
+    REQUIRE(world.GetCompoundCloudSystem().addCloud(2, 500, second));
+
+    const auto firstAmount =
+        world.GetCompoundCloudSystem().amountAvailable(1, first, 1);
+    const auto secondAmount =
+        world.GetCompoundCloudSystem().amountAvailable(2, second, 1);
+
+    CHECK(firstAmount > 0);
+    CHECK(secondAmount > 0);
+
+    std::stringstream stream;
+    {
+        SaveWriter writer(stream);
+        writer.writeHeader();
+        writer.beginSection(SAVE_SECTION::COMPOUND_CLOUDS);
+        world.GetCompoundCloudSystem().saveClouds(writer);
+        writer.endSection();
+        writer.writeEnd();
+    }
+
+    world.GetCompoundCloudSystem().emptyAllClouds();
+    CHECK(world.GetCompoundCloudSystem().amountAvailable(1, first, 1) == 0);
+
+    SaveReader reader(stream);
+    reader.readHeader();
+
+    SAVE_SECTION section;
+    REQUIRE(reader.nextSection(section));
+    REQUIRE_NOTHROW(world.GetCompoundCloudSystem().loadClouds(world, reader));
+
+    CHECK(reader.getSectionRemaining() == 0);
+    CHECK(world.GetCompoundCloudSystem().amountAvailable(1, first, 1) ==
+          firstAmount);
+    CHECK(world.GetCompoundCloudSystem().amountAvailable(2, second, 1) ==
+          secondAmount);
+
+    SECTION("From a snapshot")
+    {
+        CompoundCloudsSnapshot snapshot;
+        world.GetCompoundCloudSystem().takeSnapshot(snapshot);
+
+        CHECK(!snapshot.clouds.empty());
+
+        // Changes after taking the snapshot are not saved
+        world.GetCompoundCloudSystem().emptyAllClouds();
+
+        std::stringstream snapshotStream;
+        {
+            SaveWriter writer(snapshotStream);
+            writer.writeHeader();
+            writer.beginSection(SAVE_SECTION::COMPOUND_CLOUDS);
+            snapshot.write(writer);
+            writer.endSection();
+            writer.writeEnd();
+        }
+
+        SaveReader snapshotReader(snapshotStream);
+        snapshotReader.readHeader();
+
+        REQUIRE(snapshotReader.nextSection(section));
+        REQUIRE_NOTHROW(
+            world.GetCompoundCloudSystem().loadClouds(world, snapshotReader));
+
+        CHECK(world.GetCompoundCloudSystem().amountAvailable(1, first, 1) ==
+              firstAmount);
+    }
+
+    world.Release();
+}
@@ -0,0 +1,96 @@
+//! Tests the timing of world systems
+#include "engine/system_profiler.h"
+#include "generated/cell_stage_world.h"
+
+#include <LeviathanTest/PartialEngine.h>
+
+#include "catch.hpp"
+
+using namespace thrive;
+using namespace std::chrono_literals;
+
+TEST_CASE("System profiler keeps rolling statistics", "[engine]")
+{
+    Leviathan::Test::PartialEngine<false> engine;
+    CellStageWorld world{nullptr};
+
+    auto& profiler = world.GetSystemProfiler();
+
+    CHECK(SystemProfiler::getForWorld(world) == &profiler);
+    CHECK(profiler.getStats().empty());
+
+    profiler.addSample("SpawnSystem", 2ms);
+    profiler.addSample("FluidSystem", 1ms);
+    profiler.addSample("SpawnSystem", 4ms);
+    profiler.addTickTotal(10ms);
+
+    auto stats = profiler.getStats();
+
+    REQUIRE(stats.size() == 3);
+
+    // In the order the systems first ran
+    CHECK(stats[0].name == "SpawnSystem");
+    CHECK(stats[0].samples == 2);
+    CHECK(stats[0].last == Approx(4));
+    CHECK(stats[0].average == Approx(3));
+    CHECK(stats[0].max == Approx(4));
+
+    CHECK(stats[1].name == "FluidSystem");
+
+    CHECK(stats[2].name == SystemProfiler::UNPROFILED);
+    CHECK(stats[2].last == Approx(3));
+
+    SECTION("Only the latest runs are kept")
+    {
+        for(int i = 0; i < 500; ++i)
+            profiler.addSample("FluidSystem", 5ms);
+
+        stats = profiler.getStats();
+        CHECK(stats[1].samples < 500);
+        CHECK(stats[1].average == Approx(5));
+        CHECK(stats[1].last == Approx(5));
+    }
+
+    SECTION("Dumps contain all systems")
+    {
+        const auto json = profiler.toJSON();
+        CHECK(json.front() == '[');
+        CHECK(json.find("\"name\":\"FluidSystem\"") != std::string::npos);
+
+        const auto csv = profiler.toCSV();
+        CHECK(csv.find("system,last_ms,average_ms,max_ms,samples\n") == 0);
+        CHECK(csv.find("SpawnSystem,4,3,4,2\n") != std::string::npos);
+    }
+
+    SECTION("Ticks ran by the engine are timed from the first system")
+    {
+        const auto now = SystemProfiler::Clock::now();
+
+        // No system has ran
+        profiler.finishTick(now);
+        CHECK(profiler.getStats()[2].samples == 1);
+
+        profiler.addSample("SpawnSystem", 2ms);
+        profiler.finishTick(SystemProfiler::Clock::now() + 5ms);
+
+        stats = profiler.getStats();
+        CHECK(stats[2].samples == 2);
+        CHECK(stats[2].last >= 5);
+    }
+
+    SECTION("Clearing removes the systems")
+    {
+        profiler.OnClear();
+        CHECK(profiler.getStats().empty());
+    }
+}
+
+TEST_CASE("System profiler interns script system names", "[engine]")
+{
+    const auto* name = SystemProfiler::internName("MicrobeSystem");
+
+    CHECK(std::string(name) == "MicrobeSystem");
+    CHECK(SystemProfiler::internName(std::string("Microbe") + "System") ==
+          name);
+    CHECK(SystemProfiler::internName("MicrobeAISystem") != name);
+}
@@ -0,0 +1,68 @@
+//! Tests recording traces
+#include "engine/tracing.h"
+
+#include "catch.hpp"
+
+#include <thread>
+
+using namespace thrive;
+
+TEST_CASE("Tracer records nothing when not recording", "[engine]")
+{
+    Tracer::start();
+    Tracer::stop();
+
+    {
+        TraceZone zone("NotRecorded");
+        Tracer::counter("NotRecordedCounter", 1);
+    }
+
+    const auto json = Tracer::toChromeTraceJSON();
+    CHECK(json.find("NotRecorded") == std::string::npos);
+}
+
+TEST_CASE("Tracer writes zones from multiple threads", "[engine]")
+{
+    Tracer::start();
+    REQUIRE(Tracer::isRecording());
+
+    Tracer::setThreadName("Test \"main\"");
+
+    {
+        TraceZone zone("MainZone");
+        Tracer::flowStart("Work", 42);
+        Tracer::counter("Queued", 3);
+    }
+
+    std::thread worker([]() {
+        Tracer::setThreadName("Worker");
+
+        TraceZone zone("WorkerZone", "worker");
+        Tracer::flowEnd("Work", 42);
+    });
+    worker.join();
+
+    Tracer::stop();
+
+    const auto json = Tracer::toChromeTraceJSON();
+
+    CHECK(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    CHECK(json.find("\"name\":\"Test \\\"main\\\"\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"Worker\"") != std::string::npos);
+
+    CHECK(json.find("\"ph\":\"X\",\"name\":\"MainZone\",\"cat\":\"thrive\"") !=
+          std::string::npos);
+    CHECK(json.find("\"name\":\"WorkerZone\",\"cat\":\"worker\"") !=
+          std::string::npos);
+    CHECK(json.find("\"ph\":\"s\",\"name\":\"Work\"") != std::string::npos);
+    CHECK(json.find("\"id\":42,\"bp\":\"e\"") != std::string::npos);
+    CHECK(json.find("\"args\":{\"value\":3}") != std::string::npos);
+
+    SECTION("Starting again clears the events")
+    {
+        Tracer::start();
+        Tracer::stop();
+        CHECK(Tracer::toChromeTraceJSON().find("MainZone") ==
+              std::string::npos);
+    }
+}
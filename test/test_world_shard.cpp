@@ -0,0 +1,142 @@
+//! Tests the server world shards
+#include "generated/cell_stage_world.h"
+#include "server/world_shard.h"
+#include "test_thrive_game.h"
+
+#include <Exceptions.h>
+#include <LeviathanTest/PartialEngine.h>
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace thrive;
+
+TEST_CASE("World shard ticks its world at the fixed rate", "[server]")
+{
+    Leviathan::Test::PartialEngine<false> engine;
+    TestThriveGame thrive{&engine};
+    thrive.lightweightInit();
+
+    auto world = std::make_shared<CellStageWorld>(nullptr);
+    REQUIRE(world->Init(
+        Leviathan::WorldNetworkSettings::GetSettingsForServer(), nullptr));
+
+    {
+        WorldShard shard(3, world, 100, 20);
+        CHECK(shard.getPatchId() == 3);
+
+        // The time is given to the shard so that this doesn't depend on how
+        // fast the test runs
+        const auto start = FixedRateTicker::Clock::now();
+        const auto at = [&](int milliseconds) {
+            return start + std::chrono::milliseconds(milliseconds);
+        };
+
+        // The first update starts the ticking
+        CHECK(shard.update(at(0)) == 1);
+        CHECK(shard.update(at(5)) == 0);
+        CHECK(shard.update(at(100)) == 10);
+
+        const auto stats = shard.takeStats(at(100));
+
+        CHECK(stats.ticks.ticks == 11);
+        CHECK(stats.ticks.droppedTicks == 0);
+        CHECK(stats.players == 0);
+        CHECK(stats.wallTime == std::chrono::milliseconds(100));
+        CHECK(stats.getCpuUsage() >= 0);
+
+        // Stats are reset
+        CHECK(shard.takeStats(at(200)).ticks.ticks == 0);
+
+        // Falling far behind drops the ticks beyond the catch up limit
+        CHECK(shard.update(at(1000)) == 20);
+        CHECK(shard.takeStats(at(1000)).ticks.droppedTicks == 70);
+
+        CHECK(!shard.hasPlayer(1));
+        CHECK(shard.removePlayer(1) == nullptr);
+    }
+
+    world->Release();
+}
+
+TEST_CASE("World shard runs queued tasks before its next tick", "[server]")
+{
+    Leviathan::Test::PartialEngine<false> engine;
+    TestThriveGame thrive{&engine};
+    thrive.lightweightInit();
+
+    auto world = std::make_shared<CellStageWorld>(nullptr);
+    REQUIRE(world->Init(
+        Leviathan::WorldNetworkSettings::GetSettingsForServer(), nullptr));
+
+    {
+        WorldShard shard(1, world, 100, 20);
+
+        const auto start = FixedRateTicker::Clock::now();
+        const auto at = [&](int milliseconds) {
+            return start + std::chrono::milliseconds(milliseconds);
+        };
+
+        CHECK(shard.update(at(0)) == 1);
+
+        int ran = 0;
+        shard.queueTask([&](WorldShard& target) {
+            CHECK(&target == &shard);
+            ++ran;
+        });
+
+        // Not ran between the ticks
+        CHECK(shard.update(at(5)) == 0);
+        CHECK(ran == 0);
+
+        CHECK(shard.update(at(10)) == 1);
+        CHECK(ran == 1);
+
+        // Only once
+        CHECK(shard.update(at(20)) == 1);
+        CHECK(ran == 1);
+    }
+
+    world->Release();
+}
+
+TEST_CASE("World shard ticks on its own thread", "[server]")
+{
+    Leviathan::Test::PartialEngine<false> engine;
+    TestThriveGame thrive{&engine};
+    thrive.lightweightInit();
+
+    auto world = std::make_shared<CellStageWorld>(nullptr);
+    REQUIRE(world->Init(
+        Leviathan::WorldNetworkSettings::GetSettingsForServer(), nullptr));
+
+    {
+        WorldShard shard(1, world, 100, 20);
+
+        std::atomic<bool> ran{false};
+        std::thread::id taskThread;
+
+        shard.queueTask([&](WorldShard&) {
+            taskThread = std::this_thread::get_id();
+            ran = true;
+        });
+
+        shard.start();
+        CHECK(shard.isRunning());
+        CHECK_THROWS_AS(shard.start(), Leviathan::InvalidState);
+
+        for(int i = 0; i < 200 && !ran; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        shard.stop();
+        CHECK(!shard.isRunning());
+
+        REQUIRE(ran);
+        CHECK(taskThread != std::this_thread::get_id());
+        CHECK(shard.takeStats().ticks.ticks > 0);
+    }
+
+    world->Release();
+}